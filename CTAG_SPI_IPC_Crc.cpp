@@ -0,0 +1,215 @@
+/**
+ * @file CTAG_SPI_IPC_Crc.cpp
+ * @brief Table-driven CRC-8, CRC-16 and CRC-32, the RP2040's DMA sniffer and
+ * the ESP32's ROM CRC-32.
+ *
+ * The tables are computed at compile time. CRC-16 and CRC-32 use four tables
+ * (slicing-by-4) and take four bytes per step. The functions and their tables
+ * are kept in RAM, as the slave checks frames in its interrupt, and on the
+ * RP2040 a table lookup from flash would miss the XIP cache most of the time.
+ */
+#include "CTAG_SPI_IPC.h"
+
+#ifdef ESP32
+#include "esp_rom_crc.h"
+#endif
+
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/dma.h>
+#include <hardware/sync.h>
+#include <pico/platform.h>
+#endif
+
+#ifdef ESP32
+#define CRC_FUNC(func) IRAM_ATTR func
+#define CRC_TABLE DRAM_ATTR
+#elif defined(ARDUINO_ARCH_RP2040)
+#define CRC_FUNC(func) __not_in_flash_func(func)
+#define CRC_TABLE __not_in_flash("ctag_crc")
+#else
+#define CRC_FUNC(func) func
+#define CRC_TABLE
+#endif
+
+namespace CTAG_SPI_IPC {
+
+// --- Tables ---
+
+struct Crc8Table  { uint8_t  t[256]; };
+struct Crc16Table { uint16_t t[4][256]; };
+struct Crc32Table { uint32_t t[4][256]; };
+
+/**
+ * @brief CRC-8, polynomial 0x07, MSB first: the checksum the frames have
+ * always used.
+ */
+static constexpr Crc8Table makeCrc8() {
+  Crc8Table r = {};
+  for (int i = 0; i < 256; ++i) {
+    uint8_t c = (uint8_t)i;
+    for (int b = 0; b < 8; ++b) c = (c & 0x80) ? (uint8_t)((c << 1) ^ 0x07) : (uint8_t)(c << 1);
+    r.t[i] = c;
+  }
+  return r;
+}
+
+/**
+ * @brief Reflected tables: t[0] is the classic byte table, t[k] advances a
+ * byte by k further zero bytes.
+ */
+static constexpr Crc16Table makeCrc16(uint16_t poly) {
+  Crc16Table r = {};
+  for (int i = 0; i < 256; ++i) {
+    uint16_t c = (uint16_t)i;
+    for (int b = 0; b < 8; ++b) c = (c & 1) ? (uint16_t)((c >> 1) ^ poly) : (uint16_t)(c >> 1);
+    r.t[0][i] = c;
+  }
+  for (int k = 1; k < 4; ++k)
+    for (int i = 0; i < 256; ++i)
+      r.t[k][i] = (uint16_t)((r.t[k - 1][i] >> 8) ^ r.t[0][r.t[k - 1][i] & 0xFF]);
+  return r;
+}
+
+static constexpr Crc32Table makeCrc32(uint32_t poly) {
+  Crc32Table r = {};
+  for (int i = 0; i < 256; ++i) {
+    uint32_t c = (uint32_t)i;
+    for (int b = 0; b < 8; ++b) c = (c & 1) ? (c >> 1) ^ poly : c >> 1;
+    r.t[0][i] = c;
+  }
+  for (int k = 1; k < 4; ++k)
+    for (int i = 0; i < 256; ++i)
+      r.t[k][i] = (r.t[k - 1][i] >> 8) ^ r.t[0][r.t[k - 1][i] & 0xFF];
+  return r;
+}
+
+static const Crc8Table  CRC_TABLE kCrc8  = makeCrc8();
+static const Crc16Table CRC_TABLE kCrc16 = makeCrc16(0x8408);      // X-25, reflected 0x1021
+static const Crc32Table CRC_TABLE kCrc32 = makeCrc32(0xEDB88320);  // zlib, reflected 0x04C11DB7
+
+
+// --- Software ---
+
+uint8_t CRC_FUNC(crc8)(const uint8_t* data, size_t len) {
+  uint8_t crc = 0;
+  while (len--) crc = kCrc8.t[crc ^ *data++];
+  return crc;
+}
+
+uint16_t CRC_FUNC(crc16)(const uint8_t* data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  // Bytes are loaded one by one, so alignment and endianness do not matter
+  for (; len >= 4; len -= 4, data += 4) {
+    crc = kCrc16.t[3][(crc ^ data[0]) & 0xFF] ^ kCrc16.t[2][((crc >> 8) ^ data[1]) & 0xFF] ^
+          kCrc16.t[1][data[2]] ^ kCrc16.t[0][data[3]];
+  }
+  while (len--) crc = (crc >> 8) ^ kCrc16.t[0][(crc ^ *data++) & 0xFF];
+  return (uint16_t)~crc;
+}
+
+uint32_t CRC_FUNC(crc32Software)(const uint8_t* data, size_t len) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (; len >= 4; len -= 4, data += 4) {
+    crc ^= data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+    crc = kCrc32.t[3][crc & 0xFF] ^ kCrc32.t[2][(crc >> 8) & 0xFF] ^
+          kCrc32.t[1][(crc >> 16) & 0xFF] ^ kCrc32.t[0][crc >> 24];
+  }
+  while (len--) crc = (crc >> 8) ^ kCrc32.t[0][(crc ^ *data++) & 0xFF];
+  return ~crc;
+}
+
+
+// --- Hardware ---
+
+#ifdef ARDUINO_ARCH_RP2040
+
+/// Shorter blocks are faster in software than setting up the DMA.
+static const size_t kSnifferMinLen = 128;
+
+static int      _sniffChannel = -1;      // Claimed on first use
+static int8_t   _sniffCore = -1;         // The core that owns the sniffer
+static int8_t   _sniffWorks = -1;        // Result of the self-test, -1 before it ran
+static volatile bool _sniffBusy = false; // Guards against the core's own interrupts
+static uint8_t  _sniffSink;
+
+/**
+ * @brief Runs a block through a DMA channel into a dummy byte; the sniffer
+ * computes the CRC on the way. CRC32R reflects the input bytes, and the
+ * reversed, inverted accumulator is the zlib CRC.
+ */
+static uint32_t CRC_FUNC(sniff)(const uint8_t* data, size_t len) {
+  dma_channel_config c = dma_channel_get_default_config(_sniffChannel);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_sniff_enable(&c, true);
+  dma_sniffer_set_data_accumulator(0xFFFFFFFF);
+  dma_sniffer_set_output_reverse_enabled(true);
+  dma_sniffer_set_output_invert_enabled(true);
+  dma_sniffer_enable(_sniffChannel, DMA_SNIFF_CTRL_CALC_VALUE_CRC32R, true);
+  dma_channel_configure(_sniffChannel, &c, &_sniffSink, data, len, true);
+  dma_channel_wait_for_finish_blocking(_sniffChannel);
+  uint32_t crc = dma_sniffer_get_data_accumulator();
+  dma_sniffer_disable();
+  return crc;
+}
+
+/**
+ * @brief Takes the sniffer for one block.
+ * @return False if it belongs to the other core, is in use by an interrupted
+ * call, or failed its self-test; the caller then computes in software.
+ */
+static bool CRC_FUNC(acquireSniffer)() {
+  uint32_t irq = save_and_disable_interrupts();
+  bool ok = !_sniffBusy && _sniffWorks != 0;
+  if (ok && _sniffChannel < 0) {
+    _sniffChannel = dma_claim_unused_channel(false);
+    _sniffCore = (int8_t)get_core_num();
+    if (_sniffChannel < 0) _sniffWorks = 0;
+  }
+  ok = ok && _sniffChannel >= 0 && _sniffCore == (int8_t)get_core_num();
+  if (ok) _sniffBusy = true;
+  restore_interrupts(irq);
+  if (!ok) return false;
+
+  if (_sniffWorks < 0) {
+    // Compare against the table once, so a sniffer that disagrees is never trusted
+    static const uint8_t probe[kSnifferMinLen] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    _sniffWorks = sniff(probe, sizeof(probe)) == crc32Software(probe, sizeof(probe));
+    if (!_sniffWorks) {
+      _sniffBusy = false;
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t CRC_FUNC(crc32)(const uint8_t* data, size_t len) {
+  if (len < kSnifferMinLen || !acquireSniffer()) return crc32Software(data, len);
+  uint32_t crc = sniff(data, len);
+  _sniffBusy = false;
+  return crc;
+}
+
+#elif defined(ESP32) // No CRC peripheral, but the ROM has a CRC-32 that is safe in an ISR
+
+static int8_t _romWorks = -1; // Result of the self-test, -1 before it ran
+
+uint32_t CRC_FUNC(crc32)(const uint8_t* data, size_t len) {
+  if (_romWorks < 0) {
+    // Compare against the table once, so a ROM routine that disagrees is never trusted
+    static const uint8_t CRC_TABLE probe[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    _romWorks = esp_rom_crc32_le(0, probe, sizeof(probe)) == crc32Software(probe, sizeof(probe));
+  }
+  return _romWorks ? esp_rom_crc32_le(0, data, len) : crc32Software(data, len);
+}
+
+#else
+
+uint32_t CRC_FUNC(crc32)(const uint8_t* data, size_t len) {
+  return crc32Software(data, len);
+}
+
+#endif
+
+} // namespace CTAG_SPI_IPC
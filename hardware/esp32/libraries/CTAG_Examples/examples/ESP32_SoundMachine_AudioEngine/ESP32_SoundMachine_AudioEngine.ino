@@ -5,11 +5,19 @@
  * This sketch implements the specified architecture:
  * - A dedicated task on Core 0 handles SPI communication and synth logic.
  * - A dedicated task on Core 1 handles real-time audio generation.
- * - A mutex ensures thread-safe data exchange between the tasks.
+ * - A CTAG_PluginRack receives the controller's versioned parameter deltas and
+ *   keyframes (CTAG_ParamSync) and applies them, smoothed, to whichever synth
+ *   is selected. Ranges, curves and IDs come from CTAG_SourceParams, shared
+ *   with the RP2040 controller. When a delta goes missing, the logic task asks
+ *   the controller for a keyframe.
+ * - The logic task queues a status message (active synth, DSP load) ten times a
+ *   second; the controller receives it in the same SPI transactions it uses
+ *   for its own messages. Every few seconds it prints the link statistics.
  */
 
 // --- Libraries & Headers ---
 #include <CTAG_Audio.h> // We only use the CTAG_AudioCodec class from here
+#include <CTAG_AudioParams.h>
 #include <CTAG_SPI_IPC.h>
 #include "pins_arduino.h"
 #include "driver/i2s.h" // We need direct I2S access for our custom audio task
@@ -30,45 +38,35 @@ CTAG_VCO_Sine sineSynth;        ///< A simple sine wave synthesizer object.
 CTAG_VCO_Square squareSynth;    ///< A simple square wave synthesizer object.
 CTAG_VCO_Saw sawSynth;          ///< A simple saw wave synthesizer object.
 CTAG_FMSynth fmSynth;           ///< A simple FM synthesizer object.
+CTAG_PluginRack rack;           ///< Parameter banks of all synths, selects the active one.
 
 
-/** @brief A low-level spinlock for protecting shared data between cores and ISRs. */
-static portMUX_TYPE dataMux = portMUX_INITIALIZER_UNLOCKED;
-
-// --- IPC Data Structure (must match the RP2040) ---
-typedef struct {
-  uint16_t pot_values[4];
-  uint8_t  encoder_pos;
-} ctag_ipc_packet_t;
-
 // --- Shared Resources ---
-/** @brief The "mailbox" for SPI data, written by ISR, read by audioTask. Declared volatile. */
-volatile ctag_ipc_packet_t received_data;
-/** @brief Flag set by ISR to signal new data is ready for processing. Declared volatile. */
-volatile bool newDataFromSPI = false;
 /** @brief Flag to confirm the SPI slave has been initialized. Declared volatile. */
 volatile bool slave_init = false;
 
+/** @brief Interval of the link statistics print, in logic task cycles of 100 ms. */
+static const uint32_t LINK_STATS_CYCLES = 50;
+
 
 // ====================================================================================
 //                             CALLBACK & RTOS TASKS
 // ====================================================================================
 /** * @brief SPI ISR Callback. Triggered when a full data packet is received.
  * @note This function runs in an interrupt context and must be as fast as possible.
- * It uses a critical section (spinlock) for thread-safe data copy.
+ * The rack only stores the new parameter targets (integer-only, lock-free);
+ * the audio task picks them up before its next block.
  */
 void onSpiPacketReceived(const uint8_t* data, size_t len) {
-  if (len == sizeof(ctag_ipc_packet_t)) {
-    portENTER_CRITICAL(&dataMux);
-    memcpy((void*)&received_data, data, len);
-    newDataFromSPI = true;
-    portEXIT_CRITICAL(&dataMux);
-  }
+  rack.handleMessage(data, len);
 }
 
 
 
-/** * @brief The logic task running on Core 0. Its only job is to initialize the SPI slave.
+/** * @brief The logic task running on Core 0. It initializes the SPI slave and
+ * then reports the engine's status to the controller, or asks for a keyframe
+ * while the rack's parameters are out of sync. It also prints the link
+ * statistics.
  */
 void logicTask(void *pvParameters) {
   if (CTAG_SPI_IPC::beginSlave(PIN_SPI0_SCK, PIN_SPI0_MISO, PIN_SPI0_MOSI, PIN_SPI0_SS, onSpiPacketReceived)) {
@@ -76,10 +74,40 @@ void logicTask(void *pvParameters) {
     slave_init = true;
   } else {
     Serial.println("Slave initialization FAILED!");
+    // Nothing left to do; delete the task to save resources.
+    vTaskDelete(NULL);
   }
 
-  // The Loop has done its job and can be deleted to save resources.
-  vTaskDelete(NULL);
+  for (;;) {
+    // Only queue a new message once the controller has picked up the last one.
+    if (CTAG_SPI_IPC::slaveTxPending() == 0 && rack.needsKeyframe()) {
+      uint8_t msg[2];
+      CTAG_Params::buildResync(msg, rack.syncTracker().plugin());
+      CTAG_SPI_IPC::slaveSend(msg, sizeof(msg));
+    } else if (CTAG_SPI_IPC::slaveTxPending() == 0) {
+      CTAG_AudioEngine::Stats stats = CTAG_AudioEngine::getStats();
+      uint8_t msg[4] = {
+        CTAG_Params::kStatusMsgId,
+        rack.selected(),
+        (uint8_t)constrain(stats.dspLoad * 100.0f, 0.0f, 255.0f),
+        (uint8_t)constrain(stats.peakLoad * 100.0f, 0.0f, 255.0f)
+      };
+      CTAG_SPI_IPC::slaveSend(msg, sizeof(msg));
+    }
+
+    // Frames from the controller as the engine sees them; overruns are
+    // packets the callback could not take.
+    static uint32_t cycles = 0;
+    if (++cycles >= LINK_STATS_CYCLES) {
+      cycles = 0;
+      CTAG_SPI_IPC::LinkStats link = CTAG_SPI_IPC::getLinkStats();
+      Serial.printf("Link: %lu ok, %lu CRC errors, %lu magic errors, %lu overruns, %lu B/s, %lu sync gaps\n",
+                    (unsigned long)link.framesOk, (unsigned long)link.crcErrors,
+                    (unsigned long)link.magicErrors, (unsigned long)link.overruns,
+                    (unsigned long)link.bytesPerSecond, (unsigned long)rack.syncTracker().gaps());
+    }
+    vTaskDelay(pdMS_TO_TICKS(100));
+  }
 }
 
 /** * @brief The main audio task running on Core 1.
@@ -100,104 +128,19 @@ void audioTask(void *pvParameters) {
   // 2) Configure the I2S engine (no render loop yet, just init hardware)
   CTAG_AudioEngine::init(I2S_NUM_0); 
 
-  // 3) Clear any previous source
-  CTAG_AudioEngine::setSource(nullptr);
+  // 3) Register the synths; their descriptors define the plugin IDs and
+  //    parameters the controller addresses.
+  rack.add(&sineSynth);
+  rack.add(&squareSynth);
+  rack.add(&sawSynth);
+  rack.add(&fmSynth);
   Serial.println("Audio Engine initialized. Starting render loop...");
 
-  ctag_ipc_packet_t lastPacket = { { 0 }, 0 };
   for (;;) {
-    ctag_ipc_packet_t localPacket;
-    
-    // Safely copy the latest data from the ISR's mailbox
-    portENTER_CRITICAL(&dataMux);
-      memcpy(&localPacket, (const void*)&received_data, sizeof(localPacket));
-    portEXIT_CRITICAL(&dataMux);
-    
-    // Check if the data has changed since the last loop cycle
-    if (memcmp(&localPacket, &lastPacket, sizeof(localPacket)) != 0) {
-      
-      // Use the encoder position to select the active synth object
-      switch(localPacket.encoder_pos) {
-        case 0: {// --- Sine VCO Slot ---
-          CTAG_AudioEngine::setSource(&sineSynth);
-
-          uint16_t frequency     = localPacket.pot_values[0];
-          uint16_t amplitude    = localPacket.pot_values[1];
-          uint16_t vibrato_rate  = localPacket.pot_values[2];
-          uint16_t vibrato_depth = localPacket.pot_values[3];
-
-          sineSynth.setFrequency(frequency);
-
-          float normalised_amplitude = (float)amplitude / 100.0f;             
-          sineSynth.setAmplitude(normalised_amplitude);
-
-          sineSynth.setLfoRate(vibrato_rate);
-          sineSynth.setLfoDepth(vibrato_depth);
-          break;
-        }
-
-        case 1: {// --- Square VCO Slot ---
-          CTAG_AudioEngine::setSource(&squareSynth);
-
-          uint16_t frequency     = localPacket.pot_values[0];
-          uint16_t amplitude     = localPacket.pot_values[1];
-          uint16_t duty_cycle    = localPacket.pot_values[2];
-
-          squareSynth.setFrequency(frequency);
-          
-          float normalised_amplitude = (float)amplitude / 100.0f;             
-          squareSynth.setAmplitude(normalised_amplitude);
-          
-          float normalised_duty_cycle = (float)duty_cycle / 100.0f; 
-          squareSynth.setDutyCycle(normalised_duty_cycle);
-          break;
-        }
-
-        case 2: {// --- Saw VCO Slot ---
-           CTAG_AudioEngine::setSource(&sawSynth);
-
-           uint16_t frequency     = localPacket.pot_values[0];
-           uint16_t amplitude     = localPacket.pot_values[1];
-           uint16_t skew          = localPacket.pot_values[2];
-
-           sawSynth.setFrequency(frequency);
-
-           float normalised_amplitude = (float)amplitude / 100.0f;             
-           sawSynth.setAmplitude(normalised_amplitude);
-
-           float normalised_skew = (float)skew / 100.0f; 
-           sawSynth.setSkew(normalised_skew);
-           break;
-        }
-
-        case 3: {// --- FM Synth Slot ---
-           CTAG_AudioEngine::setSource(&fmSynth);
-
-           uint16_t carrier_frequency    = localPacket.pot_values[0];
-           uint16_t amplitude            = localPacket.pot_values[1];
-           uint16_t modular_frequency    = localPacket.pot_values[2];
-           uint16_t modular_depth        = localPacket.pot_values[3];
-
-           fmSynth.setCarrierFreq(carrier_frequency);
-          
-           float normalised_amplitude = (float)amplitude / 100.0f;             
-           fmSynth.setAmplitude(normalised_amplitude);
-
-           fmSynth.setModFreq(modular_frequency);
-           fmSynth.setModIndex(modular_depth);
-           break;
-        }
-
-        default: {
-           CTAG_AudioEngine::setSource(nullptr); // No sound
-           break;
-        }
-      }
-      
-      // Remember this packet for the next comparison
-      memcpy(&lastPacket, &localPacket, sizeof(localPacket));
-    }
-    
+    // 4) Switch synths if the controller asked for it and glide the
+    //    parameters towards their latest targets.
+    rack.update();
+
     // 5) Render exactly one block of audio with the current settings
     CTAG_AudioEngine::renderBlock();
   }
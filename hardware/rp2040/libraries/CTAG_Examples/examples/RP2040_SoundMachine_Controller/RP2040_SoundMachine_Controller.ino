@@ -3,14 +3,25 @@
  * @brief Core sketch for the RP2040 acting as the main UI controller.
  *
  * This sketch performs the following tasks:
- * - Core 0: Reads all inputs from the CTAG Extension Board, and sends the complete UI state via SPI to a sound engine (ESP32).
- * - Core 1: Acts as a dedicated UI renderer, displaying the state on the OLED
- * and providing visual feedback on the LEDs.
+ * - Core 0: Keeps the UI state in sync with a sound engine (ESP32) over SPI
+ *   with CTAG_ParamSync: versioned deltas of the knobs that changed, a
+ *   keyframe of the whole plugin after a switch, every few seconds and
+ *   whenever the engine reports a lost delta. While nothing changes, the
+ *   link only polls the engine's status (DSP load) ten times a second.
+ *   Every few seconds it prints the link statistics to Serial1.
+ * - Core 1: Reads all inputs from the CTAG Extension Board and acts as a
+ *   dedicated UI renderer, displaying the state on the OLED and providing
+ *   visual feedback on the LEDs.
+ *
+ * Plugin names, parameter labels, ranges and units all come from the
+ * descriptor tables in CTAG_SourceParams, which the ESP32 uses as well.
  */
 // --- CTAG Libraries ---
 #include <CTAG_ExtensionBoard.h>
 #include <CTAG_Display.h>
 #include <CTAG_SPI_IPC.h>
+#include <CTAG_SourceParams.h>
+#include <CTAG_ParamSync.h>
 
 // --- System & Hardware Headers ---
 #include "pins_arduino.h"
@@ -29,22 +40,31 @@
 // --- Library Objects ---
 CTAG_ExtensionBoard extBoard(17, PIN_NEOPIXELS, 0x42, &Wire1);
 CTAG_Display        display;
+CTAG_ParamSyncSender paramSync;   ///< Register map of the selected plugin (Core 0 only).
 
 // --- Inter-Core Communication Mailboxes (written by Core 1, read by Core 0) ---
 // These volatile variables safely pass data from the UI core to the comms core.
-volatile int      pot_value_A = 0;
-volatile int      pot_value_B = 0;
-volatile int      pot_value_C = 0;
-volatile int      pot_value_D = 0;
-volatile int      encoder_pos = 0;
+// Pot positions are already normalized (0-65535), exactly what CTAG_Params sends.
+volatile uint16_t pot_values[4] = { 0 };
+volatile uint8_t  plugin_id     = 0;
 
-/**
- * @brief This structure defines the data packet sent via SPI to the ESP32.
- */
-typedef struct {
-  uint16_t pot_values[4];   // Current values of the 4 pots (0-1023)
-  uint8_t  encoder_pos;     // Current absolute position of the encoder
-} ctag_ipc_packet_t;
+// --- Engine Status (written by Core 0, read by Core 1) ---
+volatile uint8_t engine_load      = 0;    ///< DSP load of the ESP32's audio task in %.
+volatile uint8_t engine_peak_load = 0;    ///< Peak DSP load in %.
+volatile bool    engine_online    = false;
+
+/** @brief Pot movement (of 65535) that counts as a change; hides ADC noise. */
+static const uint16_t POT_DEADBAND = 64;
+
+/** @brief Interval of the periodic keyframe in milliseconds. Lost deltas are
+ *  repaired at once through the engine's keyframe request; this is a backstop. */
+static const uint32_t KEYFRAME_MS = 5000;
+
+/** @brief Interval of the status poll while no parameter changes, in milliseconds. */
+static const uint32_t STATUS_POLL_MS = 100;
+
+/** @brief Interval of the link statistics print, in milliseconds. */
+static const uint32_t LINK_STATS_MS = 5000;
 
 // ====================================================================================
 //                                  SETUP (CORE 0)
@@ -64,6 +84,9 @@ void setup() {
 
   // Initialize the SPI library in Master Mode for communication with the ESP32
   CTAG_SPI_IPC::beginMaster(PIN_SPI0_SS, SPI);
+
+  paramSync.setDeadband(POT_DEADBAND);
+  paramSync.setKeyframeInterval(KEYFRAME_MS);
 }
 
 // ====================================================================================
@@ -81,41 +104,60 @@ void setup1() {
 // ====================================================================================
 void loop() {
   // This core's only job is to read the latest UI state from the mailboxes
-  // and send it over SPI.
-  ctag_ipc_packet_t packet_to_send;
-
-  // Read the mailbox variables into the packet structure
-  packet_to_send.pot_values[0] = pot_value_A;
-  packet_to_send.pot_values[1] = pot_value_B;
-  packet_to_send.pot_values[2] = pot_value_C;
-  packet_to_send.pot_values[3] = pot_value_D;
-  packet_to_send.encoder_pos   = encoder_pos;
-  
-  // --- SERIAL PRINT FOR DEBUGGING ---
-  // This block prints the content of the packet right before it's sent.
-  // It only prints when a value has changed to avoid flooding the monitor.
-  static ctag_ipc_packet_t last_sent_packet;
-  if (memcmp(&packet_to_send, &last_sent_packet, sizeof(ctag_ipc_packet_t)) != 0) {
-    Serial1.println("----------------------------------------");
-    Serial1.println("CORE 0: Change detected. Preparing to send SPI packet...");
-    
-    // Print each value of the packet individually
-    Serial.printf("  - Pot Values: A=%-4d, B=%-4d, C=%-4d, D=%-4d\n", 
-                    packet_to_send.pot_values[0], packet_to_send.pot_values[1], 
-                    packet_to_send.pot_values[2], packet_to_send.pot_values[3]);
-    Serial.printf("  - Encoder Pos: %d\n", packet_to_send.encoder_pos);
-    
-    // Update the last sent packet state, so we only print on change
-    last_sent_packet = packet_to_send;
+  // and send what changed over SPI.
+  static uint8_t  last_plugin = 0xFF;
+  static uint32_t last_poll   = 0;
+  static uint32_t last_stats  = 0;
+
+  const uint8_t plugin = plugin_id;
+  const CTAG_PluginDesc& desc = CTAG_SourceParams::kPlugins[plugin];
+  if (plugin != last_plugin) {
+    paramSync.setPlugin(desc); // The next message is a keyframe
+    last_plugin = plugin;
   }
 
-  // Send the data packet to the ESP32
-  bool ok = CTAG_SPI_IPC::send((const uint8_t*)&packet_to_send, sizeof(packet_to_send));
-  if (!ok) {
-    Serial1.println("CORE 0: ERROR - SPI send failed!");
+  // Pot i controls parameter i of the selected plugin.
+  for (uint8_t i = 0; i < 4 && i < desc.numParams; ++i) {
+    paramSync.set(desc.params[i].id, pot_values[i]);
+  }
+  uint8_t msg[CTAG_SPI_IPC::kMaxPayload];
+  size_t msgLen = paramSync.build(msg, sizeof(msg), millis());
+
+  // Talk to the ESP32 only if there is a message or the status is due.
+  // Either way the ESP32's queued reply comes back in the same transaction.
+  if (msgLen || millis() - last_poll >= STATUS_POLL_MS) {
+    if (msgLen && !(msg[CTAG_Params::kSyncFlagsOffset] & CTAG_Params::kSyncKeyframe)) {
+      // --- SERIAL PRINT FOR DEBUGGING ---
+      // Only deltas are printed, keyframes would flood the monitor.
+      Serial1.printf("CORE 0: %s, v%u, %u parameter(s), %u bytes\n",
+                     desc.name, paramSync.version(), msg[CTAG_Params::kSyncCountOffset], (unsigned)msgLen);
+    }
+    uint8_t reply[CTAG_SPI_IPC::kMaxPayload];
+    int len = CTAG_SPI_IPC::exchange(msg, msgLen, reply, sizeof(reply));
+    last_poll = millis();
+    if (len < 0) {
+      Serial1.println("CORE 0: ERROR - SPI send failed!");
+    } else if (len >= 4 && reply[0] == CTAG_Params::kStatusMsgId) {
+      engine_load      = reply[2];
+      engine_peak_load = reply[3];
+      engine_online    = true;
+    } else if (paramSync.handleReply(reply, len)) {
+      Serial1.println("CORE 0: Engine lost a delta, sending a keyframe");
+    }
+  }
+
+  // --- SERIAL PRINT FOR DEBUGGING ---
+  // The engine's replies as the controller sees them; CRC or magic errors
+  // point at wiring, clock rate or a missing engine.
+  if (millis() - last_stats >= LINK_STATS_MS) {
+    last_stats = millis();
+    CTAG_SPI_IPC::LinkStats link = CTAG_SPI_IPC::getLinkStats();
+    Serial1.printf("CORE 0: link %lu ok, %lu CRC errors, %lu magic errors, %lu B/s\n",
+                   (unsigned long)link.framesOk, (unsigned long)link.crcErrors,
+                   (unsigned long)link.magicErrors, (unsigned long)link.bytesPerSecond);
   }
 
-  // Send updates roughly 60 times per second
+  // Check for updates roughly 60 times per second
   delay(16);
 }
 
@@ -123,77 +165,40 @@ void loop() {
 //                         LOOP (CORE 1) - User Interface Core
 // ====================================================================================
 void loop1() {
-  static uint16_t raw[4] = {0};
   if (extBoard.update()) {
-    // Read raw pot values
-    raw[0] = extBoard.getPot(0);
-    raw[1] = extBoard.getPot(1);
-    raw[2] = extBoard.getPot(2);
-    raw[3] = extBoard.getPot(3);
-    uint8_t enc = extBoard.getEncoderAbsolutePosition();
-
-    // Clamp encoder to [0..3]
-    encoder_pos = enc < 4 ? enc : (uint8_t)(enc % 4);
-
-    // Map pot ranges based on synth type
-    switch (encoder_pos) {
-      case 0: // Sine VCO
-        pot_value_A = map(raw[0], 0, 1023,  20, 3000);   // Frequency Hz
-        pot_value_B = map(raw[1], 0, 1023,   0,  100);   // Amplitude ×100
-        pot_value_C = map(raw[2], 0, 1023,   1,   10);   // LFO Rate Hz
-        pot_value_D = map(raw[3], 0, 1023,   0,  500);   // LFO Depth cents
-        break;
-      case 1: // Square VCO
-        pot_value_A = map(raw[0], 0, 1023,  20, 3000);   // Frequency Hz
-        pot_value_B = map(raw[1], 0, 1023,   0,  100);   // Amplitude ×100
-        pot_value_C = map(raw[2], 0, 1023,   5,  95);   // Duty Cycle
-        pot_value_D = map(raw[3], 0, 1023,   0,  500);   // UNUSED
-        break;
-      case 2: // Saw VCO
-        pot_value_A = map(raw[0], 0, 1023,  20, 3000);   // Frequency Hz
-        pot_value_B = map(raw[1], 0, 1023,   0,  100);   // Amplitude ×100
-        pot_value_C = map(raw[2], 0, 1023,   1,   99);   // LFO Rate Hz
-        pot_value_D = map(raw[3], 0, 1023,   0,  500);   // UNUSED
-        break;
-      case 3: // Wavetable
-        pot_value_A = map(raw[0], 0, 1023,  20, 3000);   // Carrier Frequency (Hz)
-        pot_value_B = map(raw[1], 0, 1023,   0,  100);   // Amplitude ×100
-        pot_value_C = map(raw[2], 0, 1023,  20, 3000);   // Modulator Frequency (Hz)
-        pot_value_D = map(raw[3], 0, 1023,   0, 25);   // Modulation Index (depth)
-        break;
+    for (uint8_t i = 0; i < 4; ++i) {
+      pot_values[i] = extBoard.getPot(i);
     }
+    plugin_id = extBoard.getEncoderAbsolutePosition() % CTAG_SourceParams::kNumPlugins;
   }
 
   // UI Rendering
   display.writeRow(0, "CTAG Synth Controller");
 
-  // Synth names
-  const char* names[4] = {
-    "Sine VCO",
-    "Square VCO",
-    "Saw VCO",
-    "2-Freq FMSynth"
-  };
-  display.writeRow(2, names[encoder_pos]);
-
-  // Parameter labels per synth
-  const char* labels[4][4] = {
-    {"Freq(Hz)",  "Amp     ", "LFO Rate", "LFO Dpth"},
-    {"Freq(Hz)","Amp     ","Duty Cycl","Unused  "},
-    {"Freq(Hz)","Amp     ","Skew     ","Unused  "},
-    {"Carr(Hz)","Amp     ","Mod (Hz)","Mod Dpth"},
-  };
-
-  // Display each label + its mapped value
+  const CTAG_PluginDesc& desc = CTAG_SourceParams::kPlugins[plugin_id];
+  display.writeRow(2, desc.name);
+
+  // Engine status, received over SPI from the ESP32
   char buf[22];
-  snprintf(buf, sizeof(buf), "%s: %-4d", labels[encoder_pos][0], pot_value_A);
-  display.writeRow(4, buf);
-  snprintf(buf, sizeof(buf), "%s: %-4d", labels[encoder_pos][1], pot_value_B);
-  display.writeRow(5, buf);
-  snprintf(buf, sizeof(buf), "%s: %-4d", labels[encoder_pos][2], pot_value_C);
-  display.writeRow(6, buf);
-  snprintf(buf, sizeof(buf), "%s: %-4d", labels[encoder_pos][3], pot_value_D);
-  display.writeRow(7, buf);
+  if (engine_online) {
+    snprintf(buf, sizeof(buf), "DSP %3u%% peak %3u%%", engine_load, engine_peak_load);
+  } else {
+    snprintf(buf, sizeof(buf), "Engine offline");
+  }
+  display.writeRow(1, buf);
+
+  // Display each parameter's label and value, as the sound engine will apply it
+  for (uint8_t i = 0; i < 4; ++i) {
+    if (i < desc.numParams) {
+      const CTAG_ParamDesc& p = desc.params[i];
+      char value[12];
+      CTAG_Params::format(p, p.fromRaw(pot_values[i]), value, sizeof(value));
+      snprintf(buf, sizeof(buf), "%-8s: %s", p.name, value);
+    } else {
+      snprintf(buf, sizeof(buf), "%-8s", "Unused");
+    }
+    display.writeRow(4 + i, buf);
+  }
 
   // Push to screen and LEDs
   display.display();
@@ -201,4 +206,4 @@ void loop1() {
 
   // ~30 FPS UI
   delay(33);
-}
\ No newline at end of file
+}
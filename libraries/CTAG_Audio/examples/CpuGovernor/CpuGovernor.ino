@@ -0,0 +1,136 @@
+/**
+ * @file CpuGovernor.ino
+ * @brief Lowers the CPU clock while the patch is light, for battery operation.
+ *
+ * @defgroup Examples_AudioCpuGovernor CpuGovernor
+ * @ingroup Examples
+ *
+ * This CpuGovernor.ino example shows how to:
+ * 1. Run a CTAG_CpuGovernor next to the engine; prepare() runs before and
+ *    update() after every block on the audio task.
+ * 2. Switch between a light patch (one sine) and a heavy one (eight FM voices
+ *    and a filter). prepare() sees the patch change and boosts the clock to
+ *    240 MHz before the heavy patch renders its first block; afterwards the
+ *    governor settles on the lowest clock that keeps the load below its
+ *    thresholds.
+ * 3. Read the time spent at each clock, the average clock, the switch count
+ *    and the cost of a switch.
+ * 4. Enter a power model to get energy estimates. The values below are zero
+ *    on purpose: measure your board's supply power at 80, 160 and 240 MHz
+ *    with this sketch's patches running (e.g. with a USB power meter and
+ *    minMhz = maxMhz) and fill them in.
+ */
+
+// Include the custom board pin definitions. This is crucial!
+#include "pins_arduino.h"
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioFilter.h"
+#include "CTAG_AudioPower.h"
+
+// --- Global Objects ---
+
+CTAG_AudioCodec  codec;
+CTAG_CpuGovernor governor;
+CTAG_VCO_Sine    lightVoice;
+CTAG_FMSynth     heavyVoices[8];
+CTAG_SVFilter    filter;
+
+/**
+ * @brief Board power in mW at 80, 160 and 240 MHz. Replace with measurements.
+ */
+const float boardPowerMw[CTAG_CpuGovernor::kNumSteps] = { 0.0f, 0.0f, 0.0f };
+
+volatile bool heavyRequested = false;
+
+/**
+ * @brief Audio task: swaps patches on request and runs the governor.
+ */
+void audioTask(void *pvParameters) {
+  delay(125);
+
+  if (!codec.begin(PIN_WIRE1_SDA, PIN_WIRE1_SCL)) {
+    Serial.println("Codec initialization failed! Halting.");
+    while (1);
+  }
+  codec.setHeadphoneVolume(60);
+  CTAG_AudioEngine::init(I2S_NUM_0);
+
+  lightVoice.setFrequency(220.0f);
+  lightVoice.setAmplitude(0.3f);
+  for (int i = 0; i < 8; ++i) {
+    float f = 110.0f * (1.0f + 0.5f * i);
+    heavyVoices[i].setCarrierFreq(f);
+    heavyVoices[i].setModFreq(f * 1.5f);
+    heavyVoices[i].setModIndex(2.0f);
+    heavyVoices[i].setAmplitude(0.05f);
+  }
+  filter.setType(CTAG_FilterType::LowPass);
+  filter.setFrequency(3000.0f);
+  CTAG_AudioEngine::setSource(&lightVoice);
+
+  CTAG_CpuGovernor::Config cfg;
+  cfg.minMhz   = 80;
+  cfg.maxMhz   = 240;
+  cfg.upLoad   = 0.70f; // a block above 70 % of its period goes straight to 240 MHz
+  cfg.downLoad = 0.50f; // step down if the worst block would stay below 50 %
+  if (!governor.begin(cfg)) {
+    Serial.println("Governor initialization failed! Running at a fixed clock.");
+  }
+  governor.setPowerModel(boardPowerMw);
+
+  bool heavy = false;
+  while (true) {
+    if (heavyRequested != heavy) {
+      heavy = heavyRequested;
+      // Every source or effect change counts as a patch change and boosts the clock.
+      if (heavy) {
+        for (CTAG_FMSynth& v : heavyVoices) CTAG_AudioEngine::addSource(&v);
+        CTAG_AudioEngine::addEffect(&filter);
+        CTAG_AudioEngine::removeSource(&lightVoice);
+      } else {
+        CTAG_AudioEngine::setSource(&lightVoice);
+        CTAG_AudioEngine::removeEffect(&filter);
+      }
+    }
+    governor.prepare();
+    CTAG_AudioEngine::renderBlock();
+    governor.update();
+  }
+}
+
+/**
+ * @brief Runs once at startup to create the audio task.
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("\n--- CTAG CPU Governor Demo ---");
+
+  xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, NULL, 1);
+}
+
+/**
+ * @brief Toggles the patch every 15 s and prints the governor's statistics.
+ */
+void loop() {
+  static uint32_t lastToggle = 0;
+  delay(1000);
+
+  if (millis() - lastToggle > 15000) {
+    lastToggle = millis();
+    heavyRequested = !heavyRequested;
+    Serial.printf("--- %s patch ---\n", heavyRequested ? "heavy" : "light");
+  }
+
+  CTAG_CpuGovernor::Stats s = governor.getStats();
+  Serial.printf("%3u MHz  load %3.0f %% (%3.0f %% at 240)  time 80/160/240: %.0f/%.0f/%.0f s  "
+                "avg %3.0f MHz  switches %lu (max %lu us)  boosts %lu",
+                s.mhz, s.load * 100.0f, s.loadAtMax * 100.0f,
+                s.seconds[0], s.seconds[1], s.seconds[2], s.averageMhz,
+                (unsigned long)s.switches, (unsigned long)s.maxSwitchUs, (unsigned long)s.boosts);
+  if (s.averageMw > 0.0f) {
+    Serial.printf("  %.0f mW  %.1f J  saved %.0f %%", s.averageMw, s.energyJ, s.savedPercent);
+  }
+  Serial.println();
+}
@@ -0,0 +1,123 @@
+/**
+ * @file DelayReverb.ino
+ * @brief Demonstrates and benchmarks the PSRAM-backed delay and FDN reverb.
+ *
+ * @defgroup Examples_AudioEffects DelayReverb
+ * @ingroup Examples
+ *
+ * This DelayReverb.ino example shows how to:
+ * 1. Allocate delay lines in PSRAM (enable "PSRAM" in the Tools menu).
+ * 2. Measure the CPU cycles per block of each effect offline.
+ * 3. Insert the effects into the engine's master chain.
+ * 4. Play a plucked square wave through delay and reverb.
+ */
+
+// Include the custom board pin definitions. This is crucial!
+#include "pins_arduino.h"
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioEffects.h"
+
+// --- Global Objects ---
+
+CTAG_AudioCodec codec;
+CTAG_VCO_Square vco;
+CTAG_Delay      delayFx;
+CTAG_FDNReverb  reverb;
+
+/**
+ * @brief Number of blocks rendered per benchmark run.
+ */
+static const int BENCH_BLOCKS = 1000;
+
+/**
+ * @brief Measures the average cycles per block of an effect.
+ */
+static void benchmark(const char* name, CTAG_AudioEffect& fx) {
+  static float block[CTAG_AUDIO_BLOCK_SIZE];
+  uint64_t total = 0;
+  uint32_t worst = 0;
+  for (int b = 0; b < BENCH_BLOCKS; ++b) {
+    vco.renderBlock(block, CTAG_AUDIO_BLOCK_SIZE);
+    uint32_t start = ESP.getCycleCount();
+    fx.process(block, CTAG_AUDIO_BLOCK_SIZE);
+    uint32_t cycles = ESP.getCycleCount() - start;
+    total += cycles;
+    if (cycles > worst) worst = cycles;
+  }
+  fx.reset();
+
+  // One block lasts CTAG_AUDIO_BLOCK_SIZE / 44100 s.
+  float budget = (float)getCpuFrequencyMhz() * 1e6f * CTAG_AUDIO_BLOCK_SIZE / 44100.0f;
+  uint32_t avg = (uint32_t)(total / BENCH_BLOCKS);
+  Serial.printf("%-8s avg %7lu cycles/block, worst %7lu (%.1f %% of one core)\n",
+                name, (unsigned long)avg, (unsigned long)worst, 100.0f * avg / budget);
+}
+
+/**
+ * @brief Audio task: benchmarks the effects, then plays through them.
+ */
+void audioTask(void *pvParameters) {
+  delay(125);
+
+  benchmark("Delay", delayFx);
+  benchmark("Reverb", reverb);
+
+  if (!codec.begin(PIN_WIRE1_SDA, PIN_WIRE1_SCL)) {
+    Serial.println("Codec initialization failed! Halting.");
+    while (1);
+  }
+  codec.setHeadphoneVolume(70);
+  CTAG_AudioEngine::init(I2S_NUM_0);
+
+  CTAG_AudioEngine::setSource(&vco);
+  CTAG_AudioEngine::addEffect(&delayFx);
+  CTAG_AudioEngine::addEffect(&reverb);
+
+  const float notes[4] = { 220.0f, 261.6f, 329.6f, 392.0f };
+  float amp = 0.0f;
+  for (uint32_t block = 0; ; ++block) {
+    // A new "pluck" every ~350 ms, decaying per block.
+    if ((block % 60) == 0) {
+      vco.setFrequency(notes[(block / 60) % 4]);
+      amp = 0.4f;
+    }
+    vco.setAmplitude(amp);
+    amp *= 0.85f;
+
+    CTAG_AudioEngine::renderBlock();
+  }
+}
+
+/**
+ * @brief Runs once at startup: allocates the effect memory and starts the audio task.
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("\n--- CTAG Delay & Reverb Demo ---");
+  Serial.printf("PSRAM: %u bytes free\n", (unsigned)ESP.getFreePsram());
+
+  vco.setAmplitude(0.4f);
+  vco.setDutyCycle(0.3f);
+
+  if (!delayFx.begin(2.0f) || !reverb.begin()) {
+    Serial.println("Effect memory allocation failed!");
+  }
+  delayFx.setDelayTime(0.375f);
+  delayFx.setFeedback(0.45f);
+  delayFx.setMix(0.3f);
+  reverb.setDecay(3.0f);
+  reverb.setDamping(0.4f);
+  reverb.setMix(0.3f);
+
+  Serial.printf("Effect memory: %u bytes\n", (unsigned)CTAG_AudioMemory::bytesAllocated());
+
+  xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, NULL, 1);
+}
+
+/**
+ * @brief The audio is generated in a background task, so this loop is free.
+ */
+void loop() {
+}
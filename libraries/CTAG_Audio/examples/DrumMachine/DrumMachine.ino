@@ -0,0 +1,163 @@
+/**
+ * @file DrumMachine.ino
+ * @brief A 16-step, 8-track drum machine made of synthetic drum voices.
+ *
+ * @defgroup Examples_AudioDrumMachine DrumMachine
+ * @ingroup Examples
+ *
+ * This DrumMachine.ino example shows how to:
+ * 1. Build a kit from CTAG_DrumKick, CTAG_DrumSnare, CTAG_DrumHat and
+ *    CTAG_DrumClap voices (the toms are tuned-up kicks, the rim a short snare).
+ * 2. Mix all eight voices through the engine and choke the open hat with the
+ *    closed one.
+ * 3. Step a 16-step pattern from the audio task; steps start on block
+ *    boundaries (5.8 ms grid), without drifting from the tempo.
+ * 4. Map General MIDI drum notes to the voices, so notes from the
+ *    CTAG_Groovebox_Sequencer can play the kit as well.
+ * 5. Read the engine load to see how much of the core the kit uses.
+ */
+
+// Include the custom board pin definitions. This is crucial!
+#include "pins_arduino.h"
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioDrums.h"
+
+// --- Global Objects ---
+
+CTAG_AudioCodec codec;
+
+CTAG_DrumKick  kick;
+CTAG_DrumSnare snare;
+CTAG_DrumClap  clap;
+CTAG_DrumHat   closedHat;
+CTAG_DrumHat   openHat;
+CTAG_DrumKick  lowTom;
+CTAG_DrumKick  highTom;
+CTAG_DrumSnare rim;
+
+CTAG_DrumVoice* const tracks[8] = { &kick, &snare, &clap, &closedHat, &openHat, &lowTom, &highTom, &rim };
+
+// One bit per step, step 1 is the lowest bit.
+volatile uint16_t pattern[8] = {
+  0b0001000100010001, // kick
+  0b0001000000010000, // snare
+  0b0000000000000000, // clap
+  0b1011101110111011, // closed hat (16ths, rests under the open hat)
+  0b0100010001000100, // open hat (offbeat 8ths)
+  0b0000000000000000, // low tom
+  0b0000000000000000, // high tom
+  0b0000000000000000, // rim
+};
+
+// Accent on beats: velocity per step.
+const float accent[16] = { 1.0f, 0.6f, 0.8f, 0.6f, 1.0f, 0.6f, 0.8f, 0.6f,
+                           1.0f, 0.6f, 0.8f, 0.6f, 1.0f, 0.6f, 0.8f, 0.6f };
+
+volatile float tempoBpm = 120.0f;
+
+/**
+ * @brief Plays a General MIDI drum note.
+ * @note trigger() is safe from any task, e.g. a MIDI receive callback.
+ */
+void triggerGM(uint8_t note, uint8_t velocity) {
+  float v = velocity / 127.0f;
+  switch (note) {
+    case 35: case 36: kick.trigger(v);      break; // Bass Drum
+    case 37:          rim.trigger(v);       break; // Side Stick
+    case 38: case 40: snare.trigger(v);     break; // Snare
+    case 39:          clap.trigger(v);      break; // Hand Clap
+    case 42: case 44: closedHat.trigger(v);        // Closed/Pedal Hi-Hat
+                      openHat.choke();      break;
+    case 46:          openHat.trigger(v);   break; // Open Hi-Hat
+    case 41: case 43: lowTom.trigger(v);    break; // Low Toms
+    case 45: case 47: case 48: case 50:
+                      highTom.trigger(v);   break; // Mid/High Toms
+  }
+}
+
+// GM note of each track, used by the internal sequencer.
+const uint8_t trackNote[8] = { 36, 38, 39, 42, 46, 41, 48, 37 };
+
+/**
+ * @brief Audio task: sets up the kit and runs the step sequencer.
+ */
+void audioTask(void *pvParameters) {
+  delay(125);
+
+  if (!codec.begin(PIN_WIRE1_SDA, PIN_WIRE1_SCL)) {
+    Serial.println("Codec initialization failed! Halting.");
+    while (1);
+  }
+  codec.setHeadphoneVolume(60);
+  CTAG_AudioEngine::init(I2S_NUM_0);
+
+  // --- Voice settings ---
+  kick.setTune(48.0f);
+  kick.setDecay(0.45f);
+  openHat.setDecay(0.4f);
+  closedHat.setLevel(0.5f);
+  openHat.setLevel(0.45f);
+  lowTom.setTune(90.0f);
+  lowTom.setSweep(2.0f);
+  lowTom.setDecay(0.35f);
+  lowTom.setClick(0.1f);
+  highTom.setTune(140.0f);
+  highTom.setSweep(2.0f);
+  highTom.setDecay(0.3f);
+  highTom.setClick(0.1f);
+  rim.setTune(400.0f);
+  rim.setToneDecay(0.03f);
+  rim.setNoiseDecay(0.02f);
+  rim.setSnappy(0.3f);
+
+  for (CTAG_DrumVoice* t : tracks) {
+    CTAG_AudioEngine::addSource(t);
+  }
+
+  // --- Step sequencer ---
+  int   step = 0;
+  float samplesToStep = 0.0f;
+  while (true) {
+    if (samplesToStep <= 0.0f) {
+      for (int t = 0; t < 8; ++t) {
+        if (pattern[t] & (1u << step)) triggerGM(trackNote[t], (uint8_t)(accent[step] * 127.0f));
+      }
+      step = (step + 1) & 15;
+      samplesToStep += 44100.0f * 60.0f / (tempoBpm * 4.0f); // one 16th note
+    }
+    CTAG_AudioEngine::renderBlock();
+    samplesToStep -= CTAG_AUDIO_BLOCK_SIZE;
+  }
+}
+
+/**
+ * @brief Runs once at startup to create the audio task.
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("\n--- CTAG Drum Machine Demo ---");
+
+  xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, NULL, 1);
+}
+
+/**
+ * @brief Adds a fill every fourth bar and prints the engine load.
+ */
+void loop() {
+  static uint32_t bar = 0;
+  delay(2000); // one bar at 120 BPM
+
+  ++bar;
+  bool fill = (bar % 4) == 3;
+  pattern[2] = fill ? 0b1000000000000000 : 0;  // clap on the last step
+  pattern[5] = fill ? 0b0000110000000000 : 0;  // low tom
+  pattern[6] = fill ? 0b0011000000000000 : 0;  // high tom
+  pattern[7] = fill ? 0b0000000001000100 : 0;  // rim
+
+  CTAG_AudioEngine::Stats s = CTAG_AudioEngine::getStats();
+  Serial.printf("bar %lu%s  load %4.1f %%  peak %4.1f %%\n",
+                (unsigned long)bar, fill ? " (fill)" : "",
+                s.dspLoad * 100.0f, s.peakLoad * 100.0f);
+}
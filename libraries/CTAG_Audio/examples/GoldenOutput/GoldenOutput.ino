@@ -0,0 +1,115 @@
+/**
+ * @file GoldenOutput.ino
+ * @brief Golden-output regression check for the CTAG Audio Library.
+ *
+ * @defgroup Examples_AudioGolden GoldenOutput
+ * @ingroup Examples
+ *
+ * This GoldenOutput.ino example shows how to:
+ * 1. Render a fixed parameter sequence for every built-in audio source.
+ * 2. Compare the result against the reference buffers in GoldenReference.h.
+ * 3. Choose between bit-exact and tolerance (SNR threshold) comparison.
+ * 4. Capture new reference buffers after an intentional output change.
+ *
+ * Run it before and after any change to the DSP math in CTAG_Audio.cpp
+ * (phase handling, clamping, conversion, lookup tables, fixed-point phase).
+ * No codec or I2S hardware is needed, everything is rendered offline.
+ */
+
+#include <CTAG_AudioGolden.h>
+#include "GoldenReference.h"
+
+// --- Configuration ---
+
+/**
+ * @brief Set to 1 to print fresh reference buffers instead of comparing.
+ */
+#define GOLDEN_CAPTURE 0
+
+/**
+ * @brief Comparison mode. The references were generated on a host build,
+ * where libm differs slightly from newlib, so the device run uses
+ * Tolerance mode. Use BitExact against references captured on the device.
+ */
+static const CTAG_AudioGolden::Mode GOLDEN_MODE = CTAG_AudioGolden::Mode::Tolerance;
+
+/**
+ * @brief Minimum signal-to-error ratio in Tolerance mode.
+ */
+static const float GOLDEN_MIN_SNR_DB = 60.0f;
+
+/**
+ * @brief Render buffer, shared by all cases.
+ */
+static int16_t rendered[CTAG_AudioGolden::kNumFrames];
+
+
+/**
+ * @brief Looks up the reference buffer of a golden case by name.
+ */
+static const int16_t* findReference(const char* name) {
+  for (const GoldenReference& ref : kGoldenReferences) {
+    if (strcmp(ref.name, name) == 0) return ref.samples;
+  }
+  return nullptr;
+}
+
+#if GOLDEN_CAPTURE
+/**
+ * @brief Prints a rendered buffer in the format of GoldenReference.h.
+ */
+static void printReference(const char* name, const int16_t* data) {
+  Serial.printf("static const int16_t kRef_%s[CTAG_AudioGolden::kNumFrames] = {\n", name);
+  for (size_t i = 0; i < CTAG_AudioGolden::kNumFrames; ++i) {
+    if (i % 12 == 0) Serial.print("  ");
+    Serial.printf("%6d,", data[i]);
+    if (i % 12 == 11 || i == CTAG_AudioGolden::kNumFrames - 1) Serial.println();
+  }
+  Serial.println("};\n");
+}
+#endif
+
+/**
+ * @brief Runs once at startup: renders and checks every golden case.
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("\n--- CTAG Audio Golden-Output Check ---");
+
+  size_t failures = 0;
+  for (size_t c = 0; c < CTAG_AudioGolden::numCases(); ++c) {
+    const CTAG_AudioGolden::Case& testCase = CTAG_AudioGolden::getCase(c);
+    testCase.render(rendered, CTAG_AudioGolden::kNumFrames);
+
+#if GOLDEN_CAPTURE
+    printReference(testCase.name, rendered);
+#else
+    const int16_t* ref = findReference(testCase.name);
+    if (!ref) {
+      Serial.printf("%-12s MISSING reference\n", testCase.name);
+      ++failures;
+      continue;
+    }
+
+    CTAG_AudioGolden::Result r = CTAG_AudioGolden::compare(
+        ref, rendered, CTAG_AudioGolden::kNumFrames, GOLDEN_MODE, GOLDEN_MIN_SNR_DB);
+    Serial.printf("%-12s %s  SNR=%7.1f dB  maxErr=%5ld  firstDiff=%5ld  hash=%08lx\n",
+                  testCase.name, r.passed ? "PASS" : "FAIL", r.snrDb,
+                  (long)r.maxAbsError, (long)r.firstMismatch,
+                  (unsigned long)CTAG_AudioGolden::hash(rendered, CTAG_AudioGolden::kNumFrames));
+    if (!r.passed) ++failures;
+#endif
+  }
+
+#if !GOLDEN_CAPTURE
+  Serial.printf("%u case(s) failed.\n", (unsigned)failures);
+#endif
+}
+
+/**
+ * @brief Nothing to do after the check has run.
+ */
+void loop() {
+  delay(1000);
+}
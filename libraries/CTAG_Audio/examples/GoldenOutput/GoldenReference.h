@@ -0,0 +1,382 @@
+/**
+ * @file GoldenReference.h
+ * @brief Checked-in reference buffers for the GoldenOutput example.
+ *
+ * Generated with CTAG_AudioGolden::getCase(i).render() (1024 samples per case).
+ * Regenerate by setting GOLDEN_CAPTURE to 1 in GoldenOutput.ino and pasting
+ * the serial output here whenever an intentional output change is made.
+ */
+#pragma once
+
+#include <CTAG_AudioGolden.h>
+
+static const int16_t kRef_VCO_Sine[CTAG_AudioGolden::kNumFrames] = {
+    1026,  2048,  3063,  4065,  5051,  6018,  6960,  7876,  8760,  9611, 10423, 11194,
+   11922, 12602, 13233, 13812, 14337, 14806, 15216, 15567, 15856, 16083, 16247, 16347,
+   16383, 16354, 16262, 16105, 15885, 15603, 15259, 14855, 14393, 13875, 13302, 12677,
+   12002, 11279, 10513,  9705,  8859,  7978,  7066,  6126,  5162,  4178,  3177,  2164,
+    1142,   116,  -909, -1932, -2948, -3952, -4940, -5909, -6855, -7773, -8662, -9516,
+  -10333,-11109,-11841,-12527,-13164,-13749,-14280,-14755,-15172,-15530,-15826,-16060,
+  -16232,-16339,-16382,-16361,-16275,-16126,-15913,-15638,-15301,-14904,-14449,-13937,
+  -13370,-12750,-12081,-11364,-10602, -9799, -8957, -8080, -7171, -6234, -5273, -4291,
+   -3292, -2280, -1259,  -233,   793,  1816,  2833,  3838,  4829,  5800,  6748,  7670,
+    8562,  9421, 10242, 11023, 11760, 12452, 13094, 13686, 14223, 14704, 15128, 15492,
+   15796, 16037, 16215, 16330, 16380, 16367, 16288, 16146, 15940, 15672, 15342, 14952,
+   14503, 13998, 13437, 12823, 12159, 11447, 10691,  9892,  9054,  8181,  7276,  6342,
+    5383,  4403,  3406,  2395,  1375,   350,  -676, -1700, -2718, -3725, -4717, -5691,
+   -6642, -7567, -8463, -9325,-10150,-10936,-11679,-12376,-13024,-13621,-14165,-14652,
+  -15083,-15454,-15764,-16013,-16198,-16320,-16378,-16371,-16300,-16165,-15967,-15706,
+  -15383,-15000,-14557,-14058,-13503,-12896,-12237,-11531,-10779, -9985, -9151, -8282,
+   -7380, -6449, -5493, -4516, -3520, -2511, -1491,  -466,   559,  1584,  2603,  3611,
+    4605,  5581,  6535,  7463,  8362,  9229, 10058, 10849, 11597, 12299, 12953, 13556,
+   14106, 14600, 15037, 15415, 15732, 15988, 16180, 16310, 16375, 16375, 16312, 16184,
+   15993, 15739, 15423, 15046, 14611, 14118, 13569, 12967, 12314, 11613, 10867, 10077,
+    9248,  8383,  7484,  6557,  5603,  4628,  3634,  2626,  1608,   583,  -443, -1468,
+   -2487, -3497, -4493, -5471, -7608, -9592,-11380,-12938,-14234,-15242,-15940,-16316,
+  -16361,-16074,-15462,-14536,-13316,-11825,-10095, -8161, -6061, -3838, -1538,   793,
+    3108,  5361,  7505,  9497, 11296, 12867, 14176, 15199, 15913, 16305, 16367, 16096,
+   15500, 14589, 13383, 11906, 10187,  8262,  6169,  3952,  1654,  -676, -2994, -5251,
+   -7401, -9401,-11211,-12794,-14117,-15155,-15885,-16293,-16371,-16118,-15537,-14642,
+  -13450,-11986,-10278, -8363, -6277, -4065, -1770,   560,  2879,  5140,  7297,  9306,
+   11126, 12721, 14058, 15110, 15856, 16281, 16375, 16138, 15574, 14694, 13516, 12065,
+   10369,  8463,  6385,  4178,  1886,  -443, -2764, -5029, -7192, -9209,-11040,-12647,
+  -13998,-15065,-15826,-16267,-16378,-16158,-15610,-14745,-13582,-12144,-10459, -8562,
+   -6492, -4291, -2002,   326,  2649,  4918,  7087,  9113, 10954, 12572, 13937, 15018,
+   15796, 16253, 16381, 16177, 15645, 14796, 13647, 12222, 10548,  8662,  6599,  4403,
+    2118,  -210, -2534, -4806, -6982, -9015,-10866,-12497,-13875,-14971,-15764,-16238,
+  -16382,-16195,-15679,-14846,-13711,-12299,-10637, -8760, -6706, -4515, -2233,    93,
+    2418,  4695,  6876,  8918, 10779, 12422, 13813, 14924, 15732, 16222, 16383, 16212,
+   15712, 14894, 13775, 12376, 10726,  8859,  6812,  4627,  2349,    23, -2303, -4583,
+   -6770, -8820,-10691,-12345,-13749,-14875,-15699,-16205,-16383,-16228,-15745,-14943,
+  -13837,-12452,-10814, -8957, -6918, -4739, -2464,  -139,  2187,  4471,  6663,  8721,
+   10602, 12268, 13686, 14826, 15665, 16188, 16382, 16244, 15777, 14990, 13900, 12527,
+   10901,  9054,  7024,  4851,  2580,   256, -2072, -4358, -6557, -8622,-10513,-12191,
+  -13621,-14776,-15631,-16169,-16380,-16259,-15808,-15037,-13961,-12602,-10988, -9151,
+   -7129, -4962, -2695,  -373,  1956,  4246,  6450,  8523, 10423, 12112, 13556, 14725,
+   15596, 16150, 16377, 16273, 15838, 15083, 14022, 12676, 11044,  9179,  7121,  4914,
+    2603,   238, -2132, -4457, -6690, -8781,-10689,-12371,-13794,-14927,-15747,-16235,
+  -16382,-16185,-15647,-14781,-13603,-12140,-10421, -8482, -6366, -4115, -1778,   596,
+    2958,  5259,  7448,  9481, 11315, 12910, 14234, 15258, 15961, 16328, 16351, 16029,
+   15370, 14388, 13102, 11540,  9735,  7725,  5552,  3262,   903, -1474, -3821, -6088,
+   -8226,-10191,-11941,-13440,-14655,-15561,-16139,-16377,-16269,-15818,-15034,-13932,
+  -12536,-10876, -8986, -6906, -4680, -2356,    17,  2391,  4715,  6939,  9016, 10904,
+   12561, 13953, 15050, 15829, 16274, 16376, 16131, 15545, 14631, 13408, 11901, 10142,
+    8170,  6024,  3751,  1399,  -983, -3344, -5635, -7806, -9813,-11612,-13166,-14441,
+  -15411,-16054,-16358,-16316,-15928,-15204,-14157,-12811,-11194, -9339, -7287, -5080,
+   -2766,  -393,  1988,  4327,  6575,  8684, 10608, 12308, 13748, 14896, 15728, 16227,
+   16383, 16190, 15655, 14788, 13607, 12138, 10411,  8464,  6337,  4075,  1727,  -657,
+   -3028, -5335, -7528, -9563,-11394,-12983,-14297,-15308,-15994,-16340,-16339,-15992,
+  -15305,-14292,-12977,-11386, -9552, -7516, -5320, -3011,  -638,  1747,  4097,  6360,
+    8487, 10434, 12160, 13627, 14805, 15668, 16197, 16383, 16220, 15712, 14870, 13712,
+   12262, 10551,  8615,  6497,  4240,  1892,  -494, -2872, -5188, -7394, -9442,-11290,
+  -12897,-14230,-15260,-15965,-16330,-16348,-16017,-15345,-14346,-13041,-11459, -9633,
+   -7601, -5407, -3098,  -722,  1667,  4023,  6292,  8428, 10384, 12119, 13595, 14781,
+   15653, 16190, 16383, 16225, 15722, 14883, 13727, 12278, 10567,  8630,  6509,  4249,
+    1898,  -492, -2873, -5193, -7401, -9452,-11302,-12909,-14242,-15270,-15972,-16333,
+  -16345,-16008,-15329,-14322,-13009,-11419, -9584, -7544, -5343, -3028,  -648,  1745,
+    4102,  6371,  8504, 10456, 12183, 13651, 14826, 15684, 16207, 16383, 16209, 15687,
+   29662, 27313, 24380, 20925, 17022, 12755,  8214,  3498, -1293, -6057,-10692,-15097,
+  -19180,-22852,-26035,-28660,-30671,-32026,-32694,-32662,-31930,-30514,-28444,-25764,
+  -22532,-18817,-14699,-10265, -5611,  -837,  3955,  8662, 13185, 17424, 21290, 24700,
+   27580, 29868, 31516, 32488, 32762, 32334, 31212, 29420, 26996, 23994, 20476, 16518,
+   12206,  7631,  2893, -1907, -6667,-11284,-15659,-19698,-23313,-26428,-28976,-30901,
+  -32162,-32732,-32599,-31766,-30250,-28083,-25313,-21999,-18212,-14033, -9552, -4866,
+     -75,  4716,  9408, 13897, 18088, 21889, 25220, 28009, 30195, 31731, 32585, 32738,
+   32186, 30942, 29032, 26497, 23391, 19782, 15747, 11373,  6753,  1988, -2818, -7566,
+  -12150,-16473,-20441,-23969,-26981,-29412,-31209,-32334,-32762,-32485,-31507,-29850,
+  -27550,-24656,-21231,-17347,-13090, -8550, -3826,   980,  5766, 10427, 14864, 18981,
+   22688, 25906, 28565, 30609, 31991, 32684, 32672, 31954, 30547, 28481, 25800, 22562,
+   18836, 14705, 10255,  5584,   793, -4015, -8738,-13272,-17519,-21388,-24795,-27667,
+  -29942,-31569,-32515,-32758,-32293,-31131,-29295,-26827,-23779,-20217,-16217,-11867,
+   -7260, -2497,  2320,  7088, 11703, 16065, 20080, 23660, 26729, 29220, 31078, 32265,
+   32754, 32534, 31610, 30002, 27745, 24887, 21491, 17629, 13386,  8853,  4128,  -685,
+   -5485,-10166,-14627,-18772,-22510,-25761,-28454,-30530,-31946,-32670,-32685,-31993,
+  -30608,-28559,-25892,-22663,-18944,-14813,-10362, -5685,  -886,  3933,  8666, 13213,
+   17473, 21354, 24772, 27653, 29935, 31567, 32515, 32758, 32290, 31121, 29278, 26799,
+   23739, 20163, 16150, 11786,  7167,  2391, -2435, -7209,-11828,-16189,-20200,-23772,
+  -26827,-29301,-31138,-32299,-32759,-32507,-31549,-29906,-27614,-24721,-21291,-17399,
+  -13128, -8572, -3830,   995,  5799, 10478, 14928, 19055, 22767, 25985, 28637, 30667,
+   32031, 32698, 32654, 31900,
+};
+
+static const int16_t kRef_VCO_Square[CTAG_AudioGolden::kNumFrames] = {
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383,
+  -16383,-16383,-16383,-16383,-16383,-16383,-16383,-16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383,-16383,-16383,-16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383,-16383,-16383,-16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383,-16383,-16383,-16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383,-16383,-16383,-16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,-16383,-16383,-16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,-16383,-16383,-16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,-16383,
+  -16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+  -16383,-16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383,-16383,-16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383,-16383,-16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+   32767, 32767, 32767,-32767,-32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767,-32767,-32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767,-32767,-32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767,-32767,-32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767,-32767,-32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,-32767,-32767,-32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,-32767,-32767,-32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,-32767,-32767,
+  -32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,-32767,
+  -32767,-32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+  -32767,-32767,-32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+   32767,-32767,-32767,-32767,
+};
+
+static const int16_t kRef_VCO_Saw[CTAG_AudioGolden::kNumFrames] = {
+  -16220,-16056,-15893,-15729,-15566,-15402,-15239,-15075,-14912,-14748,-14585,-14421,
+  -14258,-14095,-13931,-13768,-13604,-13441,-13277,-13114,-12950,-12787,-12623,-12460,
+  -12296,-12133,-11969,-11806,-11643,-11479,-11316,-11152,-10989,-10825,-10662,-10498,
+  -10335,-10171,-10008, -9844, -9681, -9518, -9354, -9191, -9027, -8864, -8700, -8537,
+   -8373, -8210, -8046, -7883, -7719, -7556, -7393, -7229, -7066, -6902, -6739, -6575,
+   -6412, -6248, -6085, -5921, -5758, -5594, -5431, -5267, -5104, -4941, -4777, -4614,
+   -4450, -4287, -4123, -3960, -3796, -3633, -3469, -3306, -3142, -2979, -2816, -2652,
+   -2489, -2325, -2162, -1998, -1835, -1671, -1508, -1344, -1181, -1017,  -854,  -691,
+    -527,  -364,  -200,   -37,   126,   289,   453,   616,   780,   943,  1107,  1270,
+    1434,  1597,  1760,  1924,  2087,  2251,  2414,  2578,  2741,  2905,  3068,  3232,
+    3395,  3559,  3722,  3885,  4049,  4212,  4376,  4539,  4703,  4866,  5030,  5193,
+    5357,  5520,  5684,  5847,  6010,  6174,  6337,  6501,  6664,  6828,  6991,  7155,
+    7318,  7482,  7645,  7809,  7972,  8136,  8299,  8462,  8626,  8789,  8953,  9116,
+    9280,  9443,  9607,  9770,  9934, 10097, 10261, 10424, 10587, 10751, 10914, 11078,
+   11241, 11405, 11568, 11732, 11895, 12059, 12222, 12386, 12549, 12713, 12876, 13039,
+   13203, 13366, 13530, 13693, 13857, 14020, 14184, 14347, 14511, 14674, 14838, 15001,
+   15165, 15328, 15491, 15655, 15818, 15982, 16145, 16309, 16294, 16130, 15967, 15803,
+   15640, 15476, 15313, 15150, 14986, 14823, 14659, 14496, 14332, 14169, 14005, 13842,
+   13678, 13515, 13351, 13188, 13024, 12861, 12698, 12534, 12371, 12207, 12044, 11880,
+   11717, 11553, 11390, 11226, 11063, 10899, 10736, 10573, 10409, 10246, 10082,  9919,
+    9755,  9592,  9428,  9265,  9101,  8938,  8774,  8611,  8447,  8284,  8121,  7957,
+    7794,  7630,  7467,  7303, -4002, -4088, -4174, -4260, -4346, -4432, -4518, -4604,
+   -4690, -4776, -4862, -4948, -5034, -5120, -5207, -5293, -5379, -5465, -5551, -5637,
+   -5723, -5809, -5895, -5981, -6067, -6153, -6239, -6325, -6411, -6497, -6583, -6669,
+   -6755, -6841, -6927, -7013, -7099, -7185, -7271, -7357, -7443, -7529, -7615, -7701,
+   -7788, -7874, -7960, -8046, -8132, -8218, -8304, -8390, -8476, -8562, -8648, -8734,
+   -8820, -8906, -8992, -9078, -9164, -9250, -9336, -9422, -9508, -9594, -9680, -9766,
+   -9852, -9938,-10024,-10110,-10196,-10282,-10368,-10455,-10541,-10627,-10713,-10799,
+  -10885,-10971,-11057,-11143,-11229,-11315,-11401,-11487,-11573,-11659,-11745,-11831,
+  -11917,-12003,-12089,-12175,-12261,-12347,-12433,-12519,-12605,-12691,-12777,-12863,
+  -12949,-13035,-13122,-13208,-13294,-13380,-13466,-13552,-13638,-13724,-13810,-13896,
+  -13982,-14068,-14154,-14240,-14326,-14412,-14498,-14584,-14670,-14756,-14842,-14928,
+  -15014,-15100,-15186,-15272,-15358,-15444,-15530,-15616,-15703,-15789,-15875,-15961,
+  -16047,-16133,-16219,-16305,-16235,-14601,-12966,-11331, -9697, -8062, -6428, -4793,
+   -3158, -1524,   110,  1745,  3379,  5014,  6649,  8283,  9918, 11552, 13187, 14822,
+   16379, 16293, 16207, 16121, 16035, 15949, 15863, 15777, 15691, 15605, 15519, 15433,
+   15347, 15261, 15175, 15089, 15003, 14917, 14831, 14745, 14658, 14572, 14486, 14400,
+   14314, 14228, 14142, 14056, 13970, 13884, 13798, 13712, 13626, 13540, 13454, 13368,
+   13282, 13196, 13110, 13024, 12938, 12852, 12766, 12680, 12594, 12508, 12422, 12336,
+   12250, 12164, 12077, 11991, 11905, 11819, 11733, 11647, 11561, 11475, 11389, 11303,
+   11217, 11131, 11045, 10959, 10873, 10787, 10701, 10615, 10529, 10443, 10357, 10271,
+   10185, 10099, 10013,  9927,  9841,  9755,  9669,  9583,  9496,  9410,  9324,  9238,
+    9152,  9066,  8980,  8894,  8808,  8722,  8636,  8550, -4479, -2133,   213,  2559,
+    4905,  7252,  9598, 11944, 14291, 11554,-15507,-13161,-10814, -8468, -6122, -3775,
+   -1429,   916,  3263,  5609,  7956, 10302, 12648, 14995, -1819,-14803,-12457,-10110,
+   -7764, -5418, -3071,  -725,  1620,  3967,  6313,  8659, 11006, 13352, 15699,-15193,
+  -14099,-11753, -9407, -7060, -4714, -2367,   -21,  2324,  4671,  7017,  9363, 11710,
+   14056, 16012,-15742,-13395,-11049, -8703, -6356, -4010, -1664,   682,  3028,  5375,
+    7721, 10067, 12414, 14760,  2638,-15038,-12691,-10345, -7999, -5652, -3306,  -960,
+    1386,  3732,  6079,  8425, 10771, 13118, 15464,-10736,-14334,-11988, -9641, -7295,
+   -4948, -2602,  -256,  2090,  4436,  6782,  9129, 11475, 13822, 16168,-15976,-13630,
+  -11284, -8937, -6591, -4244, -1898,   447,  2794,  5140,  7486,  9833, 12179, 14525,
+    7096,-15272,-12926,-10580, -8233, -5887, -3541, -1194,  1151,  3498,  5844,  8190,
+   10537, 12883, 15229, -6278,-14568,-12222, -9876, -7529, -5183, -2837,  -490,  1855,
+    4201,  6548,  8894, 11241, 13587, 15933,-16211,-13865,-11518, -9172, -6825, -4479,
+   -2133,   213,  2559,  4905,  7252,  9598, 11944, 14291, 11554,-15507,-13161,-10814,
+   -8468, -6122, -3775, -1429,   917,  3263,  5609,  7956, 10302, 12648, 14995, -1820,
+  -14803,-12457,-10110, -7764, -5418, -3071,  -725,  1620,  3967,  6313,  8660, 11006,
+   13352, 15699,-15194,-14099,-11753, -9406, -7060, -4714, -2367,   -21,  2324,  4671,
+    7017,  9363, 11710, 14056, 16011,-15742,-13395,-11049, -8703, -6356, -4010, -1663,
+     682,  3028,  5375,  7721, 10067, 12414, 14760,  2637,-15038,-12691,-10345, -7999,
+   -5652, -3306,  -960,  1386,  3732,  6079,  8425, 10771, 13118, 15464,-10736,-14334,
+  -11987, -9641, -7295, -4948, -2602,  -256,  2090,  4436,  6782,  9129, 11475, 13822,
+   16168,-15976,-13630,-11284, -8937, -6591, -4244, -1898,   447,  2794,  5140,  7486,
+   19666, 24359, 29051, 14190,-30545,-25852,-21160,-16467,-11774, -7082, -2389,  2303,
+    6996, 11688, 16381, 21074, 25767, 30459,-12558,-29137,-24445,-19752,-15059,-10366,
+   -5674,  -981,  3711,  8403, 13096, 17789, 22482, 27174, 31867,-32422,-27730,-23037,
+  -18344,-13651, -8959, -4266,   426,  5119,  9811, 14504, 19197, 23889, 28582, 23106,
+  -31014,-26322,-21629,-16936,-12244, -7551, -2858,  1834,  6526, 11219, 15912, 20605,
+   25297, 29990, -3642,-29607,-24914,-20221,-15528,-10836, -6143, -1450,  3241,  7934,
+   12627, 17320, 22012, 26705, 31398,-30391,-28199,-23506,-18813,-14121, -9428, -4735,
+     -42,  4649,  9342, 14035, 18728, 23420, 28113, 32022,-31484,-26791,-22098,-17406,
+  -12713, -8020, -3327,  1364,  6057, 10750, 15443, 20135, 24828, 29521,  5273,-30076,
+  -25383,-20690,-15998,-11305, -6612, -1919,  2772,  7465, 12158, 16850, 21543, 26236,
+   30929,-21475,-28668,-23975,-19283,-14590, -9897, -5204,  -512,  4180,  8873, 13566,
+   18258, 22951, 27644, 32336,-31953,-27260,-22567,-17875,-13182, -8489, -3797,   895,
+    5588, 10281, 14973, 19666, 24359, 29052, 14188,-30545,-25852,-21160,-16467,-11774,
+   -7081, -2389,  2303,  6996, 11688, 16381, 21074, 25767, 30459,-12559,-29137,-24445,
+  -19752,-15059,-10366, -5674,  -981,  3711,  8404, 13096, 17789, 22482, 27174, 31867,
+  -32422,-27729,-23037,-18344,-13651, -8959, -4266,   426,  5119,  9811, 14504, 19197,
+   23890, 28582, 23104,-31014,-26322,-21629,-16936,-12243, -7551, -2858,  1834,  6526,
+   11219, 15912, 20605, 25297, 29990, -3644,-29607,-24914,-20221,-15528,-10836, -6143,
+   -1450,  3242,  7934, 12627, 17320, 22013, 26705, 31398,-30392,-28199,-23506,-18813,
+  -14121, -9428, -4735,   -42,  4649,  9342, 14035, 18728, 23420, 28113, 32020,-31484,
+  -26791,-22098,-17405,-12713, -8020, -3327,  1364,  6057, 10750, 15443, 20135, 24828,
+   29521,  5271,-30076,-25383,
+};
+
+static const int16_t kRef_FMSynth[CTAG_AudioGolden::kNumFrames] = {
+    1026,  2048,  3063,  4065,  5051,  6018,  6960,  7876,  8760,  9611, 10423, 11194,
+   11922, 12602, 13233, 13812, 14337, 14806, 15216, 15567, 15856, 16083, 16247, 16347,
+   16383, 16354, 16262, 16105, 15885, 15603, 15259, 14855, 14393, 13875, 13302, 12677,
+   12002, 11279, 10513,  9705,  8859,  7978,  7066,  6126,  5162,  4178,  3177,  2164,
+    1142,   116,  -909, -1932, -2948, -3952, -4940, -5909, -6855, -7773, -8662, -9516,
+  -10333,-11109,-11841,-12527,-13164,-13749,-14280,-14755,-15172,-15530,-15826,-16060,
+  -16232,-16339,-16382,-16361,-16275,-16126,-15913,-15638,-15301,-14904,-14449,-13937,
+  -13370,-12750,-12081,-11364,-10602, -9799, -8957, -8080, -7171, -6234, -5273, -4291,
+   -3292, -2280, -1259,  -233,   793,  1816,  2833,  3838,  4829,  5800,  6748,  7670,
+    8562,  9421, 10242, 11023, 11760, 12452, 13094, 13686, 14223, 14704, 15128, 15492,
+   15796, 16037, 16215, 16330, 16380, 16367, 16288, 16146, 15940, 15672, 15342, 14952,
+   14503, 13998, 13437, 12823, 12159, 11447, 10691,  9892,  9054,  8181,  7276,  6342,
+    5383,  4403,  3406,  2395,  1375,   350,  -676, -1700, -2718, -3725, -4717, -5691,
+   -6642, -7567, -8463, -9325,-10150,-10936,-11679,-12376,-13024,-13621,-14165,-14652,
+  -15083,-15454,-15764,-16013,-16198,-16320,-16378,-16371,-16300,-16165,-15967,-15706,
+  -15383,-15000,-14557,-14058,-13503,-12896,-12237,-11531,-10779, -9985, -9151, -8282,
+   -7380, -6449, -5493, -4516, -3520, -2511, -1491,  -466,   559,  1584,  2603,  3611,
+    4605,  5581,  6535,  7463,  8362,  9229, 10058, 10849, 11597, 12299, 12953, 13556,
+   14106, 14600, 15037, 15415, 15732, 15988, 16180, 16310, 16375, 16375, 16312, 16184,
+   15993, 15739, 15423, 15046, 14611, 14118, 13569, 12967, 12314, 11613, 10867, 10077,
+    9248,  8383,  7484,  6557,  5603,  4628,  3634,  2626,  1608,   583,  -443, -1468,
+   -2487, -3497, -4493, -5471,-11509, 15439, -1332,-14482, 12548,  5363,-16382,  5242,
+   13368,-12615, -7266, 15837,  1498,-16369,  2224, 16077, -3432,-16096,  1975, 16382,
+    2382,-15396, -9251, 10176, 15556,  1368,-14059,-14199,  -686, 12925, 15942,  7873,
+   -4487,-13762,-16321,-12666, -5527,  2194,  8582, 12899, 15266, 16221, 16377, 16239,
+   16132, 16185, 16339, 16341, 15748, 13981, 10448,  4833, -2503,-10130,-15493,-15647,
+   -8970,  2751, 13550, 15815,  6233, -8980,-16374, -7304, 10103, 15788,  1235,-15251,
+   -9602, 11008, 13772, -7121,-15290,  5213, 15564, -5570,-15023,  7941, 13215,-11611,
+   -9260, 15135,  2634,-16314,  5841, 12987,-13446, -4634, 16365, -6240,-12063, 14616,
+    1723,-15830,  9611,  8961,-15999,  2276, 14466,-12073, -6582, 16305, -3302,-14480,
+   11190,  8902,-15375, -2527, 16381, -2614,-15771,  5724, 15048, -6702,-15089,  5477,
+   15905, -1678,-16331, -4924, 13736, 12772, -5018,-16296, -8815,  7657, 16327, 10616,
+   -3075,-14021,-15920, -9358,   960, 10129, 15357, 16239, 13873,  9822,  5422,  1530,
+   -1442, -3376, -4282, -4191, -3098,  -968,  2198,  6240, 10670, 14524, 16371, 14644,
+    8442, -1367,-11386,-16355,-12050,   559, 13343, 15362,  3041,-12802,-14657,  1337,
+   15880,  8262,-11877,-13263,  7710, 15105, -5600,-15433,  6020, 14756, -8706,-12455,
+   12713,  7399,-15975,   828, 15376,-10301, -8412, 16159, -3710,-13131, 14371,   936,
+  -15095, 12483,  3710,-15855, 11075,  5426,-16188,  9853,  6941,-16366,  8169,  8994,
+  -16257,  5153, 11991,-15039,  -213, 15323,-10731, -8252, 15970,  -828,-15666,  8028,
+   12585,-12234, -9455, 14049,  7920,-14303, -8650, 13075, 11544, -9348,-15226,  1638,
+   15960,  9344, -8316,-16364, -7732,  7635, 16158, 12559,  1117,-10281,-16040,-14941,
+   -8991, -1221,  5929, 11210, 14409, 15925, 16370, 16312, 16162, 16138, 16267, 16383,
+   16128, 14974, 12310,  7650,   990, -6760,-13526,-16383, 10982, 15854, 15600, 14773,
+   -3199,-15920,  4716, 16335, 10306, 10039, 16323,-10789, 14842, -2321,  1313, 15972,
+  -15944,    90,  9838,  4992,-11365,-11913, 13390,  7646,-12444,-16379,-16283, -4050,
+   13099, -3518,-15132, -9738, 16102,-16298, -1678,  5643, -1667,-15406, -6247, 15611,
+    6079,-10391,-14302, -7935, 15175,-14054, 12276, 15494,  2148,-10557, -1748, 13684,
+   14012,  3631,-15094, -4073, 16354,  1719,-12925,-15002, -6551, 16363,-16330, -1341,
+    -131,-16221, 14979,-13070,-15911,-16243,-12008,  8858, 13177,-10067,-15289, -8074,
+  -10095,-15667, 15059,-15798,-12126,-15907,  2756, -6788, 14992, 16375, 14705, -1143,
+  -16267,  5261, 15011, -1579,-10396, -5981, 14234, -9515, 16379, 12870, 16208,-12414,
+   16120,   620, -3812,  5754, 16383,   -56,-16332,  -834, 12926, 14825,  6127,-16370,
+   16356,   276, -1679, 15677,-13474, 14831, 14753, 15565, 13409, -8078,-12608, 12438,
+   12061, -1077, -2438, 11742,  2870,  3408,-14529,-12740, 11739,-11469, 14396, 16078,
+   16338,  7919,-13365, -8393, 13967, 13150,  6048, 10594, 13979,-16320,  8552, 15709,
+    8062,-16172, 12888, 12557,  9429, 15525,  9419,-14268, -4950, 15771, 10448,  4023,
+   11163, 11091,-13123, -4978,  1751,-13583,  6084,-14964,  -146,  1462, -9736,-15298,
+    6388, 14681, -4249,-14651,-15077, -3613, 15378,-12501,-13136,-14482, -6522,  7348,
+   11874,  2008,  6648, 16293,  2142,-16348,  3308, 16383, 11800, 12758, 14538,-15841,
+   15173, 13118, 16148, -3496,  6989,-15175,-16276,-15637, -2787, 15960,  2355,-16046,
+  -10316, -4369,-11506,-10907, 13267,  4104, -3382, 12117, -3233, 13286, -3296, -4586,
+    7650, 15705, -6801,-13294,  9186, 16346, 15356, 15444, -9847, 10692,-13090,-14356,
+    4629,   875, 13351,   238,  1365, 13161, 12115,-11736,-11033,  8676, 15688, 15104,
+     354,-11554,  2851, 15538, 11989,-14556, 15741, -5602,-12227, -6270, 11348, 11411,
+  -27700,-14742, 23792, 32483, 30189, -6522, -9498,-18840,  4718,-18520,-10366, -4858,
+   31180, 32766, 27859, -5751,-32315,  7934, 32491, 14345,  6263, 25491, 12518,-11485,
+  -29274,-26006,-25938, 31468, -9785,-31023,-29942, -8235, 30554,  6475,-32758, -4006,
+   23545, 26212,   985,-28650, 22163, 28109, 30069, 11437,-14042,-23350, -1755, -9121,
+  -31063,-14294, 30488, 12061,-24285,-32408,-29808,  7143,  9730, 17584, -7643, 14688,
+   15617, -1749,-32603,-32074,-30295,  2598, 32313,-11987,-29902,   990, 16034,  1881,
+  -32745, 31456,-20690,-30140, -4925, 23793, -3311,-31538,-32475,-22189, 16735, 27712,
+  -19226,-29543, -8083, -4783,-28301,  -387, -8896, 29713, 28427,-16577, 13100,-32710,
+  -25504,-29867,-27131, 17191, 24087,-25494,-24800, -2011, -3471,-30663, 13163,-27448,
+    3402, -9691,-26693, 23239, 20413,  4076, 15859, 32766,  2086,-32760,  -880, 29064,
+   32749, 28842,-15792,  7335,-32018,-24116,-31913, 29208,-32002,-18115,-14561,-30498,
+  -18316, 29315,  8535,-31525,-22936,-14179,-29117, -7446,  7354, 30674, 27581, 24702,
+  -31177, 10006, 31564, 31308, 14312,-25792,-18772, 27597, 24028,  2322,  4370, 30918,
+  -13145, 26766, -6029,  5666, 29486,-27327,-14549,  2667,-10625,-32571, -2904, 32544,
+   -7295,-32736,-26699,-30228,-19813, 30599,-11670,-30413,-16065, 32686,-29067,-18214,
+   -7362,-22364,-30779, 10587, 30056, -9987,-31778,-32721,-27084, 24149,-23499, 26569,
+   30565, -1360,-12698,-16507, 14650, 13218,-14303,-31138, 15139, 25841,-17987,-32747,
+  -32481,-24761, 30446,-32525,  -464, -2512,-32704, 32641,-15116,-31278,-28882, -4645,
+   31439,  6913,-32082,-16891,  2630, -5072,-32581, 25309,-32552,-23851,-32517, 13345,
+  -23533, 20376, 27979, 14623,-22860,-21697, 28515, 14399,-22348,-31284,-24879, 20459,
+  -11678, 32597, 25999, 31355,-29752, 31981, 16921, 11478, 27896, 24918,-21731,-22974,
+   19335, 32745, 32579, 24213,
+};
+
+/**
+ * @brief Reference buffer lookup table, matched to the golden cases by name.
+ */
+struct GoldenReference {
+  const char*    name;
+  const int16_t* samples;
+};
+
+static const GoldenReference kGoldenReferences[] = {
+  { "VCO_Sine", kRef_VCO_Sine },
+  { "VCO_Square", kRef_VCO_Square },
+  { "VCO_Saw", kRef_VCO_Saw },
+  { "FMSynth", kRef_FMSynth },
+};
@@ -0,0 +1,75 @@
+/**
+ * @file HotMix.ino
+ * @brief Mixing several sources into the master limiter.
+ *
+ * @defgroup Examples_AudioHotMix HotMix
+ * @ingroup Examples
+ *
+ * This HotMix.ino example shows how to:
+ * 1. Mix several sources with CTAG_AudioEngine::addSource().
+ * 2. Drive the mix well above full scale without wrap-around clicks.
+ * 3. Read the limiter's gain-reduction meter and clip counter.
+ */
+
+// Include the custom board pin definitions. This is crucial!
+#include "pins_arduino.h"
+
+#include "CTAG_Audio.h"
+
+// --- Global Objects ---
+
+CTAG_AudioCodec codec;
+CTAG_VCO_Saw    bass;
+CTAG_VCO_Square lead;
+CTAG_FMSynth    bell;
+
+/**
+ * @brief Audio task: renders the mix and prints the limiter meter twice per second.
+ */
+void audioTask(void *pvParameters) {
+  delay(125);
+
+  if (!codec.begin(PIN_WIRE1_SDA, PIN_WIRE1_SCL)) {
+    Serial.println("Codec initialization failed! Halting.");
+    while (1);
+  }
+  codec.setHeadphoneVolume(60);
+  CTAG_AudioEngine::init(I2S_NUM_0);
+
+  // Three sources at full amplitude: the sum peaks near 3.0 (≈ +9.5 dBFS).
+  bass.setFrequency(55.0f);   bass.setAmplitude(1.0f);
+  lead.setFrequency(220.0f);  lead.setAmplitude(1.0f); lead.setDutyCycle(0.25f);
+  bell.setCarrierFreq(880.0f); bell.setModFreq(1320.0f); bell.setModIndex(3.0f); bell.setAmplitude(1.0f);
+
+  CTAG_AudioEngine::addSource(&bass);
+  CTAG_AudioEngine::addSource(&lead);
+  CTAG_AudioEngine::addSource(&bell);
+  CTAG_AudioEngine::setLimiterCeiling(-1.0f);
+
+  for (uint32_t block = 0; ; ++block) {
+    CTAG_AudioEngine::renderBlock();
+
+    if ((block % 86) == 0) {
+      CTAG_AudioEngine::Stats s = CTAG_AudioEngine::getStats();
+      Serial.printf("GR: %5.1f dB  clipped: %lu\n", s.gainReductionDb,
+                    (unsigned long)s.clippedSamples);
+    }
+  }
+}
+
+/**
+ * @brief Runs once at startup to create the audio task.
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("\n--- CTAG Hot Mix Demo ---");
+
+  xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, NULL, 1);
+}
+
+/**
+ * @brief The audio is generated in a background task, so this loop is free.
+ */
+void loop() {
+}
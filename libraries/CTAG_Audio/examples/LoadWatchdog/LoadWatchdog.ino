@@ -0,0 +1,138 @@
+/**
+ * @file LoadWatchdog.ino
+ * @brief Graceful degradation when the audio engine runs out of CPU time.
+ *
+ * @defgroup Examples_AudioLoadWatchdog LoadWatchdog
+ * @ingroup Examples
+ *
+ * This LoadWatchdog.ino example shows how to:
+ * 1. Enable the engine's deadline watchdog and tune its thresholds.
+ * 2. Overload the audio task on purpose with a "ballast" source.
+ * 3. Watch the engine drop voices, bypass effects and switch to economy mode,
+ *    then recover once the load is gone.
+ * 4. Read the DSP load, peak load and overrun counters.
+ */
+
+// Include the custom board pin definitions. This is crucial!
+#include "pins_arduino.h"
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioFilter.h"
+
+// --- Global Objects ---
+
+CTAG_AudioCodec codec;
+CTAG_FMSynth    voices[4];
+CTAG_SVFilter   filter;
+
+/**
+ * @brief Silent source that only burns CPU time, to simulate a heavy patch.
+ */
+class BallastSource : public CTAG_AudioSource {
+public:
+  volatile uint32_t costUs = 0;
+
+  int16_t getNextSample() override { return 0; }
+
+  void renderBlock(float* out, size_t numSamples) override {
+    memset(out, 0, numSamples * sizeof(float));
+    if (costUs) delayMicroseconds(costUs);
+  }
+};
+
+BallastSource ballast;
+
+static const char* actionName(CTAG_AudioEngine::WatchdogAction a) {
+  switch (a) {
+    case CTAG_AudioEngine::WatchdogAction::VoiceDropped:    return "voice dropped";
+    case CTAG_AudioEngine::WatchdogAction::VoiceRestored:   return "voice restored";
+    case CTAG_AudioEngine::WatchdogAction::EffectsBypassed: return "effects bypassed";
+    case CTAG_AudioEngine::WatchdogAction::EffectsRestored: return "effects restored";
+    case CTAG_AudioEngine::WatchdogAction::EconomyOn:       return "economy on";
+    case CTAG_AudioEngine::WatchdogAction::EconomyOff:      return "economy off";
+  }
+  return "?";
+}
+
+/**
+ * @brief Audio task: sets up four FM voices plus the ballast and renders forever.
+ */
+void audioTask(void *pvParameters) {
+  delay(125);
+
+  if (!codec.begin(PIN_WIRE1_SDA, PIN_WIRE1_SCL)) {
+    Serial.println("Codec initialization failed! Halting.");
+    while (1);
+  }
+  codec.setHeadphoneVolume(60);
+  CTAG_AudioEngine::init(I2S_NUM_0);
+
+  // A quiet chord; the quietest voice is the first one to be dropped.
+  const float notes[4] = { 220.0f, 277.2f, 329.6f, 440.0f };
+  for (int i = 0; i < 4; ++i) {
+    voices[i].setCarrierFreq(notes[i]);
+    voices[i].setModFreq(notes[i] * 2.0f);
+    voices[i].setModIndex(1.5f);
+    voices[i].setAmplitude(0.1f + 0.05f * i);
+    CTAG_AudioEngine::addSource(&voices[i]);
+  }
+  CTAG_AudioEngine::addSource(&ballast);
+
+  filter.setType(CTAG_FilterType::LowPass);
+  filter.setFrequency(2500.0f);
+  filter.setResonance(0.3f);
+  CTAG_AudioEngine::addEffect(&filter);
+
+  CTAG_AudioEngine::WatchdogConfig cfg;
+  cfg.degradeLoad   = 0.85f; // act above 85 % of the block period
+  cfg.recoverLoad   = 0.60f; // undo one step after a quiet period below 60 %
+  cfg.holdBlocks    = 8;     // ~46 ms between degradation steps
+  cfg.recoverBlocks = 200;   // ~1.2 s between recovery steps
+  CTAG_AudioEngine::setWatchdogConfig(cfg);
+  CTAG_AudioEngine::setWatchdogEnabled(true);
+
+  while (true) {
+    CTAG_AudioEngine::renderBlock();
+  }
+}
+
+/**
+ * @brief Runs once at startup to create the audio task.
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("\n--- CTAG Load Watchdog Demo ---");
+
+  xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, NULL, 1);
+}
+
+/**
+ * @brief Toggles the ballast every 10 s and prints the watchdog log.
+ */
+void loop() {
+  static uint32_t lastToggle = 0;
+  static uint32_t lastPrint  = 0;
+
+  if (millis() - lastToggle > 10000) {
+    lastToggle = millis();
+    // The block period is ~5.8 ms; 5 ms of ballast pushes the load past 100 %.
+    ballast.costUs = ballast.costUs ? 0 : 5000;
+    Serial.printf("Ballast %s\n", ballast.costUs ? "ON" : "OFF");
+  }
+
+  CTAG_AudioEngine::WatchdogEvent e;
+  while (CTAG_AudioEngine::pollWatchdogEvent(e)) {
+    Serial.printf("[block %lu] %-16s slot %2d  load %3.0f %%\n",
+                  (unsigned long)e.block, actionName(e.action), e.slot, e.load * 100.0f);
+  }
+
+  if (millis() - lastPrint > 1000) {
+    lastPrint = millis();
+    CTAG_AudioEngine::Stats s = CTAG_AudioEngine::getStats();
+    Serial.printf("load %3.0f %%  peak %3.0f %%  overruns %lu  level %u\n",
+                  s.dspLoad * 100.0f, s.peakLoad * 100.0f,
+                  (unsigned long)s.overruns, s.degradeLevel);
+  }
+  delay(20);
+}
@@ -0,0 +1,111 @@
+/**
+ * @file RecordToFlash.ino
+ * @brief Recording the engine's output to a WAV file in the background.
+ *
+ * @defgroup Examples_AudioRecordToFlash RecordToFlash
+ * @ingroup Examples
+ *
+ * This RecordToFlash.ino example shows how to:
+ * 1. Attach a CTAG_AudioRecorder to the engine as a sink.
+ * 2. Record eight seconds of the master bus to LittleFS (SD and SD_MMC
+ *    work the same way, they are fs::FS as well).
+ * 3. Read the dropped-block and write-time counters.
+ *
+ * LittleFS lives in the same flash the code runs from. While a sector is
+ * written or erased the cache is off on both cores, so the audio task
+ * stalls as well and the output glitches; the FIFO cannot help with that.
+ * For clean takes, record to an SD card instead.
+ */
+
+// Include the custom board pin definitions. This is crucial!
+#include "pins_arduino.h"
+
+#include <LittleFS.h>
+#include "CTAG_Audio.h"
+#include "CTAG_AudioRecorder.h"
+
+// --- Global Objects ---
+
+CTAG_AudioCodec    codec;
+CTAG_FMSynth       bell;
+CTAG_AudioRecorder recorder;
+
+/**
+ * @brief Audio task: renders a slowly sweeping FM tone.
+ */
+void audioTask(void *pvParameters) {
+  delay(125);
+
+  if (!codec.begin(PIN_WIRE1_SDA, PIN_WIRE1_SCL)) {
+    Serial.println("Codec initialization failed! Halting.");
+    while (1);
+  }
+  codec.setHeadphoneVolume(60);
+  CTAG_AudioEngine::init(I2S_NUM_0);
+
+  bell.setCarrierFreq(330.0f);
+  bell.setModFreq(495.0f);
+  bell.setAmplitude(0.5f);
+  CTAG_AudioEngine::setSource(&bell);
+  CTAG_AudioEngine::addSink(&recorder);
+
+  for (uint32_t block = 0; ; ++block) {
+    bell.setModIndex(2.0f + 1.5f * sinf(block * 0.01f));
+    CTAG_AudioEngine::renderBlock();
+  }
+}
+
+/**
+ * @brief Mounts LittleFS, starts the writer task and the audio task.
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("\n--- CTAG Record To Flash Demo ---");
+
+  if (!LittleFS.begin(true)) {
+    Serial.println("LittleFS mount failed! Halting.");
+    while (1);
+  }
+
+  // 64 blocks (~370 ms) of FIFO absorb slow writes of the writer task;
+  // the flash stalls themselves hit the audio task too.
+  if (!recorder.begin(64)) {
+    Serial.println("Recorder initialization failed! Halting.");
+    while (1);
+  }
+
+  xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, NULL, 1);
+}
+
+/**
+ * @brief Records once for eight seconds, then prints the result.
+ */
+void loop() {
+  static bool done = false;
+  if (done) return;
+
+  delay(2000);
+  Serial.println("Recording /take.wav ...");
+  if (!recorder.start(LittleFS, "/take.wav")) {
+    Serial.println("Could not create the file.");
+    done = true;
+    return;
+  }
+
+  delay(8000);
+  recorder.stop();
+  while (recorder.isBusy()) delay(10);
+
+  CTAG_AudioRecorder::Stats s = recorder.getStats();
+  Serial.printf("Frames: %lu (%.2f s)  dropped blocks: %lu  write errors: %lu\n",
+                (unsigned long)s.recordedFrames, s.recordedFrames / 44100.0f,
+                (unsigned long)s.droppedBlocks, (unsigned long)s.writeErrors);
+  Serial.printf("Longest chunk write: %lu us  FIFO peak: %u frames\n",
+                (unsigned long)s.maxWriteUs, s.fifoPeak);
+
+  File f = LittleFS.open("/take.wav");
+  Serial.printf("File size: %u bytes\n", (unsigned)f.size());
+  f.close();
+  done = true;
+}
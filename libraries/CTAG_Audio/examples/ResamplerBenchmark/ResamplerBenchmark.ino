@@ -0,0 +1,209 @@
+/**
+ * @file ResamplerBenchmark.ino
+ * @brief Quality and cost of the resampler presets, plus a pitched sample player.
+ *
+ * @defgroup Examples_AudioResampler ResamplerBenchmark
+ * @ingroup Examples
+ *
+ * This ResamplerBenchmark.ino example shows how to:
+ * 1. Convert a stream block by block with CTAG_Resampler (48 kHz to 44.1 kHz).
+ * 2. Measure THD+N of each preset: a sine is converted, a sine of the same
+ *    frequency is fitted to the output (least squares) and the residual is
+ *    compared with the fitted tone.
+ * 3. Measure alias rejection when down-sampling by 2: a 15 kHz tone lies
+ *    above the new Nyquist frequency and should disappear, not fold to 7 kHz.
+ * 4. Measure the cost in microseconds per 256-sample input block.
+ * 5. Play a sample from memory at different pitches with CTAG_SamplePlayer.
+ *
+ * The measurements are rendered offline in setup() and need no codec.
+ */
+
+// Include the custom board pin definitions. This is crucial!
+#include "pins_arduino.h"
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioResampler.h"
+
+// --- Benchmark ---
+
+static const size_t kInBlock   = 256;   ///< Input samples per process() call.
+static const size_t kSettle    = 512;   ///< Output samples skipped before measuring.
+static const size_t kAnalyze   = 4096;  ///< Output samples measured.
+static const size_t kOutMax    = kInBlock * 2 + 4;
+
+static float inBlock[kInBlock];
+static float outBlock[kOutMax];
+static float captured[kAnalyze];
+
+static const char* const kPresetNames[] = { "Linear", "Cubic", "Sinc16", "Sinc32" };
+
+/**
+ * @brief Fits a*cos + b*sin + c at a known frequency and returns the residual
+ * relative to the fitted tone in dB (THD+N), and the tone's amplitude.
+ */
+static float thdPlusNoise(const float* x, size_t n, double cyclesPerSample, float* amplitude) {
+  double scc = 0, sss = 0, scs = 0, sc = 0, ss = 0, s1 = (double)n;
+  double xc = 0, xs = 0, x1 = 0, xx = 0;
+  for (size_t i = 0; i < n; ++i) {
+    double w = 2.0 * M_PI * cyclesPerSample * i;
+    double c = cos(w), s = sin(w);
+    scc += c * c; sss += s * s; scs += c * s; sc += c; ss += s;
+    xc += x[i] * c; xs += x[i] * s; x1 += x[i]; xx += (double)x[i] * x[i];
+  }
+  // Normal equations, solved with Cramer's rule.
+  double m[3][3] = { { scc, scs, sc }, { scs, sss, ss }, { sc, ss, s1 } };
+  double r[3] = { xc, xs, x1 };
+  auto det = [](double a[3][3]) {
+    return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1])
+         - a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0])
+         + a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+  };
+  double d = det(m), coef[3];
+  for (int k = 0; k < 3; ++k) {
+    double t[3][3];
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j) t[i][j] = (j == k) ? r[i] : m[i][j];
+    coef[k] = det(t) / d;
+  }
+  double fit = coef[0] * xc + coef[1] * xs + coef[2] * x1;  // energy of the fit
+  double residual = max(xx - fit, 1e-20);
+  double tone = 0.5 * (coef[0] * coef[0] + coef[1] * coef[1]) * n;
+  *amplitude = (float)sqrt(coef[0] * coef[0] + coef[1] * coef[1]);
+  return (float)(10.0 * log10(residual / tone));
+}
+
+/**
+ * @brief Streams a sine through the resampler and captures kAnalyze outputs.
+ * @return Microseconds spent in process() per input block.
+ */
+static float convertSine(CTAG_Resampler& rs, float inRate, float outRate, float freq, float amp) {
+  rs.reset();
+  rs.setRates(inRate, outRate);
+  double phase = 0.0, inc = freq / inRate;
+  size_t skipped = 0, stored = 0, blocks = 0;
+  uint32_t busy = 0;
+  while (stored < kAnalyze) {
+    for (size_t i = 0; i < kInBlock; ++i) {
+      inBlock[i] = amp * (float)sin(2.0 * M_PI * phase);
+      phase += inc;
+      if (phase >= 1.0) phase -= 1.0;
+    }
+    uint32_t t0 = micros();
+    size_t n = rs.process(inBlock, kInBlock, outBlock, kOutMax);
+    busy += micros() - t0;
+    ++blocks;
+    for (size_t i = 0; i < n && stored < kAnalyze; ++i) {
+      if (skipped < kSettle) ++skipped;
+      else captured[stored++] = outBlock[i];
+    }
+  }
+  return (float)busy / blocks;
+}
+
+/**
+ * @brief Measures every preset and prints one table row each.
+ */
+static void runBenchmark() {
+  Serial.println("preset   THD+N 1k   THD+N 15k   alias 15k@2x   us/block 48k->44.1k   us/block 2x");
+  for (int q = 0; q < 4; ++q) {
+    CTAG_Resampler rs;
+    if (!rs.begin((CTAG_ResampleQuality)q, 2.0f)) {
+      Serial.printf("%-7s  out of memory\n", kPresetNames[q]);
+      continue;
+    }
+    float amp;
+    float us = convertSine(rs, 48000.0f, 44100.0f, 1000.0f, 0.9f);
+    float thd1k = thdPlusNoise(captured, kAnalyze, 1000.0 / 44100.0, &amp);
+    convertSine(rs, 48000.0f, 44100.0f, 15000.0f, 0.9f);
+    float thd15k = thdPlusNoise(captured, kAnalyze, 15000.0 / 44100.0, &amp);
+
+    // Down-sampling by 2: whatever comes out is the 15 kHz tone folded to 7.05 kHz.
+    float us2 = convertSine(rs, 44100.0f, 22050.0f, 15000.0f, 0.9f);
+    thdPlusNoise(captured, kAnalyze, 7050.0 / 22050.0, &amp);
+    float alias = 20.0f * log10f(max(amp, 1e-7f) / 0.9f);
+
+    Serial.printf("%-7s  %6.1f dB  %7.1f dB  %9.1f dB    %10.1f          %10.1f\n",
+                  kPresetNames[q], thd1k, thd15k, alias, us, us2);
+  }
+}
+
+// --- Sample player ---
+
+CTAG_AudioCodec   codec;
+CTAG_SamplePlayer player;
+
+static const size_t kSampleLength = 22050;  ///< Half a second at 44.1 kHz.
+static int16_t sampleData[kSampleLength];
+
+/**
+ * @brief Fills sampleData with a decaying, slightly detuned sawtooth pair at
+ * 220 Hz, a stand-in for a recorded instrument.
+ */
+static void makeSample() {
+  float p1 = 0.0f, p2 = 0.0f, env = 1.0f;
+  for (size_t i = 0; i < kSampleLength; ++i) {
+    p1 += 220.0f / 44100.0f;  if (p1 >= 1.0f) p1 -= 1.0f;
+    p2 += 221.3f / 44100.0f;  if (p2 >= 1.0f) p2 -= 1.0f;
+    env *= 0.99985f;
+    sampleData[i] = (int16_t)(env * 8000.0f * ((2.0f * p1 - 1.0f) + (2.0f * p2 - 1.0f)));
+  }
+}
+
+/**
+ * @brief Audio task: plays the sample up and down a minor pentatonic scale.
+ */
+void audioTask(void *pvParameters) {
+  delay(125);
+
+  if (!codec.begin(PIN_WIRE1_SDA, PIN_WIRE1_SCL)) {
+    Serial.println("Codec initialization failed! Halting.");
+    while (1);
+  }
+  codec.setHeadphoneVolume(60);
+  CTAG_AudioEngine::init(I2S_NUM_0);
+  CTAG_AudioEngine::setSource(&player);
+
+  static const int8_t scale[] = { -12, -9, -7, -5, -2, 0, 3, 5, 7, 10, 12, 10, 7, 5, 3, 0, -2, -5, -7, -9 };
+  size_t note = 0;
+  uint32_t blocksToNote = 0;
+  while (true) {
+    if (blocksToNote == 0) {
+      player.setPitch(scale[note]);
+      player.trigger();
+      note = (note + 1) % sizeof(scale);
+      blocksToNote = 43;  // ~250 ms
+    }
+    --blocksToNote;
+    CTAG_AudioEngine::renderBlock();
+  }
+}
+
+/**
+ * @brief Runs the benchmark, then starts the sample player.
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("\n--- CTAG Resampler Benchmark ---");
+
+  runBenchmark();
+
+  makeSample();
+  if (!player.begin(CTAG_ResampleQuality::Sinc16, 4.0f)) {
+    Serial.println("Sample player initialization failed! Halting.");
+    while (1);
+  }
+  player.setSample(sampleData, kSampleLength, 44100.0f);
+  player.setAmplitude(0.8f);
+
+  xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, NULL, 1);
+}
+
+/**
+ * @brief Prints the engine load, which includes the player's interpolation.
+ */
+void loop() {
+  delay(2000);
+  CTAG_AudioEngine::Stats s = CTAG_AudioEngine::getStats();
+  Serial.printf("player load %4.1f %%  peak %4.1f %%\n", s.dspLoad * 100.0f, s.peakLoad * 100.0f);
+}
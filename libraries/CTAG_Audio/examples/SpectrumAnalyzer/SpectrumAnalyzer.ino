@@ -0,0 +1,132 @@
+/**
+ * @file SpectrumAnalyzer.ino
+ * @brief Log-band spectrum of the engine output, computed on the spare core.
+ *
+ * @defgroup Examples_AudioSpectrumAnalyzer SpectrumAnalyzer
+ * @ingroup Examples
+ *
+ * This SpectrumAnalyzer.ino example shows how to:
+ * 1. Attach a CTAG_AudioAnalyzer to the engine as a sink; its FFT task runs
+ *    on core 0 while the audio task stays on core 1.
+ * 2. Receive the 32 band levels in a callback, pack them into a message and
+ *    queue it for the display controller over CTAG_SPI_IPC
+ *    (CTAG_Display::drawBars() renders it there).
+ * 3. Measure the added cost: the analyzer's time per FFT and core-0 load,
+ *    and the audio task's load with and without the analyzer attached
+ *    (toggled every 10 s).
+ */
+
+// Include the custom board pin definitions. This is crucial!
+#include "pins_arduino.h"
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioAnalyzer.h"
+#include <CTAG_SPI_IPC.h>
+
+// --- Global Objects ---
+
+CTAG_AudioCodec    codec;
+CTAG_FMSynth       voice;
+CTAG_AudioAnalyzer analyzer;
+
+// Latest spectrum message, also printed by loop().
+uint8_t spectrumMsg[CTAG_AudioAnalyzer::kSpectrumMsgLen];
+bool    slaveReady = false;
+
+/**
+ * @brief Called on the analyzer task after every FFT (~21 times per second).
+ * This is the only task that calls slaveSend().
+ */
+void onSpectrum(const uint8_t* levels, void* arg) {
+  analyzer.packSpectrum(spectrumMsg);
+  // A controller that polls slower than the analyzer only misses spectra;
+  // the ring never fills up with stale ones.
+  if (slaveReady && CTAG_SPI_IPC::slaveTxPending() == 0) {
+    CTAG_SPI_IPC::slaveSend(spectrumMsg, sizeof(spectrumMsg));
+  }
+}
+
+/**
+ * @brief Audio task: renders an FM voice whose pitch and brightness wander.
+ */
+void audioTask(void *pvParameters) {
+  delay(125);
+
+  if (!codec.begin(PIN_WIRE1_SDA, PIN_WIRE1_SCL)) {
+    Serial.println("Codec initialization failed! Halting.");
+    while (1);
+  }
+  codec.setHeadphoneVolume(60);
+  CTAG_AudioEngine::init(I2S_NUM_0);
+
+  voice.setAmplitude(0.5f);
+  CTAG_AudioEngine::setSource(&voice);
+  CTAG_AudioEngine::addSink(&analyzer);
+
+  for (uint32_t block = 0; ; ++block) {
+    float f = 110.0f * powf(2.0f, 3.0f * (0.5f + 0.5f * sinf(block * 0.004f)));
+    voice.setCarrierFreq(f);
+    voice.setModFreq(f * 1.5f);
+    voice.setModIndex(1.0f + 2.0f * (0.5f + 0.5f * sinf(block * 0.011f)));
+    CTAG_AudioEngine::renderBlock();
+  }
+}
+
+/**
+ * @brief Starts the SPI slave, the analyzer task on core 0 and the audio
+ * task on core 1.
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("\n--- CTAG Spectrum Analyzer Demo ---");
+
+  // The controller picks the spectra up with CTAG_SPI_IPC::exchange().
+  slaveReady = CTAG_SPI_IPC::beginSlave(PIN_SPI0_SCK, PIN_SPI0_MISO, PIN_SPI0_MOSI, PIN_SPI0_SS, nullptr);
+  if (!slaveReady) Serial.println("SPI slave initialization failed, printing only.");
+
+  // 2048-point FFT every 8 blocks (~46 ms window, ~21.5 analyses per second).
+  if (!analyzer.begin(2048, 8, 0)) {
+    Serial.println("Analyzer initialization failed! Halting.");
+    while (1);
+  }
+  analyzer.setCallback(onSpectrum);
+
+  xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, NULL, 1);
+}
+
+/**
+ * @brief Prints the bands as a text bar graph and the cost counters.
+ */
+void loop() {
+  static uint32_t lastToggle = 0;
+  static bool attached = true;
+
+  delay(1000);
+
+  if (millis() - lastToggle > 10000) {
+    lastToggle = millis();
+    attached = !attached;
+    if (attached) {
+      CTAG_AudioEngine::addSink(&analyzer);
+    } else {
+      CTAG_AudioEngine::removeSink(&analyzer);
+    }
+    CTAG_AudioEngine::resetStats();
+    Serial.printf("Analyzer %s\n", attached ? "attached" : "detached");
+  }
+
+  // One character per band, from silent to full scale.
+  static const char shades[] = " .:-=+*#%@";
+  char line[CTAG_ANALYZER_BANDS + 1];
+  for (int i = 0; i < CTAG_ANALYZER_BANDS; ++i) {
+    line[i] = shades[spectrumMsg[2 + i] * 9 / 255];
+  }
+  line[CTAG_ANALYZER_BANDS] = '\0';
+
+  CTAG_AudioAnalyzer::Stats a = analyzer.getStats();
+  CTAG_AudioEngine::Stats   e = CTAG_AudioEngine::getStats();
+  Serial.printf("|%s|  FFT %lu us (max %lu)  core 0 %4.1f %%  audio %4.1f %%  dropped %lu\n",
+                line, (unsigned long)a.lastUs, (unsigned long)a.maxUs,
+                a.load * 100.0f, e.dspLoad * 100.0f, (unsigned long)a.droppedBlocks);
+}
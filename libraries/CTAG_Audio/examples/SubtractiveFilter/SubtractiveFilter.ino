@@ -0,0 +1,138 @@
+/**
+ * @file SubtractiveFilter.ino
+ * @brief Subtractive synthesis with the CTAG filter module.
+ *
+ * @defgroup Examples_AudioFilter SubtractiveFilter
+ * @ingroup Examples
+ *
+ * This SubtractiveFilter.ino example shows how to:
+ * 1. Check the frequency response of a biquad cascade against its analytic response.
+ * 2. Measure the cycles per block of the biquad, the SVF and the 4-voice SVF bank.
+ * 3. Insert a resonant state-variable filter after a saw oscillator.
+ * 4. Sweep the cutoff from the control loop (coefficients update once per block).
+ */
+
+// Include the custom board pin definitions. This is crucial!
+#include "pins_arduino.h"
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioFilter.h"
+
+// --- Global Objects ---
+
+CTAG_AudioCodec   codec;
+CTAG_VCO_Saw      saw;
+CTAG_SVFilter     svf;
+CTAG_BiquadFilter biquad(44100.0f, 2);
+CTAG_SVFilterBank4 bank;
+
+static float block[4][CTAG_AUDIO_BLOCK_SIZE];
+
+/**
+ * @brief Measures the steady-state gain of a filter for a sine input.
+ */
+static float measureGain(CTAG_AudioEffect& fx, float freq) {
+  fx.reset();
+  float phase = 0.0f, energy = 0.0f;
+  const float inc = 2.0f * M_PI * freq / 44100.0f;
+  for (int b = 0; b < 80; ++b) {
+    for (int i = 0; i < CTAG_AUDIO_BLOCK_SIZE; ++i) {
+      block[0][i] = sinf(phase);
+      phase += inc;
+      if (phase >= 2.0f * M_PI) phase -= 2.0f * M_PI;
+    }
+    fx.process(block[0], CTAG_AUDIO_BLOCK_SIZE);
+    if (b >= 40) { // skip the transient
+      for (int i = 0; i < CTAG_AUDIO_BLOCK_SIZE; ++i) energy += block[0][i] * block[0][i];
+    }
+  }
+  return sqrtf(2.0f * energy / (40 * CTAG_AUDIO_BLOCK_SIZE));
+}
+
+/**
+ * @brief Prints the measured and analytic response of the biquad cascade.
+ */
+static void printResponse() {
+  biquad.setType(CTAG_FilterType::LowPass);
+  biquad.setFrequency(1000.0f);
+  biquad.setQ(0.7071f);
+  Serial.println("Biquad LP 1 kHz, 2 stages:  freq   measured   analytic");
+  const float freqs[] = { 100.0f, 500.0f, 1000.0f, 2000.0f, 4000.0f, 8000.0f };
+  for (float f : freqs) {
+    float measured = 20.0f * log10f(measureGain(biquad, f));
+    float analytic = 20.0f * log10f(biquad.magnitudeAt(f));
+    Serial.printf("                        %6.0f Hz %7.2f dB %7.2f dB\n", f, measured, analytic);
+  }
+}
+
+/**
+ * @brief Prints the average cycles per block of each filter.
+ */
+static void printBenchmark() {
+  const int runs = 1000;
+  float* voices[4] = { block[0], block[1], block[2], block[3] };
+  uint32_t t0, biquadCycles = 0, svfCycles = 0, bankCycles = 0;
+
+  for (int r = 0; r < runs; ++r) {
+    t0 = ESP.getCycleCount(); biquad.process(block[0], CTAG_AUDIO_BLOCK_SIZE); biquadCycles += ESP.getCycleCount() - t0;
+    t0 = ESP.getCycleCount(); svf.process(block[1], CTAG_AUDIO_BLOCK_SIZE);    svfCycles    += ESP.getCycleCount() - t0;
+    t0 = ESP.getCycleCount(); bank.process(voices, CTAG_AUDIO_BLOCK_SIZE);     bankCycles   += ESP.getCycleCount() - t0;
+  }
+  Serial.printf("Biquad (2 stages): %lu cycles/block\n", (unsigned long)(biquadCycles / runs));
+  Serial.printf("SVF:               %lu cycles/block\n", (unsigned long)(svfCycles / runs));
+  Serial.printf("SVF bank (4 voices): %lu cycles/block\n", (unsigned long)(bankCycles / runs));
+  biquad.reset();
+  svf.reset();
+  bank.reset();
+}
+
+/**
+ * @brief Audio task: runs the checks, then renders the filtered saw.
+ */
+void audioTask(void *pvParameters) {
+  delay(125);
+
+  printResponse();
+  printBenchmark();
+
+  if (!codec.begin(PIN_WIRE1_SDA, PIN_WIRE1_SCL)) {
+    Serial.println("Codec initialization failed! Halting.");
+    while (1);
+  }
+  codec.setHeadphoneVolume(70);
+  CTAG_AudioEngine::init(I2S_NUM_0);
+
+  saw.setFrequency(110.0f);
+  saw.setAmplitude(0.5f);
+  saw.setSkew(0.99f);
+  svf.setType(CTAG_FilterType::LowPass);
+  svf.setResonance(0.8f);
+
+  CTAG_AudioEngine::setSource(&saw);
+  CTAG_AudioEngine::addEffect(&svf);
+
+  for (;;) {
+    CTAG_AudioEngine::renderBlock();
+
+    // Slow exponential cutoff sweep between 100 Hz and 4 kHz.
+    float sweep = 0.5f + 0.5f * sinf(millis() * 0.0005f);
+    svf.setFrequency(100.0f * powf(40.0f, sweep));
+  }
+}
+
+/**
+ * @brief Runs once at startup to create the audio task.
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("\n--- CTAG Subtractive Filter Demo ---");
+
+  xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, NULL, 1);
+}
+
+/**
+ * @brief The audio is generated in a background task, so this loop is free.
+ */
+void loop() {
+}
@@ -0,0 +1,117 @@
+/**
+ * @file Tuner.ino
+ * @brief Pitch detection (tuner) on the spare core.
+ *
+ * @defgroup Examples_AudioTuner Tuner
+ * @ingroup Examples
+ *
+ * This Tuner.ino example shows how to:
+ * 1. Attach a CTAG_AudioTuner to one source slot of the engine; its YIN task
+ *    runs on core 0 while the audio task stays on core 1.
+ * 2. Read frequency, note and cents, pack them into a 7-byte message and
+ *    queue it for the display controller over CTAG_SPI_IPC.
+ * 3. Read the tuner's cost: time per update and core-0 load.
+ *
+ * A slowly drifting sawtooth stands in for an instrument; any source in the
+ * tapped slot, e.g. one that plays the codec input, is tuned the same way.
+ */
+
+// Include the custom board pin definitions. This is crucial!
+#include "pins_arduino.h"
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioTuner.h"
+#include <CTAG_SPI_IPC.h>
+
+// --- Global Objects ---
+
+CTAG_AudioCodec codec;
+CTAG_VCO_Saw    instrument;
+CTAG_AudioTuner tuner;
+
+bool slaveReady = false;
+
+/**
+ * @brief Called on the tuner task after every update (~172 times per second).
+ * This is the only task that calls slaveSend().
+ */
+void onReading(const CTAG_AudioTuner::Reading& reading, void* arg) {
+  // Only the newest reading matters; skip it while the last one is queued.
+  if (!slaveReady || CTAG_SPI_IPC::slaveTxPending() != 0) return;
+  uint8_t msg[CTAG_AudioTuner::kTunerMsgLen];
+  size_t len = tuner.packReading(msg);
+  CTAG_SPI_IPC::slaveSend(msg, len);
+}
+
+/**
+ * @brief Audio task: plays a low E that drifts a quarter tone up and down.
+ */
+void audioTask(void *pvParameters) {
+  delay(125);
+
+  if (!codec.begin(PIN_WIRE1_SDA, PIN_WIRE1_SCL)) {
+    Serial.println("Codec initialization failed! Halting.");
+    while (1);
+  }
+  codec.setHeadphoneVolume(60);
+  CTAG_AudioEngine::init(I2S_NUM_0);
+
+  instrument.setAmplitude(0.4f);
+  CTAG_AudioEngine::setSource(&instrument);
+
+  for (uint32_t block = 0; ; ++block) {
+    float cents = 50.0f * sinf(block * 0.002f);
+    instrument.setFrequency(82.41f * powf(2.0f, cents / 1200.0f));
+    CTAG_AudioEngine::renderBlock();
+  }
+}
+
+/**
+ * @brief Starts the SPI slave, the tuner task on core 0 and the audio task
+ * on core 1.
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("\n--- CTAG Tuner Demo ---");
+
+  // The controller picks the readings up with CTAG_SPI_IPC::exchange().
+  slaveReady = CTAG_SPI_IPC::beginSlave(PIN_SPI0_SCK, PIN_SPI0_MISO, PIN_SPI0_MOSI, PIN_SPI0_SS, nullptr);
+  if (!slaveReady) Serial.println("SPI slave initialization failed, printing only.");
+
+  if (!tuner.begin(0)) {
+    Serial.println("Tuner initialization failed! Halting.");
+    while (1);
+  }
+  tuner.setTap(CTAG_AudioTuner::Tap::Source, 0); // slot 0, the instrument
+  tuner.setReference(440.0f);
+  tuner.setCallback(onReading);
+  CTAG_AudioEngine::addSink(&tuner);
+
+  xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, NULL, 1);
+}
+
+/**
+ * @brief Prints the reading as a needle and the cost counters.
+ */
+void loop() {
+  delay(200);
+
+  CTAG_AudioTuner::Reading r = tuner.getReading();
+  if (!r.valid) {
+    Serial.println("--");
+    return;
+  }
+
+  // A needle from -50 to +50 cents, one character per 5 cents.
+  char needle[22];
+  memset(needle, '-', 21);
+  needle[10] = '|';
+  needle[10 + r.cents / 5] = '*';
+  needle[21] = '\0';
+
+  CTAG_AudioTuner::Stats s = tuner.getStats();
+  Serial.printf("%-2s%d %+3d c  %7.2f Hz  [%s]  %lu us (max %lu)  core 0 %4.1f %%\n",
+                CTAG_AudioTuner::noteName(r.note), r.note / 12 - 1, r.cents, r.frequency,
+                needle, (unsigned long)s.lastUs, (unsigned long)s.maxUs, s.load * 100.0f);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file USBAudioStems.ino
+ * @brief Recording the engine over USB as a four-channel sound card.
+ *
+ * @defgroup Examples_AudioUSBAudioStems USBAudioStems
+ * @ingroup Examples
+ *
+ * This USBAudioStems.ino example shows how to:
+ * 1. Register the USB Audio Class 2.0 device before starting the USB stack.
+ * 2. Stream the master bus plus two per-source stems to the host.
+ * 3. Play the host's audio output into the engine mix.
+ * 4. Monitor the FIFO fill levels and the clock-drift correction.
+ *
+ * Select "USB Mode: USB-OTG (TinyUSB)" in the board menu. The board then
+ * appears as "CTAG Audio" with a 4-channel input (1/2 = master,
+ * 3 = bass stem, 4 = lead stem) and a stereo output.
+ */
+
+// Include the custom board pin definitions. This is crucial!
+#include "pins_arduino.h"
+
+#include "USB.h"
+#include "CTAG_Audio.h"
+#include "CTAG_AudioUSB.h"
+
+// --- Global Objects ---
+
+CTAG_AudioCodec codec;
+CTAG_VCO_Saw    bass;   // source slot 0 -> USB channel 3
+CTAG_VCO_Square lead;   // source slot 1 -> USB channel 4
+CTAG_USBAudio   usbAudio(4);
+
+/**
+ * @brief Audio task: renders the synth voices and the host playback.
+ */
+void audioTask(void *pvParameters) {
+  delay(125);
+
+  if (!codec.begin(PIN_WIRE1_SDA, PIN_WIRE1_SCL)) {
+    Serial.println("Codec initialization failed! Halting.");
+    while (1);
+  }
+  codec.setHeadphoneVolume(60);
+  CTAG_AudioEngine::init(I2S_NUM_0);
+
+  bass.setFrequency(55.0f);  bass.setAmplitude(0.4f);
+  lead.setFrequency(440.0f); lead.setAmplitude(0.2f); lead.setDutyCycle(0.3f);
+
+  // Slot order matters: the stems follow the source slots.
+  CTAG_AudioEngine::addSource(&bass);
+  CTAG_AudioEngine::addSource(&lead);
+  CTAG_AudioEngine::addSource(&usbAudio);  // host playback, slot 2 (no stem)
+  CTAG_AudioEngine::addSink(&usbAudio);    // master + stems to the host
+
+  while (true) {
+    CTAG_AudioEngine::renderBlock();
+  }
+}
+
+/**
+ * @brief Registers the USB audio device, starts USB and the audio task.
+ */
+void setup() {
+  Serial.begin(115200);
+
+  if (!usbAudio.begin()) {
+    Serial.println("USB audio not available (check the USB Mode setting).");
+  }
+  USB.productName("CTAG TBD");
+  USB.begin();
+
+  delay(1000);
+  Serial.println("\n--- CTAG USB Audio Stems Demo ---");
+
+  xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, NULL, 1);
+}
+
+/**
+ * @brief Prints the state of both USB streams once per second.
+ */
+void loop() {
+  CTAG_USBAudio::Stats s = usbAudio.getStats();
+  Serial.printf("to host: %s fill %3u ovr %lu corr %lu | from host: %s fill %3u %+6.0f ppm und %lu\n",
+                s.toHostActive ? "on " : "off", s.toHostFill,
+                (unsigned long)s.toHostOverruns, (unsigned long)s.sizeCorrections,
+                s.fromHostActive ? "on " : "off", s.fromHostFill,
+                s.fromHostRatioPpm, (unsigned long)s.fromHostUnderruns);
+  delay(1000);
+}
@@ -0,0 +1,111 @@
+/**
+ * @file VoicePool.ino
+ * @brief Demonstrates heap-free voice and buffer management with CTAG_AudioPool.
+ *
+ * @defgroup Examples_AudioPool VoicePool
+ * @ingroup Examples
+ *
+ * This VoicePool.ino example shows how to:
+ * 1. Reserve a fixed number of voices and DMA-capable buffers during setup.
+ * 2. Lock the allocator so any later allocation attempt is reported.
+ * 3. Create and destroy voices at runtime without touching the heap.
+ * 4. Verify that the free heap stays constant while audio is rendered.
+ */
+
+// Include the custom board pin definitions. This is crucial!
+#include "pins_arduino.h"
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioPool.h"
+
+// --- Global Objects ---
+
+CTAG_AudioCodec codec;
+
+/**
+ * @brief Up to 8 sine voices, stored in .bss instead of on the heap.
+ */
+CTAG_ObjectPool<CTAG_VCO_Sine, 8> voicePool;
+
+/**
+ * @brief DMA-capable block buffers, reserved once in setup().
+ */
+CTAG_BufferPool dmaBuffers;
+
+/**
+ * @brief Prints the statistics of a pool.
+ */
+static void printStats(const char* name, const CTAG_PoolStats& s) {
+  Serial.printf("%-8s capacity=%u inUse=%u peak=%u failed=%lu\n", name,
+                (unsigned)s.capacity, (unsigned)s.inUse, (unsigned)s.peak,
+                (unsigned long)s.failedAllocs);
+}
+
+/**
+ * @brief Audio task: renders blocks while voices come and go.
+ */
+void audioTask(void *pvParameters) {
+  delay(125);
+
+  if (!codec.begin(PIN_WIRE1_SDA, PIN_WIRE1_SCL)) {
+    Serial.println("Codec initialization failed! Halting.");
+    while (1);
+  }
+  codec.setHeadphoneVolume(70);
+  CTAG_AudioEngine::init(I2S_NUM_0);
+
+  // From here on nothing may allocate.
+  CTAG_AudioMemory::lockAllocations();
+  uint32_t heapAtStart = ESP.getFreeHeap();
+
+  CTAG_VCO_Sine* voice = nullptr;
+  for (uint32_t block = 0; ; ++block) {
+    // Every ~0.5 s swap the sounding voice for a fresh one from the pool.
+    if ((block % 86) == 0) {
+      CTAG_AudioEngine::setSource(nullptr);
+      voicePool.destroy(voice);
+      voice = voicePool.create(44100.0f);
+      if (voice) {
+        voice->setFrequency(220.0f * (1 + (block / 86) % 4));
+        voice->setAmplitude(0.3f);
+      }
+      CTAG_AudioEngine::setSource(voice);
+    }
+
+    CTAG_AudioEngine::renderBlock();
+
+    if ((block % 1000) == 999) {
+      int32_t heapDelta = (int32_t)ESP.getFreeHeap() - (int32_t)heapAtStart;
+      Serial.printf("Blocks: %lu  heap delta: %ld bytes  locked allocs: %lu\n",
+                    (unsigned long)(block + 1), (long)heapDelta,
+                    (unsigned long)CTAG_AudioMemory::lockedAllocAttempts());
+      printStats("voices", voicePool.getStats());
+      printStats("dma", dmaBuffers.getStats());
+    }
+  }
+}
+
+/**
+ * @brief Runs once at startup: reserves all memory, then starts the audio task.
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("\n--- CTAG Voice Pool Demo ---");
+
+  // 4 stereo 16-bit blocks in DMA-capable internal RAM.
+  if (!dmaBuffers.begin(CTAG_AUDIO_BLOCK_SIZE * 2 * sizeof(int16_t), 4,
+                        CTAG_AudioMemory::Region::Dma)) {
+    Serial.println("DMA buffer reservation failed!");
+  }
+  Serial.printf("Reserved %u bytes via CTAG_AudioMemory.\n",
+                (unsigned)CTAG_AudioMemory::bytesAllocated());
+
+  xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, NULL, 1);
+}
+
+/**
+ * @brief The audio is generated in a background task, so this loop is free.
+ */
+void loop() {
+}
@@ -1,4 +1,9 @@
 #include "CTAG_Audio.h"
+#include "CTAG_AudioDynamics.h"
+#include <CTAG_SourceParams.h>
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
 
 /**
  * @file CTAG_Audio.cpp
@@ -9,7 +14,7 @@
  */
 
 // --- Constants ---
-#define SAMPLE_RATE     (44100)
+#define SAMPLE_RATE     (CTAG_AUDIO_SAMPLE_RATE)
 #define BITS_PER_SAMPLE (I2S_BITS_PER_SAMPLE_16BIT)
 
 
@@ -80,24 +85,282 @@ void CTAG_AudioCodec::setLineOutVolume(uint8_t volume) {
 // =========================================================================
 // === Layer 2: Audio Engine Implementation                              ===
 // =========================================================================
+
+void CTAG_AudioSource::renderBlock(float* out, size_t numSamples) {
+    // Division (not multiplication by the reciprocal) keeps the int16 round-trip exact.
+    for (size_t i = 0; i < numSamples; ++i) {
+        out[i] = (float)getNextSample() / 32767.0f;
+    }
+}
+
 namespace CTAG_AudioEngine {
-    static CTAG_AudioSource* currentSource = nullptr;
+    static CTAG_AudioSource* volatile _sources[CTAG_AUDIO_MAX_SOURCES] = {};
+    static CTAG_AudioEffect* volatile _effects[CTAG_AUDIO_MAX_EFFECTS] = {};
+    static CTAG_AudioSink*   volatile _sinks[CTAG_AUDIO_MAX_SINKS]     = {};
     static i2s_port_t _i2s_port;
 
+    // Block buffers live in static memory so the audio task stack stays small.
+    static float   _mixBuffer[CTAG_AUDIO_BLOCK_SIZE];
+    static float   _voiceBuffer[CTAG_AUDIO_BLOCK_SIZE];
+    static int16_t _i2sBuffer[CTAG_AUDIO_BLOCK_SIZE * 2];
+
+    static DenormalPolicy _denormalPolicy = DenormalPolicy::FlushToZero;
+    static float          _dcOffset       = 1e-18f; // sign alternates every block
+    static volatile uint32_t _blocksRendered = 0;
+    static volatile uint32_t _nanResets      = 0;
+    static volatile bool     _fpuDirty       = true;
+
+    static CTAG_Limiter  _limiter(SAMPLE_RATE);
+    static volatile bool _limiterEnabled = true;
+    static uint32_t      _clippedBase    = 0; // limiter clip count at the last resetStats()
+    static_assert(CTAG_AUDIO_BLOCK_SIZE % CTAG_Limiter::kLookahead == 0,
+                  "CTAG_AUDIO_BLOCK_SIZE must be a multiple of the limiter look-ahead");
+
+    // --- Deadline watchdog ---
+    static const float kBlockPeriodUs = CTAG_AUDIO_BLOCK_SIZE * 1e6f / SAMPLE_RATE;
+    static const int   kEventLogSize  = 16;
+
+    static volatile bool  _watchdogEnabled = false;
+    static volatile bool  _watchdogRestore = false; // audio task undoes all steps on the next block
+    static WatchdogConfig _wdConfig;
+    static float          _load       = 0.0f;
+    static float          _peakLoad   = 0.0f;
+    static float          _blockLoad  = 0.0f;
+    static volatile uint32_t _patchChanges = 0;
+    static volatile uint32_t _overruns = 0;
+    static DegradeLevel   _level      = DegradeLevel::Normal;
+    static bool           _voiceDropped[CTAG_AUDIO_MAX_SOURCES] = {};
+    static float          _voiceLevel[CTAG_AUDIO_MAX_SOURCES]   = {};
+    static int8_t         _dropOrder[CTAG_AUDIO_MAX_SOURCES];
+    static int            _numDropped      = 0;
+    static bool           _effectsBypassed = false;
+    static bool           _economy         = false;
+    static uint16_t       _holdCounter     = 0;
+    static uint16_t       _recoverCounter  = 0;
+    static WatchdogEvent  _events[kEventLogSize];
+    static volatile uint8_t _eventHead = 0; // written by the audio task
+    static volatile uint8_t _eventTail = 0; // written by pollWatchdogEvent()
+
+    /**
+     * @brief Configures the FPU for the active denormal policy on targets that support it.
+     * @note The ESP32 FPU has no flush-to-zero mode; there protectDenormal() does the work.
+     */
+    static void _applyFpuMode() {
+#if defined(__SSE__)
+        uint32_t csr = _mm_getcsr();
+        if (_denormalPolicy == DenormalPolicy::FlushToZero) csr |= 0x8040;  // FTZ | DAZ
+        else                                                csr &= ~0x8040u;
+        _mm_setcsr(csr);
+#endif
+    }
+
+    /**
+     * @brief Returns true if every sample of the block is finite.
+     * @note x * 0 is 0 for finite x and NaN for NaN/Inf, so a single
+     * accumulator is enough to detect a bad sample anywhere in the block.
+     */
+    static inline bool _isBlockFinite(const float* buf, size_t n) {
+        float acc = 0.0f;
+        for (size_t i = 0; i < n; ++i) acc += buf[i] * 0.0f;
+        return acc == 0.0f;
+    }
+
+    /**
+     * @brief Appends a transition to the watchdog log (dropped if the log is full).
+     */
+    static void _logEvent(WatchdogAction action, int8_t slot) {
+        uint8_t next = (_eventHead + 1) % kEventLogSize;
+        if (next == _eventTail) return;
+        WatchdogEvent& e = _events[_eventHead];
+        e.block  = _blocksRendered;
+        e.action = action;
+        e.slot   = slot;
+        e.level  = _level;
+        e.load   = _load;
+        _eventHead = next;
+    }
+
+    static void _updateLevel() {
+        if (_economy)              _level = DegradeLevel::Economy;
+        else if (_effectsBypassed) _level = DegradeLevel::BypassEffects;
+        else if (_numDropped > 0)  _level = DegradeLevel::DropVoices;
+        else                       _level = DegradeLevel::Normal;
+    }
+
+    static void _setEconomy(bool enabled) {
+        _economy = enabled;
+        for (int v = 0; v < CTAG_AUDIO_MAX_SOURCES; ++v) {
+            CTAG_AudioSource* src = _sources[v];
+            if (src) src->setEconomyMode(enabled);
+        }
+    }
+
+    /**
+     * @brief One degradation step: drop the quietest voice while more than one
+     * plays, then bypass the effects, then switch sources to economy mode.
+     */
+    static void _degradeStep() {
+        if (!_effectsBypassed) {
+            int quietest = -1, active = 0;
+            for (int v = 0; v < CTAG_AUDIO_MAX_SOURCES; ++v) {
+                if (!_sources[v] || _voiceDropped[v]) continue;
+                ++active;
+                if (quietest < 0 || _voiceLevel[v] < _voiceLevel[quietest]) quietest = v;
+            }
+            if (active > 1) {
+                _voiceDropped[quietest] = true;
+                _dropOrder[_numDropped++] = (int8_t)quietest;
+                _updateLevel();
+                _logEvent(WatchdogAction::VoiceDropped, (int8_t)quietest);
+            } else {
+                _effectsBypassed = true;
+                _updateLevel();
+                _logEvent(WatchdogAction::EffectsBypassed, -1);
+            }
+        } else if (!_economy) {
+            _setEconomy(true);
+            _updateLevel();
+            _logEvent(WatchdogAction::EconomyOn, -1);
+        }
+    }
+
+    /**
+     * @brief Undoes the most recent degradation step.
+     */
+    static void _recoverStep() {
+        if (_economy) {
+            _setEconomy(false);
+            _updateLevel();
+            _logEvent(WatchdogAction::EconomyOff, -1);
+        } else if (_effectsBypassed) {
+            _effectsBypassed = false;
+            _updateLevel();
+            _logEvent(WatchdogAction::EffectsRestored, -1);
+        } else if (_numDropped > 0) {
+            int8_t slot = _dropOrder[--_numDropped];
+            _voiceDropped[slot] = false;
+            _updateLevel();
+            _logEvent(WatchdogAction::VoiceRestored, slot);
+        }
+    }
+
+    /**
+     * @brief Runs once per block on the audio task after the load was measured.
+     */
+    static void _runWatchdog() {
+        if (_watchdogRestore) {
+            _watchdogRestore = false;
+            while (_level != DegradeLevel::Normal) _recoverStep();
+        }
+        if (!_watchdogEnabled) return;
+
+        if (_holdCounter) --_holdCounter;
+
+        if (_load > _wdConfig.degradeLoad) {
+            _recoverCounter = 0;
+            if (_holdCounter == 0) {
+                _degradeStep();
+                _holdCounter = _wdConfig.holdBlocks;
+            }
+        } else if (_load < _wdConfig.recoverLoad && _level != DegradeLevel::Normal) {
+            if (++_recoverCounter >= _wdConfig.recoverBlocks) {
+                _recoverStep();
+                _recoverCounter = 0;
+            }
+        } else {
+            _recoverCounter = 0;
+        }
+    }
+
+    /**
+     * @brief Renders one block from the current source into the interleaved I2S buffer.
+     */
+    static void _render() {
+        const uint32_t startUs = micros();
+
+        if (_fpuDirty) {
+            // FPU control state is per task, so it is applied on the rendering task.
+            _applyFpuMode();
+            _fpuDirty = false;
+        }
+
+        // Mix all sources. A source that produced NaN/Inf is reset and left out.
+        memset(_mixBuffer, 0, sizeof(_mixBuffer));
+        for (int v = 0; v < CTAG_AUDIO_MAX_SOURCES; ++v) {
+            CTAG_AudioSource* src = _sources[v];
+            if (!src || _voiceDropped[v]) continue;
+            src->renderBlock(_voiceBuffer, CTAG_AUDIO_BLOCK_SIZE);
+            if (!_isBlockFinite(_voiceBuffer, CTAG_AUDIO_BLOCK_SIZE)) {
+                // One NaN would otherwise silence the voice forever.
+                src->reset();
+                _nanResets = _nanResets + 1;
+                continue;
+            }
+            float peak = 0.0f;
+            for (int i = 0; i < CTAG_AUDIO_BLOCK_SIZE; ++i) {
+                _mixBuffer[i] += _voiceBuffer[i];
+                peak = max(peak, fabsf(_voiceBuffer[i]));
+            }
+            _voiceLevel[v] = peak; // used by the watchdog to find the quietest voice
+
+            for (int k = 0; k < CTAG_AUDIO_MAX_SINKS; ++k) {
+                CTAG_AudioSink* sink = _sinks[k];
+                if (sink) sink->writeVoice((uint8_t)v, _voiceBuffer, CTAG_AUDIO_BLOCK_SIZE);
+            }
+        }
+
+        if (!_effectsBypassed) {
+            for (int i = 0; i < CTAG_AUDIO_MAX_EFFECTS; ++i) {
+                CTAG_AudioEffect* fx = _effects[i];
+                if (fx) fx->process(_mixBuffer, CTAG_AUDIO_BLOCK_SIZE);
+            }
+        }
+
+        if (!_isBlockFinite(_mixBuffer, CTAG_AUDIO_BLOCK_SIZE)) {
+            // A feedback effect went bad; without a reset it would stay silent.
+            for (int i = 0; i < CTAG_AUDIO_MAX_EFFECTS; ++i) {
+                CTAG_AudioEffect* fx = _effects[i];
+                if (fx) fx->reset();
+            }
+            memset(_mixBuffer, 0, sizeof(_mixBuffer));
+            _nanResets = _nanResets + 1;
+        }
+
+        // Master bus: look-ahead limiter + soft clipper, then saturating conversion.
+        if (_limiterEnabled) _limiter.process(_mixBuffer, CTAG_AUDIO_BLOCK_SIZE);
+
+        for (int i = 0; i < CTAG_AUDIO_BLOCK_SIZE; ++i) {
+            float x = constrain(_mixBuffer[i], -1.0f, 1.0f);
+            _mixBuffer[i] = x;
+            int16_t s = (int16_t)(x * 32767.0f);
+            _i2sBuffer[2*i  ] = s;
+            _i2sBuffer[2*i+1] = s;
+        }
+
+        for (int k = 0; k < CTAG_AUDIO_MAX_SINKS; ++k) {
+            CTAG_AudioSink* sink = _sinks[k];
+            if (sink) sink->writeMaster(_mixBuffer, CTAG_AUDIO_BLOCK_SIZE);
+        }
+
+        _dcOffset = -_dcOffset;
+        _blocksRendered = _blocksRendered + 1;
+
+        // Render time against the block period (the I2S deadline).
+        float blockLoad = (float)(micros() - startUs) / kBlockPeriodUs;
+        _blockLoad = blockLoad;
+        _load += 0.1f * (blockLoad - _load);
+        if (blockLoad > _peakLoad) _peakLoad = blockLoad;
+        if (blockLoad > 1.0f) _overruns = _overruns + 1;
+        _runWatchdog();
+    }
 
     static void audio_task(void* /*params*/) {
-        const int buffer_samples = 256;
-        int16_t i2s_buffer[buffer_samples * 2];
         size_t bytes_written = 0;
         while (true) {
-            for (int i = 0; i < buffer_samples * 2; i += 2) {
-                int16_t s = currentSource ? currentSource->getNextSample() : 0;
-                i2s_buffer[i]     = s;
-                i2s_buffer[i + 1] = s;
-            }
+            _render();
             i2s_write(_i2s_port,
-                      i2s_buffer,
-                      sizeof(i2s_buffer),
+                      _i2sBuffer,
+                      sizeof(_i2sBuffer),
                       &bytes_written,
                       portMAX_DELAY);
         }
@@ -132,7 +395,93 @@ namespace CTAG_AudioEngine {
     }
 
     void setSource(CTAG_AudioSource* source) {
-        currentSource = source;
+        for (int i = 1; i < CTAG_AUDIO_MAX_SOURCES; ++i) _sources[i] = nullptr;
+        _sources[0] = source;
+        // A new patch starts at full quality.
+        _watchdogRestore = true;
+        _patchChanges = _patchChanges + 1;
+    }
+
+    bool addSource(CTAG_AudioSource* source) {
+        if (!source) return false;
+        if (_economy) source->setEconomyMode(true);
+        for (int i = 0; i < CTAG_AUDIO_MAX_SOURCES; ++i) {
+            // Slots of dropped voices stay reserved until the watchdog restores them.
+            if (!_sources[i] && !_voiceDropped[i]) {
+                _sources[i] = source;
+                _patchChanges = _patchChanges + 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void removeSource(CTAG_AudioSource* source) {
+        for (int i = 0; i < CTAG_AUDIO_MAX_SOURCES; ++i) {
+            if (_sources[i] == source) _sources[i] = nullptr;
+        }
+        if (source && _economy) source->setEconomyMode(false);
+        _patchChanges = _patchChanges + 1;
+    }
+
+    void setWatchdogEnabled(bool enabled) {
+        _watchdogEnabled = enabled;
+        if (!enabled) _watchdogRestore = true;
+    }
+
+    void setWatchdogConfig(const WatchdogConfig& config) {
+        _wdConfig = config;
+    }
+
+    bool pollWatchdogEvent(WatchdogEvent& event) {
+        if (_eventTail == _eventHead) return false;
+        event = _events[_eventTail];
+        _eventTail = (_eventTail + 1) % kEventLogSize;
+        return true;
+    }
+
+    void setLimiterEnabled(bool enabled) {
+        _limiterEnabled = enabled;
+    }
+
+    void setLimiterCeiling(float dBFS) {
+        _limiter.setCeiling(dBFS);
+    }
+
+    bool addEffect(CTAG_AudioEffect* effect) {
+        if (!effect) return false;
+        for (int i = 0; i < CTAG_AUDIO_MAX_EFFECTS; ++i) {
+            if (!_effects[i]) {
+                _effects[i] = effect;
+                _patchChanges = _patchChanges + 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void removeEffect(CTAG_AudioEffect* effect) {
+        for (int i = 0; i < CTAG_AUDIO_MAX_EFFECTS; ++i) {
+            if (_effects[i] == effect) _effects[i] = nullptr;
+        }
+        _patchChanges = _patchChanges + 1;
+    }
+
+    bool addSink(CTAG_AudioSink* sink) {
+        if (!sink) return false;
+        for (int i = 0; i < CTAG_AUDIO_MAX_SINKS; ++i) {
+            if (!_sinks[i]) {
+                _sinks[i] = sink;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void removeSink(CTAG_AudioSink* sink) {
+        for (int i = 0; i < CTAG_AUDIO_MAX_SINKS; ++i) {
+            if (_sinks[i] == sink) _sinks[i] = nullptr;
+        }
     }
 
     void begin() {
@@ -141,20 +490,58 @@ namespace CTAG_AudioEngine {
     }
 
     void renderBlock() {
-        const int buffer_samples = 256;
-        int16_t buf[buffer_samples * 2];
-        size_t  written;
-        for (int i = 0; i < buffer_samples; ++i) {
-            int16_t s = currentSource ? currentSource->getNextSample() : 0;
-            buf[2*i  ] = s;
-            buf[2*i+1] = s;
-        }
-        i2s_write(_i2s_port, buf, sizeof(buf), &written, portMAX_DELAY);
+        size_t written;
+        _render();
+        i2s_write(_i2s_port, _i2sBuffer, sizeof(_i2sBuffer), &written, portMAX_DELAY);
     }
 
     void audioLoop() {
         while (true) renderBlock();
     }
+
+    void setDenormalPolicy(DenormalPolicy policy) {
+        _denormalPolicy = policy;
+        _fpuDirty = true;
+    }
+
+    DenormalPolicy getDenormalPolicy() {
+        return _denormalPolicy;
+    }
+
+    float protectDenormal(float x) {
+        switch (_denormalPolicy) {
+            case DenormalPolicy::FlushToZero:
+                return (fabsf(x) < 1e-15f) ? 0.0f : x;
+            case DenormalPolicy::DcOffset:
+                return x + _dcOffset;
+            default:
+                return x;
+        }
+    }
+
+    Stats getStats() {
+        Stats s;
+        s.blocksRendered  = _blocksRendered;
+        s.nanResets       = _nanResets;
+        s.gainReductionDb = _limiter.getGainReductionDb();
+        s.clippedSamples  = _limiter.getClippedSamples() - _clippedBase;
+        s.dspLoad         = _load;
+        s.peakLoad        = _peakLoad;
+        s.overruns        = _overruns;
+        s.degradeLevel    = (uint8_t)_level;
+        s.blockLoad       = _blockLoad;
+        s.patchChanges    = _patchChanges;
+        return s;
+    }
+
+    void resetStats() {
+        _blocksRendered = 0;
+        _nanResets      = 0;
+        _clippedBase    = _limiter.getClippedSamples();
+        _peakLoad       = 0.0f;
+        _overruns       = 0;
+        _patchChanges   = 0;
+    }
 }
 
 // =========================================================================
@@ -196,19 +583,58 @@ void CTAG_VCO_Sine::setLfoDepth(float depth) {
     _lfoDepth = depth;
 }
 
+void CTAG_VCO_Sine::reset() {
+    _phase    = 0.0f;
+    _lfoPhase = 0.0f;
+}
+
+const CTAG_PluginDesc* CTAG_VCO_Sine::getPluginDesc() const {
+    return &CTAG_SourceParams::kPlugins[CTAG_SourceParams::kSine];
+}
+
+void CTAG_VCO_Sine::setParam(uint8_t id, float value) {
+    switch (id) {
+        case CTAG_SourceParams::kFrequency: setFrequency(value); break;
+        case CTAG_SourceParams::kAmplitude: setAmplitude(value); break;
+        case CTAG_SourceParams::kLfoRate:   setLfoRate(value);   break;
+        case CTAG_SourceParams::kLfoDepth:  setLfoDepth(value);  break;
+    }
+}
+
 int16_t CTAG_VCO_Sine::getNextSample() {
+    return (int16_t)(_tick() * 32767.0f);
+}
+
+void CTAG_VCO_Sine::renderBlock(float* out, size_t numSamples) {
+    for (size_t i = 0; i < numSamples; ++i) out[i] = _tick();
+}
+
+/**
+ * @brief Parabolic sine approximation with one refinement step, for economy mode.
+ * @param x Phase in radians (any range).
+ */
+static inline float _fastSin(float x) {
+    const float invTwoPi = 0.15915494f;
+    // Range-reduce to [-pi, pi)
+    x -= 2.0f * (float)M_PI * floorf(x * invTwoPi + 0.5f);
+    float y = 1.2732395f * x - 0.40528473f * x * fabsf(x);
+    return 0.225f * (y * fabsf(y) - y) + y;
+}
+
+float CTAG_VCO_Sine::_tick() {
     // Advance LFO
     _lfoPhase += _lfoIncrement;
     if (_lfoPhase >= 2.0f * M_PI) _lfoPhase -= 2.0f * M_PI;
-    float vibrato = sin(_lfoPhase) * _lfoDepth;
+    float vibrato = (_lfoDepth != 0.0f)
+        ? (_economy ? _fastSin(_lfoPhase) : sin(_lfoPhase)) * _lfoDepth
+        : 0.0f;
 
     // Instantaneous phase increment with vibrato
     float instIncrement = (2.0f * M_PI * (_frequency + vibrato)) / _sampleRate;
     _phase += instIncrement;
     if (_phase >= 2.0f * M_PI) _phase -= 2.0f * M_PI;
 
-    float out = sin(_phase) * _amplitude;
-    return (int16_t)(out * 32767.0f);
+    return (_economy ? _fastSin(_phase) : sin(_phase)) * _amplitude;
 }
 
 // --- CTAG_VCO_Square with Pulse-Width Control ---
@@ -240,7 +666,31 @@ void CTAG_VCO_Square::setDutyCycle(float duty) {
     _dutyCycle = constrain(duty, 0.05f, 0.95f);
 }
 
+void CTAG_VCO_Square::reset() {
+    _phase = 0.0f;
+}
+
+const CTAG_PluginDesc* CTAG_VCO_Square::getPluginDesc() const {
+    return &CTAG_SourceParams::kPlugins[CTAG_SourceParams::kSquare];
+}
+
+void CTAG_VCO_Square::setParam(uint8_t id, float value) {
+    switch (id) {
+        case CTAG_SourceParams::kFrequency: setFrequency(value); break;
+        case CTAG_SourceParams::kAmplitude: setAmplitude(value); break;
+        case CTAG_SourceParams::kDutyCycle: setDutyCycle(value); break;
+    }
+}
+
 int16_t CTAG_VCO_Square::getNextSample() {
+    return (int16_t)(_tick() * 32767.0f);
+}
+
+void CTAG_VCO_Square::renderBlock(float* out, size_t numSamples) {
+    for (size_t i = 0; i < numSamples; ++i) out[i] = _tick();
+}
+
+float CTAG_VCO_Square::_tick() {
     // Advance phase
     _phase += _phaseIncrement;
     if (_phase >= 2.0f * M_PI) {
@@ -249,10 +699,8 @@ int16_t CTAG_VCO_Square::getNextSample() {
 
     // Output high for the first portion of the cycle,
     // then low for the remainder, scaled by amplitude.
-    float out = (_phase < (2.0f * M_PI * _dutyCycle) ? 1.0f : -1.0f)
-                * _amplitude;
-
-    return (int16_t)(out * 32767.0f);
+    return (_phase < (2.0f * M_PI * _dutyCycle) ? 1.0f : -1.0f)
+           * _amplitude;
 }
 
 // --- CTAG_VCO_Saw with Skew Control ---
@@ -283,7 +731,31 @@ void CTAG_VCO_Saw::setSkew(float skew) {
     _skew = constrain(skew, 0.01f, 0.99f);
 }
 
+void CTAG_VCO_Saw::reset() {
+    _phase = 0.0f;
+}
+
+const CTAG_PluginDesc* CTAG_VCO_Saw::getPluginDesc() const {
+    return &CTAG_SourceParams::kPlugins[CTAG_SourceParams::kSaw];
+}
+
+void CTAG_VCO_Saw::setParam(uint8_t id, float value) {
+    switch (id) {
+        case CTAG_SourceParams::kFrequency: setFrequency(value); break;
+        case CTAG_SourceParams::kAmplitude: setAmplitude(value); break;
+        case CTAG_SourceParams::kSkew:      setSkew(value);      break;
+    }
+}
+
 int16_t CTAG_VCO_Saw::getNextSample() {
+    return (int16_t)(_tick() * 32767.0f);
+}
+
+void CTAG_VCO_Saw::renderBlock(float* out, size_t numSamples) {
+    for (size_t i = 0; i < numSamples; ++i) out[i] = _tick();
+}
+
+float CTAG_VCO_Saw::_tick() {
     // Advance phase
     _phase += _phaseIncrement;
     if (_phase >= 2.0f * M_PI) {
@@ -302,10 +774,7 @@ int16_t CTAG_VCO_Saw::getNextSample() {
     }
 
     // Apply amplitude
-    out *= _amplitude;
-
-    // Convert to 16-bit
-    return (int16_t)(out * 32767.0f);
+    return out * _amplitude;
 }
 
 
@@ -342,16 +811,41 @@ void CTAG_FMSynth::setAmplitude(float amp) {
     _amplitude = constrain(amp, 0.0f, 1.0f);
 }
 
+void CTAG_FMSynth::reset() {
+    _carrierPhase = 0.0f;
+    _modPhase     = 0.0f;
+}
+
+const CTAG_PluginDesc* CTAG_FMSynth::getPluginDesc() const {
+    return &CTAG_SourceParams::kPlugins[CTAG_SourceParams::kFM];
+}
+
+void CTAG_FMSynth::setParam(uint8_t id, float value) {
+    switch (id) {
+        case CTAG_SourceParams::kFrequency: setCarrierFreq(value); break;
+        case CTAG_SourceParams::kAmplitude: setAmplitude(value);   break;
+        case CTAG_SourceParams::kModFreq:   setModFreq(value);     break;
+        case CTAG_SourceParams::kModIndex:  setModIndex(value);    break;
+    }
+}
+
 int16_t CTAG_FMSynth::getNextSample() {
+    return (int16_t)(_tick() * 32767.0f);
+}
+
+void CTAG_FMSynth::renderBlock(float* out, size_t numSamples) {
+    for (size_t i = 0; i < numSamples; ++i) out[i] = _tick();
+}
+
+float CTAG_FMSynth::_tick() {
     // advance modulator
     _modPhase += _modInc;
     if (_modPhase >= 2.0f * M_PI) _modPhase -= 2.0f * M_PI;
-    float mod = sin(_modPhase) * _modIndex;
+    float mod = (_economy ? _fastSin(_modPhase) : sin(_modPhase)) * _modIndex;
 
     // advance carrier, including FM
     _carrierPhase += _carrierInc + mod;
     if (_carrierPhase >= 2.0f * M_PI) _carrierPhase -= 2.0f * M_PI;
 
-    float out = sin(_carrierPhase) * _amplitude;
-    return (int16_t)(out * 32767.0f);
+    return (_economy ? _fastSin(_carrierPhase) : sin(_carrierPhase)) * _amplitude;
 }
\ No newline at end of file
@@ -8,7 +8,9 @@
  * This file defines the public interface for the three main components of the library:
  * 1. CTAG_AudioCodec: A low-level driver for the audio codec hardware.
  * 2. CTAG_AudioSource: An abstract base class for creating audio-generating "plugins".
- * 3. CTAG_AudioEngine: The main engine that handles I2S streaming and processing.
+ * 3. CTAG_AudioEffect: An abstract base class for in-place block processors (delay, reverb, ...).
+ * 4. CTAG_AudioSink: An abstract base class for taps that receive the rendered audio (USB, recorder, ...).
+ * 5. CTAG_AudioEngine: The main engine that handles I2S streaming and processing.
  */
 #pragma once
 #ifndef CTAG_AUDIO_H
@@ -19,7 +21,42 @@
 #include "driver/i2s.h"
 #include <math.h>
 #include <vector>
-    
+#include <CTAG_Params.h>
+
+/**
+ * @brief Sample rate of the engine and the codec in Hz.
+ */
+#define CTAG_AUDIO_SAMPLE_RATE 44100
+
+/**
+ * @brief Number of frames the engine renders per block.
+ * @note Can be overridden before including this header.
+ */
+#ifndef CTAG_AUDIO_BLOCK_SIZE
+#define CTAG_AUDIO_BLOCK_SIZE 256
+#endif
+
+/**
+ * @brief Maximum number of sources the engine mixes.
+ */
+#ifndef CTAG_AUDIO_MAX_SOURCES
+#define CTAG_AUDIO_MAX_SOURCES 8
+#endif
+
+/**
+ * @brief Maximum number of effects in the engine's master chain.
+ */
+#ifndef CTAG_AUDIO_MAX_EFFECTS
+#define CTAG_AUDIO_MAX_EFFECTS 4
+#endif
+
+/**
+ * @brief Maximum number of sinks attached to the engine.
+ */
+#ifndef CTAG_AUDIO_MAX_SINKS
+#define CTAG_AUDIO_MAX_SINKS 2
+#endif
+
 
 // =========================================================================
 // === Layer 1: The Codec Driver                                         ===
@@ -79,6 +116,96 @@ public:
      * @return A 16-bit signed audio sample (-32768 to 32767).
      */
     virtual int16_t getNextSample() = 0;
+
+    /**
+     * @brief Renders a block of normalized float samples (-1.0 to 1.0).
+     * @note The default implementation pulls getNextSample() once per frame,
+     * so existing plugins keep working. Override it for block-based rendering.
+     * @param out Destination buffer.
+     * @param numSamples Number of samples to render.
+     */
+    virtual void renderBlock(float* out, size_t numSamples);
+
+    /**
+     * @brief Returns the source to a clean initial state (phases, filter memories).
+     * @note Called by the engine when this source produced NaN or Inf samples.
+     */
+    virtual void reset() {}
+
+    /**
+     * @brief Switches the source to a cheaper, lower-quality rendering mode.
+     * @note Called by the engine's deadline watchdog under overload. Sources
+     * without a cheaper mode can ignore it.
+     * @param enabled True to enable economy mode.
+     */
+    virtual void setEconomyMode(bool enabled) { (void)enabled; }
+
+    /**
+     * @brief Describes the source's parameters (see CTAG_Params).
+     * @return The plugin descriptor, or nullptr if the source has none.
+     */
+    virtual const CTAG_PluginDesc* getPluginDesc() const { return nullptr; }
+
+    /**
+     * @brief Sets a parameter by its descriptor ID.
+     * @param id Parameter ID from getPluginDesc().
+     * @param value Value in the parameter's unit, within its range.
+     */
+    virtual void setParam(uint8_t id, float value) { (void)id; (void)value; }
+};
+
+
+/**
+ * @class CTAG_AudioEffect
+ * @brief Abstract base class for effects that process a block in place.
+ * @note Effects run on the audio task after the source, in the order they were added.
+ */
+class CTAG_AudioEffect {
+public:
+    virtual ~CTAG_AudioEffect() {}
+
+    /**
+     * @brief Processes a block of normalized float samples in place.
+     * @param buffer The samples to process.
+     * @param numSamples Number of samples (at most CTAG_AUDIO_BLOCK_SIZE).
+     */
+    virtual void process(float* buffer, size_t numSamples) = 0;
+
+    /**
+     * @brief Clears all internal state (delay lines, filter memories).
+     * @note Called by the engine when the output turned NaN or Inf.
+     */
+    virtual void reset() {}
+};
+
+
+/**
+ * @class CTAG_AudioSink
+ * @brief Abstract base class for consumers of the rendered audio.
+ * @note Sinks are called on the audio task and must not block. Hand the data
+ * over to another task (e.g. through a ring buffer) for anything slow.
+ */
+class CTAG_AudioSink {
+public:
+    virtual ~CTAG_AudioSink() {}
+
+    /**
+     * @brief Receives the block of one source before it is mixed.
+     * @note Only called for sources that actually played in this block.
+     * @param slot Source slot (0 … CTAG_AUDIO_MAX_SOURCES - 1).
+     * @param block Normalized float samples.
+     * @param numSamples Number of samples.
+     */
+    virtual void writeVoice(uint8_t slot, const float* block, size_t numSamples) {
+        (void)slot; (void)block; (void)numSamples;
+    }
+
+    /**
+     * @brief Receives the finished master block (after effects and limiter).
+     * @param block Normalized float samples in [-1, 1].
+     * @param numSamples Number of samples.
+     */
+    virtual void writeMaster(const float* block, size_t numSamples) = 0;
 };
 
 
@@ -95,9 +222,43 @@ namespace CTAG_AudioEngine {
 
     /**
      * @brief Pick which CTAG_AudioSource to pull samples from.
+     * @note Replaces all sources added with addSource().
      */
     void setSource(CTAG_AudioSource* source);
 
+    /**
+     * @brief Adds a source to the mix.
+     * @return False if the mix is full (CTAG_AUDIO_MAX_SOURCES) or source is nullptr.
+     */
+    bool addSource(CTAG_AudioSource* source);
+
+    /**
+     * @brief Removes a source from the mix.
+     */
+    void removeSource(CTAG_AudioSource* source);
+
+    /**
+     * @brief Appends an effect to the master chain.
+     * @return False if the chain is full (CTAG_AUDIO_MAX_EFFECTS) or effect is nullptr.
+     */
+    bool addEffect(CTAG_AudioEffect* effect);
+
+    /**
+     * @brief Removes an effect from the master chain.
+     */
+    void removeEffect(CTAG_AudioEffect* effect);
+
+    /**
+     * @brief Attaches a sink that receives every rendered block.
+     * @return False if all sink slots (CTAG_AUDIO_MAX_SINKS) are used or sink is nullptr.
+     */
+    bool addSink(CTAG_AudioSink* sink);
+
+    /**
+     * @brief Detaches a sink.
+     */
+    void removeSink(CTAG_AudioSink* sink);
+
     /**
      * @brief Blocking call that never returns:
      *        streams audio forever on the calling task/thread.
@@ -110,6 +271,137 @@ namespace CTAG_AudioEngine {
 
 
     void audioLoop() __attribute__((deprecated));
+
+    /**
+     * @brief Strategy used against denormal numbers in float feedback paths.
+     */
+    enum class DenormalPolicy : uint8_t {
+        None,        ///< No protection.
+        FlushToZero, ///< Values below the denormal threshold are flushed to 0.
+        DcOffset     ///< A tiny alternating offset is injected into feedback paths.
+    };
+
+    /**
+     * @brief Instrumentation counters of the engine.
+     */
+    struct Stats {
+        uint32_t blocksRendered;  ///< Number of blocks rendered since start/reset.
+        uint32_t nanResets;       ///< Number of blocks with NaN/Inf that caused a source/effect reset.
+        float    gainReductionDb; ///< Master limiter gain reduction during the last block (dB).
+        uint32_t clippedSamples;  ///< Samples that hit the master soft clipper since start/reset.
+        float    dspLoad;         ///< Smoothed render time / block period (1.0 = deadline).
+        float    peakLoad;        ///< Highest single-block load since start/reset.
+        uint32_t overruns;        ///< Blocks whose render time exceeded the block period.
+        uint8_t  degradeLevel;    ///< Current DegradeLevel of the watchdog.
+        float    blockLoad;       ///< Load of the last block alone (unsmoothed).
+        uint32_t patchChanges;    ///< Source or effect changes since start/reset.
+    };
+
+    /**
+     * @brief Degradation steps of the deadline watchdog, from mild to severe.
+     */
+    enum class DegradeLevel : uint8_t {
+        Normal,        ///< Everything runs.
+        DropVoices,    ///< The quietest sources are muted one by one.
+        BypassEffects, ///< Additionally, the effect chain is bypassed.
+        Economy        ///< Additionally, sources run in their cheaper economy mode.
+    };
+
+    /**
+     * @brief Thresholds of the deadline watchdog.
+     */
+    struct WatchdogConfig {
+        float    degradeLoad   = 0.85f; ///< Smoothed load above which the engine degrades one step.
+        float    recoverLoad   = 0.60f; ///< Smoothed load below which the engine may recover one step.
+        uint16_t holdBlocks    = 8;     ///< Minimum blocks between two degrade steps.
+        uint16_t recoverBlocks = 200;   ///< Blocks below recoverLoad before one step is undone.
+    };
+
+    /**
+     * @brief What a watchdog transition did.
+     */
+    enum class WatchdogAction : uint8_t {
+        VoiceDropped,
+        VoiceRestored,
+        EffectsBypassed,
+        EffectsRestored,
+        EconomyOn,
+        EconomyOff
+    };
+
+    /**
+     * @brief Log entry of one watchdog transition.
+     */
+    struct WatchdogEvent {
+        uint32_t       block;  ///< Block counter when the transition happened.
+        WatchdogAction action; ///< The transition.
+        int8_t         slot;   ///< Source slot for voice transitions, -1 otherwise.
+        DegradeLevel   level;  ///< Level after the transition.
+        float          load;   ///< Smoothed load that triggered it.
+    };
+
+    /**
+     * @brief Enables the deadline watchdog (default: disabled).
+     * @note Load is measured in either case and reported through getStats().
+     * Disabling it restores all voices, effects and full-quality mode.
+     */
+    void setWatchdogEnabled(bool enabled);
+
+    /**
+     * @brief Sets the watchdog thresholds.
+     */
+    void setWatchdogConfig(const WatchdogConfig& config);
+
+    /**
+     * @brief Fetches the oldest logged watchdog transition.
+     * @note The log holds up to 15 unread transitions (newer ones are lost
+     * while it is full) and is meant to be polled from a non-audio task.
+     * @param event Receives the transition.
+     * @return False if no transition is pending.
+     */
+    bool pollWatchdogEvent(WatchdogEvent& event);
+
+    /**
+     * @brief Enables the master-bus limiter and soft clipper (default: enabled).
+     * @note The limiter adds CTAG_Limiter::kLookahead samples of latency.
+     * The final int16 conversion saturates in either case.
+     */
+    void setLimiterEnabled(bool enabled);
+
+    /**
+     * @brief Sets the master limiter ceiling.
+     * @param dBFS Ceiling in dBFS (-12 … -0.2, default -1).
+     */
+    void setLimiterCeiling(float dBFS);
+
+    /**
+     * @brief Selects the denormal protection policy (default: FlushToZero).
+     */
+    void setDenormalPolicy(DenormalPolicy policy);
+
+    /**
+     * @brief Returns the active denormal protection policy.
+     */
+    DenormalPolicy getDenormalPolicy();
+
+    /**
+     * @brief Applies the active denormal policy to a feedback state variable.
+     * @note Sources with recursive float state (filters, feedback FM, reverbs)
+     * should pass their state through this once per block.
+     * @param x The state value.
+     * @return The protected value.
+     */
+    float protectDenormal(float x);
+
+    /**
+     * @brief Returns a snapshot of the engine counters.
+     */
+    Stats getStats();
+
+    /**
+     * @brief Resets all engine counters to zero.
+     */
+    void resetStats();
 }
 
 
@@ -169,7 +461,32 @@ public:
      */
     int16_t getNextSample() override;
 
+    /**
+     * @brief Renders a block of normalized float samples.
+     */
+    void renderBlock(float* out, size_t numSamples) override;
+
+    /**
+     * @brief Resets oscillator and LFO phases.
+     */
+    void reset() override;
+
+    /**
+     * @brief Replaces sin() by a parabolic approximation (max. error about 0.1 %).
+     */
+    void setEconomyMode(bool enabled) override { _economy = enabled; }
+
+    /**
+     * @brief Parameters as listed in CTAG_SourceParams.
+     */
+    const CTAG_PluginDesc* getPluginDesc() const override;
+    void setParam(uint8_t id, float value) override;
+
 private:
+    float _tick();
+
+    volatile bool _economy = false;
+
     float _sampleRate;
     float _frequency;
     float _amplitude;
@@ -226,7 +543,25 @@ public:
      */
     int16_t getNextSample() override;
 
+    /**
+     * @brief Renders a block of normalized float samples.
+     */
+    void renderBlock(float* out, size_t numSamples) override;
+
+    /**
+     * @brief Resets the oscillator phase.
+     */
+    void reset() override;
+
+    /**
+     * @brief Parameters as listed in CTAG_SourceParams.
+     */
+    const CTAG_PluginDesc* getPluginDesc() const override;
+    void setParam(uint8_t id, float value) override;
+
 private:
+    float _tick();
+
     float _sampleRate;
     float _frequency;
     float _amplitude;
@@ -280,7 +615,25 @@ public:
      */
     int16_t getNextSample() override;
 
+    /**
+     * @brief Renders a block of normalized float samples.
+     */
+    void renderBlock(float* out, size_t numSamples) override;
+
+    /**
+     * @brief Resets the oscillator phase.
+     */
+    void reset() override;
+
+    /**
+     * @brief Parameters as listed in CTAG_SourceParams.
+     */
+    const CTAG_PluginDesc* getPluginDesc() const override;
+    void setParam(uint8_t id, float value) override;
+
 private:
+    float _tick();
+
     float _sampleRate;
     float _frequency;
     float _amplitude;
@@ -340,7 +693,32 @@ public:
      */
     int16_t getNextSample() override;
 
+    /**
+     * @brief Renders a block of normalized float samples.
+     */
+    void renderBlock(float* out, size_t numSamples) override;
+
+    /**
+     * @brief Resets carrier and modulator phases.
+     */
+    void reset() override;
+
+    /**
+     * @brief Replaces sin() by a parabolic approximation (max. error about 0.1 %).
+     */
+    void setEconomyMode(bool enabled) override { _economy = enabled; }
+
+    /**
+     * @brief Parameters as listed in CTAG_SourceParams.
+     */
+    const CTAG_PluginDesc* getPluginDesc() const override;
+    void setParam(uint8_t id, float value) override;
+
 private:
+    float _tick();
+
+    volatile bool _economy = false;
+
     float _sampleRate;
 
     float _carrierFreq;
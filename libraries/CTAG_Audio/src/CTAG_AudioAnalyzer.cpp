@@ -0,0 +1,278 @@
+/**
+ * @file CTAG_AudioAnalyzer.cpp
+ * @brief Implementation of the spectrum analyzer tap.
+ */
+#include "CTAG_AudioAnalyzer.h"
+
+CTAG_AudioAnalyzer::CTAG_AudioAnalyzer() {
+    for (auto& db : _bandDb) db = kFloorDb;
+}
+
+CTAG_AudioAnalyzer::~CTAG_AudioAnalyzer() {
+    _stopTask();
+    if (_mem) CTAG_AudioMemory::release(_mem);
+}
+
+bool CTAG_AudioAnalyzer::begin(size_t fftSize, uint16_t hopBlocks, BaseType_t core) {
+    if (_taskHandle) return true;
+    if (fftSize < 256 || fftSize > 4096 || (fftSize & (fftSize - 1)) || hopBlocks == 0) return false;
+
+    _size = fftSize;
+    _half = fftSize / 2;
+    _hopBlocks  = hopBlocks;
+    size_t windowBlocks = (fftSize + CTAG_AUDIO_BLOCK_SIZE - 1) / CTAG_AUDIO_BLOCK_SIZE;
+    _pushBlocks = (uint16_t)min((size_t)hopBlocks, windowBlocks);
+    _blockCount = 0;
+
+    // Room for two hops' worth of pushed blocks, so one analysis may run late.
+    if (!_fifo.begin(2 * _pushBlocks * CTAG_AUDIO_BLOCK_SIZE, 1, CTAG_AudioMemory::Region::Internal)) return false;
+
+    const size_t N = _size, M = _half;
+    size_t floats = N            // window
+                  + 2 * M        // work
+                  + M            // power
+                  + M            // twiddle (M / 2 complex)
+                  + M + 2;       // split (M / 2 + 1 complex)
+    size_t bytes = floats * sizeof(float) + N * sizeof(int16_t);
+    _mem = CTAG_AudioMemory::allocate(bytes, CTAG_AudioMemory::Region::Internal);
+    if (!_mem) {
+        _fifo.end();
+        return false;
+    }
+
+    float* p = (float*)_mem;
+    _window  = p; p += N;
+    _work    = p; p += 2 * M;
+    _power   = p; p += M;
+    _twiddle = p; p += M;
+    _split   = p; p += M + 2;
+    _history = (int16_t*)p;
+    memset(_history, 0, N * sizeof(int16_t));
+    _histPos = 0;
+    _newSamples = 0;
+
+    // Periodic Hann window; the 1/N and coherent-gain scaling is folded in
+    // here so that a full-scale sine reads about 0 dB in its band.
+    const float scale = 4.0f / (float)N;
+    for (size_t n = 0; n < N; ++n) {
+        _window[n] = scale * 0.5f * (1.0f - cosf(2.0f * (float)M_PI * n / N));
+    }
+    for (size_t k = 0; k < M / 2; ++k) {
+        _twiddle[2 * k]     =  cosf(2.0f * (float)M_PI * k / M);
+        _twiddle[2 * k + 1] = -sinf(2.0f * (float)M_PI * k / M);
+    }
+    for (size_t k = 0; k <= M / 2; ++k) {
+        _split[2 * k]     =  cosf(2.0f * (float)M_PI * k / N);
+        _split[2 * k + 1] = -sinf(2.0f * (float)M_PI * k / N);
+    }
+
+    // Band edges in bins. Bands narrower than a bin fall back to the bin
+    // nearest their centre, so neighbouring low bands may show the same bin.
+    const float binHz = (float)CTAG_AUDIO_SAMPLE_RATE / N;
+    const float hi    = min(kMaxFreq, CTAG_AUDIO_SAMPLE_RATE * 0.5f);
+    const float ratio = powf(hi / kMinFreq, 1.0f / CTAG_ANALYZER_BANDS);
+    float lo = kMinFreq;
+    for (int b = 0; b < CTAG_ANALYZER_BANDS; ++b) {
+        float up    = lo * ratio;
+        int   first = (int)ceilf(lo / binHz);
+        int   last  = (int)floorf(up / binHz);
+        if (last < first) first = last = (int)lrintf(sqrtf(lo * up) / binHz);
+        _bandFirst[b] = (uint16_t)constrain(first, 1, (int)M - 1);
+        _bandLast[b]  = (uint16_t)constrain(last, (int)_bandFirst[b], (int)M - 1);
+        lo = up;
+    }
+
+    if (!_startTask("Analyzer", core)) {
+        CTAG_AudioMemory::release(_mem);
+        _mem = nullptr;
+        _fifo.end();
+        return false;
+    }
+    return true;
+}
+
+void CTAG_AudioAnalyzer::setRelease(float dbPerSecond) {
+    _release = max(dbPerSecond, 0.0f);
+}
+
+void CTAG_AudioAnalyzer::setCallback(Callback cb, void* arg) {
+    _setCallback(_cb, _cbArg, cb, arg);
+}
+
+uint32_t CTAG_AudioAnalyzer::getLevels(uint8_t* levels) const {
+    // A copy taken while the task updates may mix two analyses, which is
+    // invisible on a bar display.
+    memcpy(levels, _levels, CTAG_ANALYZER_BANDS);
+    return _analyses;
+}
+
+size_t CTAG_AudioAnalyzer::packSpectrum(uint8_t* dst) const {
+    dst[0] = kSpectrumMsgId;
+    dst[1] = CTAG_ANALYZER_BANDS;
+    memcpy(dst + 2, _levels, CTAG_ANALYZER_BANDS);
+    return kSpectrumMsgLen;
+}
+
+CTAG_AudioAnalyzer::Stats CTAG_AudioAnalyzer::getStats() const {
+    Stats s;
+    s.analyses      = _analyses;
+    s.droppedBlocks = _droppedBlocks;
+    s.lastUs        = _lastUs;
+    s.maxUs         = _maxUs;
+    float hopUs = _hopBlocks * CTAG_AUDIO_BLOCK_SIZE * 1e6f / CTAG_AUDIO_SAMPLE_RATE;
+    s.load = _hopBlocks ? _avgUs / hopUs : 0.0f;
+    return s;
+}
+
+
+// --- Audio task ---
+
+void CTAG_AudioAnalyzer::writeMaster(const float* block, size_t numSamples) {
+    CTAG_AudioTap::writeMaster(block, numSamples);
+    // The master is written once per block, so it also advances the hop.
+    if (++_blockCount >= _hopBlocks) _blockCount = 0;
+}
+
+void CTAG_AudioAnalyzer::_push(const float* block, size_t numSamples) {
+    // Only the blocks that end up in the next window are copied.
+    if (!_taskHandle || _blockCount < _hopBlocks - _pushBlocks) return;
+
+    if (_fifo.space() < numSamples) {
+        _droppedBlocks = _droppedBlocks + 1;
+        return;
+    }
+
+    _fifo.writeFloat(block, numSamples);
+}
+
+
+// --- Analyzer task ---
+
+void CTAG_AudioAnalyzer::_taskLoop() {
+    const size_t hopSamples = (size_t)_pushBlocks * CTAG_AUDIO_BLOCK_SIZE;
+    while (true) {
+        // Move everything that arrived into the history ring.
+        size_t n;
+        while ((n = _fifo.read(_history + _histPos, _size - _histPos)) > 0) {
+            _histPos = (_histPos + n) & (_size - 1);
+            _newSamples += n;
+        }
+
+        if (_newSamples >= hopSamples) {
+            // A backlog is skipped rather than analyzed twice.
+            _newSamples = 0;
+            uint32_t t0 = micros();
+            _analyze();
+            uint32_t dt = micros() - t0;
+            _lastUs = dt;
+            if (dt > _maxUs) _maxUs = dt;
+            _avgUs += 0.1f * ((float)dt - _avgUs);
+            _analyses = _analyses + 1;
+
+            Callback cb = _cb;
+            if (cb) cb(_levels, _cbArg);
+            continue;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+}
+
+void CTAG_AudioAnalyzer::_analyze() {
+    const size_t N = _size, M = _half;
+
+    // Window the history, oldest sample first, and pack even/odd samples
+    // into the real/imaginary parts of an N/2-point complex sequence.
+    for (size_t n = 0; n < N; ++n) {
+        _work[n] = _history[(_histPos + n) & (N - 1)] * (1.0f / 32768.0f) * _window[n];
+    }
+    _fft(_work);
+
+    // Split step: X[k] = E[k] + W_N^k O[k], evaluated for k and M - k at once.
+    const float* z = _work;
+    float dc = z[0] + z[1];
+    _power[0] = dc * dc;
+    for (size_t k = 1; k <= M / 2; ++k) {
+        float ar = z[2 * k],       ai = z[2 * k + 1];
+        float br = z[2 * (M - k)], bi = z[2 * (M - k) + 1];
+        float er = 0.5f * (ar + br), ei = 0.5f * (ai - bi);
+        float orr = 0.5f * (ai + bi), oi = -0.5f * (ar - br);
+        float wr = _split[2 * k], wi = _split[2 * k + 1];
+        float tr = wr * orr - wi * oi, ti = wr * oi + wi * orr;
+        _power[k]     = (er + tr) * (er + tr) + (ei + ti) * (ei + ti);
+        _power[M - k] = (er - tr) * (er - tr) + (ei - ti) * (ei - ti);
+    }
+
+    const float hopSec = _hopBlocks * (float)CTAG_AUDIO_BLOCK_SIZE / CTAG_AUDIO_SAMPLE_RATE;
+    const float fall   = _release * hopSec;
+    for (int b = 0; b < CTAG_ANALYZER_BANDS; ++b) {
+        float sum = 0.0f;
+        for (int k = _bandFirst[b]; k <= _bandLast[b]; ++k) sum += _power[k];
+        float db = 10.0f * log10f(sum + 1e-12f);
+        _bandDb[b] = max(db, _bandDb[b] - fall);
+        float level = (_bandDb[b] - kFloorDb) * (255.0f / -kFloorDb);
+        _levels[b] = (uint8_t)constrain(level, 0.0f, 255.0f);
+    }
+}
+
+void CTAG_AudioAnalyzer::_fft(float* x) {
+    const size_t M = _half;
+
+    // Bit-reversed reordering.
+    for (size_t i = 1, j = 0; i < M; ++i) {
+        size_t bit = M >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) {
+            float tr = x[2 * i], ti = x[2 * i + 1];
+            x[2 * i] = x[2 * j]; x[2 * i + 1] = x[2 * j + 1];
+            x[2 * j] = tr;       x[2 * j + 1] = ti;
+        }
+    }
+
+    size_t log2M = 0;
+    while ((1u << log2M) < M) ++log2M;
+
+    size_t s = 1;
+    if (log2M & 1) {
+        // One radix-2 pass when log2(M) is odd; all twiddles are 1.
+        for (size_t i = 0; i < M; i += 2) {
+            float tr = x[2 * i + 2], ti = x[2 * i + 3];
+            x[2 * i + 2] = x[2 * i] - tr; x[2 * i + 3] = x[2 * i + 1] - ti;
+            x[2 * i]    += tr;            x[2 * i + 1] += ti;
+        }
+        s = 2;
+    }
+
+    // Radix-4 passes: the stages of span s and 2s are fused, so every group
+    // of four points is loaded and stored once per two stages.
+    for (; s < M; s *= 4) {
+        const size_t step2 = M / (2 * s), step4 = M / (4 * s);
+        for (size_t base = 0; base < M; base += 4 * s) {
+            for (size_t j = 0; j < s; ++j) {
+                float* a0 = x + 2 * (base + j);
+                float* a1 = a0 + 2 * s;
+                float* a2 = a1 + 2 * s;
+                float* a3 = a2 + 2 * s;
+                const float w2r = _twiddle[2 * j * step2], w2i = _twiddle[2 * j * step2 + 1];
+                const float w4r = _twiddle[2 * j * step4], w4i = _twiddle[2 * j * step4 + 1];
+
+                // Span s: (a0, a1) and (a2, a3) with W_2s^j.
+                float tr = w2r * a1[0] - w2i * a1[1], ti = w2r * a1[1] + w2i * a1[0];
+                float p0r = a0[0] + tr, p0i = a0[1] + ti;
+                float p1r = a0[0] - tr, p1i = a0[1] - ti;
+                tr = w2r * a3[0] - w2i * a3[1]; ti = w2r * a3[1] + w2i * a3[0];
+                float p2r = a2[0] + tr, p2i = a2[1] + ti;
+                float p3r = a2[0] - tr, p3i = a2[1] - ti;
+
+                // Span 2s: (p0, p2) with W_4s^j, (p1, p3) with W_4s^(j+s) = -i W_4s^j.
+                tr = w4r * p2r - w4i * p2i; ti = w4r * p2i + w4i * p2r;
+                a0[0] = p0r + tr; a0[1] = p0i + ti;
+                a2[0] = p0r - tr; a2[1] = p0i - ti;
+                tr = w4r * p3i + w4i * p3r; ti = -(w4r * p3r - w4i * p3i);
+                a1[0] = p1r + tr; a1[1] = p1i + ti;
+                a3[0] = p1r - tr; a3[1] = p1i - ti;
+            }
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * @file CTAG_AudioAnalyzer.h
+ * @brief Spectrum analyzer tap for the CTAG audio engine.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * The analyzer is an engine sink. On the audio task it only copies the
+ * blocks it needs into a lock-free FIFO, converted to 16 bit: with a hop
+ * longer than the FFT window the blocks in between are skipped entirely.
+ * A low-priority task on the other core runs a Hann-windowed real FFT
+ * (a complex FFT of half the size with radix-4 passes, plus the usual
+ * split step) and reduces the bins to CTAG_ANALYZER_BANDS log-spaced bands.
+ *
+ * The cost per analysis is fixed by the FFT size, so the load is bounded by
+ * fftSize and hopBlocks and is reported through getStats().
+ *
+ * 1. CTAG_AudioAnalyzer: Log-band spectrum of the master bus or one source slot.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_ANALYZER_H
+#define CTAG_AUDIO_ANALYZER_H
+
+#include "CTAG_AudioTap.h"
+
+#ifndef CTAG_ANALYZER_BANDS
+#define CTAG_ANALYZER_BANDS 32 ///< Number of log-spaced output bands.
+#endif
+
+/**
+ * @class CTAG_AudioAnalyzer
+ * @brief Computes band levels of the engine output in the background.
+ */
+class CTAG_AudioAnalyzer : public CTAG_AudioTap {
+public:
+    /// First byte of a packed spectrum message (see packSpectrum()).
+    static const uint8_t kSpectrumMsgId  = CTAG_Params::kSpectrumMsgId;
+    /// Size of a packed spectrum message: ID, band count, one byte per band.
+    static const size_t  kSpectrumMsgLen = 2 + CTAG_ANALYZER_BANDS;
+    /// Lower edge of the first band in Hz.
+    static constexpr float kMinFreq  = 40.0f;
+    /// Upper edge of the last band in Hz.
+    static constexpr float kMaxFreq  = 16000.0f;
+    /// Band level that maps to 0; 0 dBFS maps to 255.
+    static constexpr float kFloorDb  = -72.0f;
+
+    /**
+     * @brief Called from the analyzer task after every analysis.
+     * @param levels CTAG_ANALYZER_BANDS levels, 0 (kFloorDb) … 255 (0 dBFS).
+     * @param arg The pointer given to setCallback().
+     */
+    using Callback = void(*)(const uint8_t* levels, void* arg);
+
+    /**
+     * @brief Cost and throughput counters.
+     */
+    struct Stats {
+        uint32_t analyses;      ///< Number of completed analyses.
+        uint32_t droppedBlocks; ///< Blocks lost because the FIFO was full.
+        uint32_t lastUs;        ///< Duration of the last analysis.
+        uint32_t maxUs;         ///< Longest analysis.
+        float    load;          ///< Share of the analyzer core used (0.0 … 1.0).
+    };
+
+    CTAG_AudioAnalyzer();
+    ~CTAG_AudioAnalyzer();
+
+    /**
+     * @brief Allocates the buffers, precomputes the tables and starts the task.
+     * @param fftSize Window length, a power of two from 256 to 4096. 2048
+     * resolves 21.5 Hz bins, which keeps the lowest bands apart.
+     * @param hopBlocks Engine blocks between two analyses (8 = ~21.5 Hz).
+     * @param core Core the analyzer task runs on.
+     * @return False on an invalid size or if memory or the task could not be allocated.
+     */
+    bool begin(size_t fftSize = 2048, uint16_t hopBlocks = 8, BaseType_t core = 0);
+
+    /**
+     * @brief Sets how fast the bars fall back (default 40 dB per second).
+     * Rising levels are shown immediately.
+     */
+    void setRelease(float dbPerSecond);
+
+    /**
+     * @brief Registers a function that receives every new set of levels,
+     * e.g. to send them to the display controller.
+     * @note Runs on the analyzer task; it may block briefly, but every
+     * millisecond spent there delays the next analysis.
+     */
+    void setCallback(Callback cb, void* arg = nullptr);
+
+    /**
+     * @brief Copies the current band levels.
+     * @param levels Room for CTAG_ANALYZER_BANDS bytes.
+     * @return Number of analyses so far; compare with the last call to see
+     * whether the levels changed.
+     */
+    uint32_t getLevels(uint8_t* levels) const;
+
+    /**
+     * @brief Writes the current levels as a compact message:
+     * [kSpectrumMsgId, CTAG_ANALYZER_BANDS, level 0 … level n-1].
+     * @param dst Room for kSpectrumMsgLen bytes. The message fits into one
+     * CTAG_SPI_IPC frame.
+     * @return kSpectrumMsgLen.
+     */
+    size_t packSpectrum(uint8_t* dst) const;
+
+    Stats getStats() const;
+
+    // --- CTAG_AudioSink ---
+    void writeMaster(const float* block, size_t numSamples) override;
+
+private:
+    void _push(const float* block, size_t numSamples) override;
+    void _taskLoop() override;
+    void _analyze();
+    void _fft(float* data);
+
+    void* _mem = nullptr;
+
+    size_t   _size      = 0;  ///< FFT length N.
+    size_t   _half      = 0;  ///< Complex FFT length M = N / 2.
+    uint16_t _hopBlocks = 0;
+    uint16_t _pushBlocks = 0; ///< Blocks copied per hop (the window or the hop, whichever is shorter).
+    uint16_t _blockCount = 0; ///< Position within the current hop (audio task).
+    float    _release   = 40.0f; ///< Fall rate in dB per second.
+
+    // Tables and work buffers, all carved out of _mem.
+    int16_t*  _history = nullptr; ///< Ring of the last N samples.
+    float*    _window  = nullptr; ///< Hann window, N.
+    float*    _work    = nullptr; ///< Interleaved complex data, 2 * M.
+    float*    _power   = nullptr; ///< Bin powers, M.
+    float*    _twiddle = nullptr; ///< e^(-2 pi i k / M), k < M / 2, interleaved.
+    float*    _split   = nullptr; ///< e^(-2 pi i k / N), k <= M / 2, interleaved.
+    size_t    _histPos = 0;
+    size_t    _newSamples = 0;
+
+    uint16_t _bandFirst[CTAG_ANALYZER_BANDS];
+    uint16_t _bandLast[CTAG_ANALYZER_BANDS];
+    uint8_t  _levels[CTAG_ANALYZER_BANDS] = {};
+    float    _bandDb[CTAG_ANALYZER_BANDS]; ///< Displayed (released) band levels.
+
+    Callback volatile _cb    = nullptr;
+    void* volatile    _cbArg = nullptr;
+
+    volatile uint32_t _analyses      = 0;
+    volatile uint32_t _droppedBlocks = 0;
+    volatile uint32_t _lastUs        = 0;
+    volatile uint32_t _maxUs         = 0;
+    float             _avgUs         = 0.0f;
+};
+
+#endif // CTAG_AUDIO_ANALYZER_H
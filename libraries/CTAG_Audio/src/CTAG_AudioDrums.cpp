@@ -0,0 +1,297 @@
+/**
+ * @file CTAG_AudioDrums.cpp
+ * @brief Implementation of the synthetic drum voices.
+ */
+#include "CTAG_AudioDrums.h"
+
+static const float kSilence = 1e-4f; ///< -80 dB, below this a voice stops.
+
+/**
+ * @brief Sine of a phase given in cycles (0 … 1), parabolic approximation
+ * with one refinement step (~0.1 % error), as used by the oscillators' economy mode.
+ */
+static inline float _sinCycles(float phase) {
+    float x = phase < 0.5f ? phase : phase - 1.0f;
+    float y = 8.0f * x - 16.0f * x * fabsf(x);
+    return 0.225f * (y * fabsf(y) - y) + y;
+}
+
+/**
+ * @brief Coefficients of a TPT state variable filter.
+ */
+static void _svfCoefficients(float freq, float k, float sampleRate, float& a1, float& a2, float& a3) {
+    float g = tanf((float)M_PI * constrain(freq, 20.0f, 0.45f * sampleRate) / sampleRate);
+    a1 = 1.0f / (1.0f + g * (g + k));
+    a2 = g * a1;
+    a3 = g * a2;
+}
+
+
+// --- CTAG_DrumVoice ---
+
+const int16_t* CTAG_DrumVoice::_sharedNoise() {
+    // Filled once, on the first construction (during setup, not on the audio task).
+    static int16_t table[kNoiseSize];
+    static bool filled = false;
+    if (!filled) {
+        uint32_t x = 0x9E3779B9u;
+        for (size_t i = 0; i < kNoiseSize; ++i) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            table[i] = (int16_t)(x >> 16);
+        }
+        filled = true;
+    }
+    return table;
+}
+
+CTAG_DrumVoice::CTAG_DrumVoice(float sampleRate)
+    : _sampleRate(sampleRate)
+    , _noiseTable(_sharedNoise())
+{
+    // Every voice walks the table with its own odd stride, so voices that
+    // hit together do not play identical noise.
+    static uint32_t instances = 0;
+    ++instances;
+    _seed      = 0x2545F491u * instances;
+    _noiseStep = (2 * (instances * 389) + 1) & (kNoiseSize - 1);
+}
+
+void CTAG_DrumVoice::trigger(float velocity) {
+    _velocity = constrain(velocity, 0.0f, 1.0f);
+    _pending  = true;
+}
+
+void CTAG_DrumVoice::setLevel(float level) {
+    _level = constrain(level, 0.0f, 1.0f);
+}
+
+int16_t CTAG_DrumVoice::getNextSample() {
+    float s;
+    renderBlock(&s, 1);
+    return (int16_t)(constrain(s, -1.0f, 1.0f) * 32767.0f);
+}
+
+void CTAG_DrumVoice::renderBlock(float* out, size_t numSamples) {
+    if (_pending) {
+        _pending = false;
+        // A random start in the noise table keeps repeated hits from sounding identical.
+        _seed = _seed * 1664525u + 1013904223u;
+        _noisePos = _seed >> 20;
+        _start(_velocity);
+        _active = true;
+    }
+    if (!_active) {
+        memset(out, 0, numSamples * sizeof(float));
+        return;
+    }
+    _active = _render(out, numSamples);
+}
+
+void CTAG_DrumVoice::reset() {
+    _pending = false;
+    _active  = false;
+}
+
+
+// --- CTAG_DrumKick ---
+
+CTAG_DrumKick::CTAG_DrumKick(float sampleRate) : CTAG_DrumVoice(sampleRate) {
+    setDecay(0.5f);
+    setSweepTime(0.03f);
+    _clickEnv.setTime(0.004f, _sampleRate);
+}
+
+void CTAG_DrumKick::setTune(float freq)         { _tune  = constrain(freq, 30.0f, 200.0f); }
+void CTAG_DrumKick::setSweep(float ratio)       { _sweep = constrain(ratio, 1.0f, 8.0f); }
+void CTAG_DrumKick::setSweepTime(float seconds) { _pitchEnv.setTime(seconds, _sampleRate); }
+void CTAG_DrumKick::setDecay(float seconds)     { _ampEnv.setTime(seconds, _sampleRate); }
+void CTAG_DrumKick::setClick(float amount)      { _click = constrain(amount, 0.0f, 1.0f); }
+
+void CTAG_DrumKick::_start(float velocity) {
+    _amp = velocity * _level;
+    _phase = 0.0f;
+    _ampEnv.value   = 1.0f;
+    _pitchEnv.value = 1.0f;
+    _clickEnv.value = 1.0f;
+}
+
+bool CTAG_DrumKick::_render(float* out, size_t numSamples) {
+    const float base  = _tune / _sampleRate;
+    const float depth = base * (_sweep - 1.0f);
+    for (size_t i = 0; i < numSamples; ++i) {
+        _phase += base + depth * _pitchEnv.next();
+        if (_phase >= 1.0f) _phase -= 1.0f;
+        float s = _sinCycles(_phase) * _ampEnv.next();
+        s += _click * _noise() * _clickEnv.next();
+        out[i] = _amp * s;
+    }
+    _pitchEnv.flush();
+    _clickEnv.flush();
+    return _ampEnv.value > kSilence;
+}
+
+
+// --- CTAG_DrumSnare ---
+
+CTAG_DrumSnare::CTAG_DrumSnare(float sampleRate) : CTAG_DrumVoice(sampleRate) {
+    setToneDecay(0.12f);
+    setNoiseDecay(0.22f);
+    // One-pole high-pass around 1 kHz keeps the wires out of the shell's range.
+    _hpCoeff = expf(-2.0f * (float)M_PI * 1000.0f / _sampleRate);
+}
+
+void CTAG_DrumSnare::setTune(float freq)          { _tune = constrain(freq, 100.0f, 400.0f); }
+void CTAG_DrumSnare::setToneDecay(float seconds)  { _toneEnv.setTime(seconds, _sampleRate); }
+void CTAG_DrumSnare::setNoiseDecay(float seconds) { _noiseEnv.setTime(seconds, _sampleRate); }
+void CTAG_DrumSnare::setSnappy(float amount)      { _snappy = constrain(amount, 0.0f, 1.0f); }
+
+void CTAG_DrumSnare::_start(float velocity) {
+    _amp = velocity * _level;
+    _phase1 = _phase2 = 0.0f;
+    _hpState = 0.0f;
+    _toneEnv.value  = 1.0f;
+    _noiseEnv.value = 1.0f;
+}
+
+bool CTAG_DrumSnare::_render(float* out, size_t numSamples) {
+    const float inc1 = _tune / _sampleRate;
+    const float inc2 = inc1 * 1.47f; // second shell mode
+    const float tone = 1.0f - _snappy;
+    for (size_t i = 0; i < numSamples; ++i) {
+        _phase1 += inc1; if (_phase1 >= 1.0f) _phase1 -= 1.0f;
+        _phase2 += inc2; if (_phase2 >= 1.0f) _phase2 -= 1.0f;
+        float shell = (_sinCycles(_phase1) + 0.5f * _sinCycles(_phase2)) * _toneEnv.next();
+
+        float n = _noise();
+        float lp = n + _hpCoeff * (_hpState - n);
+        _hpState = lp;
+        float wires = (n - lp) * _noiseEnv.next();
+
+        out[i] = _amp * (tone * shell + 1.1f * _snappy * wires);
+    }
+    _toneEnv.flush();
+    _noiseEnv.flush();
+    return _toneEnv.value > kSilence || _noiseEnv.value > kSilence;
+}
+
+
+// --- CTAG_DrumHat ---
+
+CTAG_DrumHat::CTAG_DrumHat(float sampleRate) : CTAG_DrumVoice(sampleRate) {
+    setDecay(0.05f);
+    setTune(1.0f);
+}
+
+void CTAG_DrumHat::setTune(float scale) {
+    static const float kFreqs[kOscillators] = { 205.3f, 304.4f, 369.6f, 522.7f, 540.0f, 800.0f };
+    _tune = constrain(scale, 0.5f, 2.0f);
+    for (int i = 0; i < kOscillators; ++i) {
+        _inc[i] = (uint32_t)(kFreqs[i] * _tune / _sampleRate * 4294967296.0f);
+    }
+    _updateFilter();
+}
+
+void CTAG_DrumHat::setDecay(float seconds) {
+    _decay = seconds;
+    _env.setTime(seconds, _sampleRate);
+}
+
+void CTAG_DrumHat::choke() {
+    _chokePending = true;
+}
+
+void CTAG_DrumHat::_updateFilter() {
+    _k = 1.4142f;
+    _svfCoefficients(7000.0f * _tune, _k, _sampleRate, _a1, _a2, _a3);
+}
+
+void CTAG_DrumHat::_start(float velocity) {
+    _amp = velocity * _level;
+    _chokePending = false;
+    _env.setTime(_decay, _sampleRate);
+    _env.value = 1.0f;
+    _ic1 = _ic2 = 0.0f;
+}
+
+bool CTAG_DrumHat::_render(float* out, size_t numSamples) {
+    if (_chokePending) {
+        _chokePending = false;
+        _env.setTime(0.005f, _sampleRate);
+    }
+
+    const bool metal = !_economy;
+    for (size_t i = 0; i < numSamples; ++i) {
+        float x = _noise();
+        if (metal) {
+            // Square waves from the top bit of each phase accumulator.
+            int sum = 0;
+            for (int o = 0; o < kOscillators; ++o) {
+                _phase[o] += _inc[o];
+                sum += (_phase[o] >> 31) ? 1 : -1;
+            }
+            x = 0.5f * x + sum * (1.0f / kOscillators);
+        }
+
+        float v3 = x - _ic2;
+        float v1 = _a1 * _ic1 + _a2 * v3;
+        float v2 = _ic2 + _a2 * _ic1 + _a3 * v3;
+        _ic1 = 2.0f * v1 - _ic1;
+        _ic2 = 2.0f * v2 - _ic2;
+        float hp = x - _k * v1 - v2;
+
+        out[i] = _amp * hp * _env.next();
+    }
+    return _env.value > kSilence;
+}
+
+
+// --- CTAG_DrumClap ---
+
+CTAG_DrumClap::CTAG_DrumClap(float sampleRate) : CTAG_DrumVoice(sampleRate) {
+    _spacing = (uint32_t)(0.010f * _sampleRate);
+    _burstEnv.setTime(0.02f, _sampleRate);
+    setDecay(0.25f);
+    setTone(1200.0f);
+}
+
+void CTAG_DrumClap::setTone(float freq) {
+    _tone = constrain(freq, 500.0f, 3000.0f);
+    _svfCoefficients(_tone, _k, _sampleRate, _a1, _a2, _a3);
+}
+
+void CTAG_DrumClap::setDecay(float seconds) {
+    _tailEnv.setTime(seconds, _sampleRate);
+}
+
+void CTAG_DrumClap::_start(float velocity) {
+    _amp    = velocity * _level;
+    _timer  = 0;
+    _bursts = 1;
+    _burstEnv.value = 1.0f;
+    _tailEnv.value  = 0.0f;
+    _ic1 = _ic2 = 0.0f;
+}
+
+bool CTAG_DrumClap::_render(float* out, size_t numSamples) {
+    for (size_t i = 0; i < numSamples; ++i) {
+        // Bursts at 0, 10 and 20 ms; the tail starts with the last one.
+        if (_bursts < 3 && ++_timer >= _spacing) {
+            _timer = 0;
+            ++_bursts;
+            _burstEnv.value = 1.0f;
+            if (_bursts == 3) _tailEnv.value = 0.6f;
+        }
+
+        float x  = _noise();
+        float v3 = x - _ic2;
+        float v1 = _a1 * _ic1 + _a2 * v3;
+        float v2 = _ic2 + _a2 * _ic1 + _a3 * v3;
+        _ic1 = 2.0f * v1 - _ic1;
+        _ic2 = 2.0f * v2 - _ic2;
+
+        out[i] = _amp * 1.6f * v1 * (_burstEnv.next() + _tailEnv.next());
+    }
+    _burstEnv.flush();
+    _tailEnv.flush();
+    return _bursts < 3 || _tailEnv.value > kSilence || _burstEnv.value > kSilence;
+}
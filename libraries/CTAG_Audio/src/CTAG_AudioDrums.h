@@ -0,0 +1,292 @@
+/**
+ * @file CTAG_AudioDrums.h
+ * @brief Synthetic drum voices for the CTAG audio engine.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * All voices render whole blocks and are cheap enough that a full kit of
+ * eight tracks fits comfortably into the audio task:
+ * - envelopes are exponential decays, one multiply per sample; the decay
+ *   coefficients are computed with expf() only when a parameter changes;
+ * - noise is read from one shared precomputed table (no random number
+ *   generator per sample), each voice with its own stride;
+ * - a voice that has decayed below -80 dB only clears its block.
+ *
+ * trigger() and the setters may be called from any task (sequencer, MIDI);
+ * a trigger is picked up at the start of the next block.
+ *
+ * 1. CTAG_DrumVoice: Base class (trigger, level, silence detection).
+ * 2. CTAG_DrumKick: Sine with a pitch sweep and a noise click.
+ * 3. CTAG_DrumSnare: Two tuned modes plus high-passed noise.
+ * 4. CTAG_DrumHat: Six-oscillator metallic tone plus noise, high-passed, chokeable.
+ * 5. CTAG_DrumClap: Band-passed noise with three bursts and a tail.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_DRUMS_H
+#define CTAG_AUDIO_DRUMS_H
+
+#include "CTAG_Audio.h"
+
+/**
+ * @brief Exponential decay envelope, one multiply per sample.
+ */
+struct CTAG_DecayEnvelope {
+    float value = 0.0f;
+    float coeff = 0.0f;
+
+    /**
+     * @brief Sets the time to decay by 60 dB.
+     */
+    void setTime(float seconds, float sampleRate) {
+        coeff = expf(-6.9077553f / (max(seconds, 0.0005f) * sampleRate));
+    }
+
+    float next() { return value *= coeff; }
+
+    /**
+     * @brief Ends a finished decay at exactly zero, before it reaches the
+     * slow denormal range. Call once per block.
+     */
+    void flush() { if (value < 1e-6f) value = 0.0f; }
+};
+
+/**
+ * @class CTAG_DrumVoice
+ * @brief Common base of the drum voices.
+ */
+class CTAG_DrumVoice : public CTAG_AudioSource {
+public:
+    /// Length of the shared noise table (a power of two).
+    static const size_t kNoiseSize = 4096;
+
+    CTAG_DrumVoice(float sampleRate);
+
+    /**
+     * @brief Starts the sound at the beginning of the next block.
+     * @param velocity 0.0 … 1.0.
+     */
+    void trigger(float velocity = 1.0f);
+
+    /**
+     * @brief Sets the output level (0.0 … 1.0, default 0.8).
+     */
+    void setLevel(float level);
+
+    /**
+     * @brief True while the voice is still audible.
+     */
+    bool isActive() const { return _active; }
+
+    int16_t getNextSample() override;
+    void renderBlock(float* out, size_t numSamples) override;
+    void reset() override;
+
+protected:
+    /**
+     * @brief Restarts the envelopes and oscillators.
+     */
+    virtual void _start(float velocity) = 0;
+
+    /**
+     * @brief Renders one block into out (overwriting it).
+     * @return False once the sound has decayed completely.
+     */
+    virtual bool _render(float* out, size_t numSamples) = 0;
+
+    /**
+     * @brief Next value of the shared noise table, -1.0 … 1.0.
+     */
+    float _noise() {
+        _noisePos = (_noisePos + _noiseStep) & (kNoiseSize - 1);
+        return _noiseTable[_noisePos] * (1.0f / 32768.0f);
+    }
+
+    float _sampleRate;
+    float _level = 0.8f;
+
+private:
+    static const int16_t* _sharedNoise();
+
+    const int16_t* _noiseTable;
+    uint32_t       _noisePos  = 0;
+    uint32_t       _noiseStep = 1;
+    uint32_t       _seed;
+    volatile bool  _pending  = false;
+    volatile float _velocity = 1.0f;
+    bool           _active   = false;
+};
+
+/**
+ * @class CTAG_DrumKick
+ * @brief Bass drum: a sine whose pitch falls from a multiple of the tune
+ * frequency, plus a short noise click.
+ */
+class CTAG_DrumKick : public CTAG_DrumVoice {
+public:
+    CTAG_DrumKick(float sampleRate = 44100.0f);
+
+    /**
+     * @brief Final pitch in Hz (30 … 200, default 50). Tuned up it makes a tom.
+     */
+    void setTune(float freq);
+
+    /**
+     * @brief Start of the pitch sweep as a multiple of the tune (1 … 8, default 4).
+     */
+    void setSweep(float ratio);
+
+    /**
+     * @brief Time of the pitch sweep in seconds (default 0.03).
+     */
+    void setSweepTime(float seconds);
+
+    /**
+     * @brief Decay time (-60 dB) in seconds (default 0.5).
+     */
+    void setDecay(float seconds);
+
+    /**
+     * @brief Level of the attack click (0.0 … 1.0, default 0.3).
+     */
+    void setClick(float amount);
+
+protected:
+    void _start(float velocity) override;
+    bool _render(float* out, size_t numSamples) override;
+
+private:
+    float _tune  = 50.0f;
+    float _sweep = 4.0f;
+    float _click = 0.3f;
+    float _phase = 0.0f;
+    float _amp   = 0.0f;
+    CTAG_DecayEnvelope _ampEnv, _pitchEnv, _clickEnv;
+};
+
+/**
+ * @class CTAG_DrumSnare
+ * @brief Snare drum: two sine modes for the shell, high-passed noise for the wires.
+ */
+class CTAG_DrumSnare : public CTAG_DrumVoice {
+public:
+    CTAG_DrumSnare(float sampleRate = 44100.0f);
+
+    /**
+     * @brief Pitch of the lower shell mode in Hz (100 … 400, default 180).
+     */
+    void setTune(float freq);
+
+    /**
+     * @brief Decay of the shell tone in seconds (default 0.12).
+     */
+    void setToneDecay(float seconds);
+
+    /**
+     * @brief Decay of the wires in seconds (default 0.22).
+     */
+    void setNoiseDecay(float seconds);
+
+    /**
+     * @brief Balance between shell and wires (0.0 … 1.0, default 0.6).
+     */
+    void setSnappy(float amount);
+
+protected:
+    void _start(float velocity) override;
+    bool _render(float* out, size_t numSamples) override;
+
+private:
+    float _tune   = 180.0f;
+    float _snappy = 0.6f;
+    float _phase1 = 0.0f, _phase2 = 0.0f;
+    float _amp    = 0.0f;
+    float _hpState = 0.0f, _hpCoeff = 0.0f;
+    CTAG_DecayEnvelope _toneEnv, _noiseEnv;
+};
+
+/**
+ * @class CTAG_DrumHat
+ * @brief Hi-hat: six detuned square oscillators (the classic analog ratios)
+ * mixed with noise and high-passed. Use one instance for closed and one for
+ * open hats and choke() the open one when the closed one plays.
+ */
+class CTAG_DrumHat : public CTAG_DrumVoice {
+public:
+    CTAG_DrumHat(float sampleRate = 44100.0f);
+
+    /**
+     * @brief Scales the oscillator pitches and the high-pass (0.5 … 2.0, default 1.0).
+     */
+    void setTune(float scale);
+
+    /**
+     * @brief Decay time in seconds (default 0.05 closed; ~0.4 for an open hat).
+     */
+    void setDecay(float seconds);
+
+    /**
+     * @brief Fades the voice out within a few milliseconds.
+     */
+    void choke();
+
+    /**
+     * @brief Economy mode drops the metallic oscillators and keeps the noise.
+     */
+    void setEconomyMode(bool enabled) override { _economy = enabled; }
+
+protected:
+    void _start(float velocity) override;
+    bool _render(float* out, size_t numSamples) override;
+
+private:
+    void _updateFilter();
+
+    static const int kOscillators = 6;
+    float _tune  = 1.0f;
+    float _decay = 0.05f;
+    float _amp   = 0.0f;
+    uint32_t _phase[kOscillators] = {};
+    uint32_t _inc[kOscillators]   = {};
+    // High-pass state variable filter (TPT form)
+    float _a1 = 0.0f, _a2 = 0.0f, _a3 = 0.0f, _k = 1.4142f;
+    float _ic1 = 0.0f, _ic2 = 0.0f;
+    volatile bool _chokePending = false;
+    volatile bool _economy = false;
+    CTAG_DecayEnvelope _env;
+};
+
+/**
+ * @class CTAG_DrumClap
+ * @brief Hand clap: band-passed noise with three quick bursts and a diffuse tail.
+ */
+class CTAG_DrumClap : public CTAG_DrumVoice {
+public:
+    CTAG_DrumClap(float sampleRate = 44100.0f);
+
+    /**
+     * @brief Center of the noise band in Hz (500 … 3000, default 1200).
+     */
+    void setTone(float freq);
+
+    /**
+     * @brief Decay of the tail in seconds (default 0.25).
+     */
+    void setDecay(float seconds);
+
+protected:
+    void _start(float velocity) override;
+    bool _render(float* out, size_t numSamples) override;
+
+private:
+    float    _tone  = 1200.0f;
+    float    _amp   = 0.0f;
+    uint32_t _timer = 0;
+    uint32_t _spacing;  ///< Samples between two bursts.
+    uint8_t  _bursts = 0;
+    // Band-pass state variable filter (TPT form)
+    float _a1 = 0.0f, _a2 = 0.0f, _a3 = 0.0f, _k = 0.5f;
+    float _ic1 = 0.0f, _ic2 = 0.0f;
+    CTAG_DecayEnvelope _burstEnv, _tailEnv;
+};
+
+#endif // CTAG_AUDIO_DRUMS_H
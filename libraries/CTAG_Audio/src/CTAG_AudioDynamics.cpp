@@ -0,0 +1,72 @@
+/**
+ * @file CTAG_AudioDynamics.cpp
+ * @brief Implementation of the master-bus limiter and soft clipper.
+ */
+#include "CTAG_AudioDynamics.h"
+
+CTAG_Limiter::CTAG_Limiter(float sampleRate)
+    : _sampleRate(sampleRate)
+{
+    setRelease(0.1f);
+}
+
+void CTAG_Limiter::setCeiling(float dBFS) {
+    // Keep some headroom above the ceiling for the soft clipper's curve.
+    _ceiling = powf(10.0f, constrain(dBFS, -12.0f, -0.2f) / 20.0f);
+}
+
+void CTAG_Limiter::setRelease(float seconds) {
+    seconds = constrain(seconds, 0.01f, 2.0f);
+    // The gain is updated once per look-ahead chunk.
+    _releaseCoef = 1.0f - expf(-(float)kLookahead / (seconds * _sampleRate));
+}
+
+void CTAG_Limiter::process(float* buffer, size_t numSamples) {
+    const float ceiling = _ceiling;
+    const float knee    = ceiling;
+    float minGain = 1.0f;
+
+    for (size_t c = 0; c + kLookahead <= numSamples; c += kLookahead) {
+        float* chunk = buffer + c;
+
+        // 1) Peak of the incoming chunk, which will be played one chunk later.
+        float peak = 0.0f;
+        for (size_t j = 0; j < kLookahead; ++j) {
+            float a = fabsf(chunk[j]);
+            if (a > peak) peak = a;
+        }
+        float target = (peak > ceiling) ? ceiling / peak : 1.0f;
+
+        // 2) Gain at the end of this chunk: low enough for both the chunk being
+        //    played now and the one after it, otherwise release towards unity.
+        float released = _gain + (1.0f - _gain) * _releaseCoef;
+        float next = min(min(target, _prevTarget), released);
+
+        // 3) Output the delayed chunk with a linear gain ramp, store the new one.
+        float g    = _gain;
+        float step = (next - g) / (float)kLookahead;
+        for (size_t j = 0; j < kLookahead; ++j) {
+            g += step;
+            float x = chunk[j];
+            float y = _delay[j] * g;
+            // Small tolerance for rounding in the gain ramp.
+            if (fabsf(y) > knee * 1.001f) ++_clipped;
+            chunk[j]  = softClip(y, knee);
+            _delay[j] = x;
+        }
+
+        if (next < minGain) minGain = next;
+        _gain       = next;
+        _prevTarget = target;
+    }
+
+    _grDb = (minGain < 1.0f) ? -20.0f * log10f(minGain) : 0.0f;
+}
+
+void CTAG_Limiter::reset() {
+    memset(_delay, 0, sizeof(_delay));
+    _gain       = 1.0f;
+    _prevTarget = 1.0f;
+    _grDb       = 0.0f;
+    _clipped    = 0;
+}
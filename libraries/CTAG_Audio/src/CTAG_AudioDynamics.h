@@ -0,0 +1,95 @@
+/**
+ * @file CTAG_AudioDynamics.h
+ * @brief Master-bus dynamics for the CTAG audio engine.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * 1. CTAG_Limiter: Look-ahead peak limiter followed by a polynomial soft clipper.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_DYNAMICS_H
+#define CTAG_AUDIO_DYNAMICS_H
+
+#include "CTAG_Audio.h"
+
+/**
+ * @class CTAG_Limiter
+ * @brief Cheap look-ahead peak limiter with a soft-clipping safety stage.
+ *
+ * The signal is delayed by kLookahead samples. For every chunk of that size
+ * the peak is measured before it is played, and the gain is ramped linearly
+ * so that it has reached the required reduction when the peak comes out.
+ * This costs one peak scan and one multiply per sample instead of a
+ * per-sample envelope follower. Whatever still exceeds the knee is bent
+ * into full scale by a quadratic soft clipper, so the int16 conversion never
+ * wraps around.
+ */
+class CTAG_Limiter : public CTAG_AudioEffect {
+public:
+    /**
+     * @brief Look-ahead in samples (also the added latency).
+     * @note process() expects numSamples to be a multiple of this value.
+     */
+    static const size_t kLookahead = 32;
+
+    /**
+     * @brief Constructs a new limiter.
+     * @param sampleRate The sample rate of the audio engine (e.g., 44100.0f).
+     */
+    CTAG_Limiter(float sampleRate = 44100.0f);
+
+    /**
+     * @brief Sets the limiter ceiling; the soft clipper knee follows it.
+     * @param dBFS Ceiling in dBFS (-12 … -0.2).
+     */
+    void setCeiling(float dBFS);
+
+    /**
+     * @brief Sets the release time of the gain reduction.
+     * @param seconds Release time constant (0.01 … 2 s).
+     */
+    void setRelease(float seconds);
+
+    /**
+     * @brief Gain reduction applied during the last processed block.
+     * @return Largest reduction in dB (0 = no limiting, positive values = reduction).
+     */
+    float getGainReductionDb() const { return _grDb; }
+
+    /**
+     * @brief Number of samples that reached the soft clipper since the last reset.
+     */
+    uint32_t getClippedSamples() const { return _clipped; }
+
+    void process(float* buffer, size_t numSamples) override;
+    void reset() override;
+
+    /**
+     * @brief Quadratic soft clipper: linear up to the knee, then bends smoothly into ±1.
+     * @param x Input sample.
+     * @param knee Start of the curved region (0 < knee < 1).
+     * @return Output in [-1, 1].
+     */
+    static inline float softClip(float x, float knee) {
+        float a = fabsf(x);
+        if (a <= knee) return x;
+        float d = 1.0f - knee;
+        float u = a - knee;
+        float y = (u >= 2.0f * d) ? 1.0f : knee + u - u * u / (4.0f * d);
+        return x < 0.0f ? -y : y;
+    }
+
+private:
+    float _sampleRate;
+    float _ceiling     = 0.89125f; // -1 dBFS
+    float _releaseCoef = 0.0f;
+
+    float _gain       = 1.0f; ///< Gain at the end of the last chunk.
+    float _prevTarget = 1.0f; ///< Required gain of the chunk currently in the delay.
+    float _delay[kLookahead] = {};
+
+    float    _grDb    = 0.0f;
+    uint32_t _clipped = 0;
+};
+
+#endif // CTAG_AUDIO_DYNAMICS_H
@@ -0,0 +1,229 @@
+/**
+ * @file CTAG_AudioEffects.cpp
+ * @brief Implementation of the PSRAM-backed delay and reverb effects.
+ */
+#include "CTAG_AudioEffects.h"
+
+// =========================================================================
+// === CTAG_PsramDelayLine Implementation                                ===
+// =========================================================================
+
+CTAG_PsramDelayLine::~CTAG_PsramDelayLine() {
+    CTAG_AudioMemory::release(_buf);
+}
+
+bool CTAG_PsramDelayLine::begin(size_t length, CTAG_AudioMemory::Region region) {
+    if (_buf) return length <= _length;
+    _buf = (float*)CTAG_AudioMemory::allocate(length * sizeof(float), region);
+    if (!_buf) return false;
+    _length = length;
+    clear();
+    return true;
+}
+
+void CTAG_PsramDelayLine::read(float* dst, size_t delay, size_t n) const {
+    if (!_buf) {
+        memset(dst, 0, n * sizeof(float));
+        return;
+    }
+    // At most two contiguous copies: up to the end of the ring, then from its start.
+    size_t start = (_write + _length - delay) % _length;
+    size_t first = min(n, _length - start);
+    memcpy(dst, _buf + start, first * sizeof(float));
+    if (first < n) memcpy(dst + first, _buf, (n - first) * sizeof(float));
+}
+
+void CTAG_PsramDelayLine::write(const float* src, size_t n) {
+    if (!_buf) return;
+    size_t first = min(n, _length - _write);
+    memcpy(_buf + _write, src, first * sizeof(float));
+    if (first < n) memcpy(_buf, src + first, (n - first) * sizeof(float));
+    _write = (_write + n) % _length;
+}
+
+void CTAG_PsramDelayLine::clear() {
+    if (_buf) memset(_buf, 0, _length * sizeof(float));
+    _write = 0;
+}
+
+
+// =========================================================================
+// === CTAG_Delay Implementation                                         ===
+// =========================================================================
+
+CTAG_Delay::CTAG_Delay(float sampleRate)
+    : _sampleRate(sampleRate)
+{
+}
+
+bool CTAG_Delay::begin(float maxDelaySeconds) {
+    size_t length = (size_t)(maxDelaySeconds * _sampleRate);
+    if (length < CTAG_AUDIO_BLOCK_SIZE) length = CTAG_AUDIO_BLOCK_SIZE;
+    return _line.begin(length);
+}
+
+void CTAG_Delay::setDelayTime(float seconds) {
+    // Chunked access needs at least one block between write and read position.
+    size_t samples = (size_t)(seconds * _sampleRate);
+    _delay = constrain(samples, (size_t)CTAG_AUDIO_BLOCK_SIZE, max(_line.length(), (size_t)CTAG_AUDIO_BLOCK_SIZE));
+}
+
+void CTAG_Delay::setFeedback(float feedback) {
+    _feedback = constrain(feedback, 0.0f, 0.95f);
+}
+
+void CTAG_Delay::setMix(float mix) {
+    _mix = constrain(mix, 0.0f, 1.0f);
+}
+
+void CTAG_Delay::process(float* buffer, size_t numSamples) {
+    const size_t target = _delay;
+    const bool   xfade  = (target != _activeDelay);
+
+    _line.read(_tapNew, target, numSamples);
+    if (xfade) _line.read(_tapOld, _activeDelay, numSamples);
+
+    const float step = 1.0f / (float)numSamples;
+    for (size_t i = 0; i < numSamples; ++i) {
+        float y = _tapNew[i];
+        if (xfade) y = _tapOld[i] + (y - _tapOld[i]) * (float)(i + 1) * step;
+
+        float x = buffer[i];
+        _feed[i]  = CTAG_AudioEngine::protectDenormal(x + _feedback * y);
+        buffer[i] = x + _mix * (y - x);
+    }
+
+    _line.write(_feed, numSamples);
+    _activeDelay = target;
+}
+
+void CTAG_Delay::reset() {
+    _line.clear();
+    _activeDelay = _delay;
+}
+
+
+// =========================================================================
+// === CTAG_FDNReverb Implementation                                     ===
+// =========================================================================
+
+// Mutually prime lengths at 44.1 kHz, scaled to the actual sample rate.
+static const size_t kFdnLengths[4]      = { 1687, 1601, 2053, 2251 };
+static const size_t kDiffuserLengths[4] = { 142, 107, 379, 277 };
+static const float  kDiffuserGain       = 0.6f;
+
+CTAG_FDNReverb::CTAG_FDNReverb(float sampleRate)
+    : _sampleRate(sampleRate)
+{
+    float scale = _sampleRate / 44100.0f;
+    for (int l = 0; l < kLines; ++l) {
+        size_t len = (size_t)(kFdnLengths[l] * scale);
+        _lineDelay[l] = max(len, (size_t)CTAG_AUDIO_BLOCK_SIZE);
+    }
+    _updateGains();
+}
+
+bool CTAG_FDNReverb::begin() {
+    bool ok = true;
+    float scale = _sampleRate / 44100.0f;
+    for (int l = 0; l < kLines; ++l) {
+        ok &= _lines[l].begin(_lineDelay[l]);
+    }
+    for (int d = 0; d < kDiffusers; ++d) {
+        Allpass& ap = _diffusers[d];
+        if (ap.buf) continue;
+        ap.length = max((size_t)(kDiffuserLengths[d] * scale), (size_t)1);
+        ap.buf = (float*)CTAG_AudioMemory::allocate(ap.length * sizeof(float),
+                                                    CTAG_AudioMemory::Region::Internal);
+        ok &= (ap.buf != nullptr);
+    }
+    reset();
+    return ok;
+}
+
+void CTAG_FDNReverb::setDecay(float seconds) {
+    _decay = constrain(seconds, 0.1f, 20.0f);
+    _updateGains();
+}
+
+void CTAG_FDNReverb::setDamping(float damping) {
+    _damping = constrain(damping, 0.0f, 0.95f);
+}
+
+void CTAG_FDNReverb::setMix(float mix) {
+    _mix = constrain(mix, 0.0f, 1.0f);
+}
+
+void CTAG_FDNReverb::_updateGains() {
+    // -60 dB after `_decay` seconds: g = 10^(-3 * delay / (T60 * fs))
+    for (int l = 0; l < kLines; ++l) {
+        _lineGain[l] = powf(10.0f, -3.0f * (float)_lineDelay[l] / (_decay * _sampleRate));
+    }
+}
+
+void CTAG_FDNReverb::process(float* buffer, size_t numSamples) {
+    // 1) Input diffusion in internal RAM (per-sample random access is cheap there).
+    for (size_t i = 0; i < numSamples; ++i) {
+        float v = buffer[i];
+        for (int d = 0; d < kDiffusers; ++d) {
+            Allpass& ap = _diffusers[d];
+            if (!ap.buf) continue;
+            float delayed = ap.buf[ap.pos];
+            float w = v + kDiffuserGain * delayed;
+            ap.buf[ap.pos] = w;
+            v = delayed - kDiffuserGain * w;
+            if (++ap.pos >= ap.length) ap.pos = 0;
+        }
+        _diffused[i] = v;
+    }
+
+    // 2) One contiguous PSRAM read per line.
+    for (int l = 0; l < kLines; ++l) {
+        _lines[l].read(_taps[l], _lineDelay[l], numSamples);
+    }
+
+    // 3) Damping, Hadamard feedback matrix and output mix. The new line
+    //    inputs overwrite the taps in place.
+    const float lpCoeff = 1.0f - _damping;
+    float s0 = _lpState[0], s1 = _lpState[1], s2 = _lpState[2], s3 = _lpState[3];
+    for (size_t i = 0; i < numSamples; ++i) {
+        float o0 = _taps[0][i], o1 = _taps[1][i], o2 = _taps[2][i], o3 = _taps[3][i];
+
+        s0 += lpCoeff * (o0 - s0);
+        s1 += lpCoeff * (o1 - s1);
+        s2 += lpCoeff * (o2 - s2);
+        s3 += lpCoeff * (o3 - s3);
+
+        // Normalized 4x4 Hadamard matrix (orthogonal, so the loop stays stable for g < 1).
+        float a = s0 + s1, b = s0 - s1, c = s2 + s3, e = s2 - s3;
+        float in = _diffused[i];
+        _taps[0][i] = CTAG_AudioEngine::protectDenormal(in + _lineGain[0] * 0.5f * (a + c));
+        _taps[1][i] = CTAG_AudioEngine::protectDenormal(in + _lineGain[1] * 0.5f * (b + e));
+        _taps[2][i] = CTAG_AudioEngine::protectDenormal(in + _lineGain[2] * 0.5f * (a - c));
+        _taps[3][i] = CTAG_AudioEngine::protectDenormal(in + _lineGain[3] * 0.5f * (b - e));
+
+        float wet = 0.5f * (o0 + o1 + o2 + o3);
+        float x = buffer[i];
+        buffer[i] = x + _mix * (wet - x);
+    }
+    _lpState[0] = CTAG_AudioEngine::protectDenormal(s0);
+    _lpState[1] = CTAG_AudioEngine::protectDenormal(s1);
+    _lpState[2] = CTAG_AudioEngine::protectDenormal(s2);
+    _lpState[3] = CTAG_AudioEngine::protectDenormal(s3);
+
+    // 4) One contiguous PSRAM write per line.
+    for (int l = 0; l < kLines; ++l) {
+        _lines[l].write(_taps[l], numSamples);
+    }
+}
+
+void CTAG_FDNReverb::reset() {
+    for (int l = 0; l < kLines; ++l) {
+        _lines[l].clear();
+        _lpState[l] = 0.0f;
+    }
+    for (int d = 0; d < kDiffusers; ++d) {
+        if (_diffusers[d].buf) memset(_diffusers[d].buf, 0, _diffusers[d].length * sizeof(float));
+        _diffusers[d].pos = 0;
+    }
+}
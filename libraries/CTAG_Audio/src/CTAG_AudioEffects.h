@@ -0,0 +1,202 @@
+/**
+ * @file CTAG_AudioEffects.h
+ * @brief Delay and reverb effects for the CTAG audio engine.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * Long delay lines are placed in PSRAM, where random access per sample is
+ * slow. Both effects therefore only touch PSRAM in contiguous chunks of one
+ * block: every delay tap is read once per block into internal RAM, processed
+ * there, and the new block is written back in one piece. This requires all
+ * PSRAM delays to be at least CTAG_AUDIO_BLOCK_SIZE samples long. Short
+ * structures (diffusion allpasses) stay in internal RAM.
+ *
+ * 1. CTAG_Delay: Feedback delay with click-free delay time changes.
+ * 2. CTAG_FDNReverb: Four-line feedback delay network reverb with input diffusion.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_EFFECTS_H
+#define CTAG_AUDIO_EFFECTS_H
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioPool.h"
+
+/**
+ * @class CTAG_PsramDelayLine
+ * @brief Circular float buffer that is only accessed in contiguous chunks.
+ */
+class CTAG_PsramDelayLine {
+public:
+    ~CTAG_PsramDelayLine();
+
+    /**
+     * @brief Allocates the line. Call once during setup.
+     * @param length Capacity in samples.
+     * @param region Memory region (default PSRAM, falls back to internal RAM).
+     * @return True on success.
+     */
+    bool begin(size_t length, CTAG_AudioMemory::Region region = CTAG_AudioMemory::Region::Psram);
+
+    /**
+     * @brief Copies the n samples written `delay` samples ago into dst.
+     * @param dst Destination buffer in internal RAM.
+     * @param delay Delay in samples (n ≤ delay ≤ length()).
+     * @param n Number of samples.
+     */
+    void read(float* dst, size_t delay, size_t n) const;
+
+    /**
+     * @brief Appends n samples to the line and advances the write position.
+     */
+    void write(const float* src, size_t n);
+
+    /**
+     * @brief Clears the line.
+     */
+    void clear();
+
+    /**
+     * @brief Capacity of the line in samples.
+     */
+    size_t length() const { return _length; }
+
+private:
+    float* _buf    = nullptr;
+    size_t _length = 0;
+    size_t _write  = 0;
+};
+
+
+/**
+ * @class CTAG_Delay
+ * @brief Feedback delay whose delay line lives in PSRAM.
+ *
+ * Delay time changes are crossfaded over one block to avoid clicks.
+ */
+class CTAG_Delay : public CTAG_AudioEffect {
+public:
+    /**
+     * @brief Constructs a new delay.
+     * @param sampleRate The sample rate of the audio engine (e.g., 44100.0f).
+     */
+    CTAG_Delay(float sampleRate = 44100.0f);
+
+    /**
+     * @brief Allocates the delay line. Call once during setup.
+     * @param maxDelaySeconds Longest delay time that will be used.
+     * @return True on success.
+     */
+    bool begin(float maxDelaySeconds = 2.0f);
+
+    /**
+     * @brief Sets the delay time (clamped to one block … maxDelaySeconds).
+     * @param seconds Delay time in seconds.
+     */
+    void setDelayTime(float seconds);
+
+    /**
+     * @brief Sets the feedback amount.
+     * @param feedback 0.0 (single echo) to 0.95.
+     */
+    void setFeedback(float feedback);
+
+    /**
+     * @brief Sets the dry/wet balance.
+     * @param mix 0.0 (dry) to 1.0 (wet only).
+     */
+    void setMix(float mix);
+
+    void process(float* buffer, size_t numSamples) override;
+    void reset() override;
+
+private:
+    float  _sampleRate;
+    CTAG_PsramDelayLine _line;
+    size_t _delay       = CTAG_AUDIO_BLOCK_SIZE; ///< Delay used for the next block.
+    size_t _activeDelay = CTAG_AUDIO_BLOCK_SIZE; ///< Delay used for the last block.
+    float  _feedback    = 0.4f;
+    float  _mix         = 0.3f;
+
+    // Internal-RAM scratch for the PSRAM chunks.
+    float _tapOld[CTAG_AUDIO_BLOCK_SIZE];
+    float _tapNew[CTAG_AUDIO_BLOCK_SIZE];
+    float _feed[CTAG_AUDIO_BLOCK_SIZE];
+};
+
+
+/**
+ * @class CTAG_FDNReverb
+ * @brief Four-line feedback delay network reverb.
+ *
+ * The input is diffused by four short allpasses in internal RAM, then fed
+ * into four long delay lines in PSRAM that are mixed by a Hadamard matrix
+ * with one-pole damping in the feedback path.
+ */
+class CTAG_FDNReverb : public CTAG_AudioEffect {
+public:
+    /**
+     * @brief Constructs a new reverb.
+     * @param sampleRate The sample rate of the audio engine (e.g., 44100.0f).
+     */
+    CTAG_FDNReverb(float sampleRate = 44100.0f);
+
+    /**
+     * @brief Allocates all delay lines. Call once during setup.
+     * @return True on success.
+     */
+    bool begin();
+
+    /**
+     * @brief Sets the decay time.
+     * @param seconds Time for the tail to decay by 60 dB (0.1 – 20 s).
+     */
+    void setDecay(float seconds);
+
+    /**
+     * @brief Sets the high-frequency damping in the feedback path.
+     * @param damping 0.0 (bright) to 0.95 (dark).
+     */
+    void setDamping(float damping);
+
+    /**
+     * @brief Sets the dry/wet balance.
+     * @param mix 0.0 (dry) to 1.0 (wet only).
+     */
+    void setMix(float mix);
+
+    void process(float* buffer, size_t numSamples) override;
+    void reset() override;
+
+private:
+    static const int kLines     = 4;
+    static const int kDiffusers = 4;
+
+    /**
+     * @brief Schroeder allpass with a short delay line in internal RAM.
+     */
+    struct Allpass {
+        float* buf    = nullptr;
+        size_t length = 0;
+        size_t pos    = 0;
+    };
+
+    void _updateGains();
+
+    float _sampleRate;
+    float _decay   = 2.0f;
+    float _damping = 0.3f;
+    float _mix     = 0.25f;
+
+    CTAG_PsramDelayLine _lines[kLines];
+    size_t _lineDelay[kLines];
+    float  _lineGain[kLines];
+    float  _lpState[kLines] = {};
+
+    Allpass _diffusers[kDiffusers];
+
+    // Internal-RAM scratch for the PSRAM chunks.
+    float _taps[kLines][CTAG_AUDIO_BLOCK_SIZE];
+    float _diffused[CTAG_AUDIO_BLOCK_SIZE];
+};
+
+#endif // CTAG_AUDIO_EFFECTS_H
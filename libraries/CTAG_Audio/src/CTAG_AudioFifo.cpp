@@ -0,0 +1,81 @@
+/**
+ * @file CTAG_AudioFifo.cpp
+ * @brief Implementation of the single-producer/single-consumer frame FIFO.
+ */
+#include "CTAG_AudioFifo.h"
+
+bool CTAG_AudioFifo::begin(size_t frames, uint8_t channels, CTAG_AudioMemory::Region region) {
+    end();
+    if (frames == 0 || channels == 0) return false;
+
+    size_t cap = 1;
+    while (cap < frames) cap <<= 1;
+
+    _buf = (int16_t*)CTAG_AudioMemory::allocate(cap * channels * sizeof(int16_t), region);
+    if (!_buf) return false;
+    memset(_buf, 0, cap * channels * sizeof(int16_t));
+
+    _capacity = cap;
+    _mask     = cap - 1;
+    _channels = channels;
+    _head = _tail = 0;
+    return true;
+}
+
+void CTAG_AudioFifo::end() {
+    if (_buf) CTAG_AudioMemory::release(_buf);
+    _buf = nullptr;
+    _capacity = _mask = 0;
+    _head = _tail = 0;
+}
+
+size_t CTAG_AudioFifo::write(const int16_t* frames, size_t numFrames) {
+    if (!_buf) return 0;
+    size_t n    = min(numFrames, space());
+    size_t head = _head;
+    // Copy in at most two pieces around the wrap point.
+    size_t first = min(n, _capacity - (head & _mask));
+    memcpy(_buf + (head & _mask) * _channels, frames, first * _channels * sizeof(int16_t));
+    memcpy(_buf, frames + first * _channels, (n - first) * _channels * sizeof(int16_t));
+    _head = head + n;
+    return n;
+}
+
+size_t CTAG_AudioFifo::writeFloat(const float* samples, size_t numFrames, size_t step) {
+    // Converted in small pieces on the stack, so sinks need no block-sized buffer.
+    const size_t kConv = 64;
+    if (!_buf || _channels > kConv) return 0;
+    int16_t pcm[kConv];
+    const size_t perPass = kConv / _channels;
+    size_t done = 0;
+    while (done < numFrames) {
+        size_t n = min(perPass, numFrames - done);
+        for (size_t f = 0; f < n; ++f) {
+            const float* in = samples + (done + f) * step * _channels;
+            for (uint8_t c = 0; c < _channels; ++c) {
+                pcm[f * _channels + c] = (int16_t)(constrain(in[c], -1.0f, 1.0f) * 32767.0f);
+            }
+        }
+        size_t w = write(pcm, n);
+        done += w;
+        if (w < n) break;
+    }
+    return done;
+}
+
+size_t CTAG_AudioFifo::read(int16_t* frames, size_t numFrames) {
+    if (!_buf) return 0;
+    size_t n    = min(numFrames, available());
+    size_t tail = _tail;
+    size_t first = min(n, _capacity - (tail & _mask));
+    memcpy(frames, _buf + (tail & _mask) * _channels, first * _channels * sizeof(int16_t));
+    memcpy(frames + first * _channels, _buf, (n - first) * _channels * sizeof(int16_t));
+    _tail = tail + n;
+    return n;
+}
+
+size_t CTAG_AudioFifo::skip(size_t numFrames) {
+    size_t n = min(numFrames, available());
+    _tail = _tail + n;
+    return n;
+}
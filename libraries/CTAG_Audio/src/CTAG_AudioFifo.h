@@ -0,0 +1,100 @@
+/**
+ * @file CTAG_AudioFifo.h
+ * @brief Lock-free frame FIFO for handing audio between tasks.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * 1. CTAG_AudioFifo: Single-producer/single-consumer ring of interleaved int16 frames.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_FIFO_H
+#define CTAG_AUDIO_FIFO_H
+
+#include <Arduino.h>
+#include "CTAG_AudioPool.h"
+
+/**
+ * @class CTAG_AudioFifo
+ * @brief Ring buffer of interleaved 16-bit frames between exactly one writer
+ * task and one reader task.
+ *
+ * Read and write positions are free-running frame counters; each side only
+ * writes its own counter, so no lock is needed. The capacity is rounded up to
+ * a power of two.
+ */
+class CTAG_AudioFifo {
+public:
+    CTAG_AudioFifo() {}
+    ~CTAG_AudioFifo() { end(); }
+
+    CTAG_AudioFifo(const CTAG_AudioFifo&) = delete;
+    CTAG_AudioFifo& operator=(const CTAG_AudioFifo&) = delete;
+
+    /**
+     * @brief Allocates the ring.
+     * @param frames Minimum capacity in frames (rounded up to a power of two).
+     * @param channels Samples per frame.
+     * @param region Memory region of the storage.
+     * @return False if the memory could not be allocated.
+     */
+    bool begin(size_t frames, uint8_t channels,
+               CTAG_AudioMemory::Region region = CTAG_AudioMemory::Region::Internal);
+
+    /**
+     * @brief Releases the storage.
+     */
+    void end();
+
+    /**
+     * @brief Appends up to numFrames frames (writer side).
+     * @return Number of frames actually written.
+     */
+    size_t write(const int16_t* frames, size_t numFrames);
+
+    /**
+     * @brief Converts normalized float frames to 16 bit and appends them
+     * (writer side). Samples outside [-1, 1] are clipped.
+     * @param samples Interleaved float frames.
+     * @param numFrames Number of frames to append.
+     * @param step Only every step-th frame is taken, e.g. to decimate a
+     * block that has been low-passed.
+     * @return Number of frames actually written.
+     */
+    size_t writeFloat(const float* samples, size_t numFrames, size_t step = 1);
+
+    /**
+     * @brief Removes up to numFrames frames (reader side).
+     * @return Number of frames actually read.
+     */
+    size_t read(int16_t* frames, size_t numFrames);
+
+    /**
+     * @brief Drops up to numFrames frames without copying them (reader side).
+     * @return Number of frames dropped.
+     */
+    size_t skip(size_t numFrames);
+
+    /**
+     * @brief Frames ready to be read.
+     */
+    size_t available() const { return _head - _tail; }
+
+    /**
+     * @brief Frames that can be written without overflowing.
+     */
+    size_t space() const { return _capacity - available(); }
+
+    size_t  capacity() const { return _capacity; }
+    uint8_t channels() const { return _channels; }
+
+private:
+    int16_t* _buf      = nullptr;
+    size_t   _capacity = 0;
+    size_t   _mask     = 0;
+    uint8_t  _channels = 0;
+
+    volatile size_t _head = 0; ///< Frames written so far, owned by the writer.
+    volatile size_t _tail = 0; ///< Frames read so far, owned by the reader.
+};
+
+#endif // CTAG_AUDIO_FIFO_H
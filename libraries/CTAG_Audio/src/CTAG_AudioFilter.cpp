@@ -0,0 +1,288 @@
+/**
+ * @file CTAG_AudioFilter.cpp
+ * @brief Implementation of the biquad and state-variable filters.
+ */
+#include "CTAG_AudioFilter.h"
+
+static inline float _clampFreq(float freq, float sampleRate) {
+    return constrain(freq, 10.0f, 0.49f * sampleRate);
+}
+
+// =========================================================================
+// === CTAG_BiquadFilter Implementation                                  ===
+// =========================================================================
+
+CTAG_BiquadFilter::CTAG_BiquadFilter(float sampleRate, uint8_t stages)
+    : _sampleRate(sampleRate)
+{
+    setStages(stages);
+    _updateCoefficients();
+}
+
+void CTAG_BiquadFilter::setType(CTAG_FilterType type) {
+    _type = type;
+    _dirty = true;
+}
+
+void CTAG_BiquadFilter::setFrequency(float freq) {
+    _freq = _clampFreq(freq, _sampleRate);
+    _dirty = true;
+}
+
+void CTAG_BiquadFilter::setQ(float q) {
+    _q = constrain(q, 0.1f, 30.0f);
+    _dirty = true;
+}
+
+void CTAG_BiquadFilter::setGain(float gainDb) {
+    _gainDb = constrain(gainDb, -24.0f, 24.0f);
+    _dirty = true;
+}
+
+void CTAG_BiquadFilter::setStages(uint8_t stages) {
+    _stages = constrain(stages, (uint8_t)1, (uint8_t)CTAG_BIQUAD_MAX_STAGES);
+}
+
+void CTAG_BiquadFilter::_updateCoefficients() {
+    _dirty = false;
+
+    // RBJ Audio EQ Cookbook
+    float w0    = 2.0f * (float)M_PI * _freq / _sampleRate;
+    float cosw  = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * _q);
+    float A     = powf(10.0f, _gainDb / 40.0f);
+    float b0, b1, b2, a0, a1, a2;
+
+    switch (_type) {
+        case CTAG_FilterType::HighPass:
+            b0 = (1.0f + cosw) * 0.5f; b1 = -(1.0f + cosw); b2 = b0;
+            a0 = 1.0f + alpha;         a1 = -2.0f * cosw;   a2 = 1.0f - alpha;
+            break;
+        case CTAG_FilterType::BandPass:
+            b0 = alpha;                b1 = 0.0f;           b2 = -alpha;
+            a0 = 1.0f + alpha;         a1 = -2.0f * cosw;   a2 = 1.0f - alpha;
+            break;
+        case CTAG_FilterType::Notch:
+            b0 = 1.0f;                 b1 = -2.0f * cosw;   b2 = 1.0f;
+            a0 = 1.0f + alpha;         a1 = -2.0f * cosw;   a2 = 1.0f - alpha;
+            break;
+        case CTAG_FilterType::Peak:
+            b0 = 1.0f + alpha * A;     b1 = -2.0f * cosw;   b2 = 1.0f - alpha * A;
+            a0 = 1.0f + alpha / A;     a1 = -2.0f * cosw;   a2 = 1.0f - alpha / A;
+            break;
+        case CTAG_FilterType::LowShelf: {
+            float sq = 2.0f * sqrtf(A) * alpha;
+            b0 =        A * ((A + 1.0f) - (A - 1.0f) * cosw + sq);
+            b1 = 2.0f * A * ((A - 1.0f) - (A + 1.0f) * cosw);
+            b2 =        A * ((A + 1.0f) - (A - 1.0f) * cosw - sq);
+            a0 =             (A + 1.0f) + (A - 1.0f) * cosw + sq;
+            a1 =    -2.0f * ((A - 1.0f) + (A + 1.0f) * cosw);
+            a2 =             (A + 1.0f) + (A - 1.0f) * cosw - sq;
+            break;
+        }
+        case CTAG_FilterType::HighShelf: {
+            float sq = 2.0f * sqrtf(A) * alpha;
+            b0 =         A * ((A + 1.0f) + (A - 1.0f) * cosw + sq);
+            b1 = -2.0f * A * ((A - 1.0f) + (A + 1.0f) * cosw);
+            b2 =         A * ((A + 1.0f) + (A - 1.0f) * cosw - sq);
+            a0 =              (A + 1.0f) - (A - 1.0f) * cosw + sq;
+            a1 =      2.0f * ((A - 1.0f) - (A + 1.0f) * cosw);
+            a2 =              (A + 1.0f) - (A - 1.0f) * cosw - sq;
+            break;
+        }
+        case CTAG_FilterType::LowPass:
+        default:
+            b0 = (1.0f - cosw) * 0.5f; b1 = 1.0f - cosw;    b2 = b0;
+            a0 = 1.0f + alpha;         a1 = -2.0f * cosw;   a2 = 1.0f - alpha;
+            break;
+    }
+
+    float inv = 1.0f / a0;
+    _b0 = b0 * inv; _b1 = b1 * inv; _b2 = b2 * inv;
+    _a1 = a1 * inv; _a2 = a2 * inv;
+}
+
+float CTAG_BiquadFilter::magnitudeAt(float freq) {
+    if (_dirty) _updateCoefficients();
+
+    // |H(e^jw)| of one section, raised to the number of stages
+    float w = 2.0f * (float)M_PI * freq / _sampleRate;
+    float c1 = cosf(w), s1 = sinf(w), c2 = cosf(2.0f * w), s2 = sinf(2.0f * w);
+    float nr = _b0 + _b1 * c1 + _b2 * c2, ni = -(_b1 * s1 + _b2 * s2);
+    float dr = 1.0f + _a1 * c1 + _a2 * c2, di = -(_a1 * s1 + _a2 * s2);
+    float mag = sqrtf((nr * nr + ni * ni) / (dr * dr + di * di));
+    return powf(mag, (float)_stages);
+}
+
+void CTAG_BiquadFilter::process(float* buffer, size_t numSamples) {
+    // Coefficients are updated once per block, not per sample.
+    if (_dirty) _updateCoefficients();
+
+    const float b0 = _b0, b1 = _b1, b2 = _b2, a1 = _a1, a2 = _a2;
+    for (uint8_t s = 0; s < _stages; ++s) {
+        float z1 = _z1[s], z2 = _z2[s];
+        for (size_t i = 0; i < numSamples; ++i) {
+            float x = buffer[i];
+            float y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            buffer[i] = y;
+        }
+        _z1[s] = CTAG_AudioEngine::protectDenormal(z1);
+        _z2[s] = CTAG_AudioEngine::protectDenormal(z2);
+    }
+}
+
+void CTAG_BiquadFilter::reset() {
+    for (int s = 0; s < CTAG_BIQUAD_MAX_STAGES; ++s) {
+        _z1[s] = 0.0f;
+        _z2[s] = 0.0f;
+    }
+}
+
+
+// =========================================================================
+// === CTAG_SVFilter Implementation                                      ===
+// =========================================================================
+
+/**
+ * @brief Per-block TPT coefficients derived from cutoff and resonance.
+ */
+struct _SvfCoeffs {
+    float a1, a2, a3, k;
+};
+
+static inline _SvfCoeffs _svfCoeffs(float freq, float res, float sampleRate) {
+    _SvfCoeffs c;
+    float g = tanf((float)M_PI * freq / sampleRate);
+    c.k  = 2.0f - 2.0f * constrain(res, 0.0f, 0.995f); // k = 1/Q, Q from 0.5 upward
+    c.a1 = 1.0f / (1.0f + g * (g + c.k));
+    c.a2 = g * c.a1;
+    c.a3 = g * c.a2;
+    return c;
+}
+
+CTAG_SVFilter::CTAG_SVFilter(float sampleRate)
+    : _sampleRate(sampleRate)
+{
+}
+
+void CTAG_SVFilter::setType(CTAG_FilterType type) {
+    _type = type;
+}
+
+void CTAG_SVFilter::setFrequency(float freq) {
+    _freq = _clampFreq(freq, _sampleRate);
+}
+
+void CTAG_SVFilter::setResonance(float res) {
+    _res = constrain(res, 0.0f, 1.0f);
+}
+
+void CTAG_SVFilter::process(float* buffer, size_t numSamples) {
+    const _SvfCoeffs c = _svfCoeffs(_freq, _res, _sampleRate);
+    float ic1 = _ic1, ic2 = _ic2;
+
+    for (size_t i = 0; i < numSamples; ++i) {
+        float v0 = buffer[i];
+        float v3 = v0 - ic2;
+        float v1 = c.a1 * ic1 + c.a2 * v3;
+        float v2 = ic2 + c.a2 * ic1 + c.a3 * v3;
+        ic1 = 2.0f * v1 - ic1;
+        ic2 = 2.0f * v2 - ic2;
+
+        switch (_type) {
+            case CTAG_FilterType::HighPass: buffer[i] = v0 - c.k * v1 - v2; break;
+            case CTAG_FilterType::BandPass: buffer[i] = c.k * v1;           break;
+            case CTAG_FilterType::Notch:    buffer[i] = v0 - c.k * v1;      break;
+            default:                        buffer[i] = v2;                 break;
+        }
+    }
+
+    _ic1 = CTAG_AudioEngine::protectDenormal(ic1);
+    _ic2 = CTAG_AudioEngine::protectDenormal(ic2);
+}
+
+void CTAG_SVFilter::reset() {
+    _ic1 = 0.0f;
+    _ic2 = 0.0f;
+}
+
+
+// =========================================================================
+// === CTAG_SVFilterBank4 Implementation                                 ===
+// =========================================================================
+
+CTAG_SVFilterBank4::CTAG_SVFilterBank4(float sampleRate)
+    : _sampleRate(sampleRate)
+{
+    for (int l = 0; l < kLanes; ++l) {
+        _freq[l] = 1000.0f;
+        _res[l]  = 0.0f;
+    }
+}
+
+void CTAG_SVFilterBank4::setType(CTAG_FilterType type) {
+    _type = type;
+}
+
+void CTAG_SVFilterBank4::setFrequency(int lane, float freq) {
+    if (lane < 0 || lane >= kLanes) return;
+    _freq[lane] = _clampFreq(freq, _sampleRate);
+}
+
+void CTAG_SVFilterBank4::setResonance(int lane, float res) {
+    if (lane < 0 || lane >= kLanes) return;
+    _res[lane] = constrain(res, 0.0f, 1.0f);
+}
+
+void CTAG_SVFilterBank4::process(float* const voices[kLanes], size_t numSamples) {
+    float a1[kLanes], a2[kLanes], a3[kLanes], k[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+        _SvfCoeffs c = _svfCoeffs(_freq[l], _res[l], _sampleRate);
+        a1[l] = c.a1; a2[l] = c.a2; a3[l] = c.a3; k[l] = c.k;
+    }
+
+    // Output mix: out = m0 * v0 + m1 * (k * v1) + m2 * v2, identical for all lanes.
+    float m0, m1, m2;
+    switch (_type) {
+        case CTAG_FilterType::HighPass: m0 = 1.0f; m1 = -1.0f; m2 = -1.0f; break;
+        case CTAG_FilterType::BandPass: m0 = 0.0f; m1 =  1.0f; m2 =  0.0f; break;
+        case CTAG_FilterType::Notch:    m0 = 1.0f; m1 = -1.0f; m2 =  0.0f; break;
+        default:                        m0 = 0.0f; m1 =  0.0f; m2 =  1.0f; break;
+    }
+
+    float ic1[kLanes], ic2[kLanes];
+    memcpy(ic1, _ic1, sizeof(ic1));
+    memcpy(ic2, _ic2, sizeof(ic2));
+
+    for (size_t i = 0; i < numSamples; ++i) {
+        float v0[kLanes];
+        for (int l = 0; l < kLanes; ++l) v0[l] = voices[l][i];
+
+        // Lane-parallel body: identical operations on all four voices.
+        float out[kLanes];
+        for (int l = 0; l < kLanes; ++l) {
+            float v3 = v0[l] - ic2[l];
+            float v1 = a1[l] * ic1[l] + a2[l] * v3;
+            float v2 = ic2[l] + a2[l] * ic1[l] + a3[l] * v3;
+            ic1[l] = 2.0f * v1 - ic1[l];
+            ic2[l] = 2.0f * v2 - ic2[l];
+            out[l] = m0 * v0[l] + m1 * k[l] * v1 + m2 * v2;
+        }
+
+        for (int l = 0; l < kLanes; ++l) voices[l][i] = out[l];
+    }
+
+    for (int l = 0; l < kLanes; ++l) {
+        _ic1[l] = CTAG_AudioEngine::protectDenormal(ic1[l]);
+        _ic2[l] = CTAG_AudioEngine::protectDenormal(ic2[l]);
+    }
+}
+
+void CTAG_SVFilterBank4::reset() {
+    for (int l = 0; l < kLanes; ++l) {
+        _ic1[l] = 0.0f;
+        _ic2[l] = 0.0f;
+    }
+}
@@ -0,0 +1,217 @@
+/**
+ * @file CTAG_AudioFilter.h
+ * @brief Block-processing filters for the CTAG audio library.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * All filters store their parameters immediately but recompute their
+ * coefficients only once, at the start of the next block. Parameter
+ * setters are therefore cheap and may be called from the control task.
+ *
+ * 1. CTAG_BiquadFilter: Cascade of identical RBJ biquad sections.
+ * 2. CTAG_SVFilter: Topology-preserving-transform state-variable filter.
+ * 3. CTAG_SVFilterBank4: Four independent SVF voices processed lane-parallel.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_FILTER_H
+#define CTAG_AUDIO_FILTER_H
+
+#include "CTAG_Audio.h"
+
+/**
+ * @brief Maximum number of sections in a CTAG_BiquadFilter cascade.
+ */
+#ifndef CTAG_BIQUAD_MAX_STAGES
+#define CTAG_BIQUAD_MAX_STAGES 4
+#endif
+
+/**
+ * @brief Response types shared by the filters.
+ * @note The SVF supports LowPass, HighPass, BandPass and Notch only.
+ */
+enum class CTAG_FilterType : uint8_t {
+    LowPass,
+    HighPass,
+    BandPass,  ///< Constant 0 dB peak gain.
+    Notch,
+    Peak,      ///< Biquad only.
+    LowShelf,  ///< Biquad only.
+    HighShelf  ///< Biquad only.
+};
+
+
+/**
+ * @class CTAG_BiquadFilter
+ * @brief Cascade of identical biquad sections (RBJ cookbook, transposed direct form II).
+ *
+ * Each stage adds 12 dB/oct of slope for the pass/stop types.
+ */
+class CTAG_BiquadFilter : public CTAG_AudioEffect {
+public:
+    /**
+     * @brief Constructs a new biquad cascade.
+     * @param sampleRate The sample rate of the audio engine (e.g., 44100.0f).
+     * @param stages Number of cascaded sections (1 … CTAG_BIQUAD_MAX_STAGES).
+     */
+    CTAG_BiquadFilter(float sampleRate = 44100.0f, uint8_t stages = 1);
+
+    /**
+     * @brief Sets the response type.
+     */
+    void setType(CTAG_FilterType type);
+
+    /**
+     * @brief Sets the cutoff/center frequency.
+     * @param freq Frequency in Hz (clamped to 10 Hz … 0.49 * sampleRate).
+     */
+    void setFrequency(float freq);
+
+    /**
+     * @brief Sets the quality factor of each section.
+     * @param q 0.1 to 30 (0.7071 gives a Butterworth section).
+     */
+    void setQ(float q);
+
+    /**
+     * @brief Sets the gain of the Peak and Shelf types.
+     * @param gainDb Gain in dB (-24 … +24).
+     */
+    void setGain(float gainDb);
+
+    /**
+     * @brief Sets the number of cascaded sections.
+     * @param stages 1 … CTAG_BIQUAD_MAX_STAGES.
+     */
+    void setStages(uint8_t stages);
+
+    /**
+     * @brief Computes the analytic magnitude response of the whole cascade.
+     * @note Uses the current parameters, useful to verify the measured response.
+     * @param freq Frequency in Hz.
+     * @return Linear magnitude.
+     */
+    float magnitudeAt(float freq);
+
+    void process(float* buffer, size_t numSamples) override;
+    void reset() override;
+
+private:
+    void _updateCoefficients();
+
+    float _sampleRate;
+    CTAG_FilterType _type = CTAG_FilterType::LowPass;
+    float   _freq   = 1000.0f;
+    float   _q      = 0.7071f;
+    float   _gainDb = 0.0f;
+    uint8_t _stages = 1;
+    volatile bool _dirty = true;
+
+    // Normalized coefficients (a0 == 1)
+    float _b0 = 1.0f, _b1 = 0.0f, _b2 = 0.0f, _a1 = 0.0f, _a2 = 0.0f;
+    float _z1[CTAG_BIQUAD_MAX_STAGES] = {};
+    float _z2[CTAG_BIQUAD_MAX_STAGES] = {};
+};
+
+
+/**
+ * @class CTAG_SVFilter
+ * @brief Zero-delay-feedback state-variable filter (Zavalishin TPT structure).
+ *
+ * Stays stable and well-behaved under fast cutoff modulation, which makes it
+ * the filter of choice for subtractive voices.
+ */
+class CTAG_SVFilter : public CTAG_AudioEffect {
+public:
+    /**
+     * @brief Constructs a new state-variable filter.
+     * @param sampleRate The sample rate of the audio engine (e.g., 44100.0f).
+     */
+    CTAG_SVFilter(float sampleRate = 44100.0f);
+
+    /**
+     * @brief Sets the response type (LowPass, HighPass, BandPass or Notch).
+     */
+    void setType(CTAG_FilterType type);
+
+    /**
+     * @brief Sets the cutoff frequency.
+     * @param freq Frequency in Hz (clamped to 10 Hz … 0.49 * sampleRate).
+     */
+    void setFrequency(float freq);
+
+    /**
+     * @brief Sets the resonance.
+     * @param res 0.0 (Q = 0.5) to 1.0 (self-oscillation edge).
+     */
+    void setResonance(float res);
+
+    void process(float* buffer, size_t numSamples) override;
+    void reset() override;
+
+private:
+    float _sampleRate;
+    CTAG_FilterType _type = CTAG_FilterType::LowPass;
+    float _freq = 1000.0f;
+    float _res  = 0.0f;
+
+    float _ic1 = 0.0f, _ic2 = 0.0f;
+};
+
+
+/**
+ * @class CTAG_SVFilterBank4
+ * @brief Four independent state-variable filters, one voice per lane.
+ *
+ * The state is stored structure-of-arrays, so the inner loop processes all
+ * four lanes with the same instructions. Compilers vectorize it on targets
+ * with float SIMD; on the ESP32-S3, whose SIMD unit is integer-only, it
+ * still saves the per-voice loop and call overhead.
+ */
+class CTAG_SVFilterBank4 {
+public:
+    static const int kLanes = 4;
+
+    /**
+     * @brief Constructs a new filter bank.
+     * @param sampleRate The sample rate of the audio engine (e.g., 44100.0f).
+     */
+    CTAG_SVFilterBank4(float sampleRate = 44100.0f);
+
+    /**
+     * @brief Sets the response type of all lanes.
+     */
+    void setType(CTAG_FilterType type);
+
+    /**
+     * @brief Sets the cutoff frequency of one lane.
+     */
+    void setFrequency(int lane, float freq);
+
+    /**
+     * @brief Sets the resonance (0.0 … 1.0) of one lane.
+     */
+    void setResonance(int lane, float res);
+
+    /**
+     * @brief Filters four voice buffers in place.
+     * @param voices Four pointers to blocks of numSamples samples each.
+     * @param numSamples Number of samples per voice.
+     */
+    void process(float* const voices[kLanes], size_t numSamples);
+
+    /**
+     * @brief Clears the state of all lanes.
+     */
+    void reset();
+
+private:
+    float _sampleRate;
+    CTAG_FilterType _type = CTAG_FilterType::LowPass;
+    float _freq[kLanes];
+    float _res[kLanes];
+
+    float _ic1[kLanes] = {};
+    float _ic2[kLanes] = {};
+};
+
+#endif // CTAG_AUDIO_FILTER_H
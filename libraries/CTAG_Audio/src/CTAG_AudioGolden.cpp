@@ -0,0 +1,118 @@
+/**
+ * @file CTAG_AudioGolden.cpp
+ * @brief Implementation of the golden-output regression helpers.
+ */
+#include "CTAG_AudioGolden.h"
+
+namespace CTAG_AudioGolden {
+
+int16_t toPcm16(float x) {
+    x = constrain(x, -1.0f, 1.0f);
+    return (int16_t)(x * 32767.0f);
+}
+
+void render(CTAG_AudioSource& src, StepFn step, int16_t* out, size_t numFrames) {
+    float block[CTAG_AUDIO_BLOCK_SIZE];
+    for (size_t b = 0; b * CTAG_AUDIO_BLOCK_SIZE < numFrames; ++b) {
+        if (step) step(src, b);
+        src.renderBlock(block, CTAG_AUDIO_BLOCK_SIZE);
+        for (size_t i = 0; i < CTAG_AUDIO_BLOCK_SIZE; ++i) {
+            out[b * CTAG_AUDIO_BLOCK_SIZE + i] = toPcm16(block[i]);
+        }
+    }
+}
+
+Result compare(const int16_t* ref, const int16_t* test, size_t n, Mode mode, float minSnrDb) {
+    Result r = { true, INFINITY, -1, 0 };
+    double signal = 0.0, noise = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        int32_t err = (int32_t)test[i] - (int32_t)ref[i];
+        if (err != 0 && r.firstMismatch < 0) r.firstMismatch = (int32_t)i;
+        if (abs(err) > r.maxAbsError) r.maxAbsError = abs(err);
+        signal += (double)ref[i] * ref[i];
+        noise  += (double)err * err;
+    }
+    if (noise > 0.0) {
+        r.snrDb = (signal > 0.0) ? (float)(10.0 * log10(signal / noise)) : -INFINITY;
+    }
+
+    if (mode == Mode::BitExact) r.passed = (r.firstMismatch < 0);
+    else                        r.passed = (r.snrDb >= minSnrDb);
+    return r;
+}
+
+uint32_t hash(const int16_t* data, size_t n) {
+    const uint8_t* p = (const uint8_t*)data;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n * sizeof(int16_t); ++i) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// --- Built-in parameter sequences ---
+// Each sequence changes parameters at block boundaries so that phase
+// continuity across parameter changes is covered as well.
+
+static void _stepSine(CTAG_AudioSource& src, size_t block) {
+    CTAG_VCO_Sine& vco = static_cast<CTAG_VCO_Sine&>(src);
+    switch (block) {
+        case 0: vco.setFrequency(440.0f);  vco.setAmplitude(0.5f); break;
+        case 1: vco.setFrequency(1000.0f); break;
+        case 2: vco.setLfoRate(6.0f);      vco.setLfoDepth(50.0f); break;
+        case 3: vco.setAmplitude(1.0f);    break;
+    }
+}
+
+static void _stepSquare(CTAG_AudioSource& src, size_t block) {
+    CTAG_VCO_Square& vco = static_cast<CTAG_VCO_Square&>(src);
+    switch (block) {
+        case 0: vco.setFrequency(220.0f);  vco.setAmplitude(0.5f); break;
+        case 1: vco.setDutyCycle(0.2f);    break;
+        case 2: vco.setFrequency(1760.0f); vco.setDutyCycle(0.9f); break;
+        case 3: vco.setAmplitude(1.0f);    break;
+    }
+}
+
+static void _stepSaw(CTAG_AudioSource& src, size_t block) {
+    CTAG_VCO_Saw& vco = static_cast<CTAG_VCO_Saw&>(src);
+    switch (block) {
+        case 0: vco.setFrequency(110.0f);  vco.setAmplitude(0.5f); break;
+        case 1: vco.setSkew(0.05f);        break;
+        case 2: vco.setFrequency(3000.0f); vco.setSkew(0.95f); break;
+        case 3: vco.setAmplitude(1.0f);    break;
+    }
+}
+
+static void _stepFM(CTAG_AudioSource& src, size_t block) {
+    CTAG_FMSynth& fm = static_cast<CTAG_FMSynth&>(src);
+    switch (block) {
+        case 0: fm.setCarrierFreq(440.0f); fm.setModFreq(220.0f); fm.setAmplitude(0.5f); break;
+        case 1: fm.setModIndex(2.0f);      break;
+        case 2: fm.setModFreq(1320.0f);    fm.setModIndex(8.0f); break;
+        case 3: fm.setAmplitude(1.0f);     break;
+    }
+}
+
+static void _renderSine(int16_t* out, size_t n)   { CTAG_VCO_Sine   s; render(s, _stepSine,   out, n); }
+static void _renderSquare(int16_t* out, size_t n) { CTAG_VCO_Square s; render(s, _stepSquare, out, n); }
+static void _renderSaw(int16_t* out, size_t n)    { CTAG_VCO_Saw    s; render(s, _stepSaw,    out, n); }
+static void _renderFM(int16_t* out, size_t n)     { CTAG_FMSynth    s; render(s, _stepFM,     out, n); }
+
+static const Case _cases[] = {
+    { "VCO_Sine",   _renderSine   },
+    { "VCO_Square", _renderSquare },
+    { "VCO_Saw",    _renderSaw    },
+    { "FMSynth",    _renderFM     },
+};
+
+size_t numCases() {
+    return sizeof(_cases) / sizeof(_cases[0]);
+}
+
+const Case& getCase(size_t index) {
+    return _cases[index < numCases() ? index : 0];
+}
+
+} // namespace CTAG_AudioGolden
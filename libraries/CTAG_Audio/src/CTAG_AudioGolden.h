@@ -0,0 +1,112 @@
+/**
+ * @file CTAG_AudioGolden.h
+ * @brief Golden-output regression helpers for the CTAG audio library.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * Renders fixed parameter sequences for every built-in source and compares
+ * the result against checked-in reference buffers, either bit-exact or with
+ * an SNR threshold. Use it to prove that refactors of the DSP math
+ * (phase handling, clamping, conversion) keep the output unchanged.
+ *
+ * 1. CTAG_AudioGolden
+ */
+#pragma once
+#ifndef CTAG_AUDIO_GOLDEN_H
+#define CTAG_AUDIO_GOLDEN_H
+
+#include "CTAG_Audio.h"
+
+/**
+ * @namespace CTAG_AudioGolden
+ * @brief Rendering and comparison helpers for golden-output checks.
+ */
+namespace CTAG_AudioGolden {
+
+    /**
+     * @brief Number of blocks rendered per golden case.
+     */
+    constexpr size_t kNumBlocks = 4;
+
+    /**
+     * @brief Number of mono samples rendered per golden case.
+     */
+    constexpr size_t kNumFrames = kNumBlocks * CTAG_AUDIO_BLOCK_SIZE;
+
+    /**
+     * @brief How a rendered buffer is compared against its reference.
+     */
+    enum class Mode : uint8_t {
+        BitExact,  ///< Every sample must match exactly.
+        Tolerance  ///< The signal-to-error ratio must reach a threshold.
+    };
+
+    /**
+     * @brief Outcome of a comparison.
+     */
+    struct Result {
+        bool    passed;        ///< True if the comparison passed in the requested mode.
+        float   snrDb;         ///< Reference energy over error energy in dB (INFINITY if identical).
+        int32_t firstMismatch; ///< Index of the first differing sample, -1 if none.
+        int32_t maxAbsError;   ///< Largest absolute sample difference.
+    };
+
+    /**
+     * @brief Called before each block to apply the parameter sequence.
+     * @param src The source under test.
+     * @param block Index of the block about to be rendered.
+     */
+    using StepFn = void(*)(CTAG_AudioSource& src, size_t block);
+
+    /**
+     * @brief A named, fixed render scenario.
+     */
+    struct Case {
+        const char* name;                               ///< Case name, used to match references.
+        void (*render)(int16_t* out, size_t numFrames); ///< Renders the case from a fresh source.
+    };
+
+    /**
+     * @brief Converts a normalized float sample to 16 bit like the engine does.
+     */
+    int16_t toPcm16(float x);
+
+    /**
+     * @brief Renders a source block by block, applying a parameter sequence.
+     * @param src The source to render.
+     * @param step Parameter sequence, may be nullptr.
+     * @param out Destination buffer with room for numFrames samples.
+     * @param numFrames Number of samples to render (multiple of CTAG_AUDIO_BLOCK_SIZE).
+     */
+    void render(CTAG_AudioSource& src, StepFn step, int16_t* out, size_t numFrames);
+
+    /**
+     * @brief Compares a rendered buffer against a reference.
+     * @param ref The reference samples.
+     * @param test The rendered samples.
+     * @param n Number of samples.
+     * @param mode Bit-exact or tolerance comparison.
+     * @param minSnrDb Minimum SNR in Tolerance mode.
+     * @return The comparison result.
+     */
+    Result compare(const int16_t* ref, const int16_t* test, size_t n,
+                   Mode mode, float minSnrDb = 90.0f);
+
+    /**
+     * @brief FNV-1a hash of a sample buffer, handy for quick bit-exact checks.
+     */
+    uint32_t hash(const int16_t* data, size_t n);
+
+    /**
+     * @brief Returns the number of built-in golden cases.
+     */
+    size_t numCases();
+
+    /**
+     * @brief Returns a built-in golden case.
+     * @param index Case index (0 … numCases() - 1).
+     */
+    const Case& getCase(size_t index);
+}
+
+#endif // CTAG_AUDIO_GOLDEN_H
@@ -0,0 +1,125 @@
+/**
+ * @file CTAG_AudioParams.cpp
+ * @brief Implementation of the parameter bank and the plugin rack.
+ */
+#include "CTAG_AudioParams.h"
+
+static const float kBlockMs = 1000.0f * CTAG_AUDIO_BLOCK_SIZE / CTAG_AUDIO_SAMPLE_RATE;
+static const float kSnap    = 1e-4f; ///< Normalized distance at which a glide ends.
+
+
+// --- CTAG_ParamBank ---
+
+bool CTAG_ParamBank::bind(CTAG_AudioSource* source) {
+    const CTAG_PluginDesc* desc = source ? source->getPluginDesc() : nullptr;
+    if (!desc || desc->numParams > CTAG_PARAMS_MAX_PER_PLUGIN) return false;
+
+    _source = source;
+    _desc   = desc;
+    _count  = desc->numParams;
+    for (uint8_t i = 0; i < _count; ++i) {
+        const CTAG_ParamDesc& p = desc->params[i];
+        Slot& s = _slots[i];
+        s.desc    = &p;
+        s.target  = p.toRaw(p.def);
+        s.current = s.target * (1.0f / CTAG_ParamDesc::kRawMax);
+        s.coeff   = (p.smoothingMs == 0 || p.curve == CTAG_ParamCurve::Stepped)
+                        ? 1.0f : 1.0f - expf(-kBlockMs / p.smoothingMs);
+        source->setParam(p.id, p.fromNormalized(s.current));
+    }
+    return true;
+}
+
+int CTAG_ParamBank::_indexOf(uint8_t id) const {
+    for (uint8_t i = 0; i < _count; ++i) {
+        if (_slots[i].desc->id == id) return i;
+    }
+    return -1;
+}
+
+bool CTAG_ParamBank::setRaw(uint8_t id, uint16_t raw) {
+    int i = _indexOf(id);
+    if (i < 0) return false;
+    _slots[i].target = raw;
+    return true;
+}
+
+bool CTAG_ParamBank::setValue(uint8_t id, float value) {
+    int i = _indexOf(id);
+    if (i < 0) return false;
+    _slots[i].target = _slots[i].desc->toRaw(value);
+    return true;
+}
+
+float CTAG_ParamBank::getValue(uint8_t id) const {
+    int i = _indexOf(id);
+    return i < 0 ? 0.0f : _slots[i].desc->fromNormalized(_slots[i].current);
+}
+
+void CTAG_ParamBank::process(bool immediate) {
+    if (!_source) return;
+    for (uint8_t i = 0; i < _count; ++i) {
+        Slot& s = _slots[i];
+        const float target = s.target * (1.0f / CTAG_ParamDesc::kRawMax);
+        if (s.current == target) continue;
+
+        // Glide in the normalized domain, so exponential parameters move
+        // evenly in octaves rather than in Hz.
+        float next = s.current + s.coeff * (target - s.current);
+        if (immediate || fabsf(target - next) < kSnap) next = target;
+        s.current = next;
+        _source->setParam(s.desc->id, s.desc->fromNormalized(next));
+    }
+}
+
+
+// --- CTAG_PluginRack ---
+
+bool CTAG_PluginRack::add(CTAG_AudioSource* source) {
+    if (_count >= CTAG_RACK_MAX_PLUGINS) return false;
+    if (!_banks[_count].bind(source)) return false;
+    if (_count == 0) _requested = _banks[0].desc()->id;
+    ++_count;
+    return true;
+}
+
+CTAG_ParamBank* CTAG_PluginRack::find(uint8_t pluginId) {
+    for (uint8_t i = 0; i < _count; ++i) {
+        if (_banks[i].desc()->id == pluginId) return &_banks[i];
+    }
+    return nullptr;
+}
+
+bool CTAG_PluginRack::handleMessage(const uint8_t* data, size_t len) {
+    if (len < 2 || (data[0] != CTAG_Params::kMsgId && data[0] != CTAG_Params::kSyncMsgId)) return false;
+    CTAG_ParamBank* bank = find(data[1]);
+    if (!bank) return false;
+
+    auto apply = [bank](uint8_t id, uint16_t raw) { bank->setRaw(id, raw); };
+    uint8_t plugin;
+    if (data[0] == CTAG_Params::kSyncMsgId) {
+        uint16_t version;
+        bool keyframe;
+        if (!CTAG_Params::parseSync(data, len, plugin, version, keyframe, apply)) return false;
+        _sync.accept(plugin, version, keyframe);
+    } else if (!CTAG_Params::parse(data, len, plugin, apply)) {
+        return false;
+    }
+    _requested = plugin;
+    return true;
+}
+
+void CTAG_PluginRack::update() {
+    const uint8_t requested = _requested;
+    if (requested != _active) {
+        CTAG_ParamBank* bank = find(requested);
+        if (bank) {
+            // Targets may have moved while the plugin was not playing.
+            bank->process(true);
+            CTAG_AudioEngine::setSource(bank->source());
+            _active = requested;
+        }
+    }
+    CTAG_ParamBank* bank = find(_active);
+    if (bank) bank->process();
+}
@@ -0,0 +1,172 @@
+/**
+ * @file CTAG_AudioParams.h
+ * @brief Applies CTAG_Params messages to audio sources, with smoothing.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * The controller sends parameters as (ID, normalized value) pairs; the
+ * sources describe their parameters with CTAG_PluginDesc. In between sits
+ * the parameter bank of each source: it stores the incoming targets, glides
+ * towards them once per block with the smoothing time of the descriptor and
+ * hands the curve-mapped values to CTAG_AudioSource::setParam(). A rack
+ * holds the banks of all plugins and switches the engine's source, so a
+ * sketch needs no per-plugin code at all:
+ *
+ * @code
+ * rack.add(&sine); rack.add(&fm);
+ * void onSpiPacket(const uint8_t* d, size_t n) { rack.handleMessage(d, n); }
+ * // audio task:
+ * rack.update();
+ * CTAG_AudioEngine::renderBlock();
+ * @endcode
+ *
+ * The rack also takes the versioned deltas and keyframes of CTAG_ParamSync.
+ * When it sees a gap in their version numbers, needsKeyframe() turns true
+ * until the next keyframe; the sketch then sends a keyframe request back.
+ *
+ * setRaw(), select() and handleMessage() use integers only and do not block,
+ * so they may be called from the SPI slave's ISR callback.
+ *
+ * 1. CTAG_ParamBank: Targets, smoothing and dispatch for one source.
+ * 2. CTAG_PluginRack: The banks of all plugins, plus plugin selection.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_PARAMS_H
+#define CTAG_AUDIO_PARAMS_H
+
+#include "CTAG_Audio.h"
+#include <CTAG_ParamSync.h>
+
+/**
+ * @brief Most parameters one bank handles.
+ */
+#ifndef CTAG_PARAMS_MAX_PER_PLUGIN
+#define CTAG_PARAMS_MAX_PER_PLUGIN 8
+#endif
+
+/**
+ * @brief Most plugins in a CTAG_PluginRack.
+ */
+#ifndef CTAG_RACK_MAX_PLUGINS
+#define CTAG_RACK_MAX_PLUGINS 8
+#endif
+
+/**
+ * @class CTAG_ParamBank
+ * @brief Parameter state of one source.
+ */
+class CTAG_ParamBank {
+public:
+    /**
+     * @brief Attaches a source and applies the default value of every parameter.
+     * @return False if the source has no descriptor or more than
+     * CTAG_PARAMS_MAX_PER_PLUGIN parameters.
+     */
+    bool bind(CTAG_AudioSource* source);
+
+    CTAG_AudioSource*      source() const { return _source; }
+    const CTAG_PluginDesc* desc() const   { return _desc; }
+
+    /**
+     * @brief Sets the target of a parameter from its normalized wire value.
+     * @return False if the plugin has no such parameter.
+     * @note ISR-safe.
+     */
+    bool setRaw(uint8_t id, uint16_t raw);
+
+    /**
+     * @brief Sets the target of a parameter in its own unit.
+     */
+    bool setValue(uint8_t id, float value);
+
+    /**
+     * @brief Current (smoothed) value of a parameter, or 0 if unknown.
+     */
+    float getValue(uint8_t id) const;
+
+    /**
+     * @brief Moves every parameter towards its target and passes changed
+     * values to the source. Call once per block on the audio task.
+     * @param immediate True to jump to the targets without smoothing.
+     */
+    void process(bool immediate = false);
+
+private:
+    struct Slot {
+        const CTAG_ParamDesc* desc;
+        volatile uint16_t     target;   ///< Normalized, written by any task or ISR.
+        float                 current;  ///< Normalized, audio task only.
+        float                 coeff;    ///< One-pole step per block, 1 = no smoothing.
+    };
+
+    int _indexOf(uint8_t id) const;
+
+    CTAG_AudioSource*      _source = nullptr;
+    const CTAG_PluginDesc* _desc   = nullptr;
+    Slot                   _slots[CTAG_PARAMS_MAX_PER_PLUGIN];
+    uint8_t                _count  = 0;
+};
+
+/**
+ * @class CTAG_PluginRack
+ * @brief Parameter banks of several plugins; one of them plays at a time.
+ */
+class CTAG_PluginRack {
+public:
+    /**
+     * @brief Adds a plugin. Its descriptor ID is the ID used on the wire.
+     * @return False if the rack is full or the source has no descriptor.
+     */
+    bool add(CTAG_AudioSource* source);
+
+    /**
+     * @brief Bank of a plugin by its ID, or nullptr.
+     */
+    CTAG_ParamBank* find(uint8_t pluginId);
+
+    /**
+     * @brief Requests a plugin switch; it happens in the next update().
+     * @note ISR-safe.
+     */
+    void select(uint8_t pluginId) { _requested = pluginId; }
+
+    /**
+     * @brief ID of the plugin that is playing (0xFF before the first update()).
+     */
+    uint8_t selected() const { return _active; }
+
+    /**
+     * @brief Applies a CTAG_Params message or a CTAG_ParamSync delta or
+     * keyframe: selects its plugin and sets the targets of its parameters.
+     * @return False if the message is malformed or names an unknown plugin.
+     * @note ISR-safe.
+     */
+    bool handleMessage(const uint8_t* data, size_t len);
+
+    /**
+     * @brief True if a sync message was lost (or none has arrived yet) and
+     * the sender should be asked for a keyframe, see CTAG_Params::buildResync().
+     */
+    bool needsKeyframe() const { return _sync.needsKeyframe(); }
+
+    /**
+     * @brief Version tracking of the sync messages.
+     */
+    const CTAG_SyncTracker& syncTracker() const { return _sync; }
+
+    /**
+     * @brief Performs a pending plugin switch on the engine and smooths the
+     * active plugin's parameters. Call once per block on the audio task,
+     * before CTAG_AudioEngine::renderBlock().
+     */
+    void update();
+
+private:
+    CTAG_ParamBank   _banks[CTAG_RACK_MAX_PLUGINS];
+    uint8_t          _count     = 0;
+    volatile uint8_t _requested = 0;
+    uint8_t          _active    = 0xFF;
+    CTAG_SyncTracker _sync;
+};
+
+#endif // CTAG_AUDIO_PARAMS_H
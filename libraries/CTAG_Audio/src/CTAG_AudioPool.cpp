@@ -0,0 +1,152 @@
+/**
+ * @file CTAG_AudioPool.cpp
+ * @brief Implementation of the setup-time allocator and the buffer pool.
+ */
+#include "CTAG_AudioPool.h"
+
+#ifdef ESP32
+#include "esp_heap_caps.h"
+#endif
+
+namespace CTAG_AudioMemory {
+
+static volatile bool     _locked       = false;
+static volatile uint32_t _lockedAllocs = 0;
+static size_t            _bytes        = 0;
+
+// Every allocation is prefixed with its size so release() can keep the byte count.
+static const size_t kHeader = 8;
+
+#ifdef ESP32
+static uint32_t _caps(Region region) {
+    switch (region) {
+        case Region::Internal: return MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+        case Region::Dma:      return MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL;
+        case Region::Psram:    return MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+        default:               return MALLOC_CAP_8BIT;
+    }
+}
+#endif
+
+void* allocate(size_t bytes, Region region) {
+    if (_locked) {
+        _lockedAllocs = _lockedAllocs + 1;
+        return nullptr;
+    }
+
+    uint8_t* raw = nullptr;
+#ifdef ESP32
+    raw = (uint8_t*)heap_caps_malloc(bytes + kHeader, _caps(region));
+    if (!raw && region == Region::Psram) {
+        // Boards without (enabled) PSRAM still get a working, smaller setup.
+        raw = (uint8_t*)heap_caps_malloc(bytes + kHeader, _caps(Region::Internal));
+    }
+#else
+    (void)region;
+    raw = (uint8_t*)malloc(bytes + kHeader);
+#endif
+    if (!raw) return nullptr;
+
+    *(size_t*)raw = bytes;
+    _bytes += bytes;
+    return raw + kHeader;
+}
+
+void release(void* ptr) {
+    if (!ptr) return;
+    uint8_t* raw = (uint8_t*)ptr - kHeader;
+    _bytes -= *(size_t*)raw;
+#ifdef ESP32
+    heap_caps_free(raw);
+#else
+    free(raw);
+#endif
+}
+
+void lockAllocations() {
+    _locked = true;
+}
+
+bool allocationsLocked() {
+    return _locked;
+}
+
+uint32_t lockedAllocAttempts() {
+    return _lockedAllocs;
+}
+
+size_t bytesAllocated() {
+    return _bytes;
+}
+
+} // namespace CTAG_AudioMemory
+
+
+// =========================================================================
+// === CTAG_BufferPool Implementation                                    ===
+// =========================================================================
+
+CTAG_BufferPool::~CTAG_BufferPool() {
+    end();
+}
+
+bool CTAG_BufferPool::begin(size_t bufferBytes, size_t count, CTAG_AudioMemory::Region region) {
+    if (_memory || count == 0) return false;
+
+    // Every buffer must hold the free-list link and stay word aligned for DMA.
+    if (bufferBytes < sizeof(void*)) bufferBytes = sizeof(void*);
+    bufferBytes = (bufferBytes + 3u) & ~(size_t)3u;
+
+    // The in-use bitmap shares the allocation, so release() can reject a second release.
+    _memory = (uint8_t*)CTAG_AudioMemory::allocate(bufferBytes * count + (count + 7) / 8, region);
+    if (!_memory) return false;
+    _used = _memory + bufferBytes * count;
+    memset(_used, 0, (count + 7) / 8);
+
+    _bufferBytes = bufferBytes;
+    _count       = count;
+    _inUse       = 0;
+    _peak        = 0;
+    _free        = nullptr;
+    for (size_t i = count; i-- > 0; ) {
+        void* buf = _memory + i * bufferBytes;
+        *(void**)buf = _free;
+        _free = buf;
+    }
+    return true;
+}
+
+void CTAG_BufferPool::end() {
+    CTAG_AudioMemory::release(_memory);
+    _memory      = nullptr;
+    _used        = nullptr;
+    _free        = nullptr;
+    _bufferBytes = 0;
+    _count       = 0;
+    _inUse       = 0;
+}
+
+void* CTAG_BufferPool::acquire() {
+    void* buf = _free;
+    if (!buf) {
+        ++_failedAllocs;
+        return nullptr;
+    }
+    _free = *(void**)buf;
+    const size_t i = ((uint8_t*)buf - _memory) / _bufferBytes;
+    _used[i / 8] |= (uint8_t)(1u << (i % 8));
+    if (++_inUse > _peak) _peak = _inUse;
+    return buf;
+}
+
+void CTAG_BufferPool::release(void* buffer) {
+    // A foreign pointer or a second release would corrupt the free list
+    if (!owns(buffer)) return;
+    const size_t i = ((uint8_t*)buffer - _memory) / _bufferBytes;
+    const uint8_t bit = (uint8_t)(1u << (i % 8));
+    if (!(_used[i / 8] & bit)) return;
+    _used[i / 8] &= (uint8_t)~bit;
+    *(void**)buffer = _free;
+    _free = buffer;
+    --_inUse;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file CTAG_AudioPool.h
+ * @brief Fixed-capacity object and buffer pools for the CTAG libraries.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * All memory is reserved once during setup. Afterwards voices, event nodes
+ * and DMA buffers are taken from and returned to the pools in O(1) without
+ * touching the heap, so nothing on a real-time path ever calls malloc.
+ *
+ * 1. CTAG_AudioMemory: Setup-time allocation from a specific memory region.
+ * 2. CTAG_ObjectPool: Typed pool for voices, event nodes, etc.
+ * 3. CTAG_BufferPool: Pool of equally sized raw buffers (e.g., DMA-capable).
+ */
+#pragma once
+#ifndef CTAG_AUDIO_POOL_H
+#define CTAG_AUDIO_POOL_H
+
+#include <Arduino.h>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Usage statistics reported by all pools.
+ */
+struct CTAG_PoolStats {
+    size_t   capacity;     ///< Number of slots in the pool.
+    size_t   inUse;        ///< Slots currently handed out.
+    size_t   peak;         ///< Highest number of slots in use at the same time.
+    uint32_t failedAllocs; ///< Requests that could not be served because the pool was empty.
+};
+
+
+/**
+ * @namespace CTAG_AudioMemory
+ * @brief Setup-time allocation from a specific memory region.
+ */
+namespace CTAG_AudioMemory {
+
+    /**
+     * @brief Memory region an allocation should come from.
+     * @note On non-ESP32 targets every region maps to the normal heap.
+     */
+    enum class Region : uint8_t {
+        Default,  ///< Any 8-bit capable memory.
+        Internal, ///< Internal SRAM (MALLOC_CAP_INTERNAL), fast random access.
+        Dma,      ///< DMA-capable internal SRAM (MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL).
+        Psram     ///< External PSRAM (MALLOC_CAP_SPIRAM), falls back to internal RAM.
+    };
+
+    /**
+     * @brief Allocates memory from a region.
+     * @note Intended for setup only. Once lockAllocations() was called this
+     * returns nullptr and counts a violation instead.
+     * @param bytes Number of bytes.
+     * @param region The memory region.
+     * @return Pointer to 4-byte aligned memory, or nullptr.
+     */
+    void* allocate(size_t bytes, Region region = Region::Default);
+
+    /**
+     * @brief Frees memory obtained from allocate().
+     */
+    void release(void* ptr);
+
+    /**
+     * @brief Forbids further allocate() calls, e.g. at the end of setup().
+     */
+    void lockAllocations();
+
+    /**
+     * @brief Returns true once lockAllocations() has been called.
+     */
+    bool allocationsLocked();
+
+    /**
+     * @brief Number of allocate() calls made after lockAllocations().
+     */
+    uint32_t lockedAllocAttempts();
+
+    /**
+     * @brief Total number of bytes currently held through allocate().
+     */
+    size_t bytesAllocated();
+}
+
+
+/**
+ * @class CTAG_ObjectPool
+ * @brief Fixed-capacity pool of objects of type T with O(1) create/destroy.
+ *
+ * The storage is part of the pool object itself, so a pool declared as a
+ * global or static lives in .bss and never touches the heap.
+ * @note Not thread-safe. Use one pool per task, or guard it externally.
+ * @tparam T The object type.
+ * @tparam N The number of slots.
+ */
+template <typename T, size_t N>
+class CTAG_ObjectPool {
+public:
+    CTAG_ObjectPool() {
+        for (size_t i = 0; i < N; ++i) {
+            _slots[i].next = (i + 1 < N) ? &_slots[i + 1] : nullptr;
+        }
+        _free = N ? &_slots[0] : nullptr;
+    }
+
+    CTAG_ObjectPool(const CTAG_ObjectPool&) = delete;
+    CTAG_ObjectPool& operator=(const CTAG_ObjectPool&) = delete;
+
+    /**
+     * @brief Constructs a new object in a free slot.
+     * @param args Constructor arguments forwarded to T.
+     * @return Pointer to the object, or nullptr if the pool is exhausted.
+     */
+    template <typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot = _free;
+        if (!slot) {
+            ++_failedAllocs;
+            return nullptr;
+        }
+        _free = slot->next;
+        if (++_inUse > _peak) _peak = _inUse;
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys an object and returns its slot to the pool.
+     * @param obj Pointer obtained from create(), nullptr is ignored.
+     */
+    void destroy(T* obj) {
+        if (!owns(obj)) return;
+        obj->~T();
+        Slot* slot = reinterpret_cast<Slot*>(obj);
+        slot->next = _free;
+        _free = slot;
+        --_inUse;
+    }
+
+    /**
+     * @brief Returns true if the pointer belongs to this pool.
+     */
+    bool owns(const T* obj) const {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(obj);
+        const uint8_t* begin = reinterpret_cast<const uint8_t*>(&_slots[0]);
+        const uint8_t* end = reinterpret_cast<const uint8_t*>(&_slots[N]);
+        return p >= begin && p < end && ((size_t)(p - begin) % sizeof(Slot)) == 0;
+    }
+
+    /**
+     * @brief Number of free slots.
+     */
+    size_t available() const { return N - _inUse; }
+
+    /**
+     * @brief Returns the usage statistics of the pool.
+     */
+    CTAG_PoolStats getStats() const {
+        return CTAG_PoolStats{ N, _inUse, _peak, _failedAllocs };
+    }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) uint8_t storage[sizeof(T)];
+    };
+
+    Slot     _slots[N];
+    Slot*    _free         = nullptr;
+    size_t   _inUse        = 0;
+    size_t   _peak         = 0;
+    uint32_t _failedAllocs = 0;
+};
+
+
+/**
+ * @class CTAG_BufferPool
+ * @brief Pool of equally sized raw buffers carved from one region allocation.
+ *
+ * Typical use is a set of DMA-capable sample buffers that are allocated once
+ * in setup() and then handed between the audio task and drivers.
+ * @note Not thread-safe. Use one pool per task, or guard it externally.
+ */
+class CTAG_BufferPool {
+public:
+    CTAG_BufferPool() {}
+    ~CTAG_BufferPool();
+
+    CTAG_BufferPool(const CTAG_BufferPool&) = delete;
+    CTAG_BufferPool& operator=(const CTAG_BufferPool&) = delete;
+
+    /**
+     * @brief Reserves the memory for all buffers. Call once during setup.
+     * @param bufferBytes Size of a single buffer (rounded up to 4 bytes).
+     * @param count Number of buffers.
+     * @param region Memory region, e.g. Region::Dma for I2S/SPI buffers.
+     * @return True on success.
+     */
+    bool begin(size_t bufferBytes, size_t count,
+               CTAG_AudioMemory::Region region = CTAG_AudioMemory::Region::Dma);
+
+    /**
+     * @brief Releases the memory of the pool. All buffers must have been returned.
+     */
+    void end();
+
+    /**
+     * @brief Takes a buffer from the pool.
+     * @return Pointer to a buffer of bufferSize() bytes, or nullptr if exhausted.
+     */
+    void* acquire();
+
+    /**
+     * @brief Returns a buffer to the pool.
+     * @param buffer Pointer obtained from acquire(). nullptr, pointers that do
+     * not belong to this pool and buffers that are not handed out (a second
+     * release) are ignored.
+     */
+    void release(void* buffer);
+
+    /**
+     * @brief Returns true if the pointer is the start of one of this pool's buffers.
+     */
+    bool owns(const void* buffer) const {
+        const uint8_t* p = static_cast<const uint8_t*>(buffer);
+        return _memory && p >= _memory && p < _memory + _bufferBytes * _count &&
+               ((size_t)(p - _memory) % _bufferBytes) == 0;
+    }
+
+    /**
+     * @brief Size of a single buffer in bytes.
+     */
+    size_t bufferSize() const { return _bufferBytes; }
+
+    /**
+     * @brief Returns the usage statistics of the pool.
+     */
+    CTAG_PoolStats getStats() const {
+        return CTAG_PoolStats{ _count, _inUse, _peak, _failedAllocs };
+    }
+
+private:
+    uint8_t* _memory       = nullptr;
+    uint8_t* _used         = nullptr; // one bit per buffer, behind the buffers
+    void*    _free         = nullptr; // free buffers are chained through their first word
+    size_t   _bufferBytes  = 0;
+    size_t   _count        = 0;
+    size_t   _inUse        = 0;
+    size_t   _peak         = 0;
+    uint32_t _failedAllocs = 0;
+};
+
+#endif // CTAG_AUDIO_POOL_H
@@ -0,0 +1,161 @@
+/**
+ * @file CTAG_AudioPower.cpp
+ * @brief Implementation of the CPU clock governor.
+ */
+#include "CTAG_AudioPower.h"
+
+const uint16_t CTAG_CpuGovernor::kStepsMhz[CTAG_CpuGovernor::kNumSteps] = { 80, 160, 240 };
+
+static const float kBlockSeconds = (float)CTAG_AUDIO_BLOCK_SIZE / CTAG_AUDIO_SAMPLE_RATE;
+
+uint8_t CTAG_CpuGovernor::_stepOf(uint16_t mhz) const {
+    for (uint8_t i = 0; i < kNumSteps; ++i) {
+        if (kStepsMhz[i] == mhz) return i;
+    }
+    return 0xFF;
+}
+
+bool CTAG_CpuGovernor::begin(const Config& config) {
+    uint8_t lo = _stepOf(config.minMhz);
+    uint8_t hi = _stepOf(config.maxMhz);
+    if (lo == 0xFF || hi == 0xFF || lo > hi) return false;
+
+    _config  = config;
+    _minStep = lo;
+    _maxStep = hi;
+    if (!setCpuFrequencyMhz(kStepsMhz[_maxStep])) return false;
+    _step = _maxStep;
+
+    _loadAtMax    = 0.0f;
+    _windowPeak   = 0.0f;
+    _holdCounter  = 0;
+    _boostCounter = 0;
+    _lastPatchChanges = CTAG_AudioEngine::getStats().patchChanges;
+    resetStats();
+    _running = true;
+    return true;
+}
+
+void CTAG_CpuGovernor::end() {
+    if (!_running) return;
+    _running = false;
+    _setStep(_maxStep);
+}
+
+void CTAG_CpuGovernor::setPowerModel(const float mw[kNumSteps]) {
+    for (uint8_t i = 0; i < kNumSteps; ++i) _powerMw[i] = mw[i];
+}
+
+void CTAG_CpuGovernor::_setStep(uint8_t step) {
+    if (step == _step) return;
+    const uint32_t t0 = micros();
+    if (!setCpuFrequencyMhz(kStepsMhz[step])) return;
+    const uint32_t us = micros() - t0;
+    if (us > _maxSwitchUs) _maxSwitchUs = us;
+    _step = step;
+    ++_switches;
+}
+
+bool CTAG_CpuGovernor::_takeBoostRequest(uint32_t patchChanges) {
+    bool boost = false;
+    if (_boostRequest) {
+        _boostRequest = false;
+        boost = true;
+    }
+    if (patchChanges < _lastPatchChanges) {
+        // CTAG_AudioEngine::resetStats() restarted the count; only changes
+        // made since then are new
+        if (patchChanges > 0) boost = true;
+    } else if (patchChanges != _lastPatchChanges) {
+        boost = true;
+    }
+    _lastPatchChanges = patchChanges;
+    return boost;
+}
+
+void CTAG_CpuGovernor::_boost() {
+    if (_step != _maxStep || _boostCounter == 0) ++_boosts;
+    _boostCounter = _config.boostBlocks;
+    _holdCounter  = 0;
+    _windowPeak   = 0.0f;
+    _setStep(_maxStep);
+}
+
+void CTAG_CpuGovernor::prepare() {
+    if (!_running) return;
+    if (_takeBoostRequest(CTAG_AudioEngine::getStats().patchChanges)) _boost();
+}
+
+void CTAG_CpuGovernor::update() {
+    if (!_running) return;
+    CTAG_AudioEngine::Stats es = CTAG_AudioEngine::getStats();
+    ++_blocksAt[_step];
+
+    // Everything below is compared at the highest clock, so it stays valid
+    // across clock changes.
+    const float scale = (float)kStepsMhz[_step] / kStepsMhz[_maxStep];
+    const float block = es.blockLoad * scale;
+    _loadAtMax += 0.05f * (block - _loadAtMax);
+
+    // Changes prepare() has not seen (e.g. when it is not called) count here.
+    bool boostNow = _takeBoostRequest(es.patchChanges);
+    if (es.blockLoad > _config.upLoad) boostNow = true;
+
+    if (boostNow) {
+        _boost();
+        return;
+    }
+    if (_boostCounter > 0) {
+        --_boostCounter;
+        return;
+    }
+    if (_step <= _minStep) return;
+
+    // Step down only if the heaviest block of a whole hold period would have
+    // stayed below downLoad one step lower.
+    if (block > _windowPeak) _windowPeak = block;
+    const float predicted = _windowPeak * kStepsMhz[_maxStep] / kStepsMhz[_step - 1];
+    if (predicted >= _config.downLoad) {
+        _holdCounter = 0;
+        _windowPeak  = block;
+        return;
+    }
+    if (++_holdCounter >= _config.holdBlocks) {
+        _holdCounter = 0;
+        _windowPeak  = 0.0f;
+        _setStep(_step - 1);
+    }
+}
+
+CTAG_CpuGovernor::Stats CTAG_CpuGovernor::getStats() const {
+    Stats s = {};
+    s.mhz         = kStepsMhz[_step];
+    s.loadAtMax   = _loadAtMax;
+    s.load        = _loadAtMax * kStepsMhz[_maxStep] / kStepsMhz[_step];
+    s.switches    = _switches;
+    s.boosts      = _boosts;
+    s.maxSwitchUs = _maxSwitchUs;
+
+    float total = 0.0f, mhzSum = 0.0f, energy = 0.0f;
+    for (uint8_t i = 0; i < kNumSteps; ++i) {
+        s.seconds[i] = _blocksAt[i] * kBlockSeconds;
+        total  += s.seconds[i];
+        mhzSum += s.seconds[i] * kStepsMhz[i];
+        energy += s.seconds[i] * _powerMw[i] * 0.001f;
+    }
+    if (total > 0.0f) {
+        s.averageMhz = mhzSum / total;
+        s.energyJ    = energy;
+        s.averageMw  = energy * 1000.0f / total;
+        const float fixedMw = _powerMw[_maxStep];
+        if (fixedMw > 0.0f) s.savedPercent = 100.0f * (1.0f - s.averageMw / fixedMw);
+    }
+    return s;
+}
+
+void CTAG_CpuGovernor::resetStats() {
+    _switches    = 0;
+    _boosts      = 0;
+    _maxSwitchUs = 0;
+    for (uint8_t i = 0; i < kNumSteps; ++i) _blocksAt[i] = 0;
+}
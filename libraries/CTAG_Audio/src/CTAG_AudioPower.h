@@ -0,0 +1,151 @@
+/**
+ * @file CTAG_AudioPower.h
+ * @brief CPU clock governor driven by the audio engine's load.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * The governor picks the lowest CPU clock at which the audio task keeps a
+ * safe margin to its deadline:
+ * - a block that takes more than upLoad of the block period (at the current
+ *   clock) switches straight to the highest clock, before the next block;
+ * - a change of sources or effects, or a call to boost(), also switches to
+ *   the highest clock and holds it for a while. prepare(), called right
+ *   before the block is rendered, does this before the new patch renders
+ *   its first block; update() alone only notices the change after that
+ *   block, which then ran at the old clock;
+ * - the clock steps down one step at a time, and only after the heaviest
+ *   block of a whole hold period would have stayed below downLoad at the
+ *   lower clock.
+ *
+ * Only 80, 160 and 240 MHz are used. All three are divided from the same
+ * PLL, which also clocks I2S on the ESP32-S3 (the S3 has no APLL; the
+ * engine's use_apll request is ignored there), and APB stays at 80 MHz, so
+ * the I2S sample clock, micros() and the peripherals are not affected by a
+ * switch and nothing has to be re-tuned. Below 80 MHz the CPU would run
+ * from the crystal and the PLL could be stopped; the governor never goes
+ * there.
+ *
+ * The clock is shared by both cores: tasks on core 0 (analyzer, recorder,
+ * USB) slow down too. Raise minMhz if they need a fixed speed.
+ *
+ * The chip has no power meter, so energy figures come from a power model:
+ * the board's power at each clock, measured once (e.g. with a USB power
+ * meter) and passed to setPowerModel(). Without it only the time spent at
+ * each clock and the average clock are reported.
+ *
+ * 1. CTAG_CpuGovernor: Load-driven CPU frequency scaling with statistics.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_POWER_H
+#define CTAG_AUDIO_POWER_H
+
+#include "CTAG_Audio.h"
+
+/**
+ * @class CTAG_CpuGovernor
+ * @brief Scales the CPU clock with the audio load. Call update() once per block.
+ */
+class CTAG_CpuGovernor {
+public:
+    /// Number of clock steps.
+    static const uint8_t kNumSteps = 3;
+
+    /// Clock steps in MHz, from slowest to fastest.
+    static const uint16_t kStepsMhz[kNumSteps];
+
+    /**
+     * @brief Governor thresholds. Loads are render time / block period.
+     */
+    struct Config {
+        uint16_t minMhz      = 80;   ///< Lowest clock the governor may use.
+        uint16_t maxMhz      = 240;  ///< Highest clock, used for boosts and overload.
+        float    upLoad      = 0.70f;///< Block load above which the clock goes to maxMhz at once.
+        float    downLoad    = 0.50f;///< Predicted peak load at the lower clock that allows a step down.
+        uint16_t holdBlocks  = 172;  ///< Blocks (about 1 s) the prediction must hold before a step down.
+        uint16_t boostBlocks = 344;  ///< Blocks (about 2 s) at maxMhz after boost() or a patch change.
+    };
+
+    /**
+     * @brief Counters of the governor.
+     */
+    struct Stats {
+        uint16_t mhz;                  ///< Current CPU clock.
+        float    load;                 ///< Smoothed engine load at the current clock.
+        float    loadAtMax;            ///< The same load scaled to maxMhz.
+        uint32_t switches;             ///< Clock changes since begin/reset.
+        uint32_t boosts;               ///< Boosts (explicit, patch change or overload).
+        uint32_t maxSwitchUs;          ///< Longest time one clock change took.
+        float    seconds[kNumSteps];   ///< Time spent at each step of kStepsMhz.
+        float    averageMhz;           ///< Time-weighted average clock.
+        float    energyJ;              ///< Estimated energy (0 without a power model).
+        float    averageMw;            ///< Estimated average power (0 without a power model).
+        float    savedPercent;         ///< Estimated saving against a fixed maxMhz clock.
+    };
+
+    /**
+     * @brief Starts at maxMhz.
+     * @return False if the configuration names no valid step or the clock
+     * cannot be set.
+     */
+    bool begin(const Config& config);
+    bool begin() { return begin(Config()); }
+
+    /**
+     * @brief Stops scaling and returns to maxMhz.
+     */
+    void end();
+
+    /**
+     * @brief Sets the measured board power at each clock step.
+     * @param mw Power in mW at 80, 160 and 240 MHz.
+     */
+    void setPowerModel(const float mw[kNumSteps]);
+
+    /**
+     * @brief Requests the highest clock for boostBlocks blocks, e.g. right
+     * before loading a heavy patch. Safe from any task.
+     */
+    void boost() { _boostRequest = true; }
+
+    /**
+     * @brief Applies boost() requests and source or effect changes right away.
+     * Call on the audio task before every CTAG_AudioEngine::renderBlock(),
+     * so a new patch renders its first block at maxMhz.
+     */
+    void prepare();
+
+    /**
+     * @brief Measures the last block and adjusts the clock. Call on the audio
+     * task after every CTAG_AudioEngine::renderBlock().
+     */
+    void update();
+
+    Stats getStats() const;
+    void  resetStats();
+
+private:
+    uint8_t _stepOf(uint16_t mhz) const;
+    void    _setStep(uint8_t step);
+    bool    _takeBoostRequest(uint32_t patchChanges);
+    void    _boost();
+
+    Config        _config;
+    bool          _running = false;
+    uint8_t       _step    = kNumSteps - 1;
+    uint8_t       _minStep = 0;
+    uint8_t       _maxStep = kNumSteps - 1;
+    float         _loadAtMax   = 0.0f;
+    float         _windowPeak  = 0.0f;  ///< Heaviest block (scaled to maxMhz) of the hold window.
+    uint16_t      _holdCounter = 0;
+    uint16_t      _boostCounter = 0;
+    uint32_t      _lastPatchChanges = 0;
+    volatile bool _boostRequest = false;
+
+    uint32_t _switches    = 0;
+    uint32_t _boosts      = 0;
+    uint32_t _maxSwitchUs = 0;
+    uint32_t _blocksAt[kNumSteps] = {};
+    float    _powerMw[kNumSteps]  = {};
+};
+
+#endif // CTAG_AUDIO_POWER_H
@@ -0,0 +1,179 @@
+/**
+ * @file CTAG_AudioRecorder.cpp
+ * @brief Implementation of the background WAV recorder.
+ */
+#include "CTAG_AudioRecorder.h"
+
+static const size_t kChunkFrames = CTAG_AudioRecorder::kChunkBytes / sizeof(int16_t);
+
+CTAG_AudioRecorder::CTAG_AudioRecorder() {}
+
+CTAG_AudioRecorder::~CTAG_AudioRecorder() {
+    // stop() and wait for isBusy() to clear before destroying a recorder.
+    _stopTask();
+    if (_chunk) CTAG_AudioMemory::release(_chunk);
+}
+
+bool CTAG_AudioRecorder::begin(size_t fifoBlocks, CTAG_AudioMemory::Region region, BaseType_t writerCore) {
+    if (_taskHandle) return true;
+
+    // At least two chunks, so one can be written while the next fills up.
+    size_t frames = max(fifoBlocks * CTAG_AUDIO_BLOCK_SIZE, 2 * kChunkFrames);
+    if (!_fifo.begin(frames, 1, region)) return false;
+
+    // DMA-capable internal RAM lets the SD driver skip its bounce buffer.
+    _chunk = (uint8_t*)CTAG_AudioMemory::allocate(kChunkBytes, CTAG_AudioMemory::Region::Dma);
+    if (!_chunk) {
+        _fifo.end();
+        return false;
+    }
+
+    if (!_startTask("RecWriter", writerCore)) {
+        CTAG_AudioMemory::release(_chunk);
+        _chunk = nullptr;
+        _fifo.end();
+        return false;
+    }
+    return true;
+}
+
+bool CTAG_AudioRecorder::start(fs::FS& fs, const char* path) {
+    if (!_taskHandle || _busy) return false;
+
+    _file = fs.open(path, FILE_WRITE);
+    if (!_file) return false;
+
+    _makeHeader(_chunk, 0);
+    if (_file.write(_chunk, kHeaderBytes) != kHeaderBytes) {
+        _file.close();
+        return false;
+    }
+
+    // Nobody reads or writes the FIFO while idle, so it can be emptied here.
+    _fifo.skip(_fifo.available());
+    _recordedFrames = 0;
+    _droppedBlocks  = 0;
+    _writeErrors    = 0;
+    _maxWriteUs     = 0;
+    _fifoPeak       = 0;
+
+    _busy      = true;
+    _recording = true;
+    return true;
+}
+
+void CTAG_AudioRecorder::stop() {
+    _recording = false;
+}
+
+CTAG_AudioRecorder::Stats CTAG_AudioRecorder::getStats() const {
+    Stats s;
+    s.recording      = _recording;
+    s.recordedFrames = _recordedFrames;
+    s.droppedBlocks  = _droppedBlocks;
+    s.writeErrors    = _writeErrors;
+    s.maxWriteUs     = _maxWriteUs;
+    s.fifoPeak       = _fifoPeak;
+    return s;
+}
+
+
+// --- Audio task ---
+
+void CTAG_AudioRecorder::_push(const float* block, size_t numSamples) {
+    if (!_recording) return;
+
+    // All or nothing: a partial block would be an audible glitch in the file.
+    if (_fifo.space() < numSamples) {
+        _droppedBlocks = _droppedBlocks + 1;
+        return;
+    }
+
+    _fifo.writeFloat(block, numSamples);
+}
+
+
+// --- Writer task ---
+
+void CTAG_AudioRecorder::_taskLoop() {
+    while (true) {
+        if (!_busy) {
+            vTaskDelay(pdMS_TO_TICKS(20));
+            continue;
+        }
+
+        size_t avail = _fifo.available();
+        if (avail > _fifoPeak) _fifoPeak = (uint16_t)min(avail, (size_t)UINT16_MAX);
+
+        if (avail >= kChunkFrames) {
+            _fifo.read((int16_t*)_chunk, kChunkFrames);
+            if (!_writeChunk(kChunkBytes)) {
+                _recording = false;
+                _finalize();
+            }
+            continue; // catch up without sleeping
+        }
+
+        if (!_recording) {
+            // Let a block that was being pushed while stop() ran land, then flush.
+            vTaskDelay(pdMS_TO_TICKS(10));
+            size_t n;
+            while ((n = _fifo.read((int16_t*)_chunk, kChunkFrames)) > 0) {
+                if (!_writeChunk(n * sizeof(int16_t))) break;
+            }
+            _finalize();
+            continue;
+        }
+
+        // Half a chunk takes ~23 ms to arrive at 44.1 kHz.
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+}
+
+bool CTAG_AudioRecorder::_writeChunk(size_t bytes) {
+    uint32_t t0 = micros();
+    size_t written = _file.write(_chunk, bytes);
+    uint32_t dt = micros() - t0;
+    if (dt > _maxWriteUs) _maxWriteUs = dt;
+
+    if (written != bytes) {
+        _writeErrors = _writeErrors + 1;
+        return false;
+    }
+    _recordedFrames = _recordedFrames + bytes / sizeof(int16_t);
+    return true;
+}
+
+void CTAG_AudioRecorder::_finalize() {
+    _makeHeader(_chunk, _recordedFrames * sizeof(int16_t));
+    if (_file.seek(0)) _file.write(_chunk, kHeaderBytes);
+    _file.close();
+    _busy = false;
+}
+
+static void _put32(uint8_t* p, uint32_t v) { p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24; }
+static void _put16(uint8_t* p, uint16_t v) { p[0] = v; p[1] = v >> 8; }
+
+void CTAG_AudioRecorder::_makeHeader(uint8_t* h, uint32_t dataBytes) {
+    // RIFF/WAVE with a JUNK chunk that pads the header to kHeaderBytes.
+    const uint32_t junkBytes = kHeaderBytes - 12 - 24 - 8 - 8;
+    memset(h, 0, kHeaderBytes);
+    memcpy(h, "RIFF", 4);
+    _put32(h + 4, kHeaderBytes - 8 + dataBytes);
+    memcpy(h + 8, "WAVE", 4);
+
+    memcpy(h + 12, "fmt ", 4);
+    _put32(h + 16, 16);
+    _put16(h + 20, 1);                              // PCM
+    _put16(h + 22, 1);                              // mono
+    _put32(h + 24, CTAG_AUDIO_SAMPLE_RATE);
+    _put32(h + 28, CTAG_AUDIO_SAMPLE_RATE * sizeof(int16_t));
+    _put16(h + 32, sizeof(int16_t));                // block align
+    _put16(h + 34, 16);                             // bits per sample
+
+    memcpy(h + 36, "JUNK", 4);
+    _put32(h + 40, junkBytes);
+
+    memcpy(h + kHeaderBytes - 8, "data", 4);
+    _put32(h + kHeaderBytes - 4, dataBytes);
+}
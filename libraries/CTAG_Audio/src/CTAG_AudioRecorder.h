@@ -0,0 +1,106 @@
+/**
+ * @file CTAG_AudioRecorder.h
+ * @brief WAV recorder for the CTAG audio engine (SD card, LittleFS, ...).
+ *
+ * @ingroup Libraries_Audio
+ *
+ * The recorder is an engine sink. On the audio task it only converts the
+ * block to 16 bit and copies it into a lock-free FIFO; if the FIFO is full
+ * the whole block is dropped and counted, the audio task never waits. A
+ * low-priority writer task empties the FIFO into the file in 4 KiB chunks.
+ * The WAV header is padded to 512 bytes, so every chunk lands on a sector
+ * boundary of the card.
+ *
+ * On internal flash (LittleFS, SPIFFS) every write and erase turns the cache
+ * off on both cores and stalls the audio task along with the writer; use an
+ * SD card when the output must not glitch.
+ *
+ * 1. CTAG_AudioRecorder: Records the master bus or one source slot to a mono WAV file.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_RECORDER_H
+#define CTAG_AUDIO_RECORDER_H
+
+#include "CTAG_AudioTap.h"
+#include <FS.h>
+
+/**
+ * @class CTAG_AudioRecorder
+ * @brief Records engine audio to a 16-bit mono WAV file in the background.
+ */
+class CTAG_AudioRecorder : public CTAG_AudioTap {
+public:
+    /// Bytes handed to the file system per write (a multiple of the 512-byte sector).
+    static const size_t kChunkBytes  = 4096;
+    /// Size of the WAV header; audio data starts at this offset.
+    static const size_t kHeaderBytes = 512;
+
+    /**
+     * @brief Counters of the current/last recording.
+     */
+    struct Stats {
+        bool     recording;      ///< A recording is running.
+        uint32_t recordedFrames; ///< Frames written to the file.
+        uint32_t droppedBlocks;  ///< Blocks lost because the FIFO was full.
+        uint32_t writeErrors;    ///< Short or failed file writes (the recording stops).
+        uint32_t maxWriteUs;     ///< Longest single chunk write.
+        uint16_t fifoPeak;       ///< Highest FIFO fill in frames.
+    };
+
+    CTAG_AudioRecorder();
+    ~CTAG_AudioRecorder();
+
+    /**
+     * @brief Allocates the FIFO and chunk buffer and starts the writer task.
+     * @param fifoBlocks FIFO capacity in engine blocks; this is how long a
+     * file-system stall may last before blocks are dropped (default ~370 ms).
+     * @param region Memory region of the FIFO (PSRAM is fine).
+     * @param writerCore Core the writer task runs on.
+     * @return False if memory or the task could not be allocated.
+     */
+    bool begin(size_t fifoBlocks = 64,
+               CTAG_AudioMemory::Region region = CTAG_AudioMemory::Region::Default,
+               BaseType_t writerCore = 0);
+
+    /**
+     * @brief Creates the file, writes the header and starts recording.
+     * @param fs File system (SD, SD_MMC, LittleFS, ...).
+     * @param path File path, e.g. "/take1.wav". An existing file is replaced.
+     * @return False if not begun, already busy, or the file cannot be created.
+     */
+    bool start(fs::FS& fs, const char* path);
+
+    /**
+     * @brief Stops recording. The writer task drains the FIFO and finalizes
+     * the header in the background; poll isBusy() before removing the card.
+     */
+    void stop();
+
+    /**
+     * @brief True while recording or while the file is still being finalized.
+     */
+    bool isBusy() const { return _busy; }
+
+    Stats getStats() const;
+
+private:
+    void _push(const float* block, size_t numSamples) override;
+    void _taskLoop() override;
+    bool _writeChunk(size_t bytes);
+    void _finalize();
+    static void _makeHeader(uint8_t* dst, uint32_t dataBytes);
+
+    uint8_t* _chunk = nullptr;
+    fs::File _file;
+
+    volatile bool _recording = false; ///< Audio task may push blocks.
+    volatile bool _busy      = false; ///< File open (recording or finalizing).
+
+    volatile uint32_t _recordedFrames = 0;
+    volatile uint32_t _droppedBlocks  = 0;
+    volatile uint32_t _writeErrors    = 0;
+    volatile uint32_t _maxWriteUs     = 0;
+    volatile uint16_t _fifoPeak       = 0;
+};
+
+#endif // CTAG_AUDIO_RECORDER_H
@@ -0,0 +1,360 @@
+/**
+ * @file CTAG_AudioResampler.cpp
+ * @brief Implementation of the resampler and the sample player.
+ */
+#include "CTAG_AudioResampler.h"
+
+static const float kFracScale = 1.0f / 4294967296.0f; ///< 32.32 fraction to float.
+
+/**
+ * @brief Zeroth-order modified Bessel function, for the Kaiser window.
+ */
+static double _besselI0(double x) {
+    double sum = 1.0, term = 1.0, q = 0.25 * x * x;
+    for (int k = 1; k < 50; ++k) {
+        term *= q / ((double)k * k);
+        sum += term;
+        if (term < 1e-12 * sum) break;
+    }
+    return sum;
+}
+
+/**
+ * @brief Table shape of the sinc presets.
+ */
+struct SincDesign {
+    int   zeroCrossings; ///< Per side.
+    int   phasesLog2;
+    float rolloff;       ///< Cutoff relative to Nyquist.
+    float beta;          ///< Kaiser window shape.
+};
+
+static bool _sincDesign(CTAG_ResampleQuality q, SincDesign& d) {
+    switch (q) {
+        case CTAG_ResampleQuality::Sinc16: d = { 8, 6, 0.84f, 7.0f };  return true;
+        case CTAG_ResampleQuality::Sinc32: d = { 16, 7, 0.90f, 9.0f }; return true;
+        default: return false;
+    }
+}
+
+
+// --- CTAG_ResampleKernel ---
+
+CTAG_ResampleKernel::~CTAG_ResampleKernel() {
+    end();
+}
+
+bool CTAG_ResampleKernel::begin(CTAG_ResampleQuality quality, float maxRatio) {
+    end();
+    _quality  = quality;
+    _maxRatio = constrain(maxRatio, 1.0f, 8.0f);
+
+    SincDesign d;
+    if (!_sincDesign(quality, d)) {
+        _halfWidth = (quality == CTAG_ResampleQuality::Linear) ? 1 : 2;
+        setRatio(_ratio);
+        return true;
+    }
+
+    // Polyphase layout: row p holds the kernel at t = k + p / L for all taps
+    // k, so at ratios up to 1 each wing is one contiguous dot product. Row L
+    // closes the last phase interval; _delta holds the row-to-row differences.
+    _zeroCrossings = d.zeroCrossings;
+    _phasesLog2    = d.phasesLog2;
+    _phases        = 1 << d.phasesLog2;
+    const size_t taps = (size_t)_zeroCrossings;
+    _table = (float*)CTAG_AudioMemory::allocate((2 * _phases + 1) * taps * sizeof(float),
+                                                CTAG_AudioMemory::Region::Internal);
+    if (!_table) return false;
+    _delta = _table + (_phases + 1) * taps;
+
+    const double i0Beta = _besselI0(d.beta);
+    for (int p = 0; p <= _phases; ++p) {
+        for (int k = 0; k < _zeroCrossings; ++k) {
+            double t = k + (double)p / _phases;
+            double r = t / _zeroCrossings;
+            double h = 0.0;
+            if (r < 1.0) {
+                double x = M_PI * d.rolloff * t;
+                double sinc = (t == 0.0) ? 1.0 : sin(x) / x;
+                h = d.rolloff * sinc * _besselI0(d.beta * sqrt(1.0 - r * r)) / i0Beta;
+            }
+            _table[p * taps + k] = (float)h;
+        }
+    }
+    for (int p = 0; p < _phases; ++p) {
+        for (size_t k = 0; k < taps; ++k) {
+            _delta[p * taps + k] = _table[(p + 1) * taps + k] - _table[p * taps + k];
+        }
+    }
+
+    _halfWidth = (int)ceilf(_zeroCrossings * _maxRatio) + 1;
+    setRatio(_ratio);
+    return true;
+}
+
+void CTAG_ResampleKernel::end() {
+    if (_table) {
+        CTAG_AudioMemory::release(_table);
+        _table = nullptr;
+        _delta = nullptr;
+    }
+}
+
+void CTAG_ResampleKernel::setRatio(float ratio) {
+    _ratio  = constrain(ratio, 0.125f, _maxRatio);
+    _cutoff = _ratio > 1.0f ? 1.0f / _ratio : 1.0f;
+    _step   = _cutoff * _phases;
+}
+
+template <typename T>
+float CTAG_ResampleKernel::_interpolate(const T* x, float frac) const {
+    switch (_quality) {
+        case CTAG_ResampleQuality::Linear: {
+            float a = x[0];
+            return a + frac * ((float)x[1] - a);
+        }
+        case CTAG_ResampleQuality::Cubic: {
+            // 4-point, 3rd-order Hermite (Catmull-Rom)
+            float xm1 = x[-1], x0 = x[0], x1 = x[1], x2 = x[2];
+            float c1 = 0.5f * (x1 - xm1);
+            float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+            float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+            return ((c3 * frac + c2) * frac + c1) * frac + x0;
+        }
+        default:
+            break;
+    }
+    if (!_table) return 0.0f;
+
+    const int taps = _zeroCrossings;
+    if (_cutoff >= 1.0f) {
+        // Fixed phase per wing: x[0], x[-1], … against row frac * L;
+        // x[1], x[2], … against row (1 - frac) * L.
+        // A fraction just below 1 may round to 1.0f, so both rows are clamped.
+        float pl = frac * _phases;
+        int   il = (int)pl;
+        float el = pl - il;
+        if (il >= _phases) { il = _phases - 1; el = 1.0f; }
+        float pr = _phases - pl;
+        int   ir = (int)pr;
+        float er = pr - ir;
+        if (ir >= _phases) { ir = _phases - 1; er = 1.0f; }
+
+        const float* hl = _table + il * taps;
+        const float* dl = _delta + il * taps;
+        const float* hr = _table + ir * taps;
+        const float* dr = _delta + ir * taps;
+        float sl = 0.0f, sr = 0.0f;
+        for (int k = 0; k < taps; ++k) {
+            sl += (float)x[-k]    * (hl[k] + el * dl[k]);
+            sr += (float)x[1 + k] * (hr[k] + er * dr[k]);
+        }
+        return sl + sr;
+    }
+
+    // Stretched kernel (ratio > 1): the table is stepped by cutoff * L per
+    // input sample, so every tap has its own phase.
+    const float end  = (float)(taps << _phasesLog2);
+    const int   mask = _phases - 1;
+    float sum = 0.0f;
+    float n = frac * _step;
+    for (int k = 0; n < end; ++k, n += _step) {
+        int   i = (int)n;
+        int   j = (i & mask) * taps + (i >> _phasesLog2);
+        sum += (float)x[-k] * (_table[j] + (n - i) * _delta[j]);
+    }
+    n = (1.0f - frac) * _step;
+    for (int k = 1; n < end; ++k, n += _step) {
+        int   i = (int)n;
+        int   j = (i & mask) * taps + (i >> _phasesLog2);
+        sum += (float)x[k] * (_table[j] + (n - i) * _delta[j]);
+    }
+    return _cutoff * sum;
+}
+
+template float CTAG_ResampleKernel::_interpolate<float>(const float*, float) const;
+template float CTAG_ResampleKernel::_interpolate<int16_t>(const int16_t*, float) const;
+
+
+// --- CTAG_Resampler ---
+
+CTAG_Resampler::~CTAG_Resampler() {
+    end();
+}
+
+bool CTAG_Resampler::begin(CTAG_ResampleQuality quality, float maxRatio) {
+    end();
+    if (!_kernel.begin(quality, maxRatio)) return false;
+    _cap = kMaxInput + 2 * (size_t)_kernel.halfWidth() + 1;
+    _buf = (float*)CTAG_AudioMemory::allocate(_cap * sizeof(float), CTAG_AudioMemory::Region::Internal);
+    if (!_buf) {
+        _kernel.end();
+        return false;
+    }
+    setRatio(_kernel.ratio());
+    reset();
+    return true;
+}
+
+void CTAG_Resampler::end() {
+    if (_buf) {
+        CTAG_AudioMemory::release(_buf);
+        _buf = nullptr;
+    }
+    _kernel.end();
+}
+
+void CTAG_Resampler::setRatio(float ratio) {
+    _kernel.setRatio(ratio);
+    _inc = (uint64_t)((double)_kernel.ratio() * 4294967296.0);
+}
+
+void CTAG_Resampler::reset() {
+    if (!_buf) return;
+    // Start with halfWidth samples of silence before the first input, so the
+    // first output lines up with the first input sample.
+    const size_t h = (size_t)_kernel.halfWidth();
+    memset(_buf, 0, h * sizeof(float));
+    _fill = h;
+    _pos  = (uint64_t)h << 32;
+}
+
+size_t CTAG_Resampler::process(const float* in, size_t numIn, float* out, size_t maxOut, size_t* consumed) {
+    if (!_buf) {
+        if (consumed) *consumed = 0;
+        return 0;
+    }
+    numIn = min(numIn, _cap - _fill);
+    memcpy(_buf + _fill, in, numIn * sizeof(float));
+    _fill += numIn;
+    if (consumed) *consumed = numIn;
+
+    // An output at integer position i needs _buf[i - h … i + h].
+    const size_t h = (size_t)_kernel.halfWidth();
+    size_t produced = 0;
+    while (produced < maxOut) {
+        size_t i = (size_t)(_pos >> 32);
+        if (i + h >= _fill) break;
+        out[produced++] = _kernel.interpolate(_buf + i, (uint32_t)_pos * kFracScale);
+        _pos += _inc;
+    }
+
+    // Keep the history the next outputs still need.
+    size_t i = (size_t)(_pos >> 32);
+    size_t drop = (i > h) ? min(i - h, _fill) : 0;
+    if (drop) {
+        memmove(_buf, _buf + drop, (_fill - drop) * sizeof(float));
+        _fill -= drop;
+        _pos  -= (uint64_t)drop << 32;
+    }
+    return produced;
+}
+
+
+// --- CTAG_SamplePlayer ---
+
+CTAG_SamplePlayer::CTAG_SamplePlayer(float sampleRate)
+    : _sampleRate(sampleRate)
+{
+}
+
+CTAG_SamplePlayer::~CTAG_SamplePlayer() {
+    if (_window) CTAG_AudioMemory::release(_window);
+}
+
+bool CTAG_SamplePlayer::begin(CTAG_ResampleQuality quality, float maxRatio) {
+    if (_window) {
+        CTAG_AudioMemory::release(_window);
+        _window = nullptr;
+    }
+    if (!_kernel.begin(quality, maxRatio)) return false;
+    // Scratch window for the first and last few samples, where the kernel
+    // reaches past the data.
+    _window = (float*)CTAG_AudioMemory::allocate((2 * _kernel.halfWidth() + 2) * sizeof(float),
+                                                 CTAG_AudioMemory::Region::Internal);
+    _dirty = true;
+    return _window != nullptr;
+}
+
+void CTAG_SamplePlayer::setSample(const int16_t* data, size_t length, float rate) {
+    _playing  = false;
+    _data     = data;
+    _length   = length;
+    _dataRate = rate;
+    _dirty    = true;
+}
+
+void CTAG_SamplePlayer::setPitch(float semitones) {
+    _pitch = constrain(semitones, -48.0f, 48.0f);
+    _dirty = true;
+}
+
+void CTAG_SamplePlayer::_updateRatio() {
+    _dirty = false;
+    _kernel.setRatio(_dataRate / _sampleRate * powf(2.0f, _pitch / 12.0f));
+    _inc = (uint64_t)((double)_kernel.ratio() * 4294967296.0);
+}
+
+int16_t CTAG_SamplePlayer::getNextSample() {
+    float s;
+    renderBlock(&s, 1);
+    return (int16_t)(constrain(s, -1.0f, 1.0f) * 32767.0f);
+}
+
+void CTAG_SamplePlayer::renderBlock(float* out, size_t numSamples) {
+    if (_pending) {
+        _pending = false;
+        _playing = _data && _length && _window;
+        _pos = 0;
+    }
+    if (!_playing) {
+        memset(out, 0, numSamples * sizeof(float));
+        return;
+    }
+    if (_dirty) _updateRatio();
+
+    const size_t h   = (size_t)_kernel.halfWidth();
+    const size_t len = _length;
+    const uint64_t wrap = (uint64_t)len << 32;
+    const float  amp = _amplitude;
+    size_t n = 0;
+    while (n < numSamples) {
+        size_t i = (size_t)(_pos >> 32);
+        if (i >= len) {
+            if (!_loop) break;
+            _pos -= wrap;
+            continue;
+        }
+        float frac = (uint32_t)_pos * kFracScale;
+        if (i >= h && i + h < len) {
+            // Fast path: the whole kernel lies inside the data.
+            out[n] = amp * _kernel.interpolate(_data + i, frac);
+        } else {
+            // Edges: copy the neighbourhood, zero-padded or wrapped around.
+            for (size_t k = 0; k <= 2 * h; ++k) {
+                ptrdiff_t j = (ptrdiff_t)(i + k) - (ptrdiff_t)h;
+                if (_loop) {
+                    j %= (ptrdiff_t)len;
+                    if (j < 0) j += len;
+                    _window[k] = _data[j];
+                } else {
+                    _window[k] = (j >= 0 && (size_t)j < len) ? _data[j] : 0.0f;
+                }
+            }
+            out[n] = amp * (1.0f / 32768.0f) * _kernel.interpolate(_window + h, frac);
+        }
+        _pos += _inc;
+        ++n;
+    }
+    if (n < numSamples) {
+        _playing = false;
+        memset(out + n, 0, (numSamples - n) * sizeof(float));
+    }
+}
+
+void CTAG_SamplePlayer::reset() {
+    _pending = false;
+    _playing = false;
+    _pos = 0;
+}
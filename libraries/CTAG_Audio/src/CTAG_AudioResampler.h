@@ -0,0 +1,244 @@
+/**
+ * @file CTAG_AudioResampler.h
+ * @brief Sample-rate conversion and pitched sample playback.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * Three interpolators share one block API:
+ * - Linear and Cubic (4-point Hermite) are cheap and have no anti-aliasing;
+ * - Sinc16 and Sinc32 are band-limited interpolators after J. O. Smith: a
+ *   Kaiser-windowed sinc is tabulated once in begin() with L phases per
+ *   zero crossing, and every output sample is a dot product of the input
+ *   with the table, interpolated between neighbouring phases. When the
+ *   ratio is above 1 (down-sampling, pitching up) the kernel is stretched
+ *   so its cutoff follows the output Nyquist, at a proportionally higher cost.
+ *
+ * The read position is 32.32 fixed point, so long files and tiny pitch
+ * changes do not accumulate rounding errors (and no double math is needed
+ * on the ESP32's single-precision FPU). The ESP32-S3 has no float SIMD, so
+ * the inner loops are plain multiply-accumulates that compilers vectorize
+ * on host targets.
+ *
+ * 1. CTAG_Resampler: Streaming converter (push a block in, get the converted block out).
+ * 2. CTAG_SamplePlayer: Plays a 16-bit sample from memory at any pitch.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_RESAMPLER_H
+#define CTAG_AUDIO_RESAMPLER_H
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioPool.h"
+
+/**
+ * @brief Interpolation presets, from cheapest to best.
+ */
+enum class CTAG_ResampleQuality : uint8_t {
+    Linear, ///< 2 taps. Aliases and dulls the highs; for LFOs, control data and lo-fi effects.
+    Cubic,  ///< 4-tap Hermite. Clean on low-pitched material, aliases on bright material.
+    Sinc16, ///< 16 taps at ratio <= 1, cutoff at 84 % of Nyquist, 64 phases (4 KiB table).
+    Sinc32  ///< 32 taps at ratio <= 1, cutoff at 90 % of Nyquist, 128 phases (16 KiB table).
+};
+
+/**
+ * @class CTAG_ResampleKernel
+ * @brief The interpolator itself: tables, cutoff and per-sample evaluation.
+ *
+ * Used by CTAG_Resampler and CTAG_SamplePlayer; it can also be used directly
+ * on any buffer that has halfWidth() valid samples around the read position.
+ */
+class CTAG_ResampleKernel {
+public:
+    ~CTAG_ResampleKernel();
+
+    /**
+     * @brief Builds the sinc table (Sinc modes only).
+     * @param quality Interpolation preset.
+     * @param maxRatio Highest ratio that will be used (1 … 8). Bounds the
+     * kernel width and thereby the cost and the history needed.
+     * @return False if the table could not be allocated.
+     */
+    bool begin(CTAG_ResampleQuality quality, float maxRatio = 4.0f);
+
+    /**
+     * @brief Frees the table.
+     */
+    void end();
+
+    /**
+     * @brief Sets the conversion ratio: input samples per output sample.
+     * @param ratio 1/8 … maxRatio; e.g. 2.0 plays an octave up.
+     */
+    void setRatio(float ratio);
+
+    /**
+     * @brief Samples needed on each side of the read position (at maxRatio).
+     */
+    int halfWidth() const { return _halfWidth; }
+
+    CTAG_ResampleQuality quality() const { return _quality; }
+    float ratio() const { return _ratio; }
+
+    /**
+     * @brief Interpolates between x[0] and x[1].
+     * @param x Pointer to the sample at the integer read position; halfWidth()
+     * samples before and after it must be readable.
+     * @param frac Fractional read position, 0.0 … 1.0.
+     */
+    float interpolate(const float* x, float frac) const { return _interpolate(x, frac); }
+    float interpolate(const int16_t* x, float frac) const { return _interpolate(x, frac) * (1.0f / 32768.0f); }
+
+private:
+    template <typename T> float _interpolate(const T* x, float frac) const;
+
+    CTAG_ResampleQuality _quality = CTAG_ResampleQuality::Cubic;
+    float  _ratio     = 1.0f;
+    float  _maxRatio  = 1.0f;
+    float  _cutoff    = 1.0f;  ///< min(1, 1 / ratio).
+    float  _step      = 0.0f;  ///< Table positions per input sample (cutoff * phases).
+    int    _halfWidth = 2;
+    int    _zeroCrossings = 0; ///< One-sided kernel length in zero crossings.
+    int    _phases    = 0;     ///< Table rows (phases) per zero crossing.
+    int    _phasesLog2 = 0;
+    float* _table     = nullptr; ///< Kernel, (phases + 1) rows of zeroCrossings taps.
+    float* _delta     = nullptr; ///< Difference to the next row, phases rows.
+};
+
+/**
+ * @class CTAG_Resampler
+ * @brief Streaming sample-rate converter with an internal history.
+ *
+ * @code
+ * CTAG_Resampler rs;
+ * rs.begin(CTAG_ResampleQuality::Sinc16);
+ * rs.setRates(48000.0f, 44100.0f);
+ * size_t n = rs.process(in, 256, out, sizeof(out) / sizeof(out[0]));
+ * @endcode
+ */
+class CTAG_Resampler {
+public:
+    /// Largest number of input samples accepted by one process() call.
+    static const size_t kMaxInput = 2 * CTAG_AUDIO_BLOCK_SIZE;
+
+    ~CTAG_Resampler();
+
+    /**
+     * @brief Allocates the kernel table and the history.
+     * @param quality Interpolation preset.
+     * @param maxRatio Highest ratio that will be set (1 … 8).
+     * @return False if memory could not be allocated.
+     */
+    bool begin(CTAG_ResampleQuality quality = CTAG_ResampleQuality::Sinc16, float maxRatio = 4.0f);
+
+    void end();
+
+    /**
+     * @brief Input samples per output sample (1/8 … maxRatio).
+     */
+    void setRatio(float ratio);
+
+    /**
+     * @brief Sets the ratio from two sample rates.
+     */
+    void setRates(float inRate, float outRate) { setRatio(inRate / outRate); }
+
+    /**
+     * @brief Converts a block.
+     * @param in Input samples.
+     * @param numIn Number of input samples. Up to kMaxInput are taken as long
+     * as every call gets enough output room; outputs that do not fit stay
+     * pending and leave less room for the next input.
+     * @param out Output buffer.
+     * @param maxOut Capacity of out; numIn / ratio + 2 is always enough.
+     * @param consumed Receives the number of input samples taken; the caller
+     * passes the rest again. May be nullptr if numIn and maxOut are in range.
+     * @return Number of output samples written.
+     */
+    size_t process(const float* in, size_t numIn, float* out, size_t maxOut, size_t* consumed = nullptr);
+
+    /**
+     * @brief Clears the history (e.g. before a new, unrelated stream).
+     */
+    void reset();
+
+    /**
+     * @brief Input samples held back for the kernel's right wing: the output
+     * around input sample n is produced once sample n + latency() has arrived.
+     */
+    size_t latency() const { return (size_t)_kernel.halfWidth(); }
+
+private:
+    CTAG_ResampleKernel _kernel;
+    float*   _buf  = nullptr;
+    size_t   _cap  = 0;
+    size_t   _fill = 0;
+    uint64_t _pos  = 0;   ///< Next output time, 32.32 fixed point, relative to _buf[0].
+    uint64_t _inc  = 1ull << 32;
+};
+
+/**
+ * @class CTAG_SamplePlayer
+ * @brief Plays a 16-bit mono sample from flash, RAM or PSRAM at any pitch.
+ */
+class CTAG_SamplePlayer : public CTAG_AudioSource {
+public:
+    CTAG_SamplePlayer(float sampleRate = 44100.0f);
+    ~CTAG_SamplePlayer();
+
+    /**
+     * @brief Builds the interpolator. Call once during setup.
+     * @param quality Interpolation preset.
+     * @param maxRatio Highest playback ratio (1 … 8, default 4 = two octaves up).
+     */
+    bool begin(CTAG_ResampleQuality quality = CTAG_ResampleQuality::Sinc16, float maxRatio = 4.0f);
+
+    /**
+     * @brief Sets the sample to play. The data must stay valid while playing.
+     * @param data 16-bit mono samples.
+     * @param length Number of samples.
+     * @param rate Sample rate the data was recorded at.
+     */
+    void setSample(const int16_t* data, size_t length, float rate);
+
+    /**
+     * @brief Transposition in semitones (0 = original pitch).
+     */
+    void setPitch(float semitones);
+
+    /**
+     * @brief Loops the whole sample instead of stopping at its end.
+     */
+    void setLoop(bool loop) { _loop = loop; }
+
+    void setAmplitude(float amp) { _amplitude = constrain(amp, 0.0f, 1.0f); }
+
+    /**
+     * @brief Starts playback from the beginning at the next block.
+     */
+    void trigger() { _pending = true; }
+
+    bool isPlaying() const { return _playing; }
+
+    int16_t getNextSample() override;
+    void renderBlock(float* out, size_t numSamples) override;
+    void reset() override;
+
+private:
+    void _updateRatio();
+
+    CTAG_ResampleKernel _kernel;
+    float*         _window = nullptr; ///< Edge scratch, 2 * halfWidth + 2 samples.
+    float          _sampleRate;
+    const int16_t* _data   = nullptr;
+    size_t         _length = 0;
+    float          _dataRate  = 44100.0f;
+    float          _pitch     = 0.0f;
+    float          _amplitude = 1.0f;
+    bool           _loop      = false;
+    volatile bool  _pending   = false;
+    bool           _playing   = false;
+    volatile bool  _dirty     = true;
+    uint64_t       _pos = 0;  ///< 32.32 fixed point.
+    uint64_t       _inc = 1ull << 32;
+};
+
+#endif // CTAG_AUDIO_RESAMPLER_H
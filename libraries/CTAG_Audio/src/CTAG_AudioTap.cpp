@@ -0,0 +1,42 @@
+/**
+ * @file CTAG_AudioTap.cpp
+ * @brief Implementation of the common tap sink base.
+ */
+#include "CTAG_AudioTap.h"
+
+CTAG_AudioTap::~CTAG_AudioTap() {
+    _stopTask();
+}
+
+void CTAG_AudioTap::setTap(Tap tap, uint8_t slot) {
+    _slot = slot;
+    _tap  = tap;
+}
+
+bool CTAG_AudioTap::_startTask(const char* name, BaseType_t core) {
+    if (xTaskCreatePinnedToCore(_task, name, 4096, this, 1, &_taskHandle, core) != pdPASS) {
+        _taskHandle = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void CTAG_AudioTap::_stopTask() {
+    if (_taskHandle) vTaskDelete(_taskHandle);
+    _taskHandle = nullptr;
+}
+
+void CTAG_AudioTap::_task(void* arg) {
+    static_cast<CTAG_AudioTap*>(arg)->_taskLoop();
+}
+
+
+// --- Audio task ---
+
+void CTAG_AudioTap::writeVoice(uint8_t slot, const float* block, size_t numSamples) {
+    if (_tap == Tap::Source && slot == _slot) _push(block, numSamples);
+}
+
+void CTAG_AudioTap::writeMaster(const float* block, size_t numSamples) {
+    if (_tap == Tap::Master) _push(block, numSamples);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file CTAG_AudioTap.h
+ * @brief Common base of the sinks that hand engine audio to a task of their own.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * The recorder, the analyzer and the tuner all listen to either the master
+ * bus or one source slot, pass what they hear through a CTAG_AudioFifo and
+ * do the real work on a low-priority task. This class holds that plumbing;
+ * a derived class only implements _push() for the audio task and
+ * _taskLoop() for its own task.
+ *
+ * 1. CTAG_AudioTap: Tap selection, block routing and the background task.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_TAP_H
+#define CTAG_AUDIO_TAP_H
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioFifo.h"
+
+/**
+ * @class CTAG_AudioTap
+ * @brief Engine sink that forwards the blocks of one tap to a background task.
+ */
+class CTAG_AudioTap : public CTAG_AudioSink {
+public:
+    /**
+     * @brief What the sink listens to.
+     */
+    enum class Tap : uint8_t {
+        Master, ///< The finished master bus.
+        Source  ///< One source slot before mixing (e.g. an input source).
+    };
+
+    virtual ~CTAG_AudioTap();
+
+    /**
+     * @brief Selects what is tapped. Takes effect immediately.
+     * @param tap Master bus or a single source.
+     * @param slot Source slot for Tap::Source.
+     */
+    void setTap(Tap tap, uint8_t slot = 0);
+
+    // --- CTAG_AudioSink ---
+    void writeVoice(uint8_t slot, const float* block, size_t numSamples) override;
+    void writeMaster(const float* block, size_t numSamples) override;
+
+protected:
+    /**
+     * @brief Receives every block of the selected tap (audio task, must not block).
+     */
+    virtual void _push(const float* block, size_t numSamples) = 0;
+
+    /**
+     * @brief Body of the background task; never returns.
+     */
+    virtual void _taskLoop() = 0;
+
+    /**
+     * @brief Starts the task that runs _taskLoop().
+     * @return False if the task could not be created.
+     */
+    bool _startTask(const char* name, BaseType_t core);
+
+    /**
+     * @brief Deletes the task. Called first by the destructors of derived
+     * classes, before they free what the task works on.
+     * @note Taps normally live for the whole sketch; the task is deleted
+     * wherever it is, so stop it in a defined state before destroying one.
+     */
+    void _stopTask();
+
+    /**
+     * @brief Replaces a callback the task may be calling right now. The
+     * function is cleared first, so the task never pairs the old function
+     * with the new argument.
+     */
+    template <typename Fn>
+    static void _setCallback(Fn volatile& fn, void* volatile& fnArg, Fn cb, void* arg) {
+        fn    = nullptr;
+        fnArg = arg;
+        fn    = cb;
+    }
+
+    CTAG_AudioFifo _fifo;
+    TaskHandle_t   _taskHandle = nullptr;
+
+private:
+    static void _task(void* arg);
+
+    volatile Tap     _tap  = Tap::Master;
+    volatile uint8_t _slot = 0;
+};
+
+#endif // CTAG_AUDIO_TAP_H
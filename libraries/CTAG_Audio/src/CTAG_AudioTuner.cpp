@@ -0,0 +1,251 @@
+/**
+ * @file CTAG_AudioTuner.cpp
+ * @brief Implementation of the YIN pitch detector.
+ */
+#include "CTAG_AudioTuner.h"
+
+static const float kDecimatedRate = (float)CTAG_AUDIO_SAMPLE_RATE / CTAG_AudioTuner::kDecimation;
+static const float kGateEnergy    = 1e-5f; ///< Mean square below -50 dBFS counts as silence.
+
+CTAG_AudioTuner::CTAG_AudioTuner() : _antiAlias(CTAG_AUDIO_SAMPLE_RATE, 2) {
+    // 24 dB/oct at 2 kHz keeps the partials above the new Nyquist (5.5 kHz)
+    // from folding back onto the fundamental.
+    _antiAlias.setType(CTAG_FilterType::LowPass);
+    _antiAlias.setFrequency(2000.0f);
+    _antiAlias.setQ(0.7071f);
+}
+
+CTAG_AudioTuner::~CTAG_AudioTuner() {
+    _stopTask();
+    if (_buf) CTAG_AudioMemory::release(_buf);
+}
+
+bool CTAG_AudioTuner::begin(BaseType_t core) {
+    if (_taskHandle) return true;
+
+    _tauMin = (size_t)floorf(kDecimatedRate / kMaxFreq);
+    _tauMax = (size_t)ceilf(kDecimatedRate / kMinFreq);
+    _length = kHop + kWindow + _tauMax;
+
+    if (!_fifo.begin(8 * kHop, 1, CTAG_AudioMemory::Region::Internal)) return false;
+
+    size_t floats = _length + 2 * (_tauMax + 1);
+    _buf = (float*)CTAG_AudioMemory::allocate(floats * sizeof(float), CTAG_AudioMemory::Region::Internal);
+    if (!_buf) {
+        _fifo.end();
+        return false;
+    }
+    memset(_buf, 0, floats * sizeof(float));
+    _diff = _buf + _length;
+    _cmnd = _diff + _tauMax + 1;
+    _count  = 0;
+    _primed = false;
+
+    if (!_startTask("Tuner", core)) {
+        CTAG_AudioMemory::release(_buf);
+        _buf = nullptr;
+        _fifo.end();
+        return false;
+    }
+    return true;
+}
+
+void CTAG_AudioTuner::setReference(float a4Hz) {
+    _reference = constrain(a4Hz, 400.0f, 480.0f);
+}
+
+void CTAG_AudioTuner::setThreshold(float threshold) {
+    _threshold = constrain(threshold, 0.01f, 0.5f);
+}
+
+void CTAG_AudioTuner::setCallback(Callback cb, void* arg) {
+    _setCallback(_cb, _cbArg, cb, arg);
+}
+
+CTAG_AudioTuner::Reading CTAG_AudioTuner::getReading() const {
+    return _readings[_readIdx];
+}
+
+size_t CTAG_AudioTuner::packReading(uint8_t* dst) const {
+    Reading r = getReading();
+    uint16_t deciHz = (uint16_t)constrain(lrintf(r.frequency * 10.0f), 0L, 65535L);
+    dst[0] = kTunerMsgId;
+    dst[1] = r.valid ? 1 : 0;
+    dst[2] = r.note;
+    dst[3] = (uint8_t)r.cents;
+    dst[4] = deciHz & 0xFF;
+    dst[5] = deciHz >> 8;
+    dst[6] = (uint8_t)constrain(lrintf(r.confidence * 255.0f), 0L, 255L);
+    return kTunerMsgLen;
+}
+
+CTAG_AudioTuner::Stats CTAG_AudioTuner::getStats() const {
+    Stats s;
+    s.updates       = _updates;
+    s.droppedBlocks = _droppedBlocks;
+    s.lastUs        = _lastUs;
+    s.maxUs         = _maxUs;
+    s.load          = _avgUs / (kHop * 1e6f / kDecimatedRate);
+    return s;
+}
+
+const char* CTAG_AudioTuner::noteName(uint8_t note) {
+    static const char* const kNames[12] = {
+        "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
+    };
+    return kNames[note % 12];
+}
+
+
+// --- Audio task ---
+
+void CTAG_AudioTuner::_push(const float* block, size_t numSamples) {
+    if (!_taskHandle) return;
+    numSamples = min(numSamples, (size_t)CTAG_AUDIO_BLOCK_SIZE);
+
+    size_t out = numSamples / kDecimation;
+    if (_fifo.space() < out) {
+        _droppedBlocks = _droppedBlocks + 1;
+        return;
+    }
+
+    memcpy(_scratch, block, numSamples * sizeof(float));
+    _antiAlias.process(_scratch, numSamples);
+
+    _fifo.writeFloat(_scratch, out, kDecimation);
+}
+
+
+// --- Tuner task ---
+
+void CTAG_AudioTuner::_taskLoop() {
+    int16_t in[kHop];
+    while (true) {
+        if (_fifo.available() < kHop) {
+            vTaskDelay(pdMS_TO_TICKS(5));
+            continue;
+        }
+        _fifo.read(in, kHop);
+
+        uint32_t t0 = micros();
+
+        // Slide the buffer by one hop and append the new samples.
+        memmove(_buf, _buf + kHop, (_length - kHop) * sizeof(float));
+        float* dst = _buf + _length - kHop;
+        for (size_t i = 0; i < kHop; ++i) dst[i] = in[i] * (1.0f / 32768.0f);
+        _count += kHop;
+        if (_count < _length) continue;
+
+        bool full = !_primed || ++_sinceRefresh >= kRefreshHops;
+        if (full) _sinceRefresh = 0;
+        _update(full);
+        _primed = true;
+
+        Reading r = _estimate();
+        uint8_t next = _readIdx ^ 1;
+        _readings[next] = r;
+        _readIdx = next;
+
+        uint32_t dt = micros() - t0;
+        _lastUs = dt;
+        if (dt > _maxUs) _maxUs = dt;
+        _avgUs += 0.05f * ((float)dt - _avgUs);
+        _updates = _updates + 1;
+
+        Callback cb = _cb;
+        if (cb) cb(r, _cbArg);
+    }
+}
+
+void CTAG_AudioTuner::_update(bool full) {
+    // The window has moved from [0, kWindow) to [kHop, kHop + kWindow).
+    const float* x = _buf;
+
+    if (full) {
+        const float* w = x + kHop;
+        for (size_t tau = 0; tau <= _tauMax; ++tau) {
+            float sum = 0.0f;
+            for (size_t j = 0; j < kWindow; ++j) {
+                float d = w[j] - w[j + tau];
+                sum += d * d;
+            }
+            _diff[tau] = sum;
+        }
+        float e = 0.0f;
+        for (size_t j = 0; j < kWindow; ++j) e += w[j] * w[j];
+        _energy = e;
+        return;
+    }
+
+    // Drop the terms of samples [0, kHop), add those of [kWindow, kWindow + kHop).
+    const float* gone  = x;
+    const float* added = x + kWindow;
+    for (size_t tau = 1; tau <= _tauMax; ++tau) {
+        float sub = 0.0f, add = 0.0f;
+        for (size_t j = 0; j < kHop; ++j) {
+            float a = gone[j] - gone[j + tau];
+            float b = added[j] - added[j + tau];
+            sub += a * a;
+            add += b * b;
+        }
+        _diff[tau] = max(_diff[tau] + add - sub, 0.0f);
+    }
+    float sub = 0.0f, add = 0.0f;
+    for (size_t j = 0; j < kHop; ++j) {
+        sub += gone[j] * gone[j];
+        add += added[j] * added[j];
+    }
+    _energy = max(_energy + add - sub, 0.0f);
+}
+
+CTAG_AudioTuner::Reading CTAG_AudioTuner::_estimate() {
+    Reading r = {};
+
+    // Cumulative mean normalized difference, d'(0) = 1.
+    float running = 0.0f;
+    _cmnd[0] = 1.0f;
+    for (size_t tau = 1; tau <= _tauMax; ++tau) {
+        running += _diff[tau];
+        _cmnd[tau] = running > 0.0f ? _diff[tau] * tau / running : 1.0f;
+    }
+
+    if (_energy < kGateEnergy * kWindow) {
+        _smoothed = 0.0f;
+        return r;
+    }
+
+    // First dip below the threshold, followed down to its local minimum.
+    size_t tau = _tauMin;
+    while (tau < _tauMax && _cmnd[tau] >= _threshold) ++tau;
+    if (tau >= _tauMax) {
+        _smoothed = 0.0f;
+        return r;
+    }
+    while (tau + 1 < _tauMax && _cmnd[tau + 1] < _cmnd[tau]) ++tau;
+
+    // Parabolic interpolation on the raw difference function, which is
+    // less biased than the normalized one at short lags.
+    float period = (float)tau;
+    if (tau > 1) {
+        float a = _diff[tau - 1], b = _diff[tau], c = _diff[tau + 1];
+        float den = a - 2.0f * b + c;
+        if (den > 1e-9f) period += 0.5f * (a - c) / den;
+    }
+    float freq = kDecimatedRate / period;
+
+    // Light smoothing while the pitch holds, immediate jumps otherwise.
+    if (_smoothed > 0.0f && fabsf(freq / _smoothed - 1.0f) < 0.03f) {
+        _smoothed += 0.3f * (freq - _smoothed);
+    } else {
+        _smoothed = freq;
+    }
+
+    float midi = 69.0f + 12.0f * log2f(_smoothed / _reference);
+    long note  = constrain(lrintf(midi), 0L, 127L);
+    r.valid      = true;
+    r.frequency  = _smoothed;
+    r.note       = (uint8_t)note;
+    r.cents      = (int8_t)constrain(lrintf((midi - note) * 100.0f), -50L, 50L);
+    r.confidence = constrain(1.0f - _cmnd[tau], 0.0f, 1.0f);
+    return r;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file CTAG_AudioTuner.h
+ * @brief YIN pitch detector (tuner) for the CTAG audio engine.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * The tuner is an engine sink. On the audio task it low-passes the tapped
+ * block and keeps every fourth sample (11.025 kHz), so only 64 samples per
+ * block go through the FIFO. A low-priority task on the other core runs YIN
+ * on a 512-sample window (46 ms), which covers 40 Hz to 1 kHz.
+ *
+ * The difference function is not recomputed for every hop: when 64 new
+ * samples arrive, the terms of the 64 oldest are subtracted and those of the
+ * newest added, which costs about a quarter of a full pass. A full pass every
+ * kRefreshHops hops removes the rounding drift.
+ *
+ * 1. CTAG_AudioTuner: Frequency, MIDI note and cents of a monophonic signal.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_TUNER_H
+#define CTAG_AUDIO_TUNER_H
+
+#include "CTAG_AudioTap.h"
+#include "CTAG_AudioFilter.h"
+
+/**
+ * @class CTAG_AudioTuner
+ * @brief Detects the pitch of the master bus or one source slot in the background.
+ */
+class CTAG_AudioTuner : public CTAG_AudioTap {
+public:
+    static const uint8_t kDecimation  = 4;   ///< Audio rate / analysis rate.
+    static const size_t  kWindow      = 512; ///< YIN integration window (decimated samples).
+    static const size_t  kHop         = CTAG_AUDIO_BLOCK_SIZE / kDecimation; ///< New samples per update.
+    static const uint8_t kRefreshHops = 32;  ///< Updates between two full recomputations.
+    static constexpr float kMinFreq   = 40.0f;   ///< Lowest detectable pitch in Hz.
+    static constexpr float kMaxFreq   = 1000.0f; ///< Highest detectable pitch in Hz.
+
+    /// First byte of a packed tuner message (see packReading()).
+    static const uint8_t kTunerMsgId  = CTAG_Params::kTunerMsgId;
+    /// Size of a packed tuner message.
+    static const size_t  kTunerMsgLen = 7;
+
+    /**
+     * @brief Result of the latest update.
+     */
+    struct Reading {
+        bool    valid;      ///< A pitch was found (signal loud and periodic enough).
+        float   frequency;  ///< Detected frequency in Hz.
+        uint8_t note;       ///< Nearest MIDI note (69 = A4).
+        int8_t  cents;      ///< Deviation from that note, -50 … +50.
+        float   confidence; ///< 1 - YIN aperiodicity, 0.0 … 1.0.
+    };
+
+    /**
+     * @brief Called from the tuner task after every update.
+     * @param reading The new result.
+     * @param arg The pointer given to setCallback().
+     */
+    using Callback = void(*)(const Reading& reading, void* arg);
+
+    /**
+     * @brief Cost counters.
+     */
+    struct Stats {
+        uint32_t updates;       ///< Number of completed updates.
+        uint32_t droppedBlocks; ///< Blocks lost because the FIFO was full.
+        uint32_t lastUs;        ///< Duration of the last update.
+        uint32_t maxUs;         ///< Longest update (a full recomputation).
+        float    load;          ///< Share of the tuner core used (0.0 … 1.0).
+    };
+
+    CTAG_AudioTuner();
+    ~CTAG_AudioTuner();
+
+    /**
+     * @brief Allocates the buffers and starts the tuner task.
+     * @param core Core the tuner task runs on.
+     * @return False if memory or the task could not be allocated.
+     */
+    bool begin(BaseType_t core = 0);
+
+    /**
+     * @brief Sets the reference pitch of A4 (default 440 Hz).
+     */
+    void setReference(float a4Hz);
+
+    /**
+     * @brief Sets the YIN threshold (default 0.15). Lower values reject more
+     * noisy signals, higher values also accept weakly periodic ones.
+     */
+    void setThreshold(float threshold);
+
+    /**
+     * @brief Registers a function that receives every new reading.
+     * @note Runs on the tuner task, about 172 times per second.
+     */
+    void setCallback(Callback cb, void* arg = nullptr);
+
+    /**
+     * @brief Returns the latest reading.
+     */
+    Reading getReading() const;
+
+    /**
+     * @brief Writes the latest reading as a compact message:
+     * [kTunerMsgId, valid, note, cents, frequency in 0.1 Hz (uint16, LE), confidence 0 … 255].
+     * @param dst Room for kTunerMsgLen bytes.
+     * @return kTunerMsgLen.
+     */
+    size_t packReading(uint8_t* dst) const;
+
+    Stats getStats() const;
+
+    /**
+     * @brief Name of a MIDI note without octave, e.g. "C#".
+     */
+    static const char* noteName(uint8_t note);
+
+private:
+    void _push(const float* block, size_t numSamples) override;
+    void _taskLoop() override;
+    void _update(bool full);
+    Reading _estimate();
+
+    CTAG_BiquadFilter _antiAlias;
+    float             _scratch[CTAG_AUDIO_BLOCK_SIZE]; ///< Filtered block (audio task).
+
+    size_t   _tauMin = 0;
+    size_t   _tauMax = 0;
+    size_t   _length = 0;       ///< Samples in _buf: kHop + kWindow + tauMax.
+    float*   _buf    = nullptr; ///< Latest decimated samples, oldest first.
+    float*   _diff   = nullptr; ///< YIN difference function d(tau), tauMax + 1.
+    float*   _cmnd   = nullptr; ///< Cumulative mean normalized d(tau), tauMax + 1.
+    size_t   _count  = 0;       ///< Decimated samples received so far.
+    uint8_t  _sinceRefresh = 0;
+    bool     _primed = false;   ///< _diff holds a valid window.
+    float    _energy = 0.0f;    ///< Sum of squares over the window.
+
+    float    _reference = 440.0f;
+    float    _threshold = 0.15f;
+    float    _smoothed  = 0.0f;
+
+    Reading          _readings[2] = {};
+    volatile uint8_t _readIdx     = 0;
+
+    Callback volatile _cb    = nullptr;
+    void* volatile    _cbArg = nullptr;
+
+    volatile uint32_t _updates       = 0;
+    volatile uint32_t _droppedBlocks = 0;
+    volatile uint32_t _lastUs        = 0;
+    volatile uint32_t _maxUs         = 0;
+    float             _avgUs         = 0.0f;
+};
+
+#endif // CTAG_AUDIO_TUNER_H
@@ -0,0 +1,504 @@
+/**
+ * @file CTAG_AudioUSB.cpp
+ * @brief Implementation of the USB Audio Class 2.0 device.
+ */
+#include "CTAG_AudioUSB.h"
+
+#if CTAG_USB_AUDIO_SUPPORTED
+#include "esp32-hal-tinyusb.h"
+#include "class/audio/audio.h"
+#include "device/usbd_pvt.h"
+#endif
+
+// --- Rate adaptation ---
+
+/// Device-to-host FIFO fill the packet sizing aims for, and the dead band around it.
+static const size_t kToHostTarget = CTAG_AUDIO_BLOCK_SIZE + CTAG_AUDIO_BLOCK_SIZE / 2;
+static const size_t kToHostSlack  = CTAG_AUDIO_BLOCK_SIZE / 2 + 32;
+
+/// Host-to-device FIFO fill the resampler aims for.
+static const float kFromHostTarget = 2.0f * CTAG_AUDIO_BLOCK_SIZE;
+static const float kRatioKp        = 1e-3f;  ///< Ratio change per unit of relative fill error.
+static const float kRatioKi        = 5e-6f;  ///< Integral gain, per block.
+static const float kRatioMax       = 2e-3f;  ///< Largest correction (2000 ppm).
+
+/// Nominal frames per 1 ms USB frame: integer part and remainder in 1/1000 frames.
+static const uint32_t kFramesPerMs    = CTAG_AUDIO_SAMPLE_RATE / 1000;
+static const uint32_t kFramesPerMsRem = CTAG_AUDIO_SAMPLE_RATE % 1000;
+
+static CTAG_USBAudio* _active = nullptr;
+
+
+CTAG_USBAudio::CTAG_USBAudio(uint8_t channels)
+    : _channels(channels >= kMaxChannels ? kMaxChannels : 2)
+{
+    memset(_stems, 0, sizeof(_stems));
+}
+
+CTAG_USBAudio::~CTAG_USBAudio() {
+    end();
+}
+
+void CTAG_USBAudio::setInputGain(float gain) {
+    _inputGain = constrain(gain, 0.0f, 1.0f);
+}
+
+int16_t CTAG_USBAudio::getNextSample() {
+    float s;
+    renderBlock(&s, 1);
+    return (int16_t)(s * 32767.0f);
+}
+
+void CTAG_USBAudio::reset() {
+    _prev = _cur = 0.0f;
+    _fromHostPrimed = false;
+}
+
+CTAG_USBAudio::Stats CTAG_USBAudio::getStats() const {
+    Stats s;
+    s.toHostActive      = _toHostActive;
+    s.fromHostActive    = _fromHostActive;
+    s.toHostFill        = (uint16_t)_toHost.available();
+    s.fromHostFill      = (uint16_t)_fromHost.available();
+    s.fromHostRatioPpm  = (_ratio - 1.0f) * 1e6f;
+    s.toHostOverruns    = _toHostOverruns;
+    s.fromHostUnderruns = _fromHostUnderruns;
+    s.sizeCorrections   = _sizeCorrections;
+    return s;
+}
+
+
+// --- Engine side (audio task) ---
+
+void CTAG_USBAudio::writeVoice(uint8_t slot, const float* block, size_t numSamples) {
+    if (slot >= _channels - 2) return;
+    memcpy(_stems[slot], block, min(numSamples, (size_t)CTAG_AUDIO_BLOCK_SIZE) * sizeof(float));
+    _stemValid[slot] = true;
+}
+
+void CTAG_USBAudio::writeMaster(const float* block, size_t numSamples) {
+    if (_begun && _toHostActive) {
+        const size_t kChunk = 32;
+        int16_t frames[kChunk * kMaxChannels];
+        bool dropped = false;
+
+        for (size_t c = 0; c < numSamples; c += kChunk) {
+            size_t n = min(kChunk, numSamples - c);
+            int16_t* f = frames;
+            for (size_t i = 0; i < n; ++i) {
+                int16_t m = (int16_t)(block[c + i] * 32767.0f);
+                *f++ = m;
+                *f++ = m;
+                for (uint8_t s = 0; s + 2 < _channels; ++s) {
+                    float x = _stemValid[s] ? constrain(_stems[s][c + i], -1.0f, 1.0f) : 0.0f;
+                    *f++ = (int16_t)(x * 32767.0f);
+                }
+            }
+            if (_toHost.write(frames, n) < n) dropped = true;
+        }
+        if (dropped) _toHostOverruns = _toHostOverruns + 1;
+    }
+    for (uint8_t s = 0; s < kMaxChannels - 2; ++s) _stemValid[s] = false;
+}
+
+void CTAG_USBAudio::renderBlock(float* out, size_t numSamples) {
+    if (!_begun || !_fromHostActive) {
+        // The FIFO reader owns the tail, so stale host data is dropped here.
+        if (_begun) _fromHost.skip(_fromHost.available());
+        _fromHostPrimed = false;
+        memset(out, 0, numSamples * sizeof(float));
+        return;
+    }
+
+    float fill = (float)_fromHost.available();
+    if (!_fromHostPrimed) {
+        if (fill < kFromHostTarget) {
+            memset(out, 0, numSamples * sizeof(float));
+            return;
+        }
+        _fromHostPrimed = true;
+        _fillAvg  = fill;
+        _integral = 0.0f;
+        _frac     = 0.0f;
+        _prev = _cur = 0.0f;
+    }
+
+    // Steer the consumption rate so the FIFO stays around its target.
+    _fillAvg += 0.05f * (fill - _fillAvg);
+    float err = (_fillAvg - kFromHostTarget) / kFromHostTarget;
+    _integral = constrain(_integral + kRatioKi * err, -kRatioMax, kRatioMax);
+    _ratio    = 1.0f + constrain(kRatioKp * err + _integral, -kRatioMax, kRatioMax);
+
+    const float g = _inputGain * (0.5f / 32768.0f); // stereo sum to mono
+    for (size_t i = 0; i < numSamples; ++i) {
+        _frac += _ratio;
+        while (_frac >= 1.0f) {
+            _frac -= 1.0f;
+            int16_t frame[2];
+            if (_fromHost.read(frame, 1) == 0) {
+                // Ran dry: hold the last value and wait for the FIFO to refill.
+                _fromHostUnderruns = _fromHostUnderruns + 1;
+                _fromHostPrimed = false;
+                for (; i < numSamples; ++i) out[i] = _cur;
+                _prev = _cur = 0.0f;
+                return;
+            }
+            _prev = _cur;
+            _cur  = (float)(frame[0] + frame[1]) * g;
+        }
+        out[i] = _prev + (_cur - _prev) * _frac;
+    }
+}
+
+
+// --- USB side (TinyUSB task) ---
+
+void CTAG_USBAudio::setToHostActive(bool active) {
+    if (active == _toHostActive) return;
+    if (_begun) _toHost.skip(_toHost.available());
+    _toHostPrimed = false;
+    _packetAcc    = 0;
+    _toHostActive = active;
+}
+
+void CTAG_USBAudio::setFromHostActive(bool active) {
+    _fromHostActive = active;
+}
+
+size_t CTAG_USBAudio::nextPacketToHost(int16_t* dst) {
+    if (!_begun || !_toHostActive) return 0;
+
+    size_t fill = _toHost.available();
+    if (!_toHostPrimed) {
+        if (fill < kToHostTarget) return 0;
+        _toHostPrimed = true;
+    }
+
+    // Nominal size: 44.1 frames per ms at 44.1 kHz, i.e. nine packets of 44
+    // and one of 45. One extra or one missing frame keeps the FIFO on target.
+    size_t frames = kFramesPerMs;
+    _packetAcc += kFramesPerMsRem;
+    if (_packetAcc >= 1000) {
+        _packetAcc -= 1000;
+        ++frames;
+    }
+    if (fill > kToHostTarget + kToHostSlack) {
+        ++frames;
+        _sizeCorrections = _sizeCorrections + 1;
+    } else if (fill < kToHostTarget - kToHostSlack) {
+        --frames;
+        _sizeCorrections = _sizeCorrections + 1;
+    }
+
+    size_t n = _toHost.read(dst, frames);
+    if (n < frames) {
+        // Keep the packet rate; the engine stalled, so pad with silence.
+        memset(dst + n * _channels, 0, (frames - n) * _channels * sizeof(int16_t));
+        _toHostPrimed = false;
+    }
+    return frames;
+}
+
+void CTAG_USBAudio::packetFromHost(const int16_t* frames, size_t numFrames) {
+    if (!_begun) return;
+    // A full FIFO means the engine is not pulling; the packet is dropped.
+    _fromHost.write(frames, numFrames);
+}
+
+
+// --- USB Audio Class 2.0 driver ---
+
+#if CTAG_USB_AUDIO_SUPPORTED
+
+namespace {
+    // Entity IDs of the audio function
+    enum : uint8_t {
+        kClockId    = 0x10,
+        kFromHostIt = 0x01, ///< USB streaming in (host playback)
+        kFromHostOt = 0x02, ///< ... to the engine
+        kToHostIt   = 0x03, ///< Engine ...
+        kToHostOt   = 0x04  ///< ... to USB streaming out (host recording)
+    };
+
+    const uint16_t kAcLen = TUD_AUDIO_DESC_CLK_SRC_LEN
+                          + 2 * TUD_AUDIO_DESC_INPUT_TERM_LEN
+                          + 2 * TUD_AUDIO_DESC_OUTPUT_TERM_LEN;
+    const uint16_t kAsEpOffset = 2 * TUD_AUDIO_DESC_STD_AS_INT_LEN
+                               + TUD_AUDIO_DESC_CS_AS_INT_LEN
+                               + TUD_AUDIO_DESC_TYPE_I_FORMAT_LEN;
+    const uint16_t kAsLen = kAsEpOffset
+                          + TUD_AUDIO_DESC_STD_AS_ISO_EP_LEN
+                          + TUD_AUDIO_DESC_CS_AS_ISO_EP_LEN;
+    const uint16_t kFunctionHeaderLen = TUD_AUDIO_DESC_IAD_LEN
+                                      + TUD_AUDIO_DESC_STD_AC_LEN
+                                      + TUD_AUDIO_DESC_CS_AC_LEN;
+    const uint16_t kDescLen = kFunctionHeaderLen + kAcLen + 2 * kAsLen;
+
+    const uint16_t kFromHostEpSize = CTAG_USBAudio::kMaxPacketFrames * 2 * sizeof(int16_t);
+
+    uint8_t  _desc[kDescLen];        ///< Copy of the function descriptor, for endpoint activation.
+    uint8_t  _firstItf   = 0;
+    uint8_t  _epFromHost = 0;        ///< OUT endpoint address
+    uint8_t  _epToHost   = 0;        ///< IN endpoint address
+    uint16_t _epToHostSize = 0;
+    uint8_t  _alt[2]     = {0, 0};   ///< Alternate setting: [0] from host, [1] to host
+    bool     _registered = false;
+
+    CFG_TUSB_MEM_ALIGN uint8_t _ctrlBuf[16];
+    CFG_TUSB_MEM_ALIGN int16_t _txBuf[CTAG_USBAudio::kMaxPacketFrames * CTAG_USBAudio::kMaxChannels];
+    CFG_TUSB_MEM_ALIGN int16_t _rxBuf[CTAG_USBAudio::kMaxPacketFrames * 2];
+
+    uint16_t _loadDescriptor(uint8_t* dst, uint8_t* itf) {
+        if (!_active) return 0;
+
+        uint8_t str    = tinyusb_add_string_descriptor("CTAG Audio");
+        uint8_t epOut  = tinyusb_get_free_out_endpoint();
+        uint8_t epIn   = tinyusb_get_free_in_endpoint();
+        TU_VERIFY(epOut != 0 && epIn != 0, 0);
+
+        const uint8_t  ch     = _active->getChannels();
+        const uint32_t chCfg  = (ch == 2) ? (AUDIO_CHANNEL_CONFIG_FRONT_LEFT | AUDIO_CHANNEL_CONFIG_FRONT_RIGHT)
+                                          : AUDIO_CHANNEL_CONFIG_NON_PREDEFINED;
+        const uint8_t  i0     = *itf;
+        _firstItf     = i0;
+        _epFromHost   = epOut;
+        _epToHost     = (uint8_t)(0x80 | epIn);
+        _epToHostSize = (uint16_t)(CTAG_USBAudio::kMaxPacketFrames * ch * sizeof(int16_t));
+
+        uint8_t desc[] = {
+            TUD_AUDIO_DESC_IAD(i0, 3, 0),
+            TUD_AUDIO_DESC_STD_AC(i0, 0, str),
+            TUD_AUDIO_DESC_CS_AC(0x0200, AUDIO_FUNC_IO_BOX, kAcLen, AUDIO_CS_AS_INTERFACE_CTRL_LATENCY_POS),
+            TUD_AUDIO_DESC_CLK_SRC(kClockId, AUDIO_CLOCK_SOURCE_ATT_INT_FIX_CLK,
+                                   (AUDIO_CTRL_R << AUDIO_CLOCK_SOURCE_CTRL_CLK_FRQ_POS), 0, 0),
+            TUD_AUDIO_DESC_INPUT_TERM(kFromHostIt, AUDIO_TERM_TYPE_USB_STREAMING, 0, kClockId, 2,
+                                      AUDIO_CHANNEL_CONFIG_FRONT_LEFT | AUDIO_CHANNEL_CONFIG_FRONT_RIGHT, 0, 0, 0),
+            TUD_AUDIO_DESC_OUTPUT_TERM(kFromHostOt, AUDIO_TERM_TYPE_OUT_GENERIC_SPEAKER, 0, kFromHostIt, kClockId, 0, 0),
+            TUD_AUDIO_DESC_INPUT_TERM(kToHostIt, AUDIO_TERM_TYPE_IN_GENERIC_MIC, 0, kClockId, ch, chCfg, 0, 0, 0),
+            TUD_AUDIO_DESC_OUTPUT_TERM(kToHostOt, AUDIO_TERM_TYPE_USB_STREAMING, 0, kToHostIt, kClockId, 0, 0),
+
+            // Host playback: alt 0 = idle, alt 1 = stereo 16 bit, adaptive endpoint
+            TUD_AUDIO_DESC_STD_AS_INT((uint8_t)(i0 + 1), 0, 0, 0),
+            TUD_AUDIO_DESC_STD_AS_INT((uint8_t)(i0 + 1), 1, 1, 0),
+            TUD_AUDIO_DESC_CS_AS_INT(kFromHostIt, AUDIO_CTRL_NONE, AUDIO_FORMAT_TYPE_I, AUDIO_DATA_FORMAT_TYPE_I_PCM, 2,
+                                     AUDIO_CHANNEL_CONFIG_FRONT_LEFT | AUDIO_CHANNEL_CONFIG_FRONT_RIGHT, 0),
+            TUD_AUDIO_DESC_TYPE_I_FORMAT(2, 16),
+            TUD_AUDIO_DESC_STD_AS_ISO_EP(epOut, (uint8_t)(TUSB_XFER_ISOCHRONOUS | TUSB_ISO_EP_ATT_ADAPTIVE | TUSB_ISO_EP_ATT_DATA),
+                                         kFromHostEpSize, 1),
+            TUD_AUDIO_DESC_CS_AS_ISO_EP(AUDIO_CS_AS_ISO_DATA_EP_ATT_NON_MAX_PACKETS_OK, AUDIO_CTRL_NONE,
+                                        AUDIO_CS_AS_ISO_DATA_EP_LOCK_DELAY_UNIT_UNDEFINED, 0),
+
+            // Host recording: alt 0 = idle, alt 1 = ch x 16 bit, asynchronous endpoint
+            TUD_AUDIO_DESC_STD_AS_INT((uint8_t)(i0 + 2), 0, 0, 0),
+            TUD_AUDIO_DESC_STD_AS_INT((uint8_t)(i0 + 2), 1, 1, 0),
+            TUD_AUDIO_DESC_CS_AS_INT(kToHostOt, AUDIO_CTRL_NONE, AUDIO_FORMAT_TYPE_I, AUDIO_DATA_FORMAT_TYPE_I_PCM, ch, chCfg, 0),
+            TUD_AUDIO_DESC_TYPE_I_FORMAT(2, 16),
+            TUD_AUDIO_DESC_STD_AS_ISO_EP(_epToHost, (uint8_t)(TUSB_XFER_ISOCHRONOUS | TUSB_ISO_EP_ATT_ASYNCHRONOUS | TUSB_ISO_EP_ATT_DATA),
+                                         _epToHostSize, 1),
+            TUD_AUDIO_DESC_CS_AS_ISO_EP(AUDIO_CS_AS_ISO_DATA_EP_ATT_NON_MAX_PACKETS_OK, AUDIO_CTRL_NONE,
+                                        AUDIO_CS_AS_ISO_DATA_EP_LOCK_DELAY_UNIT_UNDEFINED, 0),
+        };
+        static_assert(sizeof(desc) == kDescLen, "UAC2 descriptor length mismatch");
+
+        memcpy(_desc, desc, sizeof(desc));
+        memcpy(dst, desc, sizeof(desc));
+        *itf += 3;
+        return sizeof(desc);
+    }
+
+    tusb_desc_endpoint_t const* _endpointDesc(bool toHost) {
+        uint16_t offset = kFunctionHeaderLen + kAcLen + (toHost ? kAsLen : 0) + kAsEpOffset;
+        return (tusb_desc_endpoint_t const*)(_desc + offset);
+    }
+
+    bool _sendToHost(uint8_t rhport) {
+        size_t frames = _active->nextPacketToHost(_txBuf);
+        return usbd_edpt_xfer(rhport, _epToHost, (uint8_t*)_txBuf,
+                              (uint16_t)(frames * _active->getChannels() * sizeof(int16_t)));
+    }
+
+    bool _setInterface(uint8_t rhport, uint8_t itf, uint8_t alt) {
+        if (itf != _firstItf + 1 && itf != _firstItf + 2) return itf == _firstItf;
+        const bool    toHost = (itf == _firstItf + 2);
+        const uint8_t ep     = toHost ? _epToHost : _epFromHost;
+
+        _alt[toHost] = alt;
+        if (alt == 0) {
+#ifndef TUP_DCD_EDPT_ISO_ALLOC
+            usbd_edpt_close(rhport, ep);
+#endif
+            if (toHost) _active->setToHostActive(false);
+            else        _active->setFromHostActive(false);
+            return true;
+        }
+
+#ifdef TUP_DCD_EDPT_ISO_ALLOC
+        TU_VERIFY(usbd_edpt_iso_activate(rhport, _endpointDesc(toHost)));
+#else
+        TU_VERIFY(usbd_edpt_open(rhport, _endpointDesc(toHost)));
+#endif
+        if (toHost) {
+            _active->setToHostActive(true);
+            return _sendToHost(rhport);
+        }
+        _active->setFromHostActive(true);
+        return usbd_edpt_xfer(rhport, ep, (uint8_t*)_rxBuf, sizeof(_rxBuf));
+    }
+
+    // --- Class driver callbacks ---
+
+    void _drvInit(void) {}
+
+    void _drvReset(uint8_t rhport) {
+        (void)rhport;
+        _alt[0] = _alt[1] = 0;
+        if (_active) {
+            _active->setToHostActive(false);
+            _active->setFromHostActive(false);
+        }
+    }
+
+    uint16_t _drvOpen(uint8_t rhport, tusb_desc_interface_t const* desc, uint16_t maxLen) {
+        if (!_active || desc->bInterfaceClass != TUSB_CLASS_AUDIO ||
+            desc->bInterfaceSubClass != AUDIO_SUBCLASS_CONTROL ||
+            desc->bInterfaceNumber != _firstItf) return 0;
+
+        // The stack hands over the function without its IAD.
+        const uint16_t len = kDescLen - TUD_AUDIO_DESC_IAD_LEN;
+        TU_VERIFY(maxLen >= len, 0);
+#ifdef TUP_DCD_EDPT_ISO_ALLOC
+        usbd_edpt_iso_alloc(rhport, _epFromHost, kFromHostEpSize);
+        usbd_edpt_iso_alloc(rhport, _epToHost, _epToHostSize);
+#else
+        (void)rhport;
+#endif
+        return len;
+    }
+
+    bool _drvControl(uint8_t rhport, uint8_t stage, tusb_control_request_t const* request) {
+        if (!_active) return false;
+
+        if (request->bmRequestType_bit.type == TUSB_REQ_TYPE_STANDARD) {
+            if (request->bmRequestType_bit.recipient != TUSB_REQ_RCPT_INTERFACE) return false;
+            const uint8_t itf = TU_U16_LOW(request->wIndex);
+            if (request->bRequest == TUSB_REQ_SET_INTERFACE) {
+                if (stage != CONTROL_STAGE_SETUP) return true;
+                TU_VERIFY(_setInterface(rhport, itf, (uint8_t)request->wValue));
+                return tud_control_status(rhport, request);
+            }
+            if (request->bRequest == TUSB_REQ_GET_INTERFACE) {
+                if (stage != CONTROL_STAGE_SETUP) return true;
+                _ctrlBuf[0] = (itf == _firstItf + 1) ? _alt[0] : (itf == _firstItf + 2) ? _alt[1] : 0;
+                return tud_control_xfer(rhport, request, _ctrlBuf, 1);
+            }
+            return false;
+        }
+
+        // Class requests: only the clock source has controls.
+        if (request->bmRequestType_bit.type != TUSB_REQ_TYPE_CLASS ||
+            request->bmRequestType_bit.recipient != TUSB_REQ_RCPT_INTERFACE ||
+            TU_U16_HIGH(request->wIndex) != kClockId) return false;
+        if (stage != CONTROL_STAGE_SETUP) return true;
+
+        const uint8_t ctrl = TU_U16_HIGH(request->wValue);
+        const uint32_t rate = CTAG_AUDIO_SAMPLE_RATE;
+
+        if (request->bmRequestType_bit.direction == TUSB_DIR_IN) {
+            if (ctrl == AUDIO_CS_CTRL_SAM_FREQ && request->bRequest == AUDIO_CS_REQ_CUR) {
+                memcpy(_ctrlBuf, &rate, 4);
+                return tud_control_xfer(rhport, request, _ctrlBuf, 4);
+            }
+            if (ctrl == AUDIO_CS_CTRL_SAM_FREQ && request->bRequest == AUDIO_CS_REQ_RANGE) {
+                // One sub-range: min = max = rate, resolution 0
+                const uint16_t count = 1;
+                const uint32_t res   = 0;
+                memcpy(_ctrlBuf,      &count, 2);
+                memcpy(_ctrlBuf + 2,  &rate,  4);
+                memcpy(_ctrlBuf + 6,  &rate,  4);
+                memcpy(_ctrlBuf + 10, &res,   4);
+                return tud_control_xfer(rhport, request, _ctrlBuf, 14);
+            }
+            if (ctrl == AUDIO_CS_CTRL_CLK_VALID && request->bRequest == AUDIO_CS_REQ_CUR) {
+                _ctrlBuf[0] = 1;
+                return tud_control_xfer(rhport, request, _ctrlBuf, 1);
+            }
+            return false;
+        }
+
+        // Some hosts set the (only) rate anyway; accept and ignore it.
+        if (ctrl == AUDIO_CS_CTRL_SAM_FREQ && request->bRequest == AUDIO_CS_REQ_CUR) {
+            return tud_control_xfer(rhport, request, _ctrlBuf, 4);
+        }
+        return false;
+    }
+
+    bool _drvXfer(uint8_t rhport, uint8_t ep, xfer_result_t result, uint32_t bytes) {
+        if (!_active) return false;
+        if (ep == _epToHost) {
+            return _alt[1] ? _sendToHost(rhport) : true;
+        }
+        if (ep == _epFromHost) {
+            if (result == XFER_RESULT_SUCCESS) {
+                _active->packetFromHost(_rxBuf, bytes / (2 * sizeof(int16_t)));
+            }
+            return _alt[0] ? usbd_edpt_xfer(rhport, ep, (uint8_t*)_rxBuf, sizeof(_rxBuf)) : true;
+        }
+        return false;
+    }
+
+    usbd_class_driver_t _driver;
+}
+
+/**
+ * @brief Hands the UAC2 class driver to the TinyUSB device stack.
+ */
+extern "C" usbd_class_driver_t const* usbd_app_driver_get_cb(uint8_t* driver_count) {
+    _driver.init            = _drvInit;
+    _driver.reset           = _drvReset;
+    _driver.open            = _drvOpen;
+    _driver.control_xfer_cb = _drvControl;
+    _driver.xfer_cb         = _drvXfer;
+    _driver.sof             = nullptr;
+    *driver_count = 1;
+    return &_driver;
+}
+
+#endif // CTAG_USB_AUDIO_SUPPORTED
+
+
+bool CTAG_USBAudio::begin() {
+#if CTAG_USB_AUDIO_SUPPORTED
+    if (_begun) return true;
+    if (_active) return false;
+
+    if (!_toHost.begin(4 * CTAG_AUDIO_BLOCK_SIZE, _channels) ||
+        !_fromHost.begin(8 * CTAG_AUDIO_BLOCK_SIZE, 2)) {
+        _toHost.end();
+        _fromHost.end();
+        return false;
+    }
+
+    _active = this;
+    if (!_registered) {
+        if (tinyusb_enable_interface(USB_INTERFACE_CUSTOM, kDescLen, _loadDescriptor) != ESP_OK) {
+            _active = nullptr;
+            _toHost.end();
+            _fromHost.end();
+            return false;
+        }
+        _registered = true;
+    }
+    _begun = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CTAG_USBAudio::end() {
+    if (_active == this) _active = nullptr;
+    _begun = false;
+    _toHostActive = _fromHostActive = false;
+    _toHost.end();
+    _fromHost.end();
+}
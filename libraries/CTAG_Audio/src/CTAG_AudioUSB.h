@@ -0,0 +1,169 @@
+/**
+ * @file CTAG_AudioUSB.h
+ * @brief USB Audio Class 2.0 device for the CTAG audio engine.
+ *
+ * @ingroup Libraries_Audio
+ *
+ * The ESP32-S3 shows up on the host as a sound card with
+ * - an input of 2 or 4 channels: the master bus on channels 1/2 and, with
+ *   4 channels, the first two source slots as stems on channels 3/4;
+ * - a stereo output, which is played into the engine as a source.
+ *
+ * Both directions run at CTAG_AUDIO_SAMPLE_RATE, 16 bit. The codec's I2S
+ * clock and the USB frame clock are independent, so each direction goes
+ * through a CTAG_AudioFifo whose fill level steers the rate:
+ * - device to host (asynchronous endpoint): the packet size is trimmed by
+ *   one frame whenever the FIFO drifts away from its target fill;
+ * - host to device (adaptive endpoint): the engine reads the FIFO through a
+ *   linear-interpolating resampler whose ratio follows the fill level.
+ *
+ * @note Needs the "USB Mode: USB-OTG (TinyUSB)" board setting. The core's
+ * TinyUSB build has no audio class, so this file brings its own small class
+ * driver through usbd_app_driver_get_cb(); no other library in the sketch
+ * may define that callback.
+ *
+ * 1. CTAG_USBAudio: The USB sound card, an engine source and sink in one.
+ */
+#pragma once
+#ifndef CTAG_AUDIO_USB_H
+#define CTAG_AUDIO_USB_H
+
+#include "CTAG_Audio.h"
+#include "CTAG_AudioFifo.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include "sdkconfig.h"
+#include "soc/soc_caps.h"
+#endif
+
+/**
+ * @brief 1 if the selected board configuration can run the USB audio device.
+ */
+#if defined(SOC_USB_OTG_SUPPORTED) && SOC_USB_OTG_SUPPORTED && CONFIG_TINYUSB_ENABLED && (ARDUINO_USB_MODE == 0)
+#define CTAG_USB_AUDIO_SUPPORTED 1
+#else
+#define CTAG_USB_AUDIO_SUPPORTED 0
+#endif
+
+/**
+ * @class CTAG_USBAudio
+ * @brief USB sound card: streams the engine to the host and plays host audio.
+ *
+ * Add it with CTAG_AudioEngine::addSink() to record the engine, and with
+ * CTAG_AudioEngine::addSource() to hear the host's playback (summed to mono).
+ */
+class CTAG_USBAudio : public CTAG_AudioSource, public CTAG_AudioSink {
+public:
+    static const uint8_t kMaxChannels = 4;
+    /// Largest USB packet in frames (nominal frames per 1 ms frame + drift correction).
+    static const size_t  kMaxPacketFrames = CTAG_AUDIO_SAMPLE_RATE / 1000 + 2;
+
+    /**
+     * @brief Fill-level and error counters of both directions.
+     */
+    struct Stats {
+        bool     toHostActive;    ///< Host has opened the recording stream.
+        bool     fromHostActive;  ///< Host has opened the playback stream.
+        uint16_t toHostFill;      ///< Frames waiting in the device-to-host FIFO.
+        uint16_t fromHostFill;    ///< Frames waiting in the host-to-device FIFO.
+        float    fromHostRatioPpm;///< Current resampler correction in ppm.
+        uint32_t toHostOverruns;  ///< Blocks dropped because the host did not fetch them.
+        uint32_t fromHostUnderruns; ///< Blocks the engine rendered without host data.
+        uint32_t sizeCorrections; ///< Packets shortened or lengthened by one frame.
+    };
+
+    /**
+     * @brief Constructs the device.
+     * @param channels Channels sent to the host: 2 (master) or 4 (master + 2 stems).
+     */
+    CTAG_USBAudio(uint8_t channels = 2);
+    ~CTAG_USBAudio();
+
+    /**
+     * @brief Allocates the FIFOs and registers the USB interfaces.
+     * @note Call before USB.begin(). Only one instance can be active.
+     * @return False if USB audio is not supported by the build settings,
+     * memory is short or another instance is active.
+     */
+    bool begin();
+
+    /**
+     * @brief Stops both streams and frees the FIFOs.
+     * @note Remove the device from the engine first. The USB interfaces stay
+     * registered until the next reset.
+     */
+    void end();
+
+    /**
+     * @brief Gain applied to the host's playback (0.0 … 1.0, default 1.0).
+     */
+    void setInputGain(float gain);
+
+    uint8_t getChannels() const { return _channels; }
+    Stats   getStats() const;
+
+    // --- CTAG_AudioSource: host playback into the engine ---
+    int16_t getNextSample() override;
+    void renderBlock(float* out, size_t numSamples) override;
+    void reset() override;
+
+    // --- CTAG_AudioSink: engine output to the host ---
+    void writeVoice(uint8_t slot, const float* block, size_t numSamples) override;
+    void writeMaster(const float* block, size_t numSamples) override;
+
+    // --- Called by the USB class driver (TinyUSB task) ---
+
+    /**
+     * @brief Opens or closes the device-to-host stream.
+     */
+    void setToHostActive(bool active);
+
+    /**
+     * @brief Opens or closes the host-to-device stream.
+     */
+    void setFromHostActive(bool active);
+
+    /**
+     * @brief Fills the next device-to-host packet.
+     * @param dst Room for kMaxPacketFrames interleaved frames.
+     * @return Number of frames in the packet (may be 0 while priming).
+     */
+    size_t nextPacketToHost(int16_t* dst);
+
+    /**
+     * @brief Stores a packet received from the host.
+     * @param frames Interleaved stereo frames.
+     * @param numFrames Number of frames.
+     */
+    void packetFromHost(const int16_t* frames, size_t numFrames);
+
+private:
+    uint8_t        _channels;
+    CTAG_AudioFifo _toHost;
+    CTAG_AudioFifo _fromHost;
+    float          _inputGain = 1.0f;
+    bool           _begun     = false;
+
+    // Device to host
+    volatile bool  _toHostActive  = false;
+    bool           _toHostPrimed  = false;
+    uint32_t       _packetAcc     = 0;  ///< Fractional-frame accumulator (1/1000 frames).
+    float          _stems[kMaxChannels - 2][CTAG_AUDIO_BLOCK_SIZE];
+    bool           _stemValid[kMaxChannels - 2] = {};
+
+    // Host to device
+    volatile bool  _fromHostActive = false;
+    bool           _fromHostPrimed = false;
+    float          _ratio     = 1.0f;   ///< Frames consumed per output sample.
+    float          _integral  = 0.0f;
+    float          _fillAvg   = 0.0f;
+    float          _frac      = 0.0f;
+    float          _prev      = 0.0f;
+    float          _cur       = 0.0f;
+
+    volatile uint32_t _toHostOverruns    = 0;
+    volatile uint32_t _fromHostUnderruns = 0;
+    volatile uint32_t _sizeCorrections   = 0;
+};
+
+#endif // CTAG_AUDIO_USB_H
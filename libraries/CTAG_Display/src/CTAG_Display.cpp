@@ -3,14 +3,17 @@
  * @brief Implementation file for the CTAG_Display class.
  */
 #include "CTAG_Display.h"
+#include <new>
 
 // Constructor: Initializes the display pointer to null.
 CTAG_Display::CTAG_Display() : _disp(nullptr) {
 }
 
-// Destructor: Frees the memory allocated for the display object.
+// Destructor: Destroys the display object constructed in the internal storage.
 CTAG_Display::~CTAG_Display() {
-  delete _disp;
+  if (_disp) {
+    _disp->~Adafruit_SH1106G();
+  }
 }
 
 bool CTAG_Display::begin(uint8_t sda, uint8_t scl, uint8_t address) {
@@ -20,11 +23,12 @@ bool CTAG_Display::begin(uint8_t sda, uint8_t scl, uint8_t address) {
   Wire1.setClock(400000); // Use 400kHz fast I2C
   Wire1.begin();
 
-  // Create the display object on the heap.
-  _disp = new Adafruit_SH1106G(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire1, OLED_RESET);
-  if (!_disp) {
-    return false; // Memory allocation failed.
+  // Construct the display object in the internal storage instead of on the heap.
+  // A repeated begin() first tears down the previous instance.
+  if (_disp) {
+    _disp->~Adafruit_SH1106G();
   }
+  _disp = new (_dispStorage) Adafruit_SH1106G(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire1, OLED_RESET);
   
   // Initialize the display driver.
   if (!_disp->begin(address, true)) { // `true` = reset display
@@ -77,6 +81,33 @@ void CTAG_Display::writeRow(uint8_t row, const char* text) {
   display();
 }
 
+void CTAG_Display::drawBars(const uint8_t* levels, uint8_t count, uint8_t firstRow) {
+  // Check for valid arguments and display object.
+  if (!_disp || !levels || count == 0 || count > SCREEN_WIDTH || firstRow >= 8) return;
+
+  // Redraw the text rows above the graph.
+  _disp->clearDisplay();
+  for (uint8_t r = 0; r < firstRow; ++r) {
+    _disp->setCursor(0, r * 8);
+    _disp->print(_buffer[r]);
+  }
+
+  // Bars grow upwards from the bottom edge; a one-pixel gap separates them
+  // as long as they are at least three pixels wide.
+  const int16_t top    = firstRow * 8;
+  const int16_t height = SCREEN_HEIGHT - top;
+  const int16_t pitch  = SCREEN_WIDTH / count;
+  const int16_t width  = pitch > 2 ? pitch - 1 : pitch;
+  const int16_t left   = (SCREEN_WIDTH - pitch * count) / 2;
+  for (uint8_t i = 0; i < count; ++i) {
+    int16_t h = (int16_t)(((uint16_t)levels[i] * height + 127) / 255);
+    if (h > 0) {
+      _disp->fillRect(left + i * pitch, SCREEN_HEIGHT - h, width, h, SH110X_WHITE);
+    }
+  }
+  _disp->display();
+}
+
 String CTAG_Display::readDisplay() const {
   String out;
   // Concatenate all rows from the buffer into a single String.
@@ -43,7 +43,7 @@ public:
   CTAG_Display();
 
   /**
-   * @brief Destroys the CTAG_Display object, freeing allocated memory.
+   * @brief Destroys the CTAG_Display object and the underlying display driver.
    */
   ~CTAG_Display();
 
@@ -74,6 +74,16 @@ public:
    */
   void writeRow(uint8_t row, const char* text);
 
+  /**
+   * @brief Draws a bar graph (e.g. a spectrum) below the text rows and updates the display.
+   * @note Rows from firstRow down are used by the bars; their text stays in the
+   * buffer and reappears with the next display() or writeRow().
+   * @param levels Bar heights, 0 (empty) to 255 (full height).
+   * @param count Number of bars (at most SCREEN_WIDTH), spread over the full width.
+   * @param firstRow First text row covered by the bars (0-7, default 1 keeps a title row).
+   */
+  void drawBars(const uint8_t* levels, uint8_t count, uint8_t firstRow = 1);
+
   /**
    * @brief Reads the entire content of the internal text buffer.
    * @return A String object containing the content of all rows, separated by newlines.
@@ -81,9 +91,12 @@ public:
   String readDisplay() const;
 
 private:
-  ///< Pointer to the underlying Adafruit display object.
+  ///< Pointer to the underlying Adafruit display object (lives in _dispStorage).
   Adafruit_SH1106G* _disp;
 
+  ///< In-place storage for the display object, so begin() does not allocate it on the heap.
+  alignas(Adafruit_SH1106G) uint8_t _dispStorage[sizeof(Adafruit_SH1106G)];
+
   ///< Internal buffer for the text content (8 rows of 21 chars + null terminator).
   char _buffer[8][22];
 };
@@ -0,0 +1,122 @@
+/**
+ * @file ParamSyncHostTest.cpp
+ * @brief Host test of CTAG_ParamSync over a lossy link.
+ *
+ * The controller side moves one knob of the FM plugin for 20 of every 100
+ * steps of 16 ms and builds a message per step; every 97th message is lost
+ * on the way. The engine side parses what arrives, tracks the versions and
+ * answers a gap with a keyframe request, which the controller handles.
+ *
+ * Build and run from this directory:
+ *
+ *   g++ -std=gnu++17 -I stub -I ../../src ParamSyncHostTest.cpp -o param_sync_host_test
+ *   ./param_sync_host_test
+ *
+ * The exit code is the number of failed checks.
+ */
+#include <CTAG_ParamSync.h>
+#include <CTAG_SourceParams.h>
+
+#include <stdio.h>
+
+static int _failures = 0;
+
+#define CHECK(cond)                                                      \
+    do {                                                                 \
+        if (!(cond)) {                                                   \
+            printf("  FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond);   \
+            ++_failures;                                                 \
+        }                                                                \
+    } while (0)
+
+static void testLossyLink() {
+    printf("lossy link\n");
+    const CTAG_PluginDesc& desc = CTAG_SourceParams::kPlugins[CTAG_SourceParams::kFM];
+    CTAG_ParamSyncSender sender;
+    CTAG_SyncTracker tracker;
+    sender.setDeadband(64);
+    sender.setKeyframeInterval(5000);
+    sender.setPlugin(desc);
+
+    uint16_t controller[256] = { 0 };
+    uint16_t engine[256] = { 0 };
+    for (uint8_t i = 0; i < desc.numParams; ++i) {
+        controller[desc.params[i].id] = desc.params[i].toRaw(desc.params[i].def);
+    }
+    uint8_t buf[60];
+    uint32_t sent = 0, bytes = 0, lost = 0, resyncs = 0, idleMessages = 0;
+    uint32_t nowMs = 0;
+
+    for (int step = 0; step < 3000; ++step, nowMs += 16) {
+        const bool moving = step % 100 < 20;
+        if (moving) {
+            const uint16_t v = (uint16_t)(step * 977);
+            sender.set(desc.params[0].id, v);
+            controller[desc.params[0].id] = v;
+        }
+        size_t len = sender.build(buf, sizeof(buf), nowMs);
+        if (!len) continue;
+        ++sent;
+        bytes += len;
+        if (!moving && !(buf[CTAG_Params::kSyncFlagsOffset] & CTAG_Params::kSyncKeyframe)) ++idleMessages;
+        if (step % 97 == 5) {
+            ++lost;
+            continue;
+        }
+
+        uint8_t plugin;
+        uint16_t version;
+        bool keyframe;
+        CHECK(CTAG_Params::parseSync(buf, len, plugin, version, keyframe,
+                                     [&](uint8_t id, uint16_t v) { engine[id] = v; }));
+        tracker.accept(plugin, version, keyframe);
+        if (tracker.needsKeyframe()) {
+            uint8_t request[2];
+            CTAG_Params::buildResync(request, tracker.plugin());
+            if (sender.handleReply(request, sizeof(request))) ++resyncs;
+        }
+    }
+
+    CTAG_ParamSyncSender::Stats stats = sender.getStats();
+    printf("  %u messages, %u bytes, %u lost, %u gaps, %u resyncs, %u deltas, %u keyframes\n",
+           (unsigned)sent, (unsigned)bytes, (unsigned)lost, (unsigned)tracker.gaps(),
+           (unsigned)resyncs, (unsigned)stats.deltas, (unsigned)stats.keyframes);
+    CHECK(lost > 0);
+    CHECK(tracker.gaps() == lost);
+    CHECK(resyncs == lost);
+    CHECK(idleMessages == 0);
+    CHECK(!tracker.needsKeyframe());
+    for (uint8_t i = 0; i < desc.numParams; ++i) {
+        CHECK(engine[desc.params[i].id] == controller[desc.params[i].id]);
+    }
+}
+
+static void testKeyframeNeverTruncated() {
+    printf("keyframe capacity\n");
+    const CTAG_PluginDesc& desc = CTAG_SourceParams::kPlugins[CTAG_SourceParams::kFM];
+    CTAG_ParamSyncSender sender;
+    sender.setPlugin(desc);
+    uint8_t buf[60];
+
+    // A keyframe that does not fit is not built, and stays due
+    const size_t full = CTAG_Params::kSyncHeaderLen + desc.numParams * CTAG_Params::kEntryLen;
+    const uint16_t version = sender.version();
+    CHECK(sender.build(buf, full - 1, 0) == 0);
+    CHECK(sender.version() == version);
+    CHECK(sender.build(buf, sizeof(buf), 0) == full);
+    CHECK(buf[CTAG_Params::kSyncFlagsOffset] & CTAG_Params::kSyncKeyframe);
+    CHECK(buf[CTAG_Params::kSyncCountOffset] == desc.numParams);
+
+    // With no deadband, unchanged registers stay out of a delta
+    sender.set(desc.params[0].id, 1234);
+    size_t len = sender.build(buf, sizeof(buf), 16);
+    CHECK(len == CTAG_Params::kSyncHeaderLen + CTAG_Params::kEntryLen);
+    CHECK(sender.build(buf, sizeof(buf), 32) == 0);
+}
+
+int main() {
+    testLossyLink();
+    testKeyframeNeverTruncated();
+    printf(_failures ? "%d checks failed\n" : "all checks passed\n", _failures);
+    return _failures;
+}
@@ -0,0 +1,11 @@
+/**
+ * @file Arduino.h
+ * @brief The part of the Arduino core that CTAG_Params uses, for host builds.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
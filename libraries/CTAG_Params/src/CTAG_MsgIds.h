@@ -0,0 +1,42 @@
+/**
+ * @file CTAG_MsgIds.h
+ * @brief Registry of the message IDs exchanged between controller and sound engine.
+ *
+ * @ingroup Libraries_Params
+ *
+ * Every message on the link between the two processors starts with a
+ * one-byte ID, in both directions, and receivers tell messages apart by that
+ * byte alone. All IDs are therefore assigned here and nowhere else: a new
+ * message type takes the next free ID, so two types can never share one.
+ *
+ * 1. CTAG_Params: The message IDs.
+ */
+#pragma once
+#ifndef CTAG_MSG_IDS_H
+#define CTAG_MSG_IDS_H
+
+#include <stdint.h>
+
+namespace CTAG_Params {
+
+/// Parameter message, controller to engine (see CTAG_Params.h).
+static constexpr uint8_t kMsgId = 0x50;
+
+/// Versioned delta or keyframe, controller to engine (see CTAG_ParamSync.h).
+static constexpr uint8_t kSyncMsgId = 0x51;
+
+/// Keyframe request, engine to controller (see CTAG_ParamSync.h).
+static constexpr uint8_t kResyncMsgId = 0x52;
+
+/// Band levels of CTAG_AudioAnalyzer, engine to controller.
+static constexpr uint8_t kSpectrumMsgId = 0x53;
+
+/// Pitch reading of CTAG_AudioTuner, engine to controller.
+static constexpr uint8_t kTunerMsgId = 0x54;
+
+/// Engine status, engine to controller: [kStatusMsgId, plugin, DSP load %, peak load %].
+static constexpr uint8_t kStatusMsgId = 0x55;
+
+} // namespace CTAG_Params
+
+#endif // CTAG_MSG_IDS_H
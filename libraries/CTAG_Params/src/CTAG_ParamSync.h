@@ -0,0 +1,274 @@
+/**
+ * @file CTAG_ParamSync.h
+ * @brief Versioned delta synchronization of a plugin's parameters.
+ *
+ * @ingroup Libraries_Params
+ *
+ * Both sides hold the same register map: the parameters of the selected
+ * plugin. The sender numbers every message it builds and puts only the
+ * registers that changed into it (a delta); now and then, and after every
+ * plugin switch, it sends all of them (a keyframe). The receiver checks the
+ * version numbers: a gap means a delta was lost, and it asks for a keyframe
+ * instead of waiting for the next periodic one. Keyframes can therefore be
+ * rare, and an idle link carries no parameter traffic at all.
+ *
+ *     [kSyncMsgId][plugin][version lo][version hi][flags][count][id][value lo][value hi] …
+ *     [kResyncMsgId][plugin]     (receiver to sender: send a keyframe)
+ *
+ * Values are absolute, so a delta that arrives after a lost one is still
+ * applied; only the registers the lost one carried are stale until the
+ * keyframe.
+ *
+ * 1. CTAG_Params: Sync message constants and parsing.
+ * 2. CTAG_SyncTracker: Version tracking on the receiving side.
+ * 3. CTAG_ParamSyncSender: Register map, deltas and keyframes on the sending side.
+ */
+#pragma once
+#ifndef CTAG_PARAM_SYNC_H
+#define CTAG_PARAM_SYNC_H
+
+#include "CTAG_Params.h"
+
+/**
+ * @brief Most registers a CTAG_ParamSyncSender holds. A keyframe of 16
+ * registers is 54 bytes and fits one CTAG_SPI_IPC packet.
+ */
+#ifndef CTAG_PARAM_SYNC_MAX_REGS
+#define CTAG_PARAM_SYNC_MAX_REGS 16
+#endif
+
+namespace CTAG_Params {
+
+/// Sync message header: ID, plugin, version (2), flags, count.
+static constexpr size_t kSyncHeaderLen = 6;
+
+/// Offset of the flags byte in a sync message.
+static constexpr size_t kSyncFlagsOffset = 4;
+
+/// Offset of the entry count in a sync message.
+static constexpr size_t kSyncCountOffset = 5;
+
+/// Flag: the message carries every register of the plugin.
+static constexpr uint8_t kSyncKeyframe = 0x01;
+
+/**
+ * @brief Walks a sync message.
+ * @param fn Called as fn(paramId, rawValue) for every entry.
+ * @return False if the message is not a well-formed sync message.
+ * @note Integer-only, so it may run in the SPI slave's ISR callback.
+ */
+template <typename Fn>
+bool parseSync(const uint8_t* data, size_t len, uint8_t& plugin, uint16_t& version,
+               bool& keyframe, Fn&& fn) {
+    if (len < kSyncHeaderLen || data[0] != kSyncMsgId) return false;
+    const uint8_t n = data[kSyncCountOffset];
+    if (len != kSyncHeaderLen + n * kEntryLen) return false;
+    plugin   = data[1];
+    version  = (uint16_t)(data[2] | (data[3] << 8));
+    keyframe = (data[kSyncFlagsOffset] & kSyncKeyframe) != 0;
+    const uint8_t* p = data + kSyncHeaderLen;
+    for (uint8_t i = 0; i < n; ++i, p += kEntryLen) {
+        fn(p[0], (uint16_t)(p[1] | (p[2] << 8)));
+    }
+    return true;
+}
+
+/**
+ * @brief Writes a keyframe request.
+ * @return Its length (2).
+ */
+inline size_t buildResync(uint8_t* buf, uint8_t plugin) {
+    buf[0] = kResyncMsgId;
+    buf[1] = plugin;
+    return 2;
+}
+
+} // namespace CTAG_Params
+
+/**
+ * @class CTAG_SyncTracker
+ * @brief Follows the version numbers of incoming sync messages.
+ * @note Integer-only; accept() may run in an ISR.
+ */
+class CTAG_SyncTracker {
+public:
+    /**
+     * @brief Records a received sync message.
+     */
+    void accept(uint8_t plugin, uint16_t version, bool keyframe) {
+        if (keyframe) {
+            _synced = true;
+        } else if (!_synced || plugin != _plugin || version != (uint16_t)(_version + 1)) {
+            // A delta or the keyframe of a plugin switch went missing
+            if (_synced) ++_gaps;
+            _synced = false;
+        }
+        _plugin  = plugin;
+        _version = version;
+    }
+
+    /**
+     * @brief True until a keyframe has arrived, and again after a gap.
+     */
+    bool needsKeyframe() const { return !_synced; }
+
+    /// Plugin of the last message.
+    uint8_t plugin() const { return _plugin; }
+
+    /// Number of gaps (lost messages) detected so far.
+    uint32_t gaps() const { return _gaps; }
+
+private:
+    volatile bool     _synced  = false;
+    volatile uint8_t  _plugin  = 0;
+    volatile uint16_t _version = 0;
+    volatile uint32_t _gaps    = 0;
+};
+
+/**
+ * @class CTAG_ParamSyncSender
+ * @brief The sender's register map; builds deltas and keyframes.
+ *
+ * @code
+ * sync.setPlugin(CTAG_SourceParams::kPlugins[plugin]);
+ * sync.set(paramId, potValue);
+ * size_t n = sync.build(msg, sizeof(msg), millis());
+ * if (n) CTAG_SPI_IPC::exchange(msg, n, reply, sizeof(reply));
+ * sync.handleReply(reply, replyLen);
+ * @endcode
+ */
+class CTAG_ParamSyncSender {
+public:
+    /**
+     * @brief Counters of the sender.
+     */
+    struct Stats {
+        uint32_t deltas;     ///< Delta messages built.
+        uint32_t keyframes;  ///< Keyframes built (periodic, plugin switch or requested).
+        uint32_t resyncs;    ///< Keyframe requests received.
+        uint32_t entries;    ///< Register values sent in total.
+    };
+
+    /**
+     * @brief Makes the plugin's parameters the register map. The registers
+     * start at their defaults, and the next message is a keyframe.
+     */
+    void setPlugin(const CTAG_PluginDesc& desc) {
+        _plugin = desc.id;
+        _count  = desc.numParams < CTAG_PARAM_SYNC_MAX_REGS ? desc.numParams : CTAG_PARAM_SYNC_MAX_REGS;
+        for (uint8_t i = 0; i < _count; ++i) {
+            _ids[i]   = desc.params[i].id;
+            _value[i] = desc.params[i].toRaw(desc.params[i].def);
+            _sent[i]  = _value[i];
+        }
+        _keyframeDue = true;
+    }
+
+    /**
+     * @brief Sets a register.
+     * @return False if the plugin has no such parameter.
+     */
+    bool set(uint8_t id, uint16_t raw) {
+        for (uint8_t i = 0; i < _count; ++i) {
+            if (_ids[i] == id) {
+                _value[i] = raw;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Smallest change that goes into a delta; hides ADC noise.
+     * Keyframes always carry the exact values.
+     */
+    void setDeadband(uint16_t raw) { _deadband = raw; }
+
+    /**
+     * @brief Interval of the periodic keyframe in milliseconds, 0 for none.
+     */
+    void setKeyframeInterval(uint32_t ms) { _keyframeMs = ms; }
+
+    /**
+     * @brief Makes the next message a keyframe.
+     */
+    void requestKeyframe() { _keyframeDue = true; }
+
+    /**
+     * @brief Handles a message from the receiver.
+     * @return True if it was a keyframe request for the current plugin.
+     */
+    bool handleReply(const uint8_t* data, size_t len) {
+        if (len < 2 || data[0] != CTAG_Params::kResyncMsgId || data[1] != _plugin) return false;
+        _keyframeDue = true;
+        ++_stats.resyncs;
+        return true;
+    }
+
+    /**
+     * @brief Builds the next message, if one is due.
+     * @param buf Output buffer, at least kSyncHeaderLen + 3 * registers bytes
+     * for a keyframe. A delta that does not fit carries the entries that do;
+     * the others go out with the next one.
+     * @param nowMs Current time, e.g. millis().
+     * @return The message length, or 0 if nothing changed and no keyframe is
+     * due, or if a due keyframe does not fit (nothing is marked as sent then).
+     */
+    size_t build(uint8_t* buf, size_t capacity, uint32_t nowMs) {
+        if (_keyframeMs && nowMs - _lastKeyframe >= _keyframeMs) _keyframeDue = true;
+        const bool keyframe = _keyframeDue;
+        if (capacity < CTAG_Params::kSyncHeaderLen) return 0;
+        // The receiver takes a keyframe as the complete state; never truncate one.
+        if (keyframe && CTAG_Params::kSyncHeaderLen + _count * CTAG_Params::kEntryLen > capacity) return 0;
+
+        size_t len = CTAG_Params::kSyncHeaderLen;
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < _count; ++i) {
+            const uint16_t v = _value[i];
+            if (!keyframe && (v == _sent[i] || abs((int)v - (int)_sent[i]) < (int)_deadband)) continue;
+            if (len + CTAG_Params::kEntryLen > capacity) break;
+            buf[len++] = _ids[i];
+            buf[len++] = (uint8_t)(v & 0xFF);
+            buf[len++] = (uint8_t)(v >> 8);
+            _sent[i] = v;
+            ++n;
+        }
+        if (n == 0 && !keyframe) return 0;
+
+        ++_version;
+        buf[0] = CTAG_Params::kSyncMsgId;
+        buf[1] = _plugin;
+        buf[2] = (uint8_t)(_version & 0xFF);
+        buf[3] = (uint8_t)(_version >> 8);
+        buf[CTAG_Params::kSyncFlagsOffset] = keyframe ? CTAG_Params::kSyncKeyframe : 0;
+        buf[CTAG_Params::kSyncCountOffset] = n;
+        if (keyframe) {
+            _keyframeDue  = false;
+            _lastKeyframe = nowMs;
+            ++_stats.keyframes;
+        } else {
+            ++_stats.deltas;
+        }
+        _stats.entries += n;
+        return len;
+    }
+
+    uint8_t  plugin() const  { return _plugin; }
+    uint16_t version() const { return _version; }
+    Stats    getStats() const { return _stats; }
+
+private:
+    uint8_t  _plugin = 0;
+    uint8_t  _count  = 0;
+    uint8_t  _ids[CTAG_PARAM_SYNC_MAX_REGS];
+    uint16_t _value[CTAG_PARAM_SYNC_MAX_REGS];
+    uint16_t _sent[CTAG_PARAM_SYNC_MAX_REGS];   ///< Last value that went out.
+    uint16_t _deadband     = 0;
+    uint16_t _version      = 0;
+    uint32_t _keyframeMs   = 2000;
+    uint32_t _lastKeyframe = 0;
+    bool     _keyframeDue  = true;
+    Stats    _stats        = {};
+};
+
+#endif // CTAG_PARAM_SYNC_H
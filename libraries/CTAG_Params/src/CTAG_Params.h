@@ -0,0 +1,243 @@
+/**
+ * @file CTAG_Params.h
+ * @brief Compile-time parameter descriptors shared by controller and sound engine.
+ *
+ * @defgroup Libraries_Params CTAG_Params
+ * @ingroup Libraries
+ *
+ * Every plugin (audio source) describes its parameters once, as constexpr
+ * tables of CTAG_ParamDesc: ID, name, range, curve, unit, default and
+ * smoothing time. Both processors include the same tables, so the controller
+ * can label and scale its knobs and the sound engine can apply values
+ * without either side hard-coding ranges or per-plugin switches.
+ *
+ * On the wire a parameter is addressed by its one-byte ID and carries a
+ * normalized 16-bit value (0 … 65535 across the range, curve applied on the
+ * receiving side). A message holds a plugin ID and any number of
+ * (ID, value) pairs, so only the parameters that changed need to be sent:
+ *
+ *     [kMsgId][plugin][count][id][value lo][value hi] … [id][value lo][value hi]
+ *
+ * The library is header-only and has no platform dependencies.
+ *
+ * 1. CTAG_ParamDesc: Descriptor of one parameter, with the curve math.
+ * 2. CTAG_PluginDesc: A plugin's ID, name and parameter table.
+ * 3. CTAG_ParamWriter: Builds a parameter message.
+ * 4. CTAG_Params: Message parsing and value formatting.
+ */
+#pragma once
+#ifndef CTAG_PARAMS_H
+#define CTAG_PARAMS_H
+
+#include <Arduino.h>
+#include <math.h>
+#include "CTAG_MsgIds.h"
+
+/**
+ * @brief Mapping from the normalized position (0 … 1) to the value.
+ */
+enum class CTAG_ParamCurve : uint8_t {
+    Linear,      ///< Even steps, e.g. amplitude, duty cycle.
+    Exponential, ///< Even steps per octave, e.g. frequencies. min must be > 0.
+    Stepped      ///< Linear, rounded to whole numbers, never smoothed.
+};
+
+/**
+ * @brief Unit of a parameter value, used for display.
+ */
+enum class CTAG_ParamUnit : uint8_t {
+    None,
+    Hz,
+    Percent,  ///< Value is a fraction 0 … 1, shown as 0 … 100 %.
+    Seconds,
+    Cents,
+    Decibel
+};
+
+/**
+ * @struct CTAG_ParamDesc
+ * @brief Describes one parameter. Build tables of these as constexpr arrays.
+ */
+struct CTAG_ParamDesc {
+    /// Largest normalized wire value.
+    static constexpr uint16_t kRawMax = 65535;
+
+    uint8_t         id;          ///< Unique within the plugin.
+    const char*     name;        ///< Short label, at most 8 characters for the display.
+    float           min;
+    float           max;
+    float           def;         ///< Value after power-up.
+    CTAG_ParamCurve curve;
+    CTAG_ParamUnit  unit;
+    uint16_t        smoothingMs; ///< Time constant of the receiver's smoothing, 0 = none.
+
+    /**
+     * @brief Value at a normalized position.
+     * @param n Position, 0.0 … 1.0.
+     */
+    float fromNormalized(float n) const {
+        n = n < 0.0f ? 0.0f : (n > 1.0f ? 1.0f : n);
+        switch (curve) {
+            case CTAG_ParamCurve::Exponential: return min * powf(max / min, n);
+            case CTAG_ParamCurve::Stepped:     return floorf(min + n * (max - min) + 0.5f);
+            default:                           return min + n * (max - min);
+        }
+    }
+
+    /**
+     * @brief Normalized position of a value, 0.0 … 1.0.
+     */
+    float toNormalized(float value) const {
+        float n;
+        if (curve == CTAG_ParamCurve::Exponential) {
+            n = (value > 0.0f) ? logf(value / min) / logf(max / min) : 0.0f;
+        } else {
+            n = (value - min) / (max - min);
+        }
+        return n < 0.0f ? 0.0f : (n > 1.0f ? 1.0f : n);
+    }
+
+    float    fromRaw(uint16_t raw) const { return fromNormalized(raw * (1.0f / kRawMax)); }
+    uint16_t toRaw(float value) const    { return (uint16_t)(toNormalized(value) * kRawMax + 0.5f); }
+};
+
+/**
+ * @struct CTAG_PluginDesc
+ * @brief Describes a plugin: its wire ID, display name and parameters.
+ */
+struct CTAG_PluginDesc {
+    uint8_t               id;
+    const char*           name;
+    const CTAG_ParamDesc* params;
+    uint8_t               numParams;
+
+    /**
+     * @brief Looks up a parameter by ID.
+     * @return The descriptor, or nullptr if the plugin has no such parameter.
+     */
+    const CTAG_ParamDesc* find(uint8_t paramId) const {
+        for (uint8_t i = 0; i < numParams; ++i) {
+            if (params[i].id == paramId) return &params[i];
+        }
+        return nullptr;
+    }
+};
+
+namespace CTAG_Params {
+
+/// Message header: ID, plugin, count.
+static constexpr size_t kHeaderLen = 3;
+
+/// Bytes per parameter in a message.
+static constexpr size_t kEntryLen = 3;
+
+/**
+ * @brief Number of entries in a constexpr descriptor array.
+ */
+template <typename T, size_t N>
+constexpr uint8_t count(const T (&)[N]) { return (uint8_t)N; }
+
+/**
+ * @brief True if no two descriptors share an ID and every range is valid.
+ * Use it in a static_assert next to the table.
+ */
+template <size_t N>
+constexpr bool isValid(const CTAG_ParamDesc (&params)[N]) {
+    for (size_t i = 0; i < N; ++i) {
+        if (!(params[i].max > params[i].min)) return false;
+        if (params[i].def < params[i].min || params[i].def > params[i].max) return false;
+        if (params[i].curve == CTAG_ParamCurve::Exponential && !(params[i].min > 0.0f)) return false;
+        for (size_t j = i + 1; j < N; ++j) {
+            if (params[i].id == params[j].id) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Walks a parameter message.
+ * @param data Message bytes.
+ * @param len Message length.
+ * @param plugin Receives the plugin ID.
+ * @param fn Called as fn(paramId, rawValue) for every entry.
+ * @return False if the message is not a well-formed parameter message.
+ * @note Integer-only, so it may run in the SPI slave's ISR callback.
+ */
+template <typename Fn>
+bool parse(const uint8_t* data, size_t len, uint8_t& plugin, Fn&& fn) {
+    if (len < kHeaderLen || data[0] != kMsgId) return false;
+    const uint8_t n = data[2];
+    if (len != kHeaderLen + n * kEntryLen) return false;
+    plugin = data[1];
+    const uint8_t* p = data + kHeaderLen;
+    for (uint8_t i = 0; i < n; ++i, p += kEntryLen) {
+        fn(p[0], (uint16_t)(p[1] | (p[2] << 8)));
+    }
+    return true;
+}
+
+/**
+ * @brief Formats a value with its unit, e.g. "440 Hz", "80 %", "1.25 s".
+ * @return Number of characters written (as snprintf).
+ */
+inline int format(const CTAG_ParamDesc& desc, float value, char* buf, size_t size) {
+    switch (desc.unit) {
+        case CTAG_ParamUnit::Hz:
+            return value < 100.0f ? snprintf(buf, size, "%.1f Hz", value)
+                                  : snprintf(buf, size, "%d Hz", (int)(value + 0.5f));
+        case CTAG_ParamUnit::Percent: return snprintf(buf, size, "%d %%", (int)(value * 100.0f + 0.5f));
+        case CTAG_ParamUnit::Seconds: return snprintf(buf, size, "%.2f s", value);
+        case CTAG_ParamUnit::Cents:   return snprintf(buf, size, "%+d ct", (int)lroundf(value));
+        case CTAG_ParamUnit::Decibel: return snprintf(buf, size, "%.1f dB", value);
+        default:
+            return desc.curve == CTAG_ParamCurve::Stepped ? snprintf(buf, size, "%d", (int)value)
+                                                          : snprintf(buf, size, "%.2f", value);
+    }
+}
+
+} // namespace CTAG_Params
+
+/**
+ * @class CTAG_ParamWriter
+ * @brief Builds a parameter message in a caller-provided buffer.
+ *
+ * @code
+ * uint8_t msg[32];
+ * CTAG_ParamWriter w(msg, sizeof(msg), plugin.id);
+ * w.add(param.id, param.toRaw(440.0f));
+ * CTAG_SPI_IPC::send(msg, w.length());
+ * @endcode
+ */
+class CTAG_ParamWriter {
+public:
+    CTAG_ParamWriter(uint8_t* buf, size_t capacity, uint8_t plugin)
+        : _buf(buf), _cap(capacity), _len(CTAG_Params::kHeaderLen)
+    {
+        _buf[0] = CTAG_Params::kMsgId;
+        _buf[1] = plugin;
+        _buf[2] = 0;
+    }
+
+    /**
+     * @brief Appends one parameter.
+     * @return False if the buffer is full.
+     */
+    bool add(uint8_t paramId, uint16_t raw) {
+        if (_len + CTAG_Params::kEntryLen > _cap || _buf[2] == 255) return false;
+        _buf[_len++] = paramId;
+        _buf[_len++] = (uint8_t)(raw & 0xFF);
+        _buf[_len++] = (uint8_t)(raw >> 8);
+        ++_buf[2];
+        return true;
+    }
+
+    size_t  length() const { return _len; }
+    uint8_t count() const  { return _buf[2]; }
+
+private:
+    uint8_t* _buf;
+    size_t   _cap;
+    size_t   _len;
+};
+
+#endif // CTAG_PARAMS_H
@@ -0,0 +1,95 @@
+/**
+ * @file CTAG_SourceParams.h
+ * @brief Parameter descriptors of the built-in CTAG_Audio sources.
+ *
+ * @ingroup Libraries_Params
+ *
+ * The tables live here rather than in CTAG_Audio, so that the RP2040
+ * controller, which cannot build the audio library, sees exactly the same
+ * ranges and IDs as the ESP32 sound engine. Parameters that several plugins
+ * share (frequency, amplitude) share an ID.
+ *
+ * 1. CTAG_SourceParams: Plugin and parameter IDs, descriptor tables, plugin list.
+ */
+#pragma once
+#ifndef CTAG_SOURCE_PARAMS_H
+#define CTAG_SOURCE_PARAMS_H
+
+#include "CTAG_Params.h"
+
+namespace CTAG_SourceParams {
+
+/**
+ * @brief Plugin IDs of the built-in sources.
+ */
+enum PluginId : uint8_t {
+    kSine   = 0,
+    kSquare = 1,
+    kSaw    = 2,
+    kFM     = 3
+};
+
+/**
+ * @brief Parameter IDs of the built-in sources.
+ */
+enum ParamId : uint8_t {
+    kFrequency = 0, ///< Oscillator or carrier frequency.
+    kAmplitude = 1,
+    kLfoRate   = 2, ///< Sine: vibrato rate.
+    kLfoDepth  = 3, ///< Sine: vibrato depth.
+    kDutyCycle = 4, ///< Square: pulse width.
+    kSkew      = 5, ///< Saw: position of the peak.
+    kModFreq   = 6, ///< FM: modulator frequency.
+    kModIndex  = 7  ///< FM: modulation index.
+};
+
+using Curve = CTAG_ParamCurve;
+using Unit  = CTAG_ParamUnit;
+
+//                                  id          name        min     max      default  curve               unit           smoothing ms
+constexpr CTAG_ParamDesc kSineParams[] = {
+    { kFrequency, "Freq",     20.0f, 3000.0f,  440.0f, Curve::Exponential, Unit::Hz,      20 },
+    { kAmplitude, "Amp",       0.0f,    1.0f,    0.5f, Curve::Linear,      Unit::Percent, 20 },
+    { kLfoRate,   "LFO Rate",  0.1f,   10.0f,    5.0f, Curve::Exponential, Unit::Hz,      50 },
+    { kLfoDepth,  "LFO Dpth",  0.0f,  500.0f,    0.0f, Curve::Linear,      Unit::Hz,      50 },
+};
+
+constexpr CTAG_ParamDesc kSquareParams[] = {
+    { kFrequency, "Freq",     20.0f, 3000.0f,  440.0f, Curve::Exponential, Unit::Hz,      20 },
+    { kAmplitude, "Amp",       0.0f,    1.0f,    0.5f, Curve::Linear,      Unit::Percent, 20 },
+    { kDutyCycle, "Duty",     0.05f,   0.95f,    0.5f, Curve::Linear,      Unit::Percent, 20 },
+};
+
+constexpr CTAG_ParamDesc kSawParams[] = {
+    { kFrequency, "Freq",     20.0f, 3000.0f,  440.0f, Curve::Exponential, Unit::Hz,      20 },
+    { kAmplitude, "Amp",       0.0f,    1.0f,    0.5f, Curve::Linear,      Unit::Percent, 20 },
+    { kSkew,      "Skew",     0.01f,   0.99f,    0.5f, Curve::Linear,      Unit::Percent, 20 },
+};
+
+constexpr CTAG_ParamDesc kFMParams[] = {
+    { kFrequency, "Carrier",  20.0f, 3000.0f,  220.0f, Curve::Exponential, Unit::Hz,      20 },
+    { kAmplitude, "Amp",       0.0f,    1.0f,    0.5f, Curve::Linear,      Unit::Percent, 20 },
+    { kModFreq,   "Mod Freq", 20.0f, 3000.0f,  440.0f, Curve::Exponential, Unit::Hz,      20 },
+    { kModIndex,  "Mod Idx",   0.0f,   25.0f,    2.0f, Curve::Linear,      Unit::None,    30 },
+};
+
+static_assert(CTAG_Params::isValid(kSineParams),   "invalid sine parameter table");
+static_assert(CTAG_Params::isValid(kSquareParams), "invalid square parameter table");
+static_assert(CTAG_Params::isValid(kSawParams),    "invalid saw parameter table");
+static_assert(CTAG_Params::isValid(kFMParams),     "invalid FM parameter table");
+
+/**
+ * @brief All built-in plugins, indexed by PluginId.
+ */
+constexpr CTAG_PluginDesc kPlugins[] = {
+    { kSine,   "Sine VCO",       kSineParams,   CTAG_Params::count(kSineParams)   },
+    { kSquare, "Square VCO",     kSquareParams, CTAG_Params::count(kSquareParams) },
+    { kSaw,    "Saw VCO",        kSawParams,    CTAG_Params::count(kSawParams)    },
+    { kFM,     "2-Freq FMSynth", kFMParams,     CTAG_Params::count(kFMParams)     },
+};
+
+constexpr uint8_t kNumPlugins = CTAG_Params::count(kPlugins);
+
+} // namespace CTAG_SourceParams
+
+#endif // CTAG_SOURCE_PARAMS_H
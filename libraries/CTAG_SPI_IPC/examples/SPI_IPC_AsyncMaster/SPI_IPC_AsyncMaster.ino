@@ -0,0 +1,87 @@
+/**
+ * @file SPI_IPC_AsyncMaster.ino
+ * @brief Queues packets for the slave without waiting for the SPI transfers.
+ *
+ * @defgroup Examples_SPI_IPC_AsyncMaster SPI_IPC_AsyncMaster
+ * @ingroup Examples
+ *
+ * The SPI_IPC_AsyncMaster.ino sketch runs on an RP2040 next to the
+ * SPI_IPC_Slave sketch. It queues a burst of packets with sendAsync() every
+ * 100 ms; DMA sends them in the background while loop() goes on. The slave's
+ * replies arrive through a callback, and the sketch prints how long queuing
+ * took compared with sending the same burst with exchange().
+ */
+#include <CTAG_SPI_IPC.h>
+#include "pins_arduino.h" // Required to use standardized pin names
+
+// --- Pin Definitions ---
+#define PIN_MISO PIN_SPI0_MISO
+#define PIN_MOSI PIN_SPI0_MOSI
+#define PIN_SCK  PIN_SPI0_SCK
+#define PIN_CS   PIN_SPI0_SS
+
+#define BURST 6
+
+volatile uint32_t repliesReceived = 0;
+
+/**
+ * @brief Called from the DMA interrupt for every completed frame.
+ */
+void onFrameDone(uint32_t tag, const uint8_t* rx, size_t rxLen) {
+  if (rxLen > 0) repliesReceived = repliesReceived + 1;
+}
+
+/**
+ * @brief Runs once at startup to initialize the SPI Master.
+ */
+void setup() {
+  Serial.begin(115200);
+  while(!Serial); // Wait for the serial port to connect
+  Serial.println("\n--- SPI Async Master IPC Demo ---");
+
+  SPI.setMISO(PIN_MISO);
+  SPI.setMOSI(PIN_MOSI);
+  SPI.setSCK(PIN_SCK);
+  SPI.begin(false);
+
+  if (CTAG_SPI_IPC::beginMaster(PIN_CS, SPI, 8000000, SPI_MODE0)) {
+    Serial.println("Master ready.");
+  } else {
+    Serial.println("Master initialization failed!");
+  }
+  CTAG_SPI_IPC::setAsyncCallback(onFrameDone);
+}
+
+/**
+ * @brief Sends one burst asynchronously and one synchronously, then prints both times.
+ */
+void loop() {
+  static uint32_t counter = 0;
+  char message[32];
+
+  // Queue the burst; this returns long before the frames are on the wire.
+  uint32_t t0 = micros();
+  for (int i = 0; i < BURST; ++i) {
+    int n = snprintf(message, sizeof(message), "Async packet No. %lu", (unsigned long)counter++);
+    if (!CTAG_SPI_IPC::sendAsync((const uint8_t*)message, n, counter)) {
+      Serial.println("Queue full!");
+      break;
+    }
+  }
+  uint32_t queueUs = micros() - t0;
+  CTAG_SPI_IPC::flushAsync();
+  uint32_t asyncUs = micros() - t0;
+
+  // The same burst with the blocking call, for comparison.
+  t0 = micros();
+  for (int i = 0; i < BURST; ++i) {
+    int n = snprintf(message, sizeof(message), "Sync packet No. %lu", (unsigned long)counter++);
+    CTAG_SPI_IPC::exchange((const uint8_t*)message, n, nullptr, 0);
+  }
+  uint32_t syncUs = micros() - t0;
+
+  Serial.printf("%d frames: queued in %lu us (on the wire after %lu us), blocking %lu us, replies %lu\n",
+                BURST, (unsigned long)queueUs, (unsigned long)asyncUs, (unsigned long)syncUs,
+                (unsigned long)repliesReceived);
+  delay(100);
+}
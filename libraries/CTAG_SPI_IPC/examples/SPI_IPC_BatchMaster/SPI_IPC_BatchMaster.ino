@@ -0,0 +1,96 @@
+/**
+ * @file SPI_IPC_BatchMaster.ino
+ * @brief Measures how many small messages per second CTAG_SPI_IPC delivers, with and without coalescing.
+ *
+ * @defgroup Examples_SPI_IPC_Batch SPI_IPC_Batch
+ * @ingroup Examples
+ *
+ * The SPI_IPC_BatchMaster.ino sketch runs on an RP2040 (or similar board) next to an
+ * ESP32 running SPI_IPC_BatchSlave.ino. For one second each, it sends numbered 5-byte
+ * messages (a type byte and a counter, about the size of a parameter change or a
+ * note event):
+ * 1. With send(): one CS-framed transaction per message.
+ * 2. With post() and a flush deadline of 0: the same, through the batch path.
+ * 3. With post() and a 1 ms flush deadline: up to ten messages share a frame.
+ * It prints the messages per second of each run; the slave prints how many arrived
+ * and whether any were missing.
+ */
+#include <CTAG_SPI_IPC.h>
+#include "pins_arduino.h" // Required to use standardized pin names
+
+// --- Pin Definitions ---
+#define PIN_MISO PIN_SPI0_MISO
+#define PIN_MOSI PIN_SPI0_MOSI
+#define PIN_SCK  PIN_SPI0_SCK
+#define PIN_CS   PIN_SPI0_SS
+
+/** @brief Message type of the test messages; the slave counts only these. */
+static const uint8_t MSG_TEST = 0x10;
+
+/** @brief Message type that tells the slave a run is over and it should report. */
+static const uint8_t MSG_REPORT = 0x11;
+
+/**
+ * @brief Sends numbered messages for one second.
+ * @param batched True to use post(), false for send().
+ * @return Messages per second.
+ */
+uint32_t runOnce(bool batched) {
+  uint32_t count = 0;
+  uint32_t start = millis();
+  while (millis() - start < 1000) {
+    uint8_t msg[5] = { MSG_TEST };
+    memcpy(&msg[1], &count, sizeof(count));
+    if (batched) {
+      CTAG_SPI_IPC::post(msg, sizeof(msg));
+      CTAG_SPI_IPC::serviceBatch();
+    } else {
+      CTAG_SPI_IPC::send(msg, sizeof(msg));
+    }
+    ++count;
+  }
+  CTAG_SPI_IPC::flushBatch();
+  return count;
+}
+
+/**
+ * @brief Runs once at startup to initialize the SPI Master.
+ */
+void setup() {
+  Serial.begin(115200);
+  while(!Serial); // Wait for the serial port to connect
+  Serial.println("\n--- SPI Master Message Coalescing Demo ---");
+
+  SPI.setMISO(PIN_MISO);
+  SPI.setMOSI(PIN_MOSI);
+  SPI.setSCK(PIN_SCK);
+  SPI.begin(false);
+
+  if (!CTAG_SPI_IPC::beginMaster(PIN_CS, SPI, 8000000, SPI_MODE0)) {
+    Serial.println("Master initialization failed!");
+  }
+}
+
+/**
+ * @brief Measures the three variants, then waits.
+ */
+void loop() {
+  static const struct { const char* name; bool batched; uint32_t deadlineUs; } RUNS[] = {
+    { "send() per message  ", false, 0 },
+    { "post(), deadline 0  ", true, 0 },
+    { "post(), deadline 1ms", true, 1000 },
+  };
+
+  for (const auto& run : RUNS) {
+    CTAG_SPI_IPC::setBatchDeadline(run.deadlineUs);
+    uint32_t rate = runOnce(run.batched);
+    Serial.printf("%s: %6lu messages/s\n", run.name, (unsigned long)rate);
+
+    // Ask the slave for its count of this run
+    const uint8_t report = MSG_REPORT;
+    CTAG_SPI_IPC::send(&report, 1);
+    delay(200);
+  }
+  Serial.println();
+  delay(3000);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file SPI_IPC_BatchSlave.ino
+ * @brief Counts the messages of SPI_IPC_BatchMaster.ino and checks that none is missing.
+ *
+ * @defgroup Examples_SPI_IPC_Batch SPI_IPC_Batch
+ * @ingroup Examples
+ *
+ * The SPI_IPC_BatchSlave.ino sketch is the counterpart of SPI_IPC_BatchMaster.ino.
+ * Every message reaches the callback on its own, whether it came in a frame of its
+ * own or in a batch, so the callback just dispatches on the type byte. After each
+ * run the sketch prints how many test messages arrived and how many were missing.
+ */
+#include <CTAG_SPI_IPC.h>
+#include "pins_arduino.h" // Required to use standardized pin names
+
+// --- Pin Definitions ---
+// Note the crossover wiring required for SPI communication.
+#define PIN_MISO PIN_SPI0_MISO // Connects to Master's MOSI
+#define PIN_MOSI PIN_SPI0_MOSI // Connects to Master's MISO
+#define PIN_SCK  PIN_SPI0_SCK
+#define PIN_CS   PIN_SPI0_SS
+
+static const uint8_t MSG_TEST   = 0x10;
+static const uint8_t MSG_REPORT = 0x11;
+
+volatile uint32_t received = 0;   ///< Test messages in the current run.
+volatile uint32_t missing  = 0;   ///< Gaps in their counter.
+volatile uint32_t expected = 0;   ///< Next counter value.
+volatile bool     reportDue = false;
+
+/**
+ * @brief Called from the SPI interrupt for every message.
+ */
+void onMessage(const uint8_t* data, size_t len) {
+  switch (data[0]) {
+    case MSG_TEST: {
+      if (len != 5) return;
+      uint32_t count;
+      memcpy(&count, &data[1], sizeof(count));
+      if (count == 0) {
+        // A new run starts
+        received = 0;
+        missing  = 0;
+      } else if (count != expected) {
+        missing = missing + (count - expected);
+      }
+      expected = count + 1;
+      received = received + 1;
+      break;
+    }
+    case MSG_REPORT:
+      reportDue = true;
+      break;
+  }
+}
+
+/**
+ * @brief Runs once at startup to initialize the SPI Slave.
+ */
+void setup() {
+  Serial.begin(115200);
+  while(!Serial); // Wait for the serial port to connect
+  Serial.println("\n--- SPI Slave Message Coalescing Demo ---");
+
+  if (CTAG_SPI_IPC::beginSlave(PIN_SCK, PIN_MISO, PIN_MOSI, PIN_CS, onMessage)) {
+    Serial.println("Slave ready and waiting for messages...");
+  } else {
+    Serial.println("Slave initialization FAILED!");
+  }
+}
+
+/**
+ * @brief Prints the result of a run when the master asks for it.
+ */
+void loop() {
+  if (reportDue) {
+    reportDue = false;
+    Serial.printf("Run: %lu messages received, %lu missing\n",
+                  (unsigned long)received, (unsigned long)missing);
+  }
+  delay(10);
+}
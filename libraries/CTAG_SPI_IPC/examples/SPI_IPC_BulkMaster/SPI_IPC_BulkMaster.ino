@@ -0,0 +1,82 @@
+/**
+ * @file SPI_IPC_BulkMaster.ino
+ * @brief Measures the bulk transfer rate of CTAG_SPI_IPC at several SPI clocks.
+ *
+ * @defgroup Examples_SPI_IPC_Bulk SPI_IPC_Bulk
+ * @ingroup Examples
+ *
+ * The SPI_IPC_BulkMaster.ino sketch runs on an RP2040 (or similar board) and sends
+ * a 64 KiB test block to an ESP32 running SPI_IPC_BulkSlave.ino, once per SPI
+ * clock rate. For each rate it prints:
+ * 1. The net throughput in MB/s (payload bytes only) against the raw bit rate.
+ * 2. The worst time a control packet waited for its turn: one control packet is
+ *    sent between every two 4 KiB fragments, as a UI would do during an upload.
+ */
+#include <CTAG_SPI_IPC.h>
+#include "pins_arduino.h" // Required to use standardized pin names
+
+// --- Pin Definitions ---
+#define PIN_MISO PIN_SPI0_MISO
+#define PIN_MOSI PIN_SPI0_MOSI
+#define PIN_SCK  PIN_SPI0_SCK
+#define PIN_CS   PIN_SPI0_SS
+
+/** @brief Size of the test block. */
+static const size_t BLOCK_SIZE = 64 * 1024;
+
+/** @brief SPI clock rates to measure, in Hz. */
+static const uint32_t SPEEDS[] = { 4000000, 8000000, 16000000, 20000000 };
+
+uint8_t block[BLOCK_SIZE];
+
+/**
+ * @brief Runs once at startup to fill the test block and set up the SPI pins.
+ */
+void setup() {
+  Serial.begin(115200);
+  while(!Serial); // Wait for the serial port to connect
+  Serial.println("\n--- SPI Master Bulk Transfer Demo ---");
+
+  // The slave checks this pattern
+  for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+    block[i] = (uint8_t)(i * 7 + (i >> 8));
+  }
+
+  SPI.setMISO(PIN_MISO);
+  SPI.setMOSI(PIN_MOSI);
+  SPI.setSCK(PIN_SCK);
+  SPI.begin(false);
+}
+
+/**
+ * @brief Sends the block once at every clock rate, then waits.
+ */
+void loop() {
+  static uint8_t id = 0;
+
+  for (uint32_t speed : SPEEDS) {
+    CTAG_SPI_IPC::beginMaster(PIN_CS, SPI, speed, SPI_MODE0);
+    delay(20); // Let the slave fetch the previous transfer
+
+    uint32_t worstWait = 0;
+    uint32_t start = micros();
+    CTAG_SPI_IPC::beginBulk(block, BLOCK_SIZE, id);
+    for (;;) {
+      // A control packet that was due when the fragment started waits this long
+      uint32_t t0 = micros();
+      int left = CTAG_SPI_IPC::bulkStep();
+      uint8_t ctl[2] = { 0x01, id };
+      CTAG_SPI_IPC::send(ctl, sizeof(ctl));
+      worstWait = max(worstWait, (uint32_t)(micros() - t0));
+      if (left <= 0) break;
+    }
+    uint32_t us = micros() - start;
+
+    Serial.printf("%2lu MHz: %5.2f MB/s net (raw %5.2f MB/s), control packet waits <= %lu us\n",
+                  (unsigned long)(speed / 1000000), (float)BLOCK_SIZE / us,
+                  speed / 8e6f, (unsigned long)worstWait);
+    ++id;
+  }
+  Serial.println();
+  delay(5000);
+}
@@ -0,0 +1,73 @@
+/**
+ * @file SPI_IPC_BulkSlave.ino
+ * @brief Receives bulk transfers with CTAG_SPI_IPC on an ESP32 and checks them.
+ *
+ * @defgroup Examples_SPI_IPC_Bulk SPI_IPC_Bulk
+ * @ingroup Examples
+ *
+ * The SPI_IPC_BulkSlave.ino sketch is the counterpart of SPI_IPC_BulkMaster.ino.
+ * It reassembles the master's 64 KiB test blocks into a buffer of its own,
+ * verifies their contents and counts the control packets that were sent in
+ * between the fragments.
+ */
+#include <CTAG_SPI_IPC.h>
+#include "pins_arduino.h" // Required to use standardized pin names
+
+// --- Pin Definitions ---
+// Note the crossover wiring required for SPI communication.
+#define PIN_MISO PIN_SPI0_MISO // Connects to Master's MOSI
+#define PIN_MOSI PIN_SPI0_MOSI // Connects to Master's MISO
+#define PIN_SCK  PIN_SPI0_SCK
+#define PIN_CS   PIN_SPI0_SS
+
+/** @brief Largest transfer this sketch accepts. */
+static const size_t BLOCK_SIZE = 64 * 1024;
+
+uint8_t* block = nullptr;
+
+/**
+ * @brief Runs once at startup to initialize the SPI Slave for bulk frames.
+ */
+void setup() {
+  Serial.begin(115200);
+  while(!Serial); // Wait for the serial port to connect
+  Serial.println("\n--- SPI Slave Bulk Transfer Demo ---");
+
+  block = (uint8_t*)malloc(BLOCK_SIZE);
+
+  // Full-size DMA buffers for 4 KiB fragments; control packets still arrive in the ring.
+  CTAG_SPI_IPC::setBulkBuffer(block, BLOCK_SIZE);
+  if (block && CTAG_SPI_IPC::beginSlave(PIN_SCK, PIN_MISO, PIN_MOSI, PIN_CS, nullptr,
+                                        CTAG_SPI_IPC::kBulkFrameSize)) {
+    Serial.println("Slave ready and waiting for transfers...");
+  } else {
+    Serial.println("Slave initialization FAILED!");
+  }
+}
+
+/**
+ * @brief Checks completed transfers and counts control packets.
+ */
+void loop() {
+  static uint32_t controlPackets = 0;
+
+  uint8_t data[CTAG_SPI_IPC::kMaxPayload];
+  while (CTAG_SPI_IPC::available()) {
+    if (CTAG_SPI_IPC::receive(data, sizeof(data)) > 0) ++controlPackets;
+  }
+
+  uint8_t id;
+  size_t len = CTAG_SPI_IPC::bulkReceive(&id);
+  if (len > 0) {
+    size_t bad = 0;
+    for (size_t i = 0; i < len; ++i) {
+      if (block[i] != (uint8_t)(i * 7 + (i >> 8))) ++bad;
+    }
+    Serial.printf("Transfer %u: %u bytes, %s, %lu control packets, %lu errors so far\n",
+                  id, (unsigned)len, bad ? "MISMATCH" : "OK",
+                  (unsigned long)controlPackets, (unsigned long)CTAG_SPI_IPC::bulkErrors());
+    controlPackets = 0;
+  }
+
+  delay(1);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file SPI_IPC_CrcBenchmark.ino
+ * @brief Measures the throughput of the CTAG_SPI_IPC checksums on the board it runs on.
+ *
+ * @defgroup Examples_SPI_IPC_CrcBenchmark SPI_IPC_CrcBenchmark
+ * @ingroup Examples
+ *
+ * The SPI_IPC_CrcBenchmark.ino sketch needs no second board. It runs on an ESP32 or
+ * an RP2040 and:
+ * 1. Checks every checksum against its check value (the CRC of "123456789").
+ * 2. Times each engine on a packet (60 bytes) and on a full bulk fragment (4109
+ *    bytes, the part of a fragment the CRC covers), and prints MB/s:
+ *    - the bit-by-bit CRC-8 the library used before it had tables, as a baseline;
+ *    - the table-driven CRC-8 of packets and batches;
+ *    - CRC-16 and CRC-32 from the slicing-by-4 tables;
+ *    - crc32(), which uses the DMA sniffer on the RP2040 and the ROM routine
+ *      on the ESP32.
+ * Use the numbers to pick the checksum of bulk transfers with setBulkChecksum(): at
+ * 10 MHz SCK the link moves 1.25 MB/s, and the slave checks every fragment in its
+ * interrupt.
+ */
+#include <CTAG_SPI_IPC.h>
+
+/** @brief Test data; the size of the largest CRC-covered part of a bulk fragment. */
+static uint8_t data[CTAG_SPI_IPC::kBulkHeader - 2 + CTAG_SPI_IPC::kBulkPayload];
+
+/** @brief Keeps the compiler from dropping the timed calls. */
+static volatile uint32_t sink;
+
+/**
+ * @brief The CRC-8 as it was computed before the tables: bit by bit.
+ */
+static uint8_t crc8Bitwise(const uint8_t* p, size_t len) {
+  uint8_t crc = 0;
+  while (len--) {
+    crc ^= *p++;
+    for (int i = 0; i < 8; ++i)
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+  }
+  return crc;
+}
+
+static uint32_t runCrc8Bitwise(const uint8_t* p, size_t len) { return crc8Bitwise(p, len); }
+static uint32_t runCrc8(const uint8_t* p, size_t len)        { return CTAG_SPI_IPC::crc8(p, len); }
+static uint32_t runCrc16(const uint8_t* p, size_t len)       { return CTAG_SPI_IPC::crc16(p, len); }
+static uint32_t runCrc32Table(const uint8_t* p, size_t len)  { return CTAG_SPI_IPC::crc32Software(p, len); }
+static uint32_t runCrc32(const uint8_t* p, size_t len)       { return CTAG_SPI_IPC::crc32(p, len); }
+
+/**
+ * @brief One engine under test.
+ */
+struct Engine {
+  const char* name;
+  uint32_t (*fn)(const uint8_t*, size_t);
+  uint32_t check;   ///< Expected CRC of "123456789".
+};
+
+static const Engine ENGINES[] = {
+  { "CRC-8  bitwise (old)", runCrc8Bitwise, 0xF4 },
+  { "CRC-8  table        ", runCrc8,        0xF4 },
+  { "CRC-16 slicing-by-4 ", runCrc16,       0x906E },
+  { "CRC-32 slicing-by-4 ", runCrc32Table,  0xCBF43926 },
+#if defined(ARDUINO_ARCH_RP2040)
+  { "CRC-32 crc32() (DMA)", runCrc32,       0xCBF43926 },
+#elif defined(ESP32)
+  { "CRC-32 crc32() (ROM)", runCrc32,       0xCBF43926 },
+#else
+  { "CRC-32 crc32()      ", runCrc32,       0xCBF43926 },
+#endif
+};
+
+/**
+ * @brief Runs an engine over len bytes for about 200 ms.
+ * @return Throughput in MB/s.
+ */
+static float measure(const Engine& e, size_t len) {
+  uint32_t rounds = 0;
+  uint32_t start = micros();
+  uint32_t elapsed;
+  do {
+    for (int i = 0; i < 16; ++i) sink = e.fn(data, len);
+    rounds += 16;
+    elapsed = micros() - start;
+  } while (elapsed < 200000);
+  return (float)rounds * len / elapsed;
+}
+
+/**
+ * @brief Runs once at startup: checks the engines and prints the table.
+ */
+void setup() {
+  Serial.begin(115200);
+  while(!Serial); // Wait for the serial port to connect
+  delay(1000);
+  Serial.println("\n--- SPI IPC Checksum Benchmark ---");
+
+  for (size_t i = 0; i < sizeof(data); ++i) data[i] = (uint8_t)(i * 131 + (i >> 8));
+
+  const uint8_t* check = (const uint8_t*)"123456789";
+  const uint32_t reference = CTAG_SPI_IPC::crc32Software(data, sizeof(data));
+  Serial.printf("engine                check      60 B MB/s   %u B MB/s\n", (unsigned)sizeof(data));
+  for (const Engine& e : ENGINES) {
+    bool ok = e.fn(check, 9) == e.check;
+    // The CRC-32 engines must also agree on a block long enough for the DMA
+    if (e.check == 0xCBF43926) ok = ok && e.fn(data, sizeof(data)) == reference;
+    Serial.printf("%s  %-8s  %9.2f  %11.2f\n", e.name, ok ? "ok" : "FAILED",
+                  measure(e, 60), measure(e, sizeof(data)));
+  }
+}
+
+/**
+ * @brief Nothing to do after the benchmark.
+ */
+void loop() {
+  delay(1000);
+}
@@ -6,7 +6,8 @@
  * @ingroup Examples
  * 
  * The SPI_IPC_Master.ino sketch configures an RP2040 (or similar board) as an SPI master and
- * periodically sends a test message to a connected SPI slave device.
+ * periodically sends a test message to a connected SPI slave device. The same
+ * transaction brings back whatever the slave has queued for the master.
  */
 #include <CTAG_SPI_IPC.h>
 #include "pins_arduino.h" // Required to use standardized pin names
@@ -54,10 +55,15 @@ void loop() {
   // Create a new test message for each iteration.
   snprintf(message, sizeof(message), "Test packet No. %d", counter++);
   
-  // Send the message via the IPC library.
+  // Send the message via the IPC library and collect the slave's reply.
   Serial.printf("Sending: \"%s\"...", message);
-  bool ok = CTAG_SPI_IPC::send((const uint8_t*)message, strlen(message));
-  Serial.println(ok ? " OK" : " FAILED");
+  uint8_t reply[CTAG_SPI_IPC::kMaxPayload + 1];
+  int len = CTAG_SPI_IPC::exchange((const uint8_t*)message, strlen(message), reply, sizeof(reply) - 1);
+  Serial.println(len >= 0 ? " OK" : " FAILED");
+  if (len > 0) {
+    reply[len] = '\0';
+    Serial.printf("Slave says: \"%s\"\n", (const char*)reply);
+  }
 
   // Wait for one second before sending the next packet.
   delay(1000);
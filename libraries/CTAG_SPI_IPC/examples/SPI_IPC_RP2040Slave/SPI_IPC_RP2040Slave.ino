@@ -0,0 +1,70 @@
+/**
+ * @file SPI_IPC_RP2040Slave.ino
+ * @brief A demonstration sketch for the CTAG_SPI_IPC library in Slave mode on an RP2040.
+ *
+ * @defgroup Examples_SPI_IPC_RP2040Slave SPI_IPC_RP2040Slave
+ * @ingroup Examples
+ *
+ * The SPI_IPC_RP2040Slave.ino sketch turns a second RP2040 board into the SPI slave of
+ * the SPI_IPC_Master or SPI_IPC_AsyncMaster sketch, so two RP2040s exchange packets
+ * directly. Packets land in the receive ring by DMA and are drained in loop(); every
+ * packet is answered with a short status text.
+ *
+ * The RP2040 slave needs SPI mode 3: change SPI_MODE0 to SPI_MODE3 in the master's
+ * beginMaster() call. Wire the boards' SCK and CS pins straight through and cross the
+ * data pins: the master's GPIO 19 (TX) goes to the slave's GPIO 20 (RX) and vice versa.
+ */
+#include <CTAG_SPI_IPC.h>
+#include "pins_arduino.h" // Required to use standardized pin names
+
+// --- Pin Definitions ---
+// The slave's pins must be the TX, RX, SCK and CSn functions of one SPI block.
+// On this board the master-side names are swapped for the slave role.
+#define PIN_MISO PIN_SPI0_MOSI // GPIO 19, SPI0 TX: slave out, to the master's RX
+#define PIN_MOSI PIN_SPI0_MISO // GPIO 20, SPI0 RX: slave in, from the master's TX
+#define PIN_SCK  PIN_SPI0_SCK
+#define PIN_CS   PIN_SPI0_SS
+
+/**
+ * @brief Runs once at startup to initialize the SPI Slave.
+ */
+void setup() {
+  Serial.begin(115200);
+  while(!Serial); // Wait for the serial port to connect
+  Serial.println("\n--- RP2040 SPI Slave IPC Demo ---");
+
+  // The library sets up SPI0 and its pins itself; SPI.begin() is not needed.
+  if (CTAG_SPI_IPC::beginSlave(PIN_SCK, PIN_MISO, PIN_MOSI, PIN_CS, nullptr)) {
+    Serial.println("Slave ready and waiting for packets...");
+  } else {
+    Serial.println("Slave initialization FAILED! Check the pins.");
+  }
+}
+
+/**
+ * @brief Runs continuously after setup and prints every packet that has arrived.
+ */
+void loop() {
+  uint8_t data[CTAG_SPI_IPC::kMaxPayload + 1];
+  static uint32_t received = 0;
+
+  while (CTAG_SPI_IPC::available()) {
+    size_t len = CTAG_SPI_IPC::receive(data, sizeof(data) - 1);
+    data[len] = '\0';
+    Serial.printf(">> Packet Received! Length=%u, Content: \"%s\"\n", (unsigned)len, (const char*)data);
+
+    // Queue a reply; it goes out on MISO while the master sends its next packet.
+    char reply[32];
+    snprintf(reply, sizeof(reply), "RP2040 got %lu packet(s)", (unsigned long)++received);
+    CTAG_SPI_IPC::slaveSend((const uint8_t*)reply, strlen(reply));
+  }
+
+  static uint32_t lastOverflows = 0;
+  uint32_t overflows = CTAG_SPI_IPC::overflows();
+  if (overflows != lastOverflows) {
+    Serial.printf("!! %lu packet(s) dropped, receive ring was full\n", (unsigned long)(overflows - lastOverflows));
+    lastOverflows = overflows;
+  }
+
+  delay(100);
+}
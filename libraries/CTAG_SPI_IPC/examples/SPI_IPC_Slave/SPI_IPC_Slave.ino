@@ -7,8 +7,10 @@
  * 
  * 
  * The SPI_IPC_Slave.ino sketch configures an ESP32 as an SPI slave device that listens for packets
- * from an SPI master. It uses a callback function to process incoming data
- * asynchronously as soon as it arrives.
+ * from an SPI master. Incoming packets are collected in the library's receive ring
+ * in the background and drained in loop(), so a burst of packets is not lost while
+ * the sketch is busy printing. Every received packet is answered with a short status
+ * text, which the master picks up with its next exchange().
  */
 #include <CTAG_SPI_IPC.h>
 #include "pins_arduino.h" // Required to use standardized pin names
@@ -21,23 +23,6 @@
 #define PIN_SCK  PIN_SPI0_SCK
 #define PIN_CS   PIN_SPI0_SS
 
-/**
- * @brief Callback function that is automatically invoked when a valid SPI packet is received.
- * @note This function is called from an interrupt context. Keep the code inside short
- * and fast. Avoid using delay() or other long-running operations here.
- * @param data A pointer to the received payload data.
- * @param len The length of the payload data in bytes.
- */
-void onPacketReceived(const uint8_t* data, size_t len) {
-  Serial.print(">> Packet Received! Length=");
-  Serial.print(len);
-  Serial.print(", Content: \"");
-  for (size_t i = 0; i < len; i++) {
-    Serial.print((char)data[i]);
-  }
-  Serial.println("\"");
-}
-
 /**
  * @brief Runs once at startup to initialize the SPI Slave.
  */
@@ -49,9 +34,10 @@ void setup() {
   // Calling SPI.begin() is not necessary for the ESP32 slave mode,
   // as the library passes the pins directly to the underlying ESP-IDF driver.
 
-  // Initialize the IPC library in slave mode, providing all necessary pins
-  // and the function to call when a packet arrives.
-  if (CTAG_SPI_IPC::beginSlave(PIN_SCK, PIN_MISO, PIN_MOSI, PIN_CS, onPacketReceived)) {
+  // Initialize the IPC library in slave mode, providing all necessary pins.
+  // Passing nullptr instead of a callback collects the packets for polling;
+  // a callback would be invoked from an interrupt for every packet instead.
+  if (CTAG_SPI_IPC::beginSlave(PIN_SCK, PIN_MISO, PIN_MOSI, PIN_CS, nullptr)) {
     Serial.println("Slave ready and waiting for packets...");
   } else {
     Serial.println("Slave initialization FAILED!");
@@ -59,11 +45,36 @@ void setup() {
 }
 
 /**
- * @brief Runs continuously after setup.
+ * @brief Runs continuously after setup and prints every packet that has arrived.
  */
 void loop() {
-  // Nothing to do here. The magic happens in the background via interrupts.
-  // A small delay can be used to prevent the watchdog timer from triggering
-  // in an otherwise empty loop on some platforms.
+  uint8_t data[CTAG_SPI_IPC::kMaxPayload];
+
+  // Drain everything that arrived since the last pass.
+  while (CTAG_SPI_IPC::available()) {
+    size_t len = CTAG_SPI_IPC::receive(data, sizeof(data));
+    Serial.print(">> Packet Received! Length=");
+    Serial.print(len);
+    Serial.print(", Content: \"");
+    for (size_t i = 0; i < len; i++) {
+      Serial.print((char)data[i]);
+    }
+    Serial.println("\"");
+
+    // Queue a reply; it goes out on MISO while the master sends its next packet.
+    static uint32_t received = 0;
+    char reply[32];
+    snprintf(reply, sizeof(reply), "Got %lu packet(s)", (unsigned long)++received);
+    CTAG_SPI_IPC::slaveSend((const uint8_t*)reply, strlen(reply));
+  }
+
+  // Packets are only lost if the ring fills up between two passes.
+  static uint32_t lastOverflows = 0;
+  uint32_t overflows = CTAG_SPI_IPC::overflows();
+  if (overflows != lastOverflows) {
+    Serial.printf("!! %lu packet(s) dropped, receive ring was full\n", (unsigned long)(overflows - lastOverflows));
+    lastOverflows = overflows;
+  }
+
   delay(100);
 }
\ No newline at end of file
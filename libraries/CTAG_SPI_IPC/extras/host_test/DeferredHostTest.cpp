@@ -0,0 +1,100 @@
+/**
+ * @file DeferredHostTest.cpp
+ * @brief Host test of the ESP32 slave's deferred dispatch.
+ *
+ * The dispatch task is a thread here, so the timing is only approximate:
+ * paced frames leave the task time to keep up, a burst does not.
+ *
+ * Build and run from this directory, optionally with the number of spare
+ * buffers (default CTAG_SPI_IPC_DEFER_BUFFERS):
+ *
+ *   g++ -std=gnu++17 -DESP32 -I stub -I ../../src DeferredHostTest.cpp HostSim.cpp \
+ *       ../../src/CTAG_SPI_IPC.cpp ../../src/CTAG_SPI_IPC_Crc.cpp -o deferred_host_test -lpthread
+ *   ./deferred_host_test 256
+ *
+ * The exit code is the number of failed checks.
+ */
+#include <CTAG_SPI_IPC.h>
+#include "HostSim.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+using namespace CTAG_SPI_IPC;
+
+static int _failures = 0;
+
+#define CHECK(cond)                                                  \
+  do {                                                               \
+    if (!(cond)) {                                                   \
+      printf("  FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+      ++_failures;                                                   \
+    }                                                                \
+  } while (0)
+
+static std::atomic<uint32_t> _got{0};
+static std::atomic<uint32_t> _outOfOrder{0};
+static std::thread::id _handlerThread;
+static uint32_t _expected = 0;
+
+/**
+ * @brief Takes numbered packets; a number below the expected one is a corruption.
+ */
+static void onPacket(const uint8_t* data, size_t len) {
+  uint32_t value = 0;
+  memcpy(&value, data, min(len, sizeof(value)));
+  if (value < _expected) ++_outOfOrder;
+  _expected = value + 1;
+  _handlerThread = std::this_thread::get_id();
+  std::this_thread::sleep_for(std::chrono::microseconds(50)); // A slow handler
+  ++_got;
+}
+
+static void sendNumber(uint32_t value) {
+  uint8_t message[4];
+  memcpy(message, &value, sizeof(message));
+  send(message, sizeof(message));
+}
+
+int main(int argc, char** argv) {
+  const uint16_t buffers = argc > 1 ? (uint16_t)atoi(argv[1]) : CTAG_SPI_IPC_DEFER_BUFFERS;
+  printf("deferred dispatch, %u spare buffers\n", (unsigned)buffers);
+  CHECK(setDeferredDispatch(true, 20, 0, buffers));
+  CHECK(beginSlave(1, 2, 3, 4, onPacket));
+  beginMaster(5);
+
+  // A reply still goes out while the task handles the frames
+  slaveSend((const uint8_t*)"hi", 2);
+  uint8_t rx[kMaxPayload];
+  CHECK(exchange(nullptr, 0, rx, sizeof(rx)) == 2 || poll(rx, sizeof(rx)) == 2);
+
+  // Paced frames: all arrive, in order, on the task's thread
+  const uint32_t paced = 2000;
+  for (uint32_t i = 0; i < paced; ++i) {
+    sendNumber(i);
+    std::this_thread::sleep_for(std::chrono::microseconds(i % 50 == 0 ? 2000 : 60));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  CHECK(_got == paced);
+  CHECK(_outOfOrder == 0);
+  CHECK(deferredDrops() == 0);
+  CHECK(_handlerThread != std::this_thread::get_id());
+  CHECK(!setDeferredDispatch(false)); // The task keeps running
+
+  // A burst: frames beyond the spare buffers are dropped and counted, never overwritten
+  const uint32_t burst = 200;
+  _got = 0;
+  _expected = 0;
+  for (uint32_t i = 0; i < burst; ++i) sendNumber(i);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  printf("  burst of %u: got %u, dropped %u\n", (unsigned)burst, (unsigned)_got, (unsigned)deferredDrops());
+  CHECK(_outOfOrder == 0);
+  CHECK(_got + deferredDrops() == burst);
+  if (buffers >= burst) CHECK(_got == burst);
+
+  printf(_failures ? "%d checks failed\n" : "all checks passed\n", _failures);
+  return _failures;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file HostSim.cpp
+ * @brief Simulated SPI link, driver stub and FreeRTOS task stub.
+ */
+#include "HostSim.h"
+
+#include <SPI.h>
+#include "driver/spi_slave.h"
+#include "freertos/task.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+SPIClass SPI;
+
+namespace HostSim {
+
+uint32_t nowMicros = 0;
+int isrYields = 0;
+
+static spi_slave_interface_config_t _config;
+static std::deque<spi_slave_transaction_t*> _queue;
+static uint64_t _transactions = 0;
+static uint64_t _bytes = 0;
+static long     _mosiFlip = -1;
+static uint64_t _misoFlipTransaction = 0;
+static size_t   _misoFlip = 0;
+
+size_t slaveTransfer(const uint8_t* mosi, size_t len, uint8_t* miso) {
+  if (_queue.empty()) return 0;
+  spi_slave_transaction_t* trans = _queue.front();
+  _queue.pop_front();
+  if (_config.post_setup_cb) _config.post_setup_cb(trans);
+
+  size_t clocked = min(len, trans->length / 8);
+  if (trans->rx_buffer) memcpy(trans->rx_buffer, mosi, clocked);
+  if (miso) {
+    if (trans->tx_buffer) memcpy(miso, trans->tx_buffer, clocked);
+    else memset(miso, 0, clocked);
+  }
+  trans->trans_len = clocked * 8;
+  if (_config.post_trans_cb) _config.post_trans_cb(trans);
+  return clocked;
+}
+
+void masterTransfer(uint8_t* buffer, size_t n) {
+  ++_transactions;
+  _bytes += n;
+  uint8_t mosi[8192];
+  uint8_t miso[8192];
+  memcpy(mosi, buffer, n);
+  if (_mosiFlip >= 0 && (size_t)_mosiFlip < n) {
+    mosi[_mosiFlip] ^= 0x5A;
+    _mosiFlip = -1;
+  }
+
+  // Nothing drives MISO without a queued descriptor, so the master reads back its own bytes
+  size_t clocked = slaveTransfer(mosi, n, miso);
+  if (_misoFlipTransaction == _transactions && _misoFlip < clocked) miso[_misoFlip] ^= 0x5A;
+  memcpy(buffer, miso, clocked);
+}
+
+void corruptMosi(size_t offset) { _mosiFlip = (long)offset; }
+
+void corruptMiso(uint64_t transaction, size_t offset) {
+  _misoFlipTransaction = transaction;
+  _misoFlip = offset;
+}
+
+uint64_t transactions() { return _transactions; }
+uint64_t bytes() { return _bytes; }
+
+void resetCounters() {
+  _transactions = 0;
+  _bytes = 0;
+  _misoFlipTransaction = 0;
+}
+
+void disconnectSlave() { _queue.clear(); }
+
+} // namespace HostSim
+
+// --- ESP-IDF SPI slave driver -----------------------------------------------
+
+esp_err_t spi_slave_initialize(spi_host_device_t, const spi_bus_config_t*,
+                               const spi_slave_interface_config_t* cfg, int) {
+  HostSim::_config = *cfg;
+  HostSim::_queue.clear();
+  return ESP_OK;
+}
+
+esp_err_t spi_slave_free(spi_host_device_t) {
+  HostSim::_queue.clear();
+  return ESP_OK;
+}
+
+esp_err_t spi_slave_queue_trans(spi_host_device_t, const spi_slave_transaction_t* trans, uint32_t) {
+  if ((int)HostSim::_queue.size() >= HostSim::_config.queue_size) return ESP_FAIL;
+  HostSim::_queue.push_back(const_cast<spi_slave_transaction_t*>(trans));
+  return ESP_OK;
+}
+
+esp_err_t spi_slave_queue_trans_isr(spi_host_device_t host, const spi_slave_transaction_t* trans) {
+  return spi_slave_queue_trans(host, trans, 0);
+}
+
+// --- FreeRTOS tasks ---------------------------------------------------------
+
+struct HostTask {
+  std::mutex              lock;
+  std::condition_variable wake;
+  uint32_t                notifications = 0;
+};
+
+static thread_local HostTask* _currentTask = nullptr;
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void*), const char*, uint32_t, void* arg,
+                                   UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+  HostTask* task = new HostTask;
+  *handle = task;
+  std::thread([fn, arg, task] {
+    _currentTask = task;
+    fn(arg);
+  }).detach();
+  return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, uint32_t) {
+  std::unique_lock<std::mutex> guard(_currentTask->lock);
+  _currentTask->wake.wait(guard, [] { return _currentTask->notifications > 0; });
+  uint32_t count = _currentTask->notifications;
+  _currentTask->notifications = clearOnExit ? 0 : count - 1;
+  return count;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken) {
+  {
+    std::lock_guard<std::mutex> guard(task->lock);
+    ++task->notifications;
+  }
+  task->wake.notify_one();
+  *higherPriorityTaskWoken = pdTRUE;
+}
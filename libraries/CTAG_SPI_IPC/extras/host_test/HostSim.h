@@ -0,0 +1,58 @@
+/**
+ * @file HostSim.h
+ * @brief Simulated SPI link between the CTAG_SPI_IPC master and ESP32 slave.
+ *
+ * Both sides of the library run in one host process. Every master
+ * transaction is handed to the slave descriptor the driver stub would clock
+ * next, and the slave's post-transaction callback runs before transfer()
+ * returns, as if the interrupt had fired between two transactions.
+ *
+ * Single bytes can be corrupted on either wire to exercise the CRC checks,
+ * retransmissions and duplicate detection.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace HostSim {
+
+/// Simulated time in microseconds, see micros().
+extern uint32_t nowMicros;
+
+/// Context switches requested by vTaskNotifyGiveFromISR().
+extern int isrYields;
+
+/**
+ * @brief Clocks one transaction from outside the master, e.g. a truncated frame.
+ * @param mosi Bytes sent to the slave.
+ * @param len Number of bytes.
+ * @param miso Receives the slave's bytes, or nullptr.
+ * @return Number of bytes the slave clocked, 0 if no descriptor was queued.
+ */
+size_t slaveTransfer(const uint8_t* mosi, size_t len, uint8_t* miso);
+
+/**
+ * @brief Flips one MOSI byte of the next master transaction.
+ */
+void corruptMosi(size_t offset);
+
+/**
+ * @brief Flips one MISO byte of a later master transaction.
+ * @param transaction The value transactions() will have during that transaction.
+ */
+void corruptMiso(uint64_t transaction, size_t offset);
+
+/// Number of master transactions so far.
+uint64_t transactions();
+
+/// Number of bytes the master clocked so far.
+uint64_t bytes();
+
+/// Zeroes transactions() and bytes().
+void resetCounters();
+
+/// Drops every queued slave descriptor, as if the slave stopped responding.
+void disconnectSlave();
+
+} // namespace HostSim
@@ -0,0 +1,558 @@
+/**
+ * @file IpcHostTest.cpp
+ * @brief Host test of the CTAG_SPI_IPC master against the ESP32 slave.
+ *
+ * Runs both sides of the library in one process over the link in
+ * HostSim.cpp and checks packets, exchange, bulk transfers, the async queue,
+ * batching, the checksums and reliable delivery. Deferred dispatch starts a
+ * task that cannot be stopped again, so it has its own DeferredHostTest.cpp.
+ *
+ * Build and run from this directory:
+ *
+ *   g++ -std=gnu++17 -DESP32 -I stub -I ../../src IpcHostTest.cpp HostSim.cpp \
+ *       ../../src/CTAG_SPI_IPC.cpp ../../src/CTAG_SPI_IPC_Crc.cpp -o ipc_host_test -lpthread
+ *   ./ipc_host_test
+ *
+ * The exit code is the number of failed checks.
+ */
+#include <CTAG_SPI_IPC.h>
+#include "HostSim.h"
+
+#include <stdio.h>
+#include <vector>
+
+using namespace CTAG_SPI_IPC;
+
+static int _failures = 0;
+
+#define CHECK(cond)                                                  \
+  do {                                                               \
+    if (!(cond)) {                                                   \
+      printf("  FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+      ++_failures;                                                   \
+    }                                                                \
+  } while (0)
+
+// --- Helpers ----------------------------------------------------------------
+
+static int _bulkDone = 0;
+static uint8_t _bulkId = 0;
+static size_t _bulkLen = 0;
+static uint8_t _bulkFirst = 0;
+
+static void onBulk(uint8_t id, const uint8_t* data, size_t len) {
+  ++_bulkDone;
+  _bulkId = id;
+  _bulkLen = len;
+  _bulkFirst = data[0];
+}
+
+/**
+ * @brief Restarts both sides with empty queues and statistics.
+ */
+static void restart(Callback cb = nullptr) {
+  beginSlave(1, 2, 3, 4, cb, kBulkFrameSize);
+  beginMaster(5);
+  setBulkReliable(false);
+  setBulkChecksum(Checksum::Crc32);
+  setBatchDeadline(1000);
+  uint8_t rx[kMaxPayload];
+  while (poll(rx, sizeof(rx)) > 0) {}
+  while (available()) receive(rx, sizeof(rx));
+  resetLinkStats();
+  HostSim::resetCounters();
+}
+
+/**
+ * @brief Takes every packet from the slave's receive ring.
+ * @return The number of packets.
+ */
+static int drain() {
+  uint8_t buffer[kMaxPayload];
+  int count = 0;
+  while (available()) {
+    receive(buffer, sizeof(buffer));
+    ++count;
+  }
+  return count;
+}
+
+/**
+ * @brief Builds a packet frame as the master does: [0xCA, 0xFE, Len, Payload..., CRC-8].
+ */
+static size_t packetFrame(uint8_t* frame, const char* text) {
+  size_t len = strlen(text);
+  frame[0] = 0xCA;
+  frame[1] = 0xFE;
+  frame[2] = (uint8_t)len;
+  memcpy(&frame[3], text, len);
+  frame[3 + len] = crc8(&frame[3], len);
+  return len + 4;
+}
+
+static std::vector<uint8_t> pattern(size_t len) {
+  std::vector<uint8_t> data(len);
+  for (size_t i = 0; i < len; ++i) data[i] = (uint8_t)(i * 7 + i / 251);
+  return data;
+}
+
+// --- Receive ring -----------------------------------------------------------
+
+static void testReceiveRing() {
+  printf("receive ring\n");
+  restart();
+  uint8_t frame[kFrameSize];
+  char text[16];
+  for (int i = 0; i < 20; ++i) {
+    snprintf(text, sizeof(text), "msg %d", i);
+    HostSim::slaveTransfer(frame, packetFrame(frame, text), nullptr);
+  }
+
+  // Packets come out oldest first; the rest overflowed
+  uint8_t buffer[kMaxPayload + 1];
+  size_t len = receive(buffer, sizeof(buffer));
+  buffer[len] = 0;
+  CHECK(strcmp((char*)buffer, "msg 0") == 0);
+  int drained = 1 + drain();
+  CHECK(drained == CTAG_SPI_IPC_RX_RING - 1);
+  CHECK(drained + (int)overflows() == 20);
+
+  // Truncated frames must not bring back what an earlier transaction left in the slot
+  const uint8_t truncated[3] = { 0xCA, 0xFE, 5 };
+  for (int i = 0; i < 8; ++i) HostSim::slaveTransfer(truncated, sizeof(truncated), nullptr);
+  CHECK(pending() == 0);
+}
+
+// --- Exchange and slave packets ---------------------------------------------
+
+static void testExchange() {
+  printf("exchange\n");
+  restart();
+  uint8_t rx[kMaxPayload];
+
+  // Telemetry comes back through exchange() and poll()
+  slaveSend((const uint8_t*)"tele-1", 6);
+  int n = exchange((const uint8_t*)"ctl", 3, rx, sizeof(rx));
+  if (n == 0) n = poll(rx, sizeof(rx));
+  CHECK(n == 6 && memcmp(rx, "tele-1", 6) == 0);
+  CHECK(drain() == 1);
+
+  // Payload limits on both sides
+  uint8_t big[kMaxPayload + 1];
+  memset(big, 7, sizeof(big));
+  CHECK(send(big, kMaxPayload));
+  CHECK(!send(big, kMaxPayload + 1));
+  CHECK(slaveSend(big, kMaxPayload));
+  int got = 0;
+  for (int i = 0; i < 4; ++i) {
+    if (poll(rx, sizeof(rx)) == (int)kMaxPayload) ++got;
+  }
+  CHECK(got == 1);
+  drain();
+
+  // Replies clocked out by send() wait in the master's reply queue
+  uint8_t control[40];
+  memset(control, 'c', sizeof(control));
+  slaveSend((const uint8_t*)"tele-2", 6);
+  slaveSend((const uint8_t*)"tele-3", 6);
+  for (int i = 0; i < 3; ++i) send(control, sizeof(control));
+  n = poll(rx, sizeof(rx));
+  CHECK(n == 6 && memcmp(rx, "tele-2", 6) == 0);
+  n = poll(rx, sizeof(rx));
+  CHECK(n == 6 && memcmp(rx, "tele-3", 6) == 0);
+  CHECK(poll(rx, sizeof(rx)) == 0);
+  CHECK(slaveTxPending() == 0);
+  CHECK(drain() == 3);
+}
+
+// --- Bulk transfers ---------------------------------------------------------
+
+static void testBulk() {
+  printf("bulk\n");
+  restart();
+  std::vector<uint8_t> src = pattern(10000);
+  std::vector<uint8_t> dst(16384);
+  setBulkBuffer(dst.data(), dst.size(), onBulk);
+
+  // Control packets between fragments
+  _bulkDone = 0;
+  CHECK(beginBulk(src.data(), src.size(), 42));
+  int controls = 0;
+  while (bulkStep() > 0) {
+    send((const uint8_t*)"ctl", 3);
+    ++controls;
+  }
+  CHECK(_bulkDone == 1 && _bulkId == 42 && _bulkLen == src.size());
+  CHECK(memcmp(src.data(), dst.data(), src.size()) == 0);
+  CHECK(drain() == controls);
+  CHECK(bulkErrors() == 0);
+
+  // Polling mode with small fragments
+  setBulkBuffer(dst.data(), dst.size());
+  memset(dst.data(), 0, dst.size());
+  CHECK(sendBulk(src.data(), 3000, 7, 100));
+  uint8_t id = 0;
+  CHECK(bulkReceive(&id) == 3000 && id == 7);
+  CHECK(memcmp(src.data(), dst.data(), 3000) == 0);
+
+  // A second transfer is refused until the first one is fetched
+  sendBulk(src.data(), 500, 8);
+  sendBulk(src.data(), 500, 9);
+  CHECK(bulkReceive(&id) == 500 && id == 8);
+  CHECK(bulkErrors() == 1);
+
+  // Larger than the buffer
+  setBulkBuffer(dst.data(), 1000);
+  sendBulk(src.data(), 2000, 2);
+  CHECK(bulkErrors() == 2);
+
+  // Every checksum detects a corrupted fragment, and the slave drops that transfer
+  for (int kind = 0; kind < 3; ++kind) {
+    setBulkBuffer(dst.data(), dst.size(), onBulk);
+    setBulkChecksum((Checksum)kind);
+    _bulkDone = 0;
+    memset(dst.data(), 0, dst.size());
+    sendBulk(src.data(), src.size(), 1);
+    CHECK(_bulkDone == 1 && memcmp(src.data(), dst.data(), src.size()) == 0);
+    _bulkDone = 0;
+    HostSim::corruptMosi(2000);
+    sendBulk(src.data(), src.size(), 1);
+    CHECK(_bulkDone == 0);
+  }
+
+  // Slave packets clocked out by fragments reach the master, with and without acks
+  std::vector<uint8_t> large(20000, 7);
+  for (int reliable = 0; reliable < 2; ++reliable) {
+    restart();
+    dst.resize(32768);
+    setBulkBuffer(dst.data(), dst.size());
+    setBulkReliable(reliable);
+    uint8_t rx[kMaxPayload];
+    int replies = 0;
+    int result;
+    CHECK(beginBulk(large.data(), large.size(), 1, 1024));
+    do {
+      slaveSend((const uint8_t*)"telemetry", 9);
+      result = bulkStep();
+      while (poll(rx, sizeof(rx)) > 0) ++replies;
+    } while (result > 0);
+    CHECK(result == 0);
+    CHECK(bulkReceive(&id) == large.size());
+    CHECK(replies == 20);
+    CHECK(slaveTxPending() == 0);
+  }
+}
+
+// --- Async queue ------------------------------------------------------------
+
+static int _asyncCallbacks = 0;
+
+static void onAsync(uint32_t, const uint8_t*, size_t) { ++_asyncCallbacks; }
+
+static void testAsync() {
+  printf("async\n");
+  restart();
+  slaveSend((const uint8_t*)"hello", 5);
+  int queued = 0;
+  for (int i = 0; i < 10; ++i) queued += sendAsync((const uint8_t*)"a", 1, 100 + i);
+  CHECK(queued == CTAG_SPI_IPC_ASYNC_QUEUE - 1);
+
+  // Results come back in order, and the slave packet with one of them
+  uint32_t tag;
+  uint8_t rx[kMaxPayload];
+  int n;
+  uint32_t expected = 100;
+  bool hello = false;
+  while ((n = pollAsync(&tag, rx, sizeof(rx))) >= 0) {
+    CHECK(tag == expected++);
+    if (n == 5 && memcmp(rx, "hello", 5) == 0) hello = true;
+  }
+  CHECK(expected == 100 + (uint32_t)queued);
+  CHECK(hello);
+  CHECK(drain() == queued);
+
+  _asyncCallbacks = 0;
+  setAsyncCallback(onAsync);
+  for (int i = 0; i < 10; ++i) sendAsync((const uint8_t*)"b", 1, i);
+  flushAsync();
+  CHECK(_asyncCallbacks == 10);
+  CHECK(drain() == 10);
+  setAsyncCallback(nullptr);
+}
+
+// --- Batching ---------------------------------------------------------------
+
+static uint32_t _batchExpected = 0;
+static uint32_t _batchGot = 0;
+static uint32_t _batchBad = 0;
+
+static void onBatchPacket(const uint8_t* data, size_t len) {
+  uint32_t value;
+  if (len != 5 || data[0] != 0x10) {
+    ++_batchBad;
+    return;
+  }
+  memcpy(&value, &data[1], 4);
+  if (value != _batchExpected) ++_batchBad;
+  _batchExpected = value + 1;
+  ++_batchGot;
+}
+
+/**
+ * @brief Sends count numbered messages, one per send() or through post().
+ */
+static void sendNumbered(uint32_t count, bool usePost) {
+  _batchExpected = _batchGot = _batchBad = 0;
+  HostSim::resetCounters();
+  for (uint32_t i = 0; i < count; ++i) {
+    uint8_t message[5] = { 0x10 };
+    memcpy(&message[1], &i, 4);
+    if (usePost) {
+      post(message, sizeof(message));
+      HostSim::nowMicros += 20;
+      serviceBatch();
+    } else {
+      send(message, sizeof(message));
+    }
+  }
+  flushBatch();
+}
+
+static void testBatch() {
+  printf("batch\n");
+  restart(onBatchPacket);
+  const uint32_t count = 100000;
+
+  sendNumbered(count, false);
+  CHECK(_batchGot == count && _batchBad == 0);
+  CHECK(HostSim::transactions() == count);
+  const uint64_t sendBytes = HostSim::bytes();
+
+  sendNumbered(count, true);
+  CHECK(_batchGot == count && _batchBad == 0);
+  CHECK(HostSim::transactions() <= count / 9);
+  CHECK(HostSim::bytes() < sendBytes);
+  printf("  %u messages: send() %.1f bytes each, post() %.1f bytes each in %llu transactions\n",
+         (unsigned)count, (double)sendBytes / count, (double)HostSim::bytes() / count,
+         (unsigned long long)HostSim::transactions());
+
+  // The deadline
+  HostSim::resetCounters();
+  uint8_t message[5] = { 0x10, 0, 0, 0, 0 };
+  _batchExpected = 0;
+  post(message, sizeof(message));
+  HostSim::nowMicros += 999;
+  CHECK(!serviceBatch());
+  HostSim::nowMicros += 1;
+  CHECK(serviceBatch());
+  CHECK(HostSim::transactions() == 1);
+
+  // Any other transfer flushes the batch first
+  _batchExpected = _batchGot = _batchBad = 0;
+  post(message, sizeof(message));
+  message[1] = 1;
+  send(message, sizeof(message));
+  CHECK(_batchGot == 2 && _batchBad == 0);
+
+  uint8_t big[kMaxMessage + 1] = { 0 };
+  CHECK(!post(big, kMaxMessage + 1));
+  CHECK(post(big, kMaxMessage));
+  flushBatch();
+
+  // Slave packets clocked out by batch frames wait in the reply queue
+  restart();
+  setBatchDeadline(1000000);
+  uint8_t rx[kMaxPayload];
+  int replies = 0;
+  int messages = 0;
+  for (int i = 0; i < 50; ++i) {
+    slaveSend((const uint8_t*)"reply", 5);
+    for (int k = 0; k < 10; ++k) post((const uint8_t*)"param", 5);
+    flushBatch();
+    messages += drain();
+    if (i % 5 == 4) {
+      while (poll(rx, sizeof(rx)) > 0) ++replies;
+    }
+  }
+  CHECK(replies == 50);
+  CHECK(messages == 500);
+}
+
+// --- Checksums --------------------------------------------------------------
+
+static uint8_t refCrc8(const uint8_t* data, size_t len) {
+  uint8_t crc = 0;
+  while (len--) {
+    crc ^= *data++;
+    for (int bit = 0; bit < 8; ++bit) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+  }
+  return crc;
+}
+
+static uint16_t refCrc16(const uint8_t* data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  while (len--) {
+    crc ^= *data++;
+    for (int bit = 0; bit < 8; ++bit) crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+  }
+  return (uint16_t)~crc;
+}
+
+static uint32_t refCrc32(const uint8_t* data, size_t len) {
+  uint32_t crc = ~0u;
+  while (len--) {
+    crc ^= *data++;
+    for (int bit = 0; bit < 8; ++bit) crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+  }
+  return ~crc;
+}
+
+static void testChecksums() {
+  printf("checksums\n");
+  const uint8_t* check = (const uint8_t*)"123456789";
+  CHECK(crc8(check, 9) == 0xF4);
+  CHECK(crc16(check, 9) == 0x906E);
+  CHECK(crc32(check, 9) == 0xCBF43926);
+
+  // Every length and alignment the table and word loops handle
+  std::vector<uint8_t> data = pattern(400);
+  int mismatches = 0;
+  for (size_t len = 0; len < 300; ++len) {
+    for (size_t offset = 0; offset < 4; ++offset) {
+      const uint8_t* p = data.data() + offset;
+      if (crc8(p, len) != refCrc8(p, len) || crc16(p, len) != refCrc16(p, len) ||
+          crc32(p, len) != refCrc32(p, len) || crc32Software(p, len) != refCrc32(p, len)) {
+        ++mismatches;
+      }
+    }
+  }
+  CHECK(mismatches == 0);
+}
+
+// --- Reliable delivery ------------------------------------------------------
+
+static void testReliable() {
+  printf("reliable\n");
+  restart();
+  uint8_t rx[kMaxPayload];
+
+  CHECK(sendReliable((const uint8_t*)"preset1", 7));
+  CHECK(drain() == 1);
+  CHECK(getLinkStats().retransmits == 0);
+
+  // A corrupted request is resent and delivered once
+  resetLinkStats();
+  HostSim::corruptMosi(6);
+  CHECK(sendReliable((const uint8_t*)"preset2", 7));
+  CHECK(drain() == 1);
+  LinkStats stats = getLinkStats();
+  CHECK(stats.crcErrors == 1 && stats.retransmits == 1);
+
+  // A lost ack leads to one duplicate, which the slave drops
+  resetLinkStats();
+  HostSim::corruptMiso(HostSim::transactions() + 2, 1);
+  CHECK(sendReliable((const uint8_t*)"preset3", 7));
+  CHECK(drain() == 1);
+  stats = getLinkStats();
+  CHECK(stats.duplicates == 1 && stats.retransmits == 1);
+
+  // A full receive ring is not acknowledged; once drained the packet goes through
+  resetLinkStats();
+  for (int i = 0; i < CTAG_SPI_IPC_RX_RING; ++i) send((const uint8_t*)"x", 1);
+  CHECK(!sendReliable((const uint8_t*)"preset4", 7));
+  CHECK(getLinkStats().reliableFailures == 1);
+  drain();
+  CHECK(sendReliable((const uint8_t*)"preset4", 7));
+  CHECK(drain() == 1);
+
+  // A queued slave packet survives the ack polls
+  slaveSend((const uint8_t*)"meter-values", 12);
+  CHECK(sendReliable((const uint8_t*)"preset5", 7));
+  int n = poll(rx, sizeof(rx));
+  CHECK(n == 12 && memcmp(rx, "meter-values", 12) == 0);
+  drain();
+
+  // ...also when every reliable packet clocks one out
+  uint8_t preset[50];
+  memset(preset, 'p', sizeof(preset));
+  int delivered = 0;
+  int replies = 0;
+  for (int i = 0; i < 20; ++i) {
+    slaveSend((const uint8_t*)"meter", 5);
+    delivered += sendReliable(preset, sizeof(preset));
+    drain();
+    while (poll(rx, sizeof(rx)) > 0) ++replies;
+  }
+  CHECK(delivered == 20 && replies == 20);
+}
+
+static void testReliableBulk() {
+  printf("reliable bulk\n");
+  restart();
+  std::vector<uint8_t> src = pattern(10000);
+  std::vector<uint8_t> dst(16384);
+  setBulkBuffer(dst.data(), dst.size(), onBulk);
+  setBulkReliable(true);
+
+  // One corrupted fragment and one lost ack
+  _bulkDone = 0;
+  CHECK(beginBulk(src.data(), src.size(), 9, 4096));
+  int result;
+  int step = 0;
+  do {
+    if (step == 1) HostSim::corruptMosi(3000);
+    if (step == 2) HostSim::corruptMiso(HostSim::transactions() + 2, 1);
+    ++step;
+    result = bulkStep();
+  } while (result > 0);
+  CHECK(result == 0);
+  CHECK(_bulkDone == 1 && _bulkLen == src.size());
+  CHECK(memcmp(src.data(), dst.data(), src.size()) == 0);
+  LinkStats stats = getLinkStats();
+  CHECK(stats.crcErrors == 1 && stats.duplicates == 1 && stats.retransmits == 2);
+
+  // The same small block twice is delivered twice
+  _bulkDone = 0;
+  resetLinkStats();
+  CHECK(sendBulk(src.data(), 100, 4));
+  CHECK(sendBulk(src.data(), 100, 4));
+  CHECK(_bulkDone == 2 && getLinkStats().duplicates == 0);
+
+  // A lost ack on a single fragment still delivers it once
+  _bulkDone = 0;
+  resetLinkStats();
+  HostSim::corruptMiso(HostSim::transactions() + 2, 1);
+  CHECK(sendBulk(src.data(), 100, 4));
+  CHECK(_bulkDone == 1 && getLinkStats().duplicates == 1);
+
+  // A repeated block whose first attempt is corrupted is not taken for the previous one
+  std::vector<uint8_t> first(100, 0x11);
+  std::vector<uint8_t> second(100, 0x22);
+  _bulkDone = 0;
+  resetLinkStats();
+  CHECK(sendBulk(first.data(), first.size(), 5));
+  HostSim::corruptMosi(20);
+  CHECK(sendBulk(second.data(), second.size(), 5));
+  CHECK(_bulkDone == 2 && _bulkFirst == 0x22);
+  CHECK(getLinkStats().duplicates == 0);
+
+  // Without a slave nothing is acknowledged
+  HostSim::disconnectSlave();
+  resetLinkStats();
+  CHECK(!sendReliable((const uint8_t*)"x", 1));
+  CHECK(!sendBulk(src.data(), 100, 1));
+  CHECK(getLinkStats().reliableFailures == 2);
+}
+
+int main() {
+  testReceiveRing();
+  testExchange();
+  testBulk();
+  testAsync();
+  testBatch();
+  testChecksums();
+  testReliable();
+  testReliableBulk();
+  printf(_failures ? "%d checks failed\n" : "all checks passed\n", _failures);
+  return _failures;
+}
@@ -0,0 +1,34 @@
+/**
+ * @file Arduino.h
+ * @brief The part of the Arduino core that CTAG_SPI_IPC uses, for host builds.
+ *
+ * Time only moves when delayMicroseconds() or HostSim::advanceMicros() is
+ * called, so timeouts and deadlines are deterministic.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <algorithm>
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+
+#define OUTPUT 1
+#define HIGH 1
+#define LOW 0
+
+using std::min;
+using std::max;
+
+namespace HostSim {
+extern uint32_t nowMicros;
+}
+
+inline uint32_t micros() { return HostSim::nowMicros; }
+inline uint32_t millis() { return HostSim::nowMicros / 1000; }
+inline void delayMicroseconds(uint32_t us) { HostSim::nowMicros += us; }
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
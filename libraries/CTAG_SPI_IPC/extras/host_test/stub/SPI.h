@@ -0,0 +1,31 @@
+/**
+ * @file SPI.h
+ * @brief Host SPI master that clocks its frames into the simulated ESP32 slave.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0
+#define SPI_MODE3 3
+#define MSBFIRST 1
+
+struct SPISettings {
+  SPISettings() {}
+  SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+namespace HostSim {
+/// Runs one CS-framed transaction: clocks n bytes of MOSI, stores MISO in place.
+void masterTransfer(uint8_t* buffer, size_t n);
+}
+
+class SPIClass {
+public:
+  void begin() {}
+  void beginTransaction(SPISettings) {}
+  void endTransaction() {}
+  void transfer(void* buffer, size_t n) { HostSim::masterTransfer(static_cast<uint8_t*>(buffer), n); }
+};
+
+extern SPIClass SPI;
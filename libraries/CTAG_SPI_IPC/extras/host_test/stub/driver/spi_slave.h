@@ -0,0 +1,61 @@
+/**
+ * @file spi_slave.h
+ * @brief Host replacement for the ESP-IDF SPI slave driver.
+ *
+ * Queued descriptors are kept in order. HostSim::masterTransfer() takes the
+ * oldest one for each transaction and calls post_setup_cb and post_trans_cb
+ * the way the driver's interrupt does, so the slave code runs unchanged.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int esp_err_t;
+#define ESP_OK   0
+#define ESP_FAIL -1
+
+#define SPI3_HOST 2
+#define SPI_DMA_CH_AUTO 3
+#define SPI_SLAVE_NO_RETURN_RESULT (1 << 4)
+
+#ifndef portMAX_DELAY
+#define portMAX_DELAY 0xFFFFFFFFu
+#endif
+
+typedef int spi_host_device_t;
+
+struct spi_slave_transaction_t {
+  size_t      length;     ///< Bits
+  size_t      trans_len;  ///< Bits actually clocked
+  const void* tx_buffer;
+  void*       rx_buffer;
+  void*       user;
+};
+
+typedef void (*slave_transaction_cb_t)(spi_slave_transaction_t* trans);
+
+struct spi_bus_config_t {
+  int mosi_io_num;
+  int miso_io_num;
+  int sclk_io_num;
+  int quadwp_io_num;
+  int quadhd_io_num;
+  int max_transfer_sz;
+};
+
+struct spi_slave_interface_config_t {
+  int                    spics_io_num;
+  uint32_t               flags;
+  int                    queue_size;
+  uint8_t                mode;
+  slave_transaction_cb_t post_setup_cb;
+  slave_transaction_cb_t post_trans_cb;
+};
+
+esp_err_t spi_slave_initialize(spi_host_device_t host, const spi_bus_config_t* bus,
+                               const spi_slave_interface_config_t* cfg, int dma);
+esp_err_t spi_slave_free(spi_host_device_t host);
+esp_err_t spi_slave_queue_trans(spi_host_device_t host, const spi_slave_transaction_t* trans,
+                                uint32_t ticks);
+esp_err_t spi_slave_queue_trans_isr(spi_host_device_t host, const spi_slave_transaction_t* trans);
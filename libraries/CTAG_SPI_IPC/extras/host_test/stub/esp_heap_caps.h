@@ -0,0 +1,13 @@
+/**
+ * @file esp_heap_caps.h
+ * @brief Host replacement for the ESP-IDF capability allocator.
+ */
+#pragma once
+
+#include <stdlib.h>
+
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+inline void* heap_caps_malloc(size_t size, uint32_t) { return malloc(size); }
+inline void heap_caps_free(void* ptr) { free(ptr); }
@@ -0,0 +1,16 @@
+/**
+ * @file esp_rom_crc.h
+ * @brief Host replacement for the ESP32 ROM CRC-32 (IEEE 802.3, reflected).
+ */
+#pragma once
+
+#include <stdint.h>
+
+inline uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* data, uint32_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    for (int bit = 0; bit < 8; ++bit) crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+  }
+  return ~crc;
+}
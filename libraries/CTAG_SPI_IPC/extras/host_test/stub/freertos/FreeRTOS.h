@@ -0,0 +1,26 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Host replacement for the FreeRTOS types CTAG_SPI_IPC uses.
+ */
+#pragma once
+
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdPASS  1
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+#ifndef portMAX_DELAY
+#define portMAX_DELAY 0xFFFFFFFFu
+#endif
+
+namespace HostSim {
+/// Counts context switches requested from the simulated interrupt.
+extern int isrYields;
+}
+
+#define portYIELD_FROM_ISR() (++HostSim::isrYields)
@@ -0,0 +1,18 @@
+/**
+ * @file task.h
+ * @brief Host replacement for FreeRTOS tasks and direct-to-task notifications.
+ *
+ * A task is a detached std::thread; its notification value is a counter
+ * guarded by a mutex and condition variable.
+ */
+#pragma once
+
+#include "FreeRTOS.h"
+
+struct HostTask;
+typedef HostTask* TaskHandle_t;
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void*), const char* name, uint32_t stack, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core);
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, uint32_t ticks);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken);
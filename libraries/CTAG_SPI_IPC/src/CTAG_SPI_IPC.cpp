@@ -4,32 +4,325 @@
  */
 #include "CTAG_SPI_IPC.h"
 
+#ifdef ESP32
+#include "driver/spi_slave.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/dma.h>
+#include <hardware/gpio.h>
+#include <hardware/irq.h>
+#include <hardware/resets.h>
+#include <hardware/spi.h>
+#include <hardware/sync.h>
+#include <pico/time.h>
+#endif
+
 namespace CTAG_SPI_IPC {
 
 // --- Module-level static variables ---
 static SPIClass* _spi = nullptr;        // Pointer to the SPI peripheral
 static uint8_t   _csPin = 255;          // Chip Select pin for master mode
 static SPISettings _settings;           // SPI settings for master mode
+static volatile uint32_t _csHighUs = 0; // When CS last went high, for the gap before the next frame
+
+// Running bulk transfer of the master
+static const uint8_t* _bulkData = nullptr;
+static size_t   _bulkLen = 0;
+static size_t   _bulkOffset = 0;
+static size_t   _bulkFragment = 0;
+static uint16_t _bulkSeq = 0;
+static uint8_t  _bulkId = 0;
+static uint8_t  _bulkTransfer = 0;              // Transfer number, advanced by beginBulk()
+static Checksum _bulkChecksum = Checksum::Crc32;
+static uint8_t  _bulkFrame[kBulkFrameSize];     // Static: too large for the stack
+
+static const uint8_t kPacketMagic = 0xFE;       // Second magic byte of a packet
+static const uint8_t kBulkMagic = 0xB0;         // Second magic byte of a bulk fragment, ORed with its Checksum
+static const uint8_t kBulkAckFlag = 0x04;       // ORed in as well if the fragment is to be acknowledged
+static const uint8_t kBulkMagicMask = 0xF8;
+static const uint8_t kBulkKindMask = 0x03;      // The Checksum bits of a bulk fragment's magic
+static const uint16_t kBulkRetryFlag = 0x8000;  // Set in the Seq field of a retransmitted fragment
+static const uint16_t kBulkSeqMask = 0x7FFF;    // The sequence number itself
+static const uint16_t kBulkLenMask = 0x1FFF;    // The payload length in the Len field
+static const uint8_t kBulkTransferShift = 13;   // Len bits 13 to 15 carry the transfer number
+static const uint8_t kBulkTransferMask = 0x07;  // (reliable fragments only)
+static const uint8_t kBatchMagic = 0xBA;        // Second magic byte of a batch of messages
+static const uint8_t kReliableMagic = 0xA0;     // Second magic byte of a reliable packet: [Seq, Message...]
+static const uint8_t kAckMagic = 0xAC;          // Acknowledgement of a reliable packet
+static const uint8_t kBulkAckMagic = 0xAD;      // Acknowledgement of a bulk fragment
+static const size_t  kAckFrameSize = 4;         // [0xCA, Magic, Seq, CRC]; shorter than any other frame
+
+// Link statistics, counted by whichever role the module plays
+static volatile uint32_t _linkOk = 0;
+static volatile uint32_t _linkCrcErrors = 0;
+static volatile uint32_t _linkMagicErrors = 0;
+static volatile uint32_t _linkDuplicates = 0;
+static volatile uint32_t _linkBytes = 0;
+static uint32_t _linkRetransmits = 0;
+static uint32_t _linkFailures = 0;
+static uint32_t _linkOverrunBase = 0;   // overflows() + deferredDrops() at the last reset
+static uint32_t _rateMs = 0;            // Start of the bytesPerSecond window
+static uint32_t _rateBytes = 0;
+
+// Reliable frames of the master
+static uint8_t  _relSeq = 0;
+static uint8_t  _relRetries = 3;
+static bool     _bulkReliable = false;
+static volatile uint16_t _lastAck = 0;  // (Magic << 8) | Seq of the last acknowledgement received
 
 /**
- * @brief Calculates the CRC8 checksum for a given data buffer.
- * @param data Pointer to the data.
- * @param len Length of the data.
- * @return The calculated 8-bit CRC.
+ * @brief A slave packet the master received but has not returned yet.
  */
-static uint8_t calcCRC(const uint8_t* data, size_t len) {
-  uint8_t crc = 0;
-  while (len--) {
-    crc ^= *data++;
-    for (int i = 0; i < 8; ++i)
-      crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+struct Reply {
+  uint8_t len;
+  uint8_t data[kMaxPayload];
+};
+
+// Reply queue of the master: transfers that do not return the slave's packet
+// keep it here for exchange(). Written and read by the calling thread only.
+static Reply    _replyRing[CTAG_SPI_IPC_REPLY_RING];
+static uint16_t _replyHead = 0;
+static uint16_t _replyTail = 0;
+static uint32_t _replyDrops = 0;
+
+// Coalescing batch of the master: [Len, Message...] entries
+static uint8_t  _batch[kMaxPayload];
+static size_t   _batchLen = 0;
+static size_t   _batchCount = 0;
+static uint32_t _batchStartUs = 0;              // When the oldest message was posted
+static uint32_t _batchDeadlineUs = 1000;
+
+/**
+ * @brief One frame of the master's asynchronous queue.
+ */
+struct AsyncSlot {
+  uint8_t  tx[kFrameSize];
+  uint8_t  rx[kFrameSize];
+  uint32_t tag;
+  uint8_t  rxLen;
+};
+
+// Asynchronous queue: sendAsync() writes _asyncHead, the transfer completion
+// writes _asyncActive, and pollAsync() (or the completion, with a callback)
+// writes _asyncTail. Slots from tail to active hold results.
+static AsyncSlot _async[CTAG_SPI_IPC_ASYNC_QUEUE];
+static volatile uint16_t _asyncHead = 0;
+static volatile uint16_t _asyncActive = 0;
+static volatile uint16_t _asyncTail = 0;
+static volatile bool     _asyncBusy = false;
+static bool              _asyncOpen = false;  // The queue's SPI transaction has not been ended yet
+static AsyncCallback     _asyncCb = nullptr;
+
+static void flushAsyncIfBusy();
+
+/**
+ * @brief Writes a frame: [Magic1, Magic2, Len, Payload..., CRC].
+ * @param magic Second magic byte; a batch uses its own.
+ * @return The frame length in bytes.
+ */
+static size_t buildFrame(uint8_t* frame, const uint8_t* data, size_t len, uint8_t magic = kPacketMagic) {
+  frame[0] = 0xCA;
+  frame[1] = magic;
+  frame[2] = (uint8_t)len;
+  if (len) memcpy(&frame[3], data, len);
+  frame[3 + len] = crc8(&frame[3], len);
+  return 3 + len + 1;
+}
+
+/**
+ * @brief Checks a received frame.
+ * @param frame The received bytes.
+ * @param received Number of bytes actually clocked in; the buffer may still
+ * hold an older frame behind them.
+ * @param magic Expected second magic byte.
+ * @return The payload length, or -1 if the frame is invalid.
+ */
+static int checkFrame(const uint8_t* frame, size_t received, uint8_t magic = kPacketMagic) {
+  // Check for magic bytes to identify a valid start of frame
+  if (received < 4 || frame[0] != 0xCA || frame[1] != magic) return -1;
+  uint8_t len = frame[2];
+  // Validate length and CRC checksum
+  if (len > kMaxPayload || received < 3u + len + 1u) return -1;
+  if (crc8(&frame[3], len) != frame[3 + len]) return -1;
+  return len;
+}
+
+/**
+ * @brief Writes an acknowledgement: [0xCA, Magic, Seq, CRC].
+ * @return Its length, kAckFrameSize.
+ */
+static size_t buildAck(uint8_t* frame, uint8_t magic, uint8_t seq) {
+  frame[0] = 0xCA;
+  frame[1] = magic;
+  frame[2] = seq;
+  frame[3] = crc8(&frame[1], 2);
+  return kAckFrameSize;
+}
+
+static inline void put16(uint8_t* p, uint16_t v) { p[0] = v; p[1] = v >> 8; }
+static inline void put32(uint8_t* p, uint32_t v) { put16(p, v); put16(p + 2, v >> 16); }
+static inline uint16_t get16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+static inline uint32_t get32(const uint8_t* p) { return get16(p) | ((uint32_t)get16(p + 2) << 16); }
+
+/**
+ * @brief Number of checksum bytes of a kind, 0 for an unknown kind.
+ */
+static inline size_t checksumSize(uint8_t kind) {
+  return kind == (uint8_t)Checksum::Crc8 ? 1 : kind == (uint8_t)Checksum::Crc16 ? 2 :
+         kind == (uint8_t)Checksum::Crc32 ? 4 : 0;
+}
+
+/**
+ * @brief Computes a checksum of the given kind.
+ */
+static inline uint32_t checksum(uint8_t kind, const uint8_t* data, size_t len) {
+  if (kind == (uint8_t)Checksum::Crc32) return crc32(data, len);
+  if (kind == (uint8_t)Checksum::Crc16) return crc16(data, len);
+  return crc8(data, len);
+}
+
+/**
+ * @brief Checks a received bulk fragment. The CRC covers everything after the
+ * magic bytes, so a corrupted offset cannot place data at the wrong position.
+ * @return The fragment's payload length, or -1 if the fragment is invalid.
+ */
+static int checkBulkFrame(const uint8_t* frame, size_t received) {
+  if (received < kBulkHeader + 1 || frame[0] != 0xCA || (frame[1] & kBulkMagicMask) != kBulkMagic) return -1;
+  const uint8_t kind = frame[1] & kBulkKindMask;
+  const size_t crcLen = checksumSize(kind);
+  uint16_t len = get16(&frame[5]) & kBulkLenMask;
+  if (crcLen == 0 || len > kBulkPayload || received < kBulkHeader + len + crcLen) return -1;
+  uint32_t crc = checksum(kind, &frame[2], kBulkHeader - 2 + len);
+  for (size_t i = 0; i < crcLen; ++i, crc >>= 8) {
+    if (frame[kBulkHeader + len + i] != (uint8_t)crc) return -1;
   }
-  return crc;
+  return len;
 }
 
 
 // --- Master Implementation ---
 
+/**
+ * @brief Waits until CS has been high for CTAG_SPI_IPC_ASYNC_GAP_US. An RP2040
+ * slave resets its SPI block and re-arms its DMA in the CS rising-edge
+ * interrupt; a frame that starts earlier would be cut by that reset.
+ */
+static void waitCsGap() {
+  const uint32_t high = micros() - _csHighUs;
+  if (high < CTAG_SPI_IPC_ASYNC_GAP_US) delayMicroseconds(CTAG_SPI_IPC_ASYNC_GAP_US - high);
+}
+
+/**
+ * @brief Clocks one CS-framed transaction; the received bytes replace the frame.
+ */
+static void transferFrame(uint8_t* frame, size_t len) {
+  _spi->beginTransaction(_settings);
+  waitCsGap();
+  digitalWrite(_csPin, LOW);
+  _spi->transfer(frame, len);
+  digitalWrite(_csPin, HIGH);
+  _csHighUs = micros();
+  _spi->endTransaction();
+  _linkBytes += len;
+}
+
+/**
+ * @brief Checks the slave's side of a full-duplex transaction and counts it
+ * in the link statistics. Acknowledgements are recorded in _lastAck.
+ * @param frame The received bytes.
+ * @param received Number of bytes clocked.
+ * @return The payload length of a valid packet, 0 if the slave had nothing
+ * queued, sent an acknowledgement or its frame did not fit into the
+ * transaction (the slave sends it again), or -1 if the frame is corrupt.
+ * @note Runs in the DMA interrupt for asynchronous frames on RP2040.
+ */
+static int checkReply(const uint8_t* frame, size_t received) {
+  if (frame[0] == 0) return 0; // No magic: the slave had nothing queued
+  if (frame[0] != 0xCA || (frame[1] != kPacketMagic && frame[1] != kAckMagic && frame[1] != kBulkAckMagic)) {
+    ++_linkMagicErrors;
+    return -1;
+  }
+  if (frame[1] != kPacketMagic) {
+    if (received < kAckFrameSize) return 0;
+    if (crc8(&frame[1], 2) != frame[3]) {
+      ++_linkCrcErrors;
+      return -1;
+    }
+    ++_linkOk;
+    _lastAck = (uint16_t)((frame[1] << 8) | frame[2]);
+    return 0;
+  }
+  if (received < 4 || received < 3u + frame[2] + 1u) return 0;
+  int len = checkFrame(frame, received);
+  if (len < 0) {
+    ++_linkCrcErrors;
+    return -1;
+  }
+  ++_linkOk;
+  return len;
+}
+
+/**
+ * @brief Checks the slave's side of a synchronous transaction and keeps a
+ * packet it carried in the reply queue. The slave drops a packet once it
+ * has been clocked out completely, whichever call clocked it.
+ */
+static void keepReply(const uint8_t* frame, size_t received) {
+  int len = checkReply(frame, received);
+  if (len <= 0) return;
+  uint16_t head = _replyHead;
+  uint16_t next = (head + 1) % CTAG_SPI_IPC_REPLY_RING;
+  if (next == _replyTail) {
+    ++_replyDrops;
+    return;
+  }
+  _replyRing[head].len = (uint8_t)len;
+  memcpy(_replyRing[head].data, &frame[3], len);
+  _replyHead = next;
+}
+
+/**
+ * @brief Returns the oldest packet of the reply queue.
+ * @return Its length, 0 if the queue is empty or the packet did not fit.
+ */
+static int takeReply(uint8_t* rxBuffer, size_t rxMaxLen) {
+  uint16_t tail = _replyTail;
+  if (tail == _replyHead) return 0;
+  int len = _replyRing[tail].len;
+  if ((size_t)len > rxMaxLen) {
+    len = 0;
+  } else {
+    memcpy(rxBuffer, _replyRing[tail].data, len);
+  }
+  _replyTail = (tail + 1) % CTAG_SPI_IPC_REPLY_RING;
+  return len;
+}
+
+/**
+ * @brief Polls the slave until it acknowledges a reliable frame. The slave
+ * loads the acknowledgement into one of its next transactions, so it takes
+ * a few short polls.
+ * @param magic kAckMagic or kBulkAckMagic.
+ * @return True if the acknowledgement arrived within CTAG_SPI_IPC_ACK_POLLS polls.
+ */
+static bool awaitAck(uint8_t magic, uint8_t seq) {
+  const uint16_t want = (uint16_t)((magic << 8) | seq);
+  for (int i = 0; i < CTAG_SPI_IPC_ACK_POLLS && _lastAck != want; ++i) {
+    delayMicroseconds(CTAG_SPI_IPC_ACK_POLL_US);
+    // An empty packet: the slave ignores it, and any frame longer than an
+    // acknowledgement is cut off and sent again later
+    uint8_t frame[kAckFrameSize];
+    buildFrame(frame, nullptr, 0);
+    transferFrame(frame, kAckFrameSize);
+    keepReply(frame, kAckFrameSize);
+  }
+  return _lastAck == want;
+}
+
 bool beginMaster(uint8_t csPin, SPIClass& spi, uint32_t speed, uint8_t mode) {
   _spi = &spi;
   _csPin = csPin;
@@ -41,68 +334,948 @@ bool beginMaster(uint8_t csPin, SPIClass& spi, uint32_t speed, uint8_t mode) {
 
 bool send(const uint8_t* data, size_t len) {
   // Check for initialization and valid length
-  if (!_spi || len > 61) return false;
+  if (!_spi || len > kMaxPayload) return false;
+  flushAsyncIfBusy();
+  flushBatch();
 
   // Construct the frame: [Magic1, Magic2, Len, Payload..., CRC]
-  uint8_t frame[64];
-  frame[0] = 0xCA;
-  frame[1] = 0xFE;
-  frame[2] = (uint8_t)len;
-  memcpy(&frame[3], data, len);
-  frame[3 + len] = calcCRC(&frame[3], len);
-  size_t frameLen = 3 + len + 1;
+  uint8_t frame[kFrameSize];
+  size_t frameLen = buildFrame(frame, data, len);
 
   // Perform SPI transaction
-  _spi->beginTransaction(_settings);
+  transferFrame(frame, frameLen);
+  keepReply(frame, frameLen);
+  return true;
+}
+
+int exchange(const uint8_t* data, size_t len, uint8_t* rxBuffer, size_t rxMaxLen) {
+  if (!_spi || len > kMaxPayload) return -1;
+  flushAsyncIfBusy();
+  flushBatch();
+
+  // A poll is answered from the reply queue while it holds packets
+  if (len > 0 || _replyTail == _replyHead) {
+    // Pad to a full frame so the slave's packet fits, whatever its length
+    uint8_t frame[kFrameSize];
+    size_t frameLen = buildFrame(frame, data, len);
+    memset(&frame[frameLen], 0, kFrameSize - frameLen);
+
+    // The slave's bytes replace ours in place while they are clocked out
+    transferFrame(frame, kFrameSize);
+    keepReply(frame, kFrameSize);
+  }
+  return takeReply(rxBuffer, rxMaxLen);
+}
+
+bool beginBulk(const uint8_t* data, size_t len, uint8_t id, size_t fragmentSize) {
+  if (!_spi || _bulkData || len == 0 || fragmentSize == 0) return false;
+  fragmentSize = min(fragmentSize, kBulkPayload);
+  // Sequence numbers must not wrap, or a fragment would look like a new transfer
+  if ((len + fragmentSize - 1) / fragmentSize > (size_t)kBulkSeqMask + 1) return false;
+  _bulkData = data;
+  _bulkLen = len;
+  _bulkOffset = 0;
+  _bulkFragment = fragmentSize;
+  _bulkSeq = 0;
+  _bulkId = id;
+  _bulkTransfer = (_bulkTransfer + 1) & kBulkTransferMask;
+  return true;
+}
+
+bool sendReliable(const uint8_t* data, size_t len) {
+  if (!_spi || len == 0 || len > kMaxMessage) return false;
+  flushAsyncIfBusy();
+  flushBatch();
+
+  uint8_t payload[kMaxPayload];
+  payload[0] = ++_relSeq;
+  memcpy(&payload[1], data, len);
+  _lastAck = 0;
+  for (uint8_t attempt = 0; attempt <= _relRetries; ++attempt) {
+    if (attempt) ++_linkRetransmits;
+    uint8_t frame[kFrameSize];
+    size_t frameLen = buildFrame(frame, payload, len + 1, kReliableMagic);
+    transferFrame(frame, frameLen);
+    keepReply(frame, frameLen);
+    if (awaitAck(kAckMagic, payload[0])) return true;
+  }
+  ++_linkFailures;
+  return false;
+}
+
+void setReliableRetries(uint8_t retries) { _relRetries = retries; }
+
+void setBulkReliable(bool enable) { _bulkReliable = enable; }
+
+/**
+ * @brief Writes the next fragment of the running bulk transfer into _bulkFrame.
+ * @param retry Marks the fragment as a retransmission, so a slave that has
+ * already taken it only acknowledges it again.
+ * @return The frame length in bytes.
+ */
+static size_t buildBulkFrame(size_t len, bool retry) {
+  // Construct the fragment: [Magic1, Magic2 | Checksum, ID, Seq, Len, Offset, Total, Payload..., CRC]
+  uint8_t* frame = _bulkFrame;
+  frame[0] = 0xCA;
+  frame[1] = kBulkMagic | (uint8_t)_bulkChecksum | (_bulkReliable ? kBulkAckFlag : 0);
+  frame[2] = _bulkId;
+  put16(&frame[3], (_bulkSeq & kBulkSeqMask) | (retry ? kBulkRetryFlag : 0));
+  // Plain fragments keep the spare bits clear, as slaves before the transfer number expect
+  const uint16_t transfer = _bulkReliable ? (uint16_t)(_bulkTransfer << kBulkTransferShift) : 0;
+  put16(&frame[5], (uint16_t)len | transfer);
+  put32(&frame[7], (uint32_t)_bulkOffset);
+  put32(&frame[11], (uint32_t)_bulkLen);
+  memcpy(&frame[kBulkHeader], _bulkData + _bulkOffset, len);
+  const size_t crcLen = checksumSize((uint8_t)_bulkChecksum);
+  uint32_t crc = checksum((uint8_t)_bulkChecksum, &frame[2], kBulkHeader - 2 + len);
+  for (size_t i = 0; i < crcLen; ++i, crc >>= 8) frame[kBulkHeader + len + i] = (uint8_t)crc;
+  return kBulkHeader + len + crcLen;
+}
+
+int bulkStep() {
+  if (!_bulkData) return -1;
+  flushAsyncIfBusy();
+  flushBatch();
+
+  size_t len = min(_bulkFragment, _bulkLen - _bulkOffset);
+  if (_bulkReliable) {
+    // The transfer overwrites the frame with the slave's bytes, so every
+    // attempt builds it again
+    _lastAck = 0;
+    bool acked = false;
+    for (uint8_t attempt = 0; attempt <= _relRetries && !acked; ++attempt) {
+      if (attempt) ++_linkRetransmits;
+      size_t frameLen = buildBulkFrame(len, attempt > 0);
+      transferFrame(_bulkFrame, frameLen);
+      keepReply(_bulkFrame, frameLen);
+      acked = awaitAck(kBulkAckMagic, (uint8_t)_bulkSeq);
+    }
+    if (!acked) {
+      // The slave abandons its side at the next fragment that does not follow
+      ++_linkFailures;
+      _bulkData = nullptr;
+      return -1;
+    }
+  } else {
+    size_t frameLen = buildBulkFrame(len, false);
+    transferFrame(_bulkFrame, frameLen);
+    keepReply(_bulkFrame, frameLen);
+  }
+
+  _bulkOffset += len;
+  ++_bulkSeq;
+  if (_bulkOffset >= _bulkLen) {
+    _bulkData = nullptr;
+    return 0;
+  }
+  return (int)((_bulkLen - _bulkOffset + _bulkFragment - 1) / _bulkFragment);
+}
+
+bool sendBulk(const uint8_t* data, size_t len, uint8_t id, size_t fragmentSize) {
+  if (!beginBulk(data, len, id, fragmentSize)) return false;
+  int remaining;
+  while ((remaining = bulkStep()) > 0) {}
+  return remaining == 0;
+}
+
+void setBulkChecksum(Checksum kind) {
+  if (checksumSize((uint8_t)kind)) _bulkChecksum = kind;
+}
+
+
+// --- Message Coalescing ---
+
+bool post(const uint8_t* data, size_t len) {
+  if (!_spi || len == 0 || len > kMaxMessage) return false;
+  if (_batchLen + 1 + len > kMaxPayload) flushBatch();
+
+  if (_batchLen == 0) _batchStartUs = micros();
+  _batch[_batchLen++] = (uint8_t)len;
+  memcpy(&_batch[_batchLen], data, len);
+  _batchLen += len;
+  ++_batchCount;
+
+  if (_batchDeadlineUs == 0) flushBatch();
+  return true;
+}
+
+bool flushBatch() {
+  if (_batchLen == 0) return false;
+  flushAsyncIfBusy();
+
+  uint8_t frame[kFrameSize];
+  size_t frameLen = buildFrame(frame, _batch, _batchLen, kBatchMagic);
+  _batchLen = 0;
+  _batchCount = 0;
+  transferFrame(frame, frameLen);
+  keepReply(frame, frameLen);
+  return true;
+}
+
+bool serviceBatch() {
+  if (_batchLen == 0 || micros() - _batchStartUs < _batchDeadlineUs) return false;
+  return flushBatch();
+}
+
+void setBatchDeadline(uint32_t us) { _batchDeadlineUs = us; }
+
+size_t batchPending() { return _batchCount; }
+
+
+// --- Asynchronous Master Queue ---
+
+/**
+ * @brief Records the result of the frame at _asyncActive and advances.
+ * @note Runs in the DMA interrupt on RP2040.
+ */
+static void completeAsync() {
+  AsyncSlot& slot = _async[_asyncActive];
+  int rxLen = checkReply(slot.rx, kFrameSize);
+  slot.rxLen = rxLen > 0 ? rxLen : 0;
+  _asyncActive = (_asyncActive + 1) % CTAG_SPI_IPC_ASYNC_QUEUE;
+  if (_asyncCb) {
+    _asyncCb(slot.tag, &slot.rx[3], slot.rxLen);
+    _asyncTail = _asyncActive;
+  }
+}
+
+#ifdef ARDUINO_ARCH_RP2040
+
+static int _dmaTx = -1;
+static int _dmaRx = -1;
+
+/**
+ * @brief The hardware block behind the SPIClass passed to beginMaster().
+ */
+static spi_inst_t* spiInstance() {
+#ifdef PIN_SPI1_MISO
+  if (_spi == &SPI1) return spi1;
+#endif
+  return spi0;
+}
+
+/**
+ * @brief Asserts CS and starts both DMA channels for the frame at _asyncActive.
+ */
+static void __not_in_flash_func(startAsyncFrame)() {
+  AsyncSlot& slot = _async[_asyncActive];
   digitalWrite(_csPin, LOW);
-  _spi->transfer(frame, frameLen);
+  dma_channel_set_write_addr(_dmaRx, slot.rx, false);
+  dma_channel_set_trans_count(_dmaRx, kFrameSize, false);
+  dma_channel_set_read_addr(_dmaTx, slot.tx, false);
+  dma_channel_set_trans_count(_dmaTx, kFrameSize, false);
+  dma_start_channel_mask((1u << _dmaRx) | (1u << _dmaTx));
+}
+
+static int64_t gapElapsed(alarm_id_t id, void* user) {
+  startAsyncFrame();
+  return 0; // Do not reschedule
+}
+
+/**
+ * @brief Shared DMA_IRQ_0 handler. The receive channel finishes after the
+ * last byte has been clocked, so CS can be released right away.
+ */
+static void __not_in_flash_func(dmaIrq)() {
+  if (!dma_channel_get_irq0_status(_dmaRx)) return;
+  dma_channel_acknowledge_irq0(_dmaRx);
   digitalWrite(_csPin, HIGH);
-  _spi->endTransaction();
+  _csHighUs = micros();
+  _linkBytes += kFrameSize;
+
+  completeAsync();
+  // SPIClass transactions are not safe in an interrupt; endAsyncTransaction()
+  // ends this one from the thread once the queue is idle
+  if (_asyncActive != _asyncHead) {
+    if (CTAG_SPI_IPC_ASYNC_GAP_US > 0) {
+      // Without a free alarm slot the gap is waited out here; leaving the
+      // queue unstarted would keep _asyncBusy set forever.
+      if (add_alarm_in_us(CTAG_SPI_IPC_ASYNC_GAP_US, gapElapsed, nullptr, true) < 0) {
+        busy_wait_us_32(CTAG_SPI_IPC_ASYNC_GAP_US);
+        startAsyncFrame();
+      }
+    } else {
+      startAsyncFrame();
+    }
+  } else {
+    _asyncBusy = false;
+  }
+}
+
+/**
+ * @brief Claims the DMA channels and installs the interrupt on first use.
+ */
+static bool initAsync() {
+  if (_dmaRx >= 0) return true;
+  int tx = dma_claim_unused_channel(false);
+  int rx = dma_claim_unused_channel(false);
+  if (tx < 0 || rx < 0) {
+    if (tx >= 0) dma_channel_unclaim(tx);
+    if (rx >= 0) dma_channel_unclaim(rx);
+    return false;
+  }
+  spi_inst_t* inst = spiInstance();
+
+  dma_channel_config c = dma_channel_get_default_config(tx);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, spi_get_dreq(inst, true));
+  dma_channel_configure(tx, &c, &spi_get_hw(inst)->dr, nullptr, 0, false);
+
+  c = dma_channel_get_default_config(rx);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+  channel_config_set_read_increment(&c, false);
+  channel_config_set_write_increment(&c, true);
+  channel_config_set_dreq(&c, spi_get_dreq(inst, false));
+  dma_channel_configure(rx, &c, nullptr, &spi_get_hw(inst)->dr, 0, false);
+
+  _dmaTx = tx;
+  _dmaRx = rx;
+  dma_channel_set_irq0_enabled(_dmaRx, true);
+  irq_add_shared_handler(DMA_IRQ_0, dmaIrq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+  irq_set_enabled(DMA_IRQ_0, true);
+  return true;
+}
+
+bool sendAsync(const uint8_t* data, size_t len, uint32_t tag) {
+  if (!_spi || len > kMaxPayload || !initAsync()) return false;
+  flushBatch();
+  uint16_t head = _asyncHead;
+  uint16_t next = (head + 1) % CTAG_SPI_IPC_ASYNC_QUEUE;
+  if (next == _asyncTail) return false;
+
+  AsyncSlot& slot = _async[head];
+  size_t frameLen = buildFrame(slot.tx, data, len);
+  memset(&slot.tx[frameLen], 0, kFrameSize - frameLen);
+  slot.tag = tag;
+
+  // Publish the frame and decide atomically whether the DMA needs a kick
+  uint32_t irq = save_and_disable_interrupts();
+  _asyncHead = next;
+  bool kick = !_asyncBusy;
+  _asyncBusy = true;
+  restore_interrupts(irq);
+
+  if (kick) {
+    // A transaction left open by the previous burst is reused
+    if (!_asyncOpen) {
+      _spi->beginTransaction(_settings);
+      _asyncOpen = true;
+    }
+    spi_get_hw(spiInstance())->dmacr = SPI_SSPDMACR_TXDMAE_BITS | SPI_SSPDMACR_RXDMAE_BITS;
+    waitCsGap(); // After a synchronous frame or the previous burst
+    startAsyncFrame();
+  }
+  return true;
+}
+
+/**
+ * @brief Ends the SPI transaction of the queue once the queue is idle.
+ * @note Thread context only. sendAsync() starts no new frame meanwhile, as
+ * the queue is used from one core.
+ */
+static void endAsyncTransaction() {
+  if (_asyncOpen && !_asyncBusy) {
+    _spi->endTransaction();
+    _asyncOpen = false;
+  }
+}
+
+void flushAsync() {
+  while (_asyncBusy) tight_loop_contents();
+  endAsyncTransaction();
+}
+
+#else // Other masters send right away
 
+bool sendAsync(const uint8_t* data, size_t len, uint32_t tag) {
+  if (!_spi || len > kMaxPayload) return false;
+  flushBatch();
+  uint16_t head = _asyncHead;
+  uint16_t next = (head + 1) % CTAG_SPI_IPC_ASYNC_QUEUE;
+  if (next == _asyncTail) return false;
+
+  AsyncSlot& slot = _async[head];
+  size_t frameLen = buildFrame(slot.tx, data, len);
+  memset(&slot.tx[frameLen], 0, kFrameSize - frameLen);
+  slot.tag = tag;
+  _asyncHead = next;
+
+  memcpy(slot.rx, slot.tx, kFrameSize);
+  transferFrame(slot.rx, kFrameSize);
+  completeAsync();
   return true;
 }
 
+static void endAsyncTransaction() {}
+
+void flushAsync() {}
+
+#endif
+
+static void flushAsyncIfBusy() {
+  if (_asyncBusy || _asyncOpen) flushAsync();
+}
+
+void setAsyncCallback(AsyncCallback cb) {
+  flushAsync();
+  _asyncCb = cb;
+}
+
+int pollAsync(uint32_t* tag, uint8_t* rxBuffer, size_t rxMaxLen) {
+  endAsyncTransaction();
+  uint16_t tail = _asyncTail;
+  if (tail == _asyncActive) return -1;
+
+  const AsyncSlot& slot = _async[tail];
+  if (tag) *tag = slot.tag;
+  int len = slot.rxLen <= rxMaxLen ? slot.rxLen : 0;
+  if (len) memcpy(rxBuffer, &slot.rx[3], len);
+  _asyncTail = (tail + 1) % CTAG_SPI_IPC_ASYNC_QUEUE; // Release the slot
+  return len;
+}
+
+size_t asyncPending() {
+  return (_asyncHead + CTAG_SPI_IPC_ASYNC_QUEUE - _asyncActive) % CTAG_SPI_IPC_ASYNC_QUEUE;
+}
+
+
+// --- Link Statistics ---
+
+LinkStats getLinkStats() {
+  LinkStats st = {};
+  st.framesOk = _linkOk;
+  st.crcErrors = _linkCrcErrors;
+  st.magicErrors = _linkMagicErrors;
+  st.overruns = overflows() + deferredDrops() - _linkOverrunBase + _replyDrops;
+  st.duplicates = _linkDuplicates;
+  st.retransmits = _linkRetransmits;
+  st.reliableFailures = _linkFailures;
+  st.bytes = _linkBytes;
+
+  const uint32_t now = millis();
+  const uint32_t ms = now - _rateMs;
+  if (ms > 0) {
+    st.bytesPerSecond = (uint32_t)((uint64_t)(st.bytes - _rateBytes) * 1000 / ms);
+    _rateMs = now;
+    _rateBytes = st.bytes;
+  }
+  return st;
+}
+
+void resetLinkStats() {
+  _linkOk = 0;
+  _linkCrcErrors = 0;
+  _linkMagicErrors = 0;
+  _linkDuplicates = 0;
+  _linkRetransmits = 0;
+  _linkFailures = 0;
+  _linkOverrunBase = overflows() + deferredDrops();
+  _replyDrops = 0;
+  _linkBytes = 0;
+  _rateBytes = 0;
+  _rateMs = millis();
+}
+
 
 // --- Slave Implementation ---
 
+#if defined(ESP32) || defined(ARDUINO_ARCH_RP2040)
+
+#define BUFFER_SIZE kFrameSize  // Largest outbound frame
+
 #ifdef ESP32
-#include "driver/spi_slave.h"
+#define SLAVE_BUFFERS CTAG_SPI_IPC_RX_SLOTS  // One per queued descriptor
+#define SLAVE_ISR(func) IRAM_ATTR func
+#else
+#define SLAVE_BUFFERS 2                      // One is filled while the other is checked
+#define SLAVE_ISR(func) __not_in_flash_func(func)
+#endif
 
-#define BUFFER_SIZE 64
+/**
+ * @brief A validated packet in the receive ring.
+ */
+struct RxFrame {
+  uint8_t len;
+  uint8_t data[kMaxPayload];
+};
 
-// Static variables for the ESP32 slave implementation
-static spi_slave_transaction_t _trans;
-WORD_ALIGNED_ATTR static uint8_t _rxBuf[BUFFER_SIZE];
-WORD_ALIGNED_ATTR static uint8_t _txBuf[BUFFER_SIZE]; // Not used for sending yet, but required by API
+/**
+ * @brief A complete outbound frame in the transmit ring.
+ */
+struct TxFrame {
+  uint8_t len;
+  uint8_t bytes[BUFFER_SIZE];
+};
+
+// Static variables shared by both slave implementations.
+// Every DMA slot has its own buffers, so a packet that arrives while an
+// earlier one is checked lands in the next buffer instead of overwriting it.
+// Transmit buffers have the same size, as the DMA reads them for the whole
+// transaction, but only their first BUFFER_SIZE bytes are used.
+static uint8_t* _rxBuf[SLAVE_BUFFERS];
+static uint8_t* _txBuf[SLAVE_BUFFERS];
+static size_t _rxBufSize = 0;
+static uint8_t _txLen[SLAVE_BUFFERS]; // Frame bytes in each _txBuf, 0 = nothing to send
 static Callback _slaveCb = nullptr;
-volatile static bool _rxReady = false; // Flag to indicate a complete, valid packet has arrived
+
+// Single-producer/single-consumer ring: the ISR writes _rxHead, receive() writes _rxTail.
+static RxFrame _rxRing[CTAG_SPI_IPC_RX_RING];
+static volatile uint16_t _rxHead = 0;
+static volatile uint16_t _rxTail = 0;
+static volatile uint32_t _rxOverflows = 0;
+
+// Same for outbound frames: slaveSend() writes _txHead, the ISR writes _txTail.
+static TxFrame _txRing[CTAG_SPI_IPC_TX_RING];
+static volatile uint16_t _txHead = 0;
+static volatile uint16_t _txTail = 0;
+
+// Acknowledgements go out before the transmit ring; a frame that was cut off
+// meanwhile waits in _txHold. _ackWord is (1 << 16) | (Magic << 8) | Seq, 0 if none.
+static volatile uint32_t _ackWord = 0;
+static TxFrame  _txHold;
+static uint32_t _relLastKey = 0;        // (1 << 24) | (Seq << 16) | CRC-16 of the last reliable packet
+
+// Bulk reassembly, written by the ISR only (except where noted)
+static uint8_t*     _bulkBuf = nullptr;
+static size_t       _bulkCap = 0;
+static BulkCallback _bulkCb = nullptr;
+static bool         _bulkRxActive = false;
+static uint8_t      _bulkRxId = 0;
+static uint16_t     _bulkRxSeq = 0;       // Next expected fragment
+static uint32_t     _bulkRxTotal = 0;
+static uint32_t     _bulkRxCount = 0;     // Bytes received so far
+static volatile bool     _bulkDone = false;  // Cleared by bulkReceive()
+static volatile uint32_t _bulkErrors = 0;
+static bool         _bulkLastValid = false; // Last acknowledged fragment, to spot retransmissions
+static uint8_t      _bulkLastId = 0;
+static uint16_t     _bulkLastSeq = 0;
+static uint32_t     _bulkLastTotal = 0;
+static uint8_t      _bulkLastTransfer = 0;
 
 /**
- * @brief ISR callback triggered after an SPI slave transaction is complete.
- * @note This runs in an interrupt context. It validates the received packet
- * and calls the user-provided callback if the packet is valid.
+ * @brief Allocates the DMA buffers of all slots, unless they already have the
+ * requested size.
+ * @return False if memory ran out.
  */
-static void IRAM_ATTR post_trans_cb(spi_slave_transaction_t *trans) {
-  // Check for magic bytes to identify a valid start of frame
-  if (_rxBuf[0] == 0xCA && _rxBuf[1] == 0xFE) {
-    uint8_t len = _rxBuf[2];
-    // Validate length and CRC checksum
-    if (len <= 61 && calcCRC(&_rxBuf[3], len) == _rxBuf[3 + len]) {
-      // If a user callback is registered, call it with the payload
-      if (_slaveCb) {
-        _slaveCb(&_rxBuf[3], len);
-      }
-      // Set the flag for the polling method (available()/receive())
-      _rxReady = true;
+static bool allocSlaveBuffers(size_t size) {
+  if (_rxBufSize == size) return true;
+  _rxBufSize = 0;
+  for (int i = 0; i < SLAVE_BUFFERS; ++i) {
+#ifdef ESP32
+    // The DMA needs internal, word-aligned RAM
+    heap_caps_free(_rxBuf[i]);
+    heap_caps_free(_txBuf[i]);
+    _rxBuf[i] = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    _txBuf[i] = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+#else
+    free(_rxBuf[i]);
+    free(_txBuf[i]);
+    _rxBuf[i] = (uint8_t*)malloc(size);
+    _txBuf[i] = (uint8_t*)malloc(size);
+#endif
+    if (!_rxBuf[i] || !_txBuf[i]) return false;
+    memset(_txBuf[i], 0, size);
+    _txLen[i] = 0;
+  }
+  _rxBufSize = size;
+  return true;
+}
+
+/**
+ * @brief Adds a validated fragment to the running bulk transfer.
+ * @note Runs in the ISR. A fragment with sequence number 0 starts a new
+ * transfer; any gap abandons the running one. A fragment the master marks as
+ * a retransmission that repeats the last one taken (same transfer number, ID,
+ * sequence number and total length) is dropped. The transfer number changes
+ * with every beginBulk(), so a repeated block whose first attempt was
+ * corrupted is not mistaken for the previous one. Unmarked fragments are always taken, so the same
+ * small block may be sent twice under the same ID.
+ * @return True if the fragment was taken or is such a retransmission.
+ */
+static bool SLAVE_ISR(handleBulk)(const uint8_t* frame, uint16_t len) {
+  uint8_t  id     = frame[2];
+  uint16_t seq    = get16(&frame[3]) & kBulkSeqMask;
+  const bool retry = (get16(&frame[3]) & kBulkRetryFlag) != 0;
+  uint32_t offset = get32(&frame[7]);
+  uint32_t total  = get32(&frame[11]);
+  const uint8_t transfer = (uint8_t)(get16(&frame[5]) >> kBulkTransferShift);
+
+  // The checksum covers the retransmission flag, so it cannot identify the repeat
+  if (retry && _bulkLastValid && transfer == _bulkLastTransfer && id == _bulkLastId &&
+      seq == _bulkLastSeq && total == _bulkLastTotal) {
+    ++_linkDuplicates;
+    return true;
+  }
+
+  if (!_bulkBuf || _bulkDone) {
+    // No buffer, or the last transfer has not been fetched yet
+    if (seq == 0) ++_bulkErrors;
+    return false;
+  }
+  if (seq == 0) {
+    if (_bulkRxActive) ++_bulkErrors; // The previous transfer never finished
+    _bulkRxActive = total <= _bulkCap;
+    if (!_bulkRxActive) {
+      ++_bulkErrors;
+      return false;
+    }
+    _bulkRxId = id;
+    _bulkRxSeq = 0;
+    _bulkRxTotal = total;
+    _bulkRxCount = 0;
+  }
+  if (!_bulkRxActive) return false;
+  if (id != _bulkRxId || seq != _bulkRxSeq || total != _bulkRxTotal ||
+      offset != _bulkRxCount || offset + len > total) {
+    _bulkRxActive = false;
+    ++_bulkErrors;
+    return false;
+  }
+
+  memcpy(_bulkBuf + offset, &frame[kBulkHeader], len);
+  _bulkRxCount += len;
+  _bulkRxSeq = (_bulkRxSeq + 1) & kBulkSeqMask;
+  _bulkLastValid = true;
+  _bulkLastId = id;
+  _bulkLastSeq = seq;
+  _bulkLastTotal = total;
+  _bulkLastTransfer = transfer;
+  if (_bulkRxCount == _bulkRxTotal) {
+    _bulkRxActive = false;
+    if (_bulkCb) {
+      _bulkCb(_bulkRxId, _bulkBuf, _bulkRxTotal);
+    } else {
+      _bulkDone = true;
     }
   }
-  // Re-queue the transaction to be ready for the next one
-  spi_slave_queue_trans(SPI3_HOST, &_trans, portMAX_DELAY);
+  return true;
 }
 
-bool beginSlave(uint8_t sckPin, uint8_t misoPin, uint8_t mosiPin, uint8_t csPin, Callback cb) {
+/**
+ * @brief Takes the pending acknowledgement and clears it. On the ESP32 the
+ * dispatch task may post the next one from the other core in between, so
+ * both happen in one atomic exchange; the RP2040 posts and takes it in the
+ * same interrupt.
+ */
+static inline uint32_t takeAck() {
+#ifdef ESP32
+  return __atomic_exchange_n(&_ackWord, 0, __ATOMIC_ACQ_REL);
+#else
+  const uint32_t ack = _ackWord;
+  _ackWord = 0;
+  return ack;
+#endif
+}
+
+/**
+ * @brief Fills the transmit buffer of the slot the DMA uses next.
+ * @param slot Slot that is used next.
+ * @param done Slot whose transaction just finished.
+ * @param clockedBits Bits the master clocked in that transaction.
+ * @note Runs in the ISR before the next slot is handed to the DMA, so the
+ * buffer is not in use.
+ */
+static void SLAVE_ISR(loadTx)(int slot, int done, size_t clockedBits) {
+  const bool cutOff = _txLen[done] && clockedBits < _txLen[done] * 8u;
+  const uint32_t ack = takeAck();
+  if (ack) {
+    // The master is polling for it with short transactions
+    if (cutOff && _txBuf[done][1] != kAckMagic && _txBuf[done][1] != kBulkAckMagic) {
+      memcpy(_txHold.bytes, _txBuf[done], _txLen[done]);
+      _txHold.len = _txLen[done];
+    }
+    _txLen[slot] = (uint8_t)buildAck(_txBuf[slot], (uint8_t)(ack >> 8), (uint8_t)ack);
+  } else if (cutOff) {
+    // The master stopped early; send the same frame again
+    if (slot != done) {
+      memcpy(_txBuf[slot], _txBuf[done], _txLen[done]);
+      _txLen[slot] = _txLen[done];
+    }
+  } else if (_txHold.len) {
+    memcpy(_txBuf[slot], _txHold.bytes, _txHold.len);
+    _txLen[slot] = _txHold.len;
+    _txHold.len = 0;
+  } else if (_txTail != _txHead) {
+    uint16_t tail = _txTail;
+    memcpy(_txBuf[slot], _txRing[tail].bytes, _txRing[tail].len);
+    _txLen[slot] = _txRing[tail].len;
+    _txTail = (tail + 1) % CTAG_SPI_IPC_TX_RING;
+  } else {
+    _txBuf[slot][0] = 0; // No magic, nothing to read for the master
+    _txLen[slot] = 0;
+  }
+}
+
+/**
+ * @brief Calls the user-provided callback with a packet or stores it in the
+ * receive ring.
+ * @note Runs in the ISR.
+ * @return False if the receive ring was full.
+ */
+static bool SLAVE_ISR(deliver)(const uint8_t* data, size_t len) {
+  if (_slaveCb) {
+    _slaveCb(data, len);
+    return true;
+  }
+  uint16_t head = _rxHead;
+  uint16_t next = (head + 1) % CTAG_SPI_IPC_RX_RING;
+  if (next == _rxTail) {
+    ++_rxOverflows;
+    return false;
+  }
+  _rxRing[head].len = len;
+  memcpy(_rxRing[head].data, data, len);
+  _rxHead = next;
+  return true;
+}
+
+/**
+ * @brief Delivers a reliable packet, unless it is a retransmission of the
+ * last one, and acknowledges it.
+ * @param payload [Seq, Message...].
+ * @note Runs in the ISR. A packet that finds the receive ring full is not
+ * acknowledged, so the master sends it again.
+ */
+static void SLAVE_ISR(handleReliable)(const uint8_t* payload, size_t len) {
+  const uint8_t seq = payload[0];
+  const uint32_t key = (1u << 24) | ((uint32_t)seq << 16) | crc16(payload + 1, len - 1);
+  if (key == _relLastKey) {
+    ++_linkDuplicates;
+  } else if (deliver(payload + 1, len - 1)) {
+    _relLastKey = key;
+  } else {
+    return;
+  }
+  _ackWord = (1u << 16) | ((uint32_t)kAckMagic << 8) | seq;
+}
+
+/**
+ * @brief Validates a received frame, counts it in the link statistics, and
+ * delivers its packet, each message of a batch, or adds the bulk fragment.
+ * @param rx The slot's receive buffer.
+ * @param received Number of bytes the master clocked.
+ * @note Runs in the ISR.
+ */
+static void SLAVE_ISR(handleFrame)(const uint8_t* rx, size_t received) {
+  if (received == 0) return;
+  _linkBytes += received;
+  const uint8_t magic = rx[1];
+  const bool bulk = (magic & kBulkMagicMask) == kBulkMagic;
+  if (received < 4 || rx[0] != 0xCA ||
+      !(bulk || magic == kPacketMagic || magic == kBatchMagic || magic == kReliableMagic)) {
+    ++_linkMagicErrors;
+    return;
+  }
+  int len = bulk ? checkBulkFrame(rx, received) : checkFrame(rx, received, magic);
+  if (len < 0) {
+    ++_linkCrcErrors;
+    return;
+  }
+  ++_linkOk;
+
+  if (bulk) {
+    if (handleBulk(rx, len) && (magic & kBulkAckFlag)) {
+      _ackWord = (1u << 16) | ((uint32_t)kBulkAckMagic << 8) | rx[3];
+    }
+  } else if (magic == kBatchMagic) {
+    // Walk the [Len, Message...] entries; a length that overruns the payload ends the walk
+    const uint8_t* p = &rx[3];
+    while (len > 0 && p[0] > 0 && 1 + p[0] <= len) {
+      deliver(p + 1, p[0]);
+      len -= 1 + p[0];
+      p += 1 + p[0];
+    }
+  } else if (magic == kReliableMagic) {
+    if (len >= 2) handleReliable(&rx[3], len);
+  } else if (len > 0) {
+    // Empty packets are polls from exchange() and are not passed on
+    deliver(&rx[3], len);
+  }
+}
+
+/**
+ * @brief Resets the rings and the bulk state before the slave starts.
+ */
+static void resetSlaveState(Callback cb) {
   _slaveCb = cb;
-  
+  _rxHead = _rxTail = 0;
+  _rxOverflows = 0;
+  _txHead = _txTail = 0;
+  for (int i = 0; i < SLAVE_BUFFERS; ++i) {
+    _txBuf[i][0] = 0;
+    _txLen[i] = 0;
+  }
+  _ackWord = 0;
+  _txHold.len = 0;
+  _relLastKey = 0;
+  _bulkLastValid = false;
+  _linkOverrunBase = 0;
+}
+
+#endif
+
+#ifdef ESP32
+
+static spi_slave_transaction_t _trans[SLAVE_BUFFERS];
+
+/**
+ * @brief A received buffer waiting for the dispatch task.
+ */
+struct FilledBuffer {
+  uint8_t* buf;
+  size_t   received;
+};
+
+// Deferred dispatch. The ISR swaps a filled receive buffer for a spare one
+// and passes it to the task through _filled; the task hands it back through
+// _spare once the frame is dispatched. Both are single-producer rings with
+// one entry kept free, so they have _spareCount + 1 entries.
+static bool         _deferEnabled = false;
+static uint8_t      _deferPriority = 0;
+static int8_t       _deferCore = -1;
+static uint16_t     _deferBuffers = CTAG_SPI_IPC_DEFER_BUFFERS;
+static TaskHandle_t _dispatchTask = nullptr;
+static uint8_t**    _spareBuf = nullptr;    // The spare buffers themselves
+static uint16_t     _spareCount = 0;
+static uint16_t     _deferRing = 1;
+static size_t       _spareSize = 0;
+static FilledBuffer* _filled = nullptr;
+static volatile uint16_t _filledHead = 0;   // ISR
+static volatile uint16_t _filledTail = 0;   // Task
+static uint8_t**    _spare = nullptr;
+static volatile uint16_t _spareHead = 0;    // Task
+static volatile uint16_t _spareTail = 0;    // ISR
+static volatile uint32_t _deferDrops = 0;
+
+/**
+ * @brief Validates and dispatches the buffers the ISR has passed on.
+ */
+static void dispatchTask(void* arg) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (_filledTail != _filledHead) {
+      uint16_t tail = _filledTail;
+      handleFrame(_filled[tail].buf, _filled[tail].received);
+
+      // Give the buffer back before releasing the entry
+      uint16_t head = _spareHead;
+      _spare[head] = _filled[tail].buf;
+      _spareHead = (head + 1) % _deferRing;
+      _filledTail = (tail + 1) % _deferRing;
+    }
+  }
+}
+
+/**
+ * @brief Frees the spare buffers and both rings.
+ */
+static void freeDispatchBuffers() {
+  for (int i = 0; i < _spareCount; ++i) heap_caps_free(_spareBuf[i]);
+  heap_caps_free(_spareBuf);
+  heap_caps_free(_filled);
+  heap_caps_free(_spare);
+  _spareBuf = nullptr;
+  _filled = nullptr;
+  _spare = nullptr;
+  _spareCount = 0;
+  _spareSize = 0;
+}
+
+/**
+ * @brief Allocates the spare buffers and starts the dispatch task on first use.
+ * @return False if memory ran out or the task could not be created.
+ */
+static bool startDispatch(size_t size) {
+  if (_spareSize != size || _spareCount != _deferBuffers) {
+    freeDispatchBuffers();
+    const uint16_t n = _deferBuffers;
+    // The ISR walks the rings, so they stay in internal RAM as well
+    _spareBuf = (uint8_t**)heap_caps_malloc(n * sizeof(uint8_t*), MALLOC_CAP_INTERNAL);
+    _filled = (FilledBuffer*)heap_caps_malloc((n + 1) * sizeof(FilledBuffer), MALLOC_CAP_INTERNAL);
+    _spare = (uint8_t**)heap_caps_malloc((n + 1) * sizeof(uint8_t*), MALLOC_CAP_INTERNAL);
+    if (!_spareBuf || !_filled || !_spare) {
+      freeDispatchBuffers();
+      return false;
+    }
+    for (; _spareCount < n; ++_spareCount) {
+      _spareBuf[_spareCount] = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+      if (!_spareBuf[_spareCount]) {
+        freeDispatchBuffers();
+        return false;
+      }
+    }
+    _spareSize = size;
+    _deferRing = n + 1;
+  }
+  _filledHead = _filledTail = 0;
+  for (int i = 0; i < _spareCount; ++i) _spare[i] = _spareBuf[i];
+  _spareTail = 0;
+  _spareHead = _spareCount;
+
+  if (!_dispatchTask &&
+      xTaskCreatePinnedToCore(dispatchTask, "SPI_IPC", 4096, nullptr, _deferPriority, &_dispatchTask,
+                              _deferCore < 0 ? tskNO_AFFINITY : _deferCore) != pdPASS) {
+    _dispatchTask = nullptr;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Passes a filled receive buffer to the dispatch task and puts a
+ * spare one into the descriptor.
+ * @note Runs in the ISR.
+ */
+static void IRAM_ATTR deferFrame(spi_slave_transaction_t* trans) {
+  uint16_t spare = _spareTail;
+  if (spare == _spareHead) {
+    // The task is behind; the frame is lost, the buffer is reused as it is
+    ++_deferDrops;
+    return;
+  }
+  uint16_t head = _filledHead;
+  _filled[head].buf = (uint8_t*)trans->rx_buffer;
+  _filled[head].received = trans->trans_len / 8;
+  _filledHead = (head + 1) % _deferRing;
+
+  trans->rx_buffer = _spare[spare];
+  _spareTail = (spare + 1) % _deferRing;
+
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(_dispatchTask, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+/**
+ * @brief ISR callback triggered after an SPI slave transaction is complete.
+ * @note This runs in an interrupt context. It handles the received frame (or
+ * passes it to the dispatch task), loads the next outbound frame and
+ * re-queues the descriptor behind the ones that are still waiting.
+ */
+static void IRAM_ATTR post_trans_cb(spi_slave_transaction_t *trans) {
+  if (_dispatchTask) {
+    deferFrame(trans);
+  } else {
+    handleFrame((const uint8_t*)trans->rx_buffer, trans->trans_len / 8);
+  }
+
+  // Descriptors are queued round-robin, so the next one is loaded right after this callback
+  int done = (int)(intptr_t)trans->user;
+  loadTx((done + 1) % SLAVE_BUFFERS, done, trans->trans_len);
+
+  // Re-queue the descriptor to be ready for a later transaction
+  spi_slave_queue_trans_isr(SPI3_HOST, trans);
+}
+
+bool beginSlave(uint8_t sckPin, uint8_t misoPin, uint8_t mosiPin, uint8_t csPin, Callback cb,
+                size_t maxFrameSize) {
+  // Allocate the buffers once
+  if (!allocSlaveBuffers((max(maxFrameSize, kFrameSize) + 3) & ~(size_t)3)) return false;
+  if (_deferEnabled && !startDispatch(_rxBufSize)) return false;
+  resetSlaveState(cb);
+
   // Configure the SPI bus
   spi_bus_config_t buscfg = {
       .mosi_io_num = mosiPin,
@@ -110,14 +1283,15 @@ bool beginSlave(uint8_t sckPin, uint8_t misoPin, uint8_t mosiPin, uint8_t csPin,
       .sclk_io_num = sckPin,
       .quadwp_io_num = -1,
       .quadhd_io_num = -1,
-      .max_transfer_sz = BUFFER_SIZE
+      .max_transfer_sz = (int)_rxBufSize
   };
 
-  // Configure the SPI slave interface
+  // Configure the SPI slave interface. Results are not collected with
+  // spi_slave_get_trans_result(); the ISR re-queues every descriptor itself.
   spi_slave_interface_config_t slvcfg = {
       .spics_io_num = csPin,
-      .flags = 0,
-      .queue_size = 1,
+      .flags = SPI_SLAVE_NO_RETURN_RESULT,
+      .queue_size = SLAVE_BUFFERS,
       .mode = 0, // Mode 0 for ESP32 slave. Master must match.
       .post_trans_cb = post_trans_cb
   };
@@ -128,38 +1302,221 @@ bool beginSlave(uint8_t sckPin, uint8_t misoPin, uint8_t mosiPin, uint8_t csPin,
       return false;
   }
 
-  // Set up the transaction buffer details
-  memset(&_trans, 0, sizeof(_trans));
-  _trans.length = BUFFER_SIZE * 8; // Length in bits
-  _trans.rx_buffer = _rxBuf;
-  _trans.tx_buffer = _txBuf;
+  // Set up the transaction descriptors and queue all of them
+  for (int i = 0; i < SLAVE_BUFFERS; ++i) {
+    memset(&_trans[i], 0, sizeof(_trans[i]));
+    _trans[i].length = _rxBufSize * 8; // Length in bits
+    _trans[i].rx_buffer = _rxBuf[i];
+    _trans[i].tx_buffer = _txBuf[i];
+    _trans[i].user = (void*)(intptr_t)i;
+    spi_slave_queue_trans(SPI3_HOST, &_trans[i], portMAX_DELAY);
+  }
 
-  // Queue the first transaction
-  spi_slave_queue_trans(SPI3_HOST, &_trans, portMAX_DELAY);
+  return true;
+}
 
+bool setDeferredDispatch(bool enable, uint8_t priority, int8_t core, uint16_t buffers) {
+  if (_dispatchTask) return enable; // The task cannot be moved once it runs
+  _deferEnabled = enable;
+  _deferPriority = priority;
+  _deferCore = core;
+  _deferBuffers = buffers ? buffers : 1;
   return true;
 }
 
-bool available() { return _rxReady; }
+uint32_t deferredDrops() { return _deferDrops; }
+
+#elif defined(ARDUINO_ARCH_RP2040)
+
+// The PL022 sees CS on its hardware SS input but raises no interrupt at the
+// end of a transaction, so the same pin also has a GPIO interrupt on the
+// rising edge.
+static spi_inst_t* _slaveSpi = nullptr;
+static int _slaveDmaTx = -1;
+static int _slaveDmaRx = -1;
+static int _slaveSlot = 0;               // Slot the DMA is filling
+
+/**
+ * @brief Resets the SPI block, which empties both FIFOs, and sets it up as a
+ * mode 3 slave. The TX FIFO has already been filled from the last slot's
+ * buffer, and there is no other way to discard those bytes.
+ */
+static void __not_in_flash_func(resetSlaveSpi)() {
+  reset_unreset_block_num_wait_blocking(spi_get_index(_slaveSpi) ? RESET_SPI1 : RESET_SPI0);
+  spi_hw_t* hw = spi_get_hw(_slaveSpi);
+  spi_set_format(_slaveSpi, 8, SPI_CPOL_1, SPI_CPHA_1, SPI_MSB_FIRST);
+  hw->cr1 = SPI_SSPCR1_MS_BITS;
+  hw->dmacr = SPI_SSPDMACR_TXDMAE_BITS | SPI_SSPDMACR_RXDMAE_BITS;
+  hw_set_bits(&hw->cr1, SPI_SSPCR1_SSE_BITS);
+}
+
+/**
+ * @brief Hands a slot's buffers to both DMA channels.
+ */
+static void __not_in_flash_func(armSlave)(int slot) {
+  dma_channel_set_write_addr(_slaveDmaRx, _rxBuf[slot], false);
+  dma_channel_set_trans_count(_slaveDmaRx, _rxBufSize, false);
+  dma_channel_set_read_addr(_slaveDmaTx, _txBuf[slot], false);
+  dma_channel_set_trans_count(_slaveDmaTx, _rxBufSize, false);
+  dma_start_channel_mask((1u << _slaveDmaRx) | (1u << _slaveDmaTx));
+}
+
+/**
+ * @brief CS rising edge: the master has finished a frame.
+ * @note Runs in the GPIO interrupt. The next slot is armed before the frame
+ * is checked, so the master only has to leave CS high for the few
+ * microseconds until the interrupt has run (see CTAG_SPI_IPC_ASYNC_GAP_US).
+ */
+static void __not_in_flash_func(csRise)() {
+  // The last byte may still be on its way from the RX FIFO
+  while (spi_is_readable(_slaveSpi) && dma_channel_is_busy(_slaveDmaRx)) tight_loop_contents();
+  size_t received = _rxBufSize - dma_channel_hw_addr(_slaveDmaRx)->transfer_count;
+  dma_channel_abort(_slaveDmaRx);
+  dma_channel_abort(_slaveDmaTx);
+
+  int done = _slaveSlot;
+  int slot = (done + 1) % SLAVE_BUFFERS;
+  loadTx(slot, done, received * 8);
+  resetSlaveSpi();
+  armSlave(slot);
+  _slaveSlot = slot;
+
+  if (received) handleFrame(_rxBuf[done], received);
+}
+
+bool beginSlave(uint8_t sckPin, uint8_t misoPin, uint8_t mosiPin, uint8_t csPin, Callback cb,
+                size_t maxFrameSize) {
+  // The pins must be the RX, CS, SCK and TX functions of one SPI block
+  uint8_t index = (sckPin >> 3) & 1;
+  if ((mosiPin & 3) != 0 || (csPin & 3) != 1 || (sckPin & 3) != 2 || (misoPin & 3) != 3 ||
+      ((mosiPin >> 3) & 1) != index || ((csPin >> 3) & 1) != index ||
+      ((misoPin >> 3) & 1) != index) {
+    return false;
+  }
+  if (_slaveSpi) detachInterrupt(csPin);
+  _slaveSpi = index ? spi1 : spi0;
+
+  if (!allocSlaveBuffers(max(maxFrameSize, kFrameSize))) return false;
+  resetSlaveState(cb);
+
+  if (_slaveDmaRx < 0) {
+    int tx = dma_claim_unused_channel(false);
+    int rx = dma_claim_unused_channel(false);
+    if (tx < 0 || rx < 0) {
+      if (tx >= 0) dma_channel_unclaim(tx);
+      if (rx >= 0) dma_channel_unclaim(rx);
+      return false;
+    }
+    _slaveDmaTx = tx;
+    _slaveDmaRx = rx;
+  }
+  dma_channel_abort(_slaveDmaRx);
+  dma_channel_abort(_slaveDmaTx);
+
+  dma_channel_config c = dma_channel_get_default_config(_slaveDmaTx);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, spi_get_dreq(_slaveSpi, true));
+  dma_channel_configure(_slaveDmaTx, &c, &spi_get_hw(_slaveSpi)->dr, nullptr, 0, false);
+
+  c = dma_channel_get_default_config(_slaveDmaRx);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+  channel_config_set_read_increment(&c, false);
+  channel_config_set_write_increment(&c, true);
+  channel_config_set_dreq(&c, spi_get_dreq(_slaveSpi, false));
+  dma_channel_configure(_slaveDmaRx, &c, nullptr, &spi_get_hw(_slaveSpi)->dr, 0, false);
+
+  gpio_set_function(mosiPin, GPIO_FUNC_SPI);
+  gpio_set_function(csPin, GPIO_FUNC_SPI);
+  gpio_set_function(sckPin, GPIO_FUNC_SPI);
+  gpio_set_function(misoPin, GPIO_FUNC_SPI);
+
+  _slaveSlot = 0;
+  resetSlaveSpi();
+  armSlave(0);
+  // GPIO interrupts see the pad even while the pin belongs to the SPI block
+  attachInterrupt(csPin, csRise, RISING);
+  return true;
+}
+
+bool setDeferredDispatch(bool enable, uint8_t priority, int8_t core, uint16_t buffers) { return !enable; }
+uint32_t deferredDrops() { return 0; }
+
+#endif
+
+#if defined(ESP32) || defined(ARDUINO_ARCH_RP2040)
+
+bool available() { return _rxHead != _rxTail; }
+
+size_t pending() {
+  return (_rxHead + CTAG_SPI_IPC_RX_RING - _rxTail) % CTAG_SPI_IPC_RX_RING;
+}
 
 size_t receive(uint8_t* buffer, size_t maxLen) {
-  if (!_rxReady) return 0;
-  
-  size_t len = _rxBuf[2];
+  uint16_t tail = _rxTail;
+  if (tail == _rxHead) return 0;
+
+  size_t len = _rxRing[tail].len;
   if (maxLen >= len) {
-    memcpy(buffer, &_rxBuf[3], len);
-  } else { 
+    memcpy(buffer, _rxRing[tail].data, len);
+  } else {
     len = 0; // Buffer too small, return 0
   }
-  
-  _rxReady = false; // Reset the flag after reading
+
+  _rxTail = (tail + 1) % CTAG_SPI_IPC_RX_RING; // Release the slot after reading
   return len;
 }
 
+uint32_t overflows() { return _rxOverflows; }
+
+bool slaveSend(const uint8_t* data, size_t len) {
+  if (len > kMaxPayload) return false;
+  uint16_t head = _txHead;
+  uint16_t next = (head + 1) % CTAG_SPI_IPC_TX_RING;
+  if (next == _txTail) return false;
+  _txRing[head].len = (uint8_t)buildFrame(_txRing[head].bytes, data, len);
+  _txHead = next;
+  return true;
+}
+
+size_t slaveTxPending() {
+  return (_txHead + CTAG_SPI_IPC_TX_RING - _txTail) % CTAG_SPI_IPC_TX_RING;
+}
+
+void setBulkBuffer(uint8_t* buffer, size_t capacity, BulkCallback cb) {
+  _bulkBuf = nullptr; // Stops the ISR from using the old buffer first
+  _bulkRxActive = false;
+  _bulkDone = false;
+  _bulkCb = cb;
+  _bulkCap = capacity;
+  _bulkBuf = buffer;
+}
+
+size_t bulkReceive(uint8_t* id) {
+  if (!_bulkDone) return 0;
+  if (id) *id = _bulkRxId;
+  size_t len = _bulkRxTotal;
+  _bulkDone = false;
+  return len;
+}
+
+uint32_t bulkErrors() { return _bulkErrors; }
+
 #else // Placeholder for other architectures
-bool beginSlave(uint8_t sckPin, uint8_t misoPin, uint8_t mosiPin, uint8_t csPin, Callback cb) { return false; }
+bool beginSlave(uint8_t sckPin, uint8_t misoPin, uint8_t mosiPin, uint8_t csPin, Callback cb,
+                size_t maxFrameSize) { return false; }
 bool available() { return false; }
+size_t pending() { return 0; }
 size_t receive(uint8_t* buffer, size_t maxLen) { return 0; }
+uint32_t overflows() { return 0; }
+bool slaveSend(const uint8_t* data, size_t len) { return false; }
+size_t slaveTxPending() { return 0; }
+void setBulkBuffer(uint8_t* buffer, size_t capacity, BulkCallback cb) {}
+size_t bulkReceive(uint8_t* id) { return 0; }
+uint32_t bulkErrors() { return 0; }
+bool setDeferredDispatch(bool enable, uint8_t priority, int8_t core, uint16_t buffers) { return !enable; }
+uint32_t deferredDrops() { return 0; }
 #endif
 
-} // namespace CTAG_SPI_IPC
\ No newline at end of file
+} // namespace CTAG_SPI_IPC
@@ -8,7 +8,36 @@
  * This library provides a master/slave communication protocol over SPI,
  * ensuring data integrity with a custom packet structure including magic bytes,
  * length, and a CRC8 checksum. The master implementation is platform-independent,
- * while the slave implementation is currently specific to the ESP32.
+ * while the slave is implemented for the ESP32 (SPI slave driver, mode 0) and
+ * the RP2040 (PL022 with DMA, mode 3), so two RP2040s can also talk directly.
+ *
+ * The link is full duplex: the slave queues packets of its own with slaveSend()
+ * (meters, spectra, voice states), and the master receives them with exchange()
+ * in the same transaction that carries its own packet.
+ *
+ * Blocks larger than one packet (samples, wavetables, presets, firmware) go
+ * through the bulk mode: the master splits them into sequence-numbered
+ * fragments of up to 4 KiB, and the slave reassembles them into a buffer of the
+ * caller's. Control packets can be sent between two fragments. Fragments are
+ * protected by a CRC-32 by default; the master picks the checksum, and its
+ * kind travels in the fragment's second magic byte.
+ *
+ * Small messages (a parameter change, a note, a clock tick) can be coalesced
+ * with post(): they share one frame, each behind a length byte, and go out
+ * when the frame is full or the oldest has waited for the flush deadline.
+ * The slave delivers every message of such a batch as a packet of its own.
+ *
+ * On the RP2040 the master can also queue packets with sendAsync(): two DMA
+ * channels clock them out back to back, with CS toggled per frame from the
+ * DMA interrupt, while the CPU keeps scanning controls. Other masters send
+ * them synchronously with the same API.
+ *
+ * Control streams are fire-and-forget: a corrupt frame is dropped, and the
+ * next value replaces it anyway. Messages that must arrive (presets, bulk
+ * transfers) can be sent reliably: sendReliable() and setBulkReliable() add a
+ * sequence number, the slave acknowledges in its reply stream, and the
+ * master sends the frame again if no acknowledgement comes. Both sides count
+ * good and bad frames, overruns and bytes; see getLinkStats().
  * 
  * 1. CTAG_SPI_IPC
  */
@@ -19,15 +48,155 @@
 #include <Arduino.h>
 #include <SPI.h>
 
+/**
+ * @brief Number of DMA transaction descriptors the slave keeps queued.
+ * While one received frame is being checked, the next ones already land in
+ * the other descriptors' buffers.
+ */
+#ifndef CTAG_SPI_IPC_RX_SLOTS
+#define CTAG_SPI_IPC_RX_SLOTS 4
+#endif
+
+/**
+ * @brief Capacity of the slave's receive ring in frames (polling mode).
+ * One entry is kept free, so the ring holds CTAG_SPI_IPC_RX_RING - 1 frames.
+ */
+#ifndef CTAG_SPI_IPC_RX_RING
+#define CTAG_SPI_IPC_RX_RING 16
+#endif
+
+/**
+ * @brief Default number of spare receive buffers of the ESP32 slave's
+ * dispatch task (see setDeferredDispatch()): frames the task may fall behind by.
+ */
+#ifndef CTAG_SPI_IPC_DEFER_BUFFERS
+#define CTAG_SPI_IPC_DEFER_BUFFERS 8
+#endif
+
+/**
+ * @brief Capacity of the slave's transmit ring in frames (see slaveSend()).
+ */
+#ifndef CTAG_SPI_IPC_TX_RING
+#define CTAG_SPI_IPC_TX_RING 8
+#endif
+
+/**
+ * @brief Capacity of the master's reply queue in packets: slave packets that
+ * arrive during transfers that do not return them (e.g. send()) wait there
+ * for exchange() or poll(). One entry is kept free.
+ */
+#ifndef CTAG_SPI_IPC_REPLY_RING
+#define CTAG_SPI_IPC_REPLY_RING 8
+#endif
+
+/**
+ * @brief Capacity of the master's asynchronous queue in frames (see sendAsync()).
+ * Completed frames keep their slot until their result is fetched.
+ */
+#ifndef CTAG_SPI_IPC_ASYNC_QUEUE
+#define CTAG_SPI_IPC_ASYNC_QUEUE 8
+#endif
+
+/**
+ * @brief Time in microseconds CS stays high between two frames, so the slave
+ * can re-arm its DMA before the next one starts. Queued and synchronous
+ * frames both keep it.
+ */
+#ifndef CTAG_SPI_IPC_ASYNC_GAP_US
+#define CTAG_SPI_IPC_ASYNC_GAP_US 10
+#endif
+
+/**
+ * @brief Polls the master clocks while it waits for an acknowledgement (see
+ * sendReliable()). The slave acknowledges in one of its next transactions;
+ * an ESP32 with deferred dispatch may need more polls.
+ */
+#ifndef CTAG_SPI_IPC_ACK_POLLS
+#define CTAG_SPI_IPC_ACK_POLLS 8
+#endif
+
+/**
+ * @brief Pause in microseconds before each acknowledgement poll, so the
+ * slave's interrupt (or dispatch task) can run.
+ */
+#ifndef CTAG_SPI_IPC_ACK_POLL_US
+#define CTAG_SPI_IPC_ACK_POLL_US 20
+#endif
+
 namespace CTAG_SPI_IPC {
 
+/// Bytes of one full frame: [0xCA, 0xFE, Len, Payload..., CRC].
+constexpr size_t kFrameSize = 64;
+
+/// Largest payload of one packet.
+constexpr size_t kMaxPayload = kFrameSize - 4;
+
+/// Largest message of a batch (see post()); one byte of the payload is its length.
+constexpr size_t kMaxMessage = kMaxPayload - 1;
+
+/// Header bytes of a bulk fragment: [0xCA, 0xB0 | Checksum, ID, Seq(2), Len(2), Offset(4), Total(4)].
+/// Bit 15 of Seq marks a retransmission, so a transfer has at most 32768 fragments.
+/// In acknowledged fragments bits 13 to 15 of Len carry a transfer number that
+/// the master advances with every beginBulk().
+constexpr size_t kBulkHeader = 15;
+
+/// Largest payload of one bulk fragment.
+constexpr size_t kBulkPayload = 4096;
+
+/// Bytes of the largest bulk frame (header, payload and a CRC-32). Pass it to
+/// beginSlave() to receive bulk transfers.
+constexpr size_t kBulkFrameSize = kBulkHeader + kBulkPayload + 4;
+
+/**
+ * @brief Checksum of a bulk fragment, sent little-endian behind the payload.
+ * Packets and batches always use CRC-8.
+ */
+enum class Checksum : uint8_t {
+  Crc8  = 0,  ///< 1 byte, polynomial 0x07; understood by every slave version.
+  Crc16 = 1,  ///< 2 bytes, CRC-16/X-25.
+  Crc32 = 2   ///< 4 bytes, the CRC-32 of zlib and Ethernet.
+};
+
+/**
+ * @brief Health counters of the link, as seen by this side.
+ */
+struct LinkStats {
+  uint32_t framesOk;          ///< Valid frames received (packets, batches, fragments, acknowledgements).
+  uint32_t crcErrors;         ///< Frames with a known magic but a wrong checksum or length.
+  uint32_t magicErrors;       ///< Transactions that did not start with a known magic.
+  uint32_t overruns;          ///< Valid packets lost to a full receive ring or dispatch task (slave), or reply queue (master).
+  uint32_t duplicates;        ///< Retransmitted reliable frames that had already arrived (slave).
+  uint32_t retransmits;       ///< Reliable frames sent again (master).
+  uint32_t reliableFailures;  ///< Reliable frames never acknowledged, after all retries (master).
+  uint32_t bytes;             ///< Bytes clocked; every byte goes both ways.
+  uint32_t bytesPerSecond;    ///< Bytes per second since the previous getLinkStats() call.
+};
+
 /**
  * @brief Callback function type for the slave mode.
- * @note On ESP32, this function is called from an interrupt service routine (ISR).
- * Keep the code within the callback short and efficient.
+ * @note This function is called from an interrupt service routine (ISR): the
+ * SPI interrupt on ESP32, the CS pin's GPIO interrupt on RP2040. Keep the code
+ * within the callback short and efficient. On ESP32, setDeferredDispatch()
+ * moves it to a task, where it may block and take longer.
  */
 using Callback = void(*)(const uint8_t* data, size_t len);
 
+/**
+ * @brief Callback function type for a completed bulk transfer (slave mode).
+ * @note Called from the same context as Callback (the ISR, or the dispatch
+ * task). The data stays valid until the next transfer starts.
+ */
+using BulkCallback = void(*)(uint8_t id, const uint8_t* data, size_t len);
+
+/**
+ * @brief Callback function type for a completed asynchronous frame (master mode).
+ * @note On RP2040, this function is called from the DMA interrupt.
+ * @param tag The tag passed to sendAsync().
+ * @param rx The slave's payload from the same transaction.
+ * @param rxLen Its length, 0 if the slave had nothing queued.
+ */
+using AsyncCallback = void(*)(uint32_t tag, const uint8_t* rx, size_t rxLen);
+
 // --- Master Functions (Platform-Independent) ---
 
 /**
@@ -45,41 +214,367 @@ bool beginMaster(uint8_t csPin,
 
 /**
  * @brief Sends a data packet as the SPI Master.
- * @note The maximum payload size is 61 bytes due to the packet overhead.
+ * @note The maximum payload size is kMaxPayload (60) bytes due to the packet overhead.
+ * Only the packet's own bytes are clocked. A slave packet that fits into them
+ * is kept in the reply queue for the next exchange() or poll(); a longer one
+ * is sent again in a later transaction.
  * @param data Pointer to the data buffer to send.
  * @param len The length of the data in bytes.
  * @return True if the packet was sent, false on error (e.g., payload too large).
  */
 bool send(const uint8_t* data, size_t len);
 
+/**
+ * @brief Sends a packet and receives the slave's next queued packet in the
+ * same transaction (full duplex).
+ * @note Always clocks a full kFrameSize frame. A packet with len 0 only polls
+ * the slave; the slave does not pass it on, and no frame is clocked while
+ * the reply queue holds packets. Packets that earlier transfers received are
+ * returned first, so the slave's packets keep their order.
+ * @param data Pointer to the data to send (may be nullptr if len is 0).
+ * @param len The length of the data in bytes.
+ * @param rxBuffer Buffer for the slave's payload.
+ * @param rxMaxLen The maximum size of rxBuffer.
+ * @return The length of the slave's oldest packet, 0 if none has arrived (or
+ * it did not fit and was dropped), or -1 if the packet could not be sent.
+ */
+int exchange(const uint8_t* data, size_t len, uint8_t* rxBuffer, size_t rxMaxLen);
+
+/**
+ * @brief Fetches the slave's next packet without sending one: from the reply
+ * queue, or with a poll transaction if the queue is empty.
+ * @return See exchange().
+ */
+inline int poll(uint8_t* rxBuffer, size_t rxMaxLen) { return exchange(nullptr, 0, rxBuffer, rxMaxLen); }
+
+/**
+ * @brief Sends a message reliably: the slave acknowledges it, and it is
+ * sent again (see setReliableRetries()) until it is. For presets and other
+ * messages that must not get lost; keep control streams on send() and post().
+ * @note The slave delivers the message like a packet, once, even if it
+ * arrives twice. Waiting for the acknowledgement takes a few short polls
+ * (CTAG_SPI_IPC_ACK_POLLS). Slave packets that arrive meanwhile are kept
+ * in the reply queue for exchange() or poll(), as with send(). A slave whose
+ * receive ring is full does not acknowledge, so the message is sent again.
+ * @param data Pointer to the message.
+ * @param len Length of the message, 1 to kMaxMessage bytes.
+ * @return True once the slave has acknowledged, false if it never did or the
+ * message is empty or too large.
+ */
+bool sendReliable(const uint8_t* data, size_t len);
+
+/**
+ * @brief Sets how often an unacknowledged reliable frame is sent again
+ * (default 3).
+ */
+void setReliableRetries(uint8_t retries);
+
+/**
+ * @brief Makes the slave acknowledge every bulk fragment; a fragment without
+ * acknowledgement is sent again. A fragment that fails all retries abandons
+ * the transfer: bulkStep() returns -1 and sendBulk() false.
+ * @note Needs a slave with the same library version.
+ */
+void setBulkReliable(bool enable);
+
+/**
+ * @brief Starts a bulk transfer of a large block (samples, wavetables, presets,
+ * firmware). Nothing is sent yet; call bulkStep() until it returns 0.
+ * @note The data must stay valid until the transfer is done. Control packets
+ * may be sent with send() or exchange() between two bulkStep() calls, so they
+ * wait at most one fragment. Every fragment clocks out the slave's next
+ * packet; it is kept in the reply queue, so poll() between fragments to
+ * receive the slave's telemetry or keyframe requests during a transfer.
+ * @param data Pointer to the block.
+ * @param len Length of the block in bytes.
+ * @param id Transfer ID, passed to the slave's BulkCallback.
+ * @param fragmentSize Payload bytes per fragment (1 to kBulkPayload).
+ * @return False if not initialized as master, a transfer is still running or
+ * the block needs more than 32768 fragments.
+ */
+bool beginBulk(const uint8_t* data, size_t len, uint8_t id, size_t fragmentSize = kBulkPayload);
+
+/**
+ * @brief Sends the next fragment of the running bulk transfer.
+ * @return The number of fragments still to send, 0 once the transfer is
+ * complete, or -1 if no transfer is running or a reliable fragment was never
+ * acknowledged (see setBulkReliable()).
+ */
+int bulkStep();
+
+/**
+ * @brief Sends a whole block in one call (beginBulk() and bulkStep() until done).
+ * @return False if the transfer could not be started or was abandoned.
+ */
+bool sendBulk(const uint8_t* data, size_t len, uint8_t id, size_t fragmentSize = kBulkPayload);
+
+/**
+ * @brief Adds a message to the current batch. The batch is sent in one
+ * frame when the next message would not fit, when serviceBatch() finds the
+ * deadline passed, or before any other transfer (send(), exchange(),
+ * bulkStep(), sendAsync()), so messages keep their order.
+ * @note By convention the first byte of a message is its type (e.g.
+ * CTAG_Params::kMsgId); the slave passes each message on as a packet, to its
+ * Callback or receive ring. A batch of many tiny messages needs as many free
+ * entries in the slave's receive ring (CTAG_SPI_IPC_RX_RING).
+ * @param data Pointer to the message (copied).
+ * @param len Length of the message, 1 to kMaxMessage bytes.
+ * @return False if the message is empty or too large, or the module is not
+ * initialized as master.
+ */
+bool post(const uint8_t* data, size_t len);
 
-// --- Slave Functions (ESP32 Specific Implementation) ---
+/**
+ * @brief Sends the current batch now.
+ * @note A slave packet that fits into the batch frame is kept in the reply
+ * queue for the next exchange() or poll(), as with send().
+ * @return True if a batch was sent, false if it was empty.
+ */
+bool flushBatch();
 
 /**
- * @brief Initializes the module as an SPI Slave (ESP32 only).
+ * @brief Sends the current batch if its oldest message has waited for the
+ * flush deadline. Call it from loop() at least as often as the deadline.
+ * @return True if a batch was sent.
+ */
+bool serviceBatch();
+
+/**
+ * @brief Sets the flush deadline: the longest a posted message may wait for
+ * more messages to share its frame (default 1000 us). 0 sends every message
+ * in a frame of its own at once.
+ */
+void setBatchDeadline(uint32_t us);
+
+/**
+ * @brief Number of messages in the current batch.
+ */
+size_t batchPending();
+
+/**
+ * @brief Queues a packet and returns at once. On RP2040 the frames go out by
+ * DMA, one CS-framed transaction each, while the calling core continues; on
+ * other targets the frame is sent before the call returns.
+ * @note Frames are full duplex like exchange(). Fetch each result with
+ * pollAsync() or set an AsyncCallback, otherwise the queue fills up.
+ * Synchronous calls (send(), exchange(), bulkStep()) wait for the queue to drain.
+ * Call from one core only. On RP2040 the queue keeps its SPI transaction
+ * open after it drains; the next flushAsync(), pollAsync() or synchronous
+ * call ends it, so other devices on the bus use it only after one of those.
+ * @param data Pointer to the data to send (copied into the queue).
+ * @param len The length of the data in bytes.
+ * @param tag A value handed back with the result.
+ * @return False if the queue is full, the payload is too large or the
+ * module is not initialized as master.
+ */
+bool sendAsync(const uint8_t* data, size_t len, uint32_t tag = 0);
+
+/**
+ * @brief Sets a function called for every completed asynchronous frame, or
+ * nullptr to collect the results for pollAsync().
+ */
+void setAsyncCallback(AsyncCallback cb);
+
+/**
+ * @brief Fetches the result of the oldest completed asynchronous frame.
+ * @param tag Receives the frame's tag (may be nullptr).
+ * @param rxBuffer Buffer for the slave's payload from the same transaction.
+ * @param rxMaxLen The maximum size of rxBuffer.
+ * @return -1 if no frame has completed, otherwise the length of the slave's
+ * payload (0 if it had nothing queued or it did not fit).
+ */
+int pollAsync(uint32_t* tag, uint8_t* rxBuffer, size_t rxMaxLen);
+
+/**
+ * @brief Number of asynchronous frames queued or in flight.
+ */
+size_t asyncPending();
+
+/**
+ * @brief Waits until all queued asynchronous frames have been sent.
+ */
+void flushAsync();
+
+/**
+ * @brief Sets the checksum of the bulk fragments the master sends (default
+ * Checksum::Crc32). The slave accepts all three.
+ * @note A CRC-8 catches only about 99.6 % of corrupted 4 KiB fragments; use
+ * Checksum::Crc8 only with a slave that predates the other kinds.
+ */
+void setBulkChecksum(Checksum kind);
+
+
+// --- Link Statistics (Master and Slave) ---
+
+/**
+ * @brief Reads the link counters. Call it from one place, e.g. a periodic
+ * debug print: bytesPerSecond covers the time since the previous call.
+ */
+LinkStats getLinkStats();
+
+/**
+ * @brief Sets all link counters to zero.
+ */
+void resetLinkStats();
+
+
+// --- Checksums ---
+
+/**
+ * @brief CRC-8 with polynomial 0x07, initial value 0 (check value 0xF4).
+ */
+uint8_t crc8(const uint8_t* data, size_t len);
+
+/**
+ * @brief CRC-16/X-25 (check value 0x906E).
+ */
+uint16_t crc16(const uint8_t* data, size_t len);
+
+/**
+ * @brief CRC-32 as in zlib (check value 0xCBF43926). On RP2040, blocks of 128
+ * bytes or more run through the DMA sniffer, which claims one DMA channel on
+ * first use; calls while the sniffer is busy or from the other core compute
+ * it in software. On ESP32 the ROM routine esp_rom_crc32_le() is used. Both
+ * are checked against the tables once and skipped if they disagree. Other
+ * targets compute it in software.
+ * @note Do not use the DMA sniffer elsewhere in the same sketch.
+ */
+uint32_t crc32(const uint8_t* data, size_t len);
+
+/**
+ * @brief CRC-32 from the tables, without hardware.
+ */
+uint32_t crc32Software(const uint8_t* data, size_t len);
+
+
+// --- Slave Functions (ESP32 and RP2040) ---
+
+/**
+ * @brief Initializes the module as an SPI Slave (ESP32 and RP2040).
+ *
+ * The ESP32 slave uses SPI3 in mode 0 and keeps CTAG_SPI_IPC_RX_SLOTS
+ * transactions queued. The RP2040 slave uses mode 3 (CPHA 0 would need CS to
+ * toggle after every byte) and two DMA buffers that are swapped in the CS
+ * pin's rising-edge interrupt; the master must leave CS high for a few
+ * microseconds between frames (CTAG_SPI_IPC_ASYNC_GAP_US, which this
+ * library's master keeps). Its pins must be the RX (MOSI), CSn, SCK and
+ * TX (MISO) functions of the same SPI block, e.g. GPIO 16 to 19 for SPI0.
  * @param sckPin The SPI Clock pin.
  * @param misoPin The SPI MISO pin (Slave Out).
  * @param mosiPin The SPI MOSI pin (Slave In).
  * @param csPin The SPI Chip Select pin.
- * @param cb Callback function that will be invoked when a new, valid packet arrives.
- * @return True on success, false otherwise.
+ * @param cb Callback function that will be invoked when a new, valid packet arrives,
+ * or nullptr to collect packets in the receive ring for available()/receive().
+ * @param maxFrameSize Size of each DMA buffer; kBulkFrameSize to accept bulk
+ * fragments of full size. Two buffers per descriptor (CTAG_SPI_IPC_RX_SLOTS)
+ * are allocated from internal DMA-capable RAM, about 33 KB for kBulkFrameSize;
+ * the RP2040 needs four buffers, about 16 KB.
+ * @return False if the pins do not fit (RP2040), memory or DMA channels ran
+ * out, or the driver could not be installed.
+ */
+bool beginSlave(uint8_t sckPin, uint8_t misoPin, uint8_t mosiPin, uint8_t csPin, Callback cb,
+                size_t maxFrameSize = kFrameSize);
+
+/**
+ * @brief Checks and dispatches received frames in a FreeRTOS task instead of
+ * the SPI interrupt (ESP32 only). Call before beginSlave().
+ *
+ * The interrupt then only swaps the filled receive buffer for a spare one,
+ * loads the next outbound frame, re-queues the descriptor and wakes the task
+ * by notification; CRC checks, bulk reassembly and the Callback run in the
+ * task. This keeps the interrupt short for I2S and lets handlers do real
+ * work. `buffers` spare buffers of maxFrameSize bytes are allocated; if the
+ * task falls behind by more frames, frames are dropped and counted by
+ * deferredDrops().
+ *
+ * @warning A burst of back-to-back frames longer than `buffers` (e.g. a
+ * batch flood or a bulk transfer without acknowledgements) arrives faster
+ * than a task can be scheduled, and everything beyond the spare buffers is
+ * lost. Deferred dispatch suits paced control traffic; for bulk or batch
+ * traffic, dispatch in the interrupt or size `buffers` for the longest burst.
+ * @param enable True to dispatch in the task.
+ * @param priority FreeRTOS priority of the task; keep it above the tasks
+ * that would otherwise delay packet handling.
+ * @param core Core of the task, or -1 for either.
+ * @param buffers Spare buffers, taken from internal DMA-capable RAM.
+ * @return False if dispatch cannot be changed: the task cannot be stopped
+ * once beginSlave() has started it, and the RP2040 slave always dispatches
+ * in its interrupt.
  */
-bool beginSlave(uint8_t sckPin, uint8_t misoPin, uint8_t mosiPin, uint8_t csPin, Callback cb);
+bool setDeferredDispatch(bool enable, uint8_t priority = 20, int8_t core = -1,
+                         uint16_t buffers = CTAG_SPI_IPC_DEFER_BUFFERS);
 
 /**
- * @brief Checks if a new packet is available to be read in slave mode (polling method).
- * @return True if a new packet has been received and validated.
+ * @brief Number of frames dropped because the dispatch task fell behind.
+ */
+uint32_t deferredDrops();
+
+/**
+ * @brief Checks if a packet is waiting in the receive ring (polling method).
+ * @return True if at least one validated packet can be read.
  */
 bool available();
 
 /**
- * @brief Reads the last received packet into a user-provided buffer.
+ * @brief Number of packets waiting in the receive ring.
+ */
+size_t pending();
+
+/**
+ * @brief Reads the oldest packet from the receive ring into a user-provided buffer.
+ * To drain a burst, call it while available() returns true: a return value
+ * of 0 does not mean the ring is empty.
  * @param buffer Pointer to the buffer where the data will be copied.
  * @param maxLen The maximum size of the buffer.
- * @return The number of bytes received, or 0 if no new packet was available.
+ * @return The number of bytes received, or 0 if no packet was available. A packet
+ * larger than maxLen is dropped and 0 is returned.
  */
 size_t receive(uint8_t* buffer, size_t maxLen);
 
+/**
+ * @brief Number of valid packets dropped because the receive ring was full.
+ */
+uint32_t overflows();
+
+/**
+ * @brief Queues a packet for the master (slave mode). It is shifted out on
+ * MISO during one of the master's next transactions.
+ * @note Must be called from one task only. The first transaction that clocks
+ * the whole packet delivers it: exchange() and poll() return it, send()
+ * keeps it in the master's reply queue. If the master clocks fewer bytes
+ * than the packet needs, the packet is repeated in the following transaction.
+ * @return False if the payload is too large or the transmit ring is full.
+ */
+bool slaveSend(const uint8_t* data, size_t len);
+
+/**
+ * @brief Number of packets queued with slaveSend() that have not been loaded
+ * into a transaction yet.
+ */
+size_t slaveTxPending();
+
+/**
+ * @brief Sets where bulk transfers are reassembled (slave mode).
+ * @param buffer Caller-provided buffer; a transfer larger than it is rejected.
+ * @param capacity Size of the buffer in bytes.
+ * @param cb Called when a transfer is complete, or nullptr to poll with bulkReceive().
+ */
+void setBulkBuffer(uint8_t* buffer, size_t capacity, BulkCallback cb = nullptr);
+
+/**
+ * @brief Checks for a completed bulk transfer (polling method). The transfer
+ * stays in the buffer, and new transfers are refused, until this is called.
+ * @param id Receives the transfer ID.
+ * @return The length of the completed transfer, or 0 if none is waiting.
+ */
+size_t bulkReceive(uint8_t* id);
+
+/**
+ * @brief Number of bulk transfers abandoned because a fragment was missing,
+ * out of order or did not fit the buffer.
+ */
+uint32_t bulkErrors();
+
 } // namespace CTAG_SPI_IPC
 
 #endif // CTAG_SPI_IPC_H
\ No newline at end of file
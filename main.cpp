@@ -0,0 +1,10 @@
+#include "CTAG_SPI_IPC.h"
+#include <cstdio>
+#include <zlib.h>
+#include <cstdlib>
+using namespace CTAG_SPI_IPC;
+int main(){const uint8_t s[]="123456789";
+printf("%02x %04x %08x %08x\n",crc8(s,9),crc16(s,9),crc32Software(s,9),crc32(s,9));
+uint8_t b[1000]; for(int i=0;i<1000;i++) b[i]=rand();
+for(int n=0;n<1000;n++) if(crc32Software(b,n)!=crc32(0,b,n)) {printf("mismatch %d\n",n);return 1;}
+puts("zlib ok");}